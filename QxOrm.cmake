@@ -286,6 +286,26 @@ if(_QX_ENABLE_QT_NETWORK)
    set(QX_LIBRARIES ${QX_LIBRARIES} Qt5::Network)
 endif() # _QX_ENABLE_QT_NETWORK
 
+################################
+# LZ4 Library Dependency (opt) #
+################################
+
+# QxService module provides a fast LZ4 compression codec (built-in implementation of LZ4 block format) to transfer data over network
+# If you enable _QX_ENABLE_LZ4 option, then the LZ4 codec uses liblz4 library instead of the built-in implementation (both are compatible)
+
+option(_QX_ENABLE_LZ4 "If you enable _QX_ENABLE_LZ4 option, then QxService module uses liblz4 library for its LZ4 compression codec (instead of the built-in implementation)" OFF)
+
+if(_QX_ENABLE_LZ4)
+   add_definitions(-D_QX_ENABLE_LZ4)
+   find_path(QX_LZ4_INCLUDE_DIR lz4.h)
+   find_library(QX_LZ4_LIBRARY NAMES lz4 liblz4)
+   if(NOT QX_LZ4_INCLUDE_DIR OR NOT QX_LZ4_LIBRARY)
+      message(FATAL_ERROR "liblz4 library not found : please disable _QX_ENABLE_LZ4 option or define QX_LZ4_INCLUDE_DIR and QX_LZ4_LIBRARY parameters")
+   endif()
+   include_directories(${QX_LZ4_INCLUDE_DIR})
+   set(QX_LIBRARIES ${QX_LIBRARIES} ${QX_LZ4_LIBRARY})
+endif() # _QX_ENABLE_LZ4
+
 ################################
 # No JSON Serialization Engine #
 ################################
@@ -152,6 +152,22 @@ contains(DEFINES, _QX_ENABLE_QT_NETWORK) {
 QT += network
 } # contains(DEFINES, _QX_ENABLE_QT_NETWORK)
 
+################################
+# LZ4 Library Dependency (opt) #
+################################
+
+# QxService module provides a fast LZ4 compression codec (built-in implementation of LZ4 block format) to transfer data over network
+# If you define _QX_ENABLE_LZ4 compilation option, then the LZ4 codec uses liblz4 library instead of the built-in implementation (both are compatible)
+# You can define where liblz4 is located using QX_LZ4_INCLUDE_PATH and QX_LZ4_LIB_PATH qmake variables
+
+# DEFINES += _QX_ENABLE_LZ4
+
+contains(DEFINES, _QX_ENABLE_LZ4) {
+!isEmpty(QX_LZ4_INCLUDE_PATH) { INCLUDEPATH += $${QX_LZ4_INCLUDE_PATH} }
+!isEmpty(QX_LZ4_LIB_PATH) { LIBS += -L$${QX_LZ4_LIB_PATH} }
+LIBS += -llz4
+} # contains(DEFINES, _QX_ENABLE_LZ4)
+
 ############################################
 # QxOrm Library Boost Serialization Engine #
 ############################################
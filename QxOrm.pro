@@ -128,8 +128,11 @@ HEADERS += ./include/QxFactory/QxFactoryX.h
 HEADERS += ./include/QxCommon/QxConfig.h
 HEADERS += ./include/QxCommon/QxMacro.h
 HEADERS += ./include/QxCommon/QxHashValue.h
+HEADERS += ./include/QxCommon/QxReadMostlyHash.h
+HEADERS += ./include/QxCommon/QxThreadLocalAggregator.h
 HEADERS += ./include/QxCommon/QxBool.h
 HEADERS += ./include/QxCommon/QxCache.h
+HEADERS += ./include/QxCommon/QxTrace.h
 HEADERS += ./include/QxCommon/QxPropertyBag.h
 HEADERS += ./include/QxCommon/QxSimpleCrypt.h
 HEADERS += ./include/QxCommon/QxAnyCastDynamic.h
@@ -166,6 +169,7 @@ HEADERS += ./include/QxDao/IxSqlQueryBuilder.h
 HEADERS += ./include/QxDao/QxSqlQueryBuilder.h
 HEADERS += ./include/QxDao/QxSqlQueryHelper.h
 HEADERS += ./include/QxDao/QxSqlQuery.h
+HEADERS += ./include/QxDao/QxSqlQueryCompiled.h
 HEADERS += ./include/QxDao/QxSqlDatabase.h
 HEADERS += ./include/QxDao/IxSqlRelation.h
 HEADERS += ./include/QxDao/QxSqlRelation.h
@@ -183,6 +187,8 @@ HEADERS += ./include/QxDao/QxDao_IsDirty.h
 HEADERS += ./include/QxDao/QxSoftDelete.h
 HEADERS += ./include/QxDao/QxSqlError.h
 HEADERS += ./include/QxDao/QxSession.h
+HEADERS += ./include/QxDao/QxUnitOfWork.h
+HEADERS += ./include/QxDao/QxIdentityMap.h
 HEADERS += ./include/QxDao/QxDateNeutral.h
 HEADERS += ./include/QxDao/QxTimeNeutral.h
 HEADERS += ./include/QxDao/QxDateTimeNeutral.h
@@ -194,6 +200,8 @@ HEADERS += ./include/QxDao/QxSqlJoin.h
 HEADERS += ./include/QxDao/QxSqlRelationLinked.h
 HEADERS += ./include/QxDao/QxDaoAsync.h
 HEADERS += ./include/QxDao/QxSqlSaveMode.h
+HEADERS += ./include/QxDao/QxDaoParallel.h
+HEADERS += ./include/QxDao/QxDaoMetrics.h
 HEADERS += ./include/QxDao/QxDaoThrowable.h
 
 HEADERS += ./include/QxDao/QxSqlElement/IxSqlElement.h
@@ -208,6 +216,7 @@ HEADERS += ./include/QxDao/QxSqlElement/QxSqlIsBetween.h
 HEADERS += ./include/QxDao/QxSqlElement/QxSqlIsNull.h
 HEADERS += ./include/QxDao/QxSqlElement/QxSqlLimit.h
 HEADERS += ./include/QxDao/QxSqlElement/QxSqlSort.h
+HEADERS += ./include/QxDao/QxSqlElement/QxSqlSeek.h
 
 HEADERS += ./include/QxDao/QxSqlGenerator/IxSqlGenerator.h
 HEADERS += ./include/QxDao/QxSqlGenerator/QxSqlGenerator.h
@@ -466,12 +475,14 @@ HEADERS += ./include/QxFunction/QxParameters.h
 HEADERS += ./include/QxService/IxParameter.h
 HEADERS += ./include/QxService/IxService.h
 HEADERS += ./include/QxService/QxClientAsync.h
+HEADERS += ./include/QxService/QxClientPool.h
 HEADERS += ./include/QxService/QxConnect.h
 HEADERS += ./include/QxService/QxServer.h
 HEADERS += ./include/QxService/QxService.h
 HEADERS += ./include/QxService/QxThread.h
 HEADERS += ./include/QxService/QxThreadPool.h
 HEADERS += ./include/QxService/QxTools.h
+HEADERS += ./include/QxService/QxCompression.h
 HEADERS += ./include/QxService/QxTransaction.h
 
 HEADERS += ./include/QxHttpServer/QxHttpRequest.h
@@ -479,6 +490,7 @@ HEADERS += ./include/QxHttpServer/QxHttpResponse.h
 HEADERS += ./include/QxHttpServer/QxHttpServer.h
 HEADERS += ./include/QxHttpServer/QxHttpTransaction.h
 HEADERS += ./include/QxHttpServer/QxHttpCookie.h
+HEADERS += ./include/QxHttpServer/QxHttpMetrics.h
 HEADERS += ./include/QxHttpServer/QxHttpSession.h
 HEADERS += ./include/QxHttpServer/QxHttpSessionManager.h
 
@@ -533,6 +545,7 @@ SOURCES += ./src/QxCollection/QxCollection.cpp
 
 SOURCES += ./src/QxCommon/QxBool.cpp
 SOURCES += ./src/QxCommon/QxCache.cpp
+SOURCES += ./src/QxCommon/QxTrace.cpp
 SOURCES += ./src/QxCommon/QxSimpleCrypt.cpp
 
 SOURCES += ./src/QxConvert/QxConvert_Export.cpp
@@ -554,15 +567,21 @@ SOURCES += ./src/QxDao/IxSqlQueryBuilder.cpp
 SOURCES += ./src/QxDao/QxSqlDatabase.cpp
 SOURCES += ./src/QxDao/IxSqlRelation.cpp
 SOURCES += ./src/QxDao/QxSqlQuery.cpp
+SOURCES += ./src/QxDao/QxSqlQueryCompiled.cpp
 SOURCES += ./src/QxDao/QxSession.cpp
+SOURCES += ./src/QxDao/QxUnitOfWork.cpp
+SOURCES += ./src/QxDao/QxIdentityMap.cpp
 SOURCES += ./src/QxDao/IxDao_Helper.cpp
 SOURCES += ./src/QxDao/IxPersistable.cpp
 SOURCES += ./src/QxDao/IxPersistableCollection.cpp
 SOURCES += ./src/QxDao/IxPersistableList.cpp
 SOURCES += ./src/QxDao/QxSqlRelationLinked.cpp
 SOURCES += ./src/QxDao/QxDaoAsync.cpp
+SOURCES += ./src/QxDao/QxDaoParallel.cpp
+SOURCES += ./src/QxDao/QxDaoMetrics.cpp
 SOURCES += ./src/QxDao/QxSqlRelationParams.cpp
 SOURCES += ./src/QxDao/QxSoftDelete.cpp
+SOURCES += ./src/QxDao/QxDao_IsDirty.cpp
 SOURCES += ./src/QxDao/QxDateNeutral.cpp
 SOURCES += ./src/QxDao/QxDateTimeNeutral.cpp
 SOURCES += ./src/QxDao/QxTimeNeutral.cpp
@@ -578,6 +597,7 @@ SOURCES += ./src/QxDao/QxSqlElement/QxSqlIsBetween.cpp
 SOURCES += ./src/QxDao/QxSqlElement/QxSqlIsNull.cpp
 SOURCES += ./src/QxDao/QxSqlElement/QxSqlLimit.cpp
 SOURCES += ./src/QxDao/QxSqlElement/QxSqlSort.cpp
+SOURCES += ./src/QxDao/QxSqlElement/QxSqlSeek.cpp
 
 SOURCES += ./src/QxDao/QxSqlGenerator/IxSqlGenerator.cpp
 SOURCES += ./src/QxDao/QxSqlGenerator/QxSqlGenerator_MySQL.cpp
@@ -656,11 +676,13 @@ SOURCES += ./src/QxRestApi/QxRestApi.cpp
 
 SOURCES += ./src/QxService/IxParameter.cpp
 SOURCES += ./src/QxService/IxService.cpp
+SOURCES += ./src/QxService/QxClientPool.cpp
 SOURCES += ./src/QxService/QxConnect.cpp
 SOURCES += ./src/QxService/QxServer.cpp
 SOURCES += ./src/QxService/QxThread.cpp
 SOURCES += ./src/QxService/QxThreadPool.cpp
 SOURCES += ./src/QxService/QxTools.cpp
+SOURCES += ./src/QxService/QxCompression.cpp
 SOURCES += ./src/QxService/QxTransaction.cpp
 
 SOURCES += ./src/QxHttpServer/QxHttpRequest.cpp
@@ -668,6 +690,7 @@ SOURCES += ./src/QxHttpServer/QxHttpResponse.cpp
 SOURCES += ./src/QxHttpServer/QxHttpServer.cpp
 SOURCES += ./src/QxHttpServer/QxHttpTransaction.cpp
 SOURCES += ./src/QxHttpServer/QxHttpCookie.cpp
+SOURCES += ./src/QxHttpServer/QxHttpMetrics.cpp
 SOURCES += ./src/QxHttpServer/QxHttpSession.cpp
 SOURCES += ./src/QxHttpServer/QxHttpSessionManager.cpp
 
@@ -711,6 +734,8 @@ OTHER_FILES += ./inl/QxDao/QxDao_DeleteById.inl
 OTHER_FILES += ./inl/QxDao/QxDao_ExecuteQuery.inl
 OTHER_FILES += ./inl/QxDao/QxDao_Exist.inl
 OTHER_FILES += ./inl/QxDao/QxDao_FetchAll.inl
+OTHER_FILES += ./inl/QxDao/QxDao_FetchAll_Parallel.inl
+OTHER_FILES += ./inl/QxDao/QxDao_FetchProjection.inl
 OTHER_FILES += ./inl/QxDao/QxDao_FetchAll_WithRelation.inl
 OTHER_FILES += ./inl/QxDao/QxDao_FetchById.inl
 OTHER_FILES += ./inl/QxDao/QxDao_FetchById_WithRelation.inl
@@ -68,6 +68,9 @@ protected:
   QMutex m_oMutexCache;      //!< Mutex => 'QxCache' is thread-safe
   long m_lMaxCost;           //!< Max cost before deleting object in cache
   long m_lCurrCost;          //!< Current cost in cache
+  qlonglong m_lHitCount;      //!< Number of objects found by at() method
+  qlonglong m_lMissCount;     //!< Number of keys not found by at() method
+  qlonglong m_lEvictionCount; //!< Number of objects removed automatically when max cost is reached
 
 public:
   QxCache();
@@ -77,6 +80,10 @@ public:
   long getMaxCost() const;
   void setMaxCost(long l);
 
+  qlonglong getHitCount();
+  qlonglong getMissCount();
+  qlonglong getEvictionCount();
+
   long count() const;
   long size() const;
   bool isEmpty() const;
@@ -0,0 +1,141 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_READ_MOSTLY_HASH_H_
+#define _QX_READ_MOSTLY_HASH_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxReadMostlyHash.h
+ * \author Lionel Marty
+ * \ingroup QxCommon
+ * \brief qx::QxReadMostlyHash<Key, Value> : thread-safe hash table optimized for many concurrent readers and rare writers
+ */
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qatomic.h>
+#include <QtCore/qthreadstorage.h>
+
+namespace qx {
+
+/*!
+ * \ingroup QxCommon
+ * \brief qx::QxReadMostlyHash<Key, Value> : thread-safe hash table optimized for many concurrent readers and rare writers
+ *
+ * Values are stored in an immutable snapshot (copy-on-write on each insert).
+ * Each thread keeps a reference to the last snapshot it read and a version number : while there is no insert, readers only load an atomic integer (no lock).
+ * After an insert, each thread takes the mutex once to refresh its snapshot.
+ * Readers never copy the shared pointer to the snapshot (no atomic reference counting shared between threads on the read path).
+ * This is useful for caches filled once (SQL queries built by class for example) and then read by all threads on each call.
+ */
+template <typename Key, typename Value>
+class QxReadMostlyHash
+{
+
+public:
+
+   typedef QHash<Key, Value> type_hash;
+   typedef std::shared_ptr<const type_hash> type_hash_ptr;
+
+private:
+
+   struct type_snapshot
+   {
+      type_hash_ptr m_pHash;     //!< Last snapshot read by current thread
+      int m_iVersion;            //!< Version of this snapshot
+      type_snapshot() : m_iVersion(-1) { ; }
+   };
+
+   QMutex m_mutex;                                 //!< Mutex used by writers (and by readers only to refresh their snapshot)
+   type_hash_ptr m_pHash;                          //!< Current snapshot (protected by mutex)
+   QAtomicInt m_iVersion;                          //!< Incremented on each modification
+   QThreadStorage<type_snapshot> m_snapshotByThread; //!< Snapshot and version read by each thread
+
+public:
+
+   QxReadMostlyHash() : m_pHash(std::make_shared<type_hash>()), m_iVersion(0) { ; }
+   ~QxReadMostlyHash() { ; }
+
+   bool find(const Key & key, Value & value)
+   {
+      const type_hash_ptr & pHash = snapshot();
+      typename type_hash::const_iterator itr = pHash->constFind(key);
+      if (itr == pHash->constEnd()) { return false; }
+      value = itr.value();
+      return true;
+   }
+
+   Value value(const Key & key) { const type_hash_ptr & pHash = snapshot(); return pHash->value(key); }
+
+   bool contains(const Key & key) { const type_hash_ptr & pHash = snapshot(); return pHash->contains(key); }
+
+   long count() { const type_hash_ptr & pHash = snapshot(); return static_cast<long>(pHash->count()); }
+
+   void insert(const Key & key, const Value & value)
+   {
+      QMutexLocker locker(& m_mutex);
+      std::shared_ptr<type_hash> pNewHash = std::make_shared<type_hash>(* m_pHash);
+      pNewHash->insert(key, value);
+      m_pHash = pNewHash;
+      m_iVersion.fetchAndAddRelease(1);
+   }
+
+   void clear()
+   {
+      QMutexLocker locker(& m_mutex);
+      m_pHash = std::make_shared<type_hash>();
+      m_iVersion.fetchAndAddRelease(1);
+   }
+
+private:
+
+   const type_hash_ptr & snapshot()
+   {
+      type_snapshot & local = m_snapshotByThread.localData();
+      if ((local.m_iVersion == m_iVersion.loadAcquire()) && local.m_pHash) { return local.m_pHash; }
+      QMutexLocker locker(& m_mutex);
+      local.m_pHash = m_pHash;
+      local.m_iVersion = m_iVersion.loadAcquire();
+      return local.m_pHash;
+   }
+
+   QxReadMostlyHash(const QxReadMostlyHash & other) Q_DECL_EQ_DELETE;
+   QxReadMostlyHash & operator=(const QxReadMostlyHash & other) Q_DECL_EQ_DELETE;
+
+};
+
+} // namespace qx
+
+#endif // _QX_READ_MOSTLY_HASH_H_
@@ -221,6 +221,16 @@ public:
    an empty string or a string containing nonsense may be returned.
    */
    QByteArray decryptToByteArray(const QByteArray &cypher);
+   /**
+   Decrypts a cyphertext binary encrypted with this class directly inside the given buffer
+   (no copy of the cyphertext is done, the buffer content is modified).
+
+   The returned QByteArray references the plain text located inside the buffer (see
+   QByteArray::fromRawData()), so the buffer must stay alive while the result is used.
+   If the cyphertext was compressed, the returned QByteArray owns its (uncompressed) data.
+   If an error occured, an empty QByteArray is returned and lastError() is set.
+   */
+   QByteArray decryptInPlace(char * cypher, int size);
 
    // enum to describe options that have been used for the encryption. Currently only one, but
    // that only leaves room for future extensions like adding a cryptographic hash...
@@ -234,6 +244,8 @@ public:
 private:
 
    void splitKey();
+   bool checkCypher(const char * cypher, int size, CryptoFlags & flags, int & headSize, int & plainSize);
+   bool decryptData(const char * cypher, int headSize, int plainSize, CryptoFlags flags, char * plain);
 
    quint64 m_key;
    QVector<char> m_keyParts;
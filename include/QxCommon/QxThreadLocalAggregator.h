@@ -0,0 +1,168 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_THREAD_LOCAL_AGGREGATOR_H_
+#define _QX_THREAD_LOCAL_AGGREGATOR_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxThreadLocalAggregator.h
+ * \author Lionel Marty
+ * \ingroup QxCommon
+ * \brief qx::QxThreadLocalAggregator<Key, Value> : hash table written by each thread without contention, and merged on demand
+ */
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadstorage.h>
+
+namespace qx {
+
+/*!
+ * \ingroup QxCommon
+ * \brief qx::QxThreadLocalAggregator<Key, Value> : hash table written by each thread without contention, and merged on demand
+ *
+ * Each thread writes to its own hash table, protected by its own mutex : this mutex is locked by this thread for each update (never contended), and by snapshot/reset.
+ * When a thread finishes, its values are merged into a hash table of finished threads.
+ * Value type must provide a default constructor and a <i>void merge(const Value & other)</i> method.
+ * This is used to collect metrics (qx::QxDaoMetrics and qx::QxHttpMetrics classes) from many threads at a low cost.
+ */
+template <typename Key, typename Value>
+class QxThreadLocalAggregator
+{
+
+public:
+
+   typedef QHash<Key, Value> type_hash;
+
+private:
+
+   struct type_thread_data
+   {
+      QMutex m_mutex;
+      type_hash m_hash;
+      QxThreadLocalAggregator * m_pOwner;
+
+      type_thread_data() : m_pOwner(NULL) { ; }
+      ~type_thread_data() { if (m_pOwner) { m_pOwner->retire(this); } }
+   };
+
+   QMutex m_mutex;                              //!< Mutex to protect list of threads and values of finished threads
+   QList<type_thread_data *> m_lstThreadData;   //!< Values of running threads
+   type_hash m_hashRetired;                     //!< Values of finished threads
+
+public:
+
+   QxThreadLocalAggregator() { ; }
+   ~QxThreadLocalAggregator()
+   {
+      QMutexLocker locker(& m_mutex);
+      for (type_thread_data * p : m_lstThreadData) { QMutexLocker lockerData(& p->m_mutex); p->m_pOwner = NULL; }
+   }
+
+   /*!
+    * Call fct(Value & value, bool bInserted) with the value of current thread associated to key (bInserted is true if value has just been created)
+    */
+   template <typename T_Fct>
+   void update(const Key & key, T_Fct fct)
+   {
+      type_thread_data * pData = getThreadData();
+      QMutexLocker locker(& pData->m_mutex);
+      typename type_hash::iterator itr = pData->m_hash.find(key);
+      bool bInserted = (itr == pData->m_hash.end());
+      if (bInserted) { itr = pData->m_hash.insert(key, Value()); }
+      fct(itr.value(), bInserted);
+   }
+
+   /*!
+    * Values of all threads (running and finished) merged by key, and cleared if bReset is true
+    */
+   type_hash snapshot(bool bReset)
+   {
+      QMutexLocker locker(& m_mutex);
+      type_hash hashAll = m_hashRetired;
+      if (bReset) { m_hashRetired.clear(); }
+      for (type_thread_data * p : m_lstThreadData)
+      {
+         QMutexLocker lockerData(& p->m_mutex);
+         merge(hashAll, p->m_hash);
+         if (bReset) { p->m_hash.clear(); }
+      }
+      return hashAll;
+   }
+
+private:
+
+   type_thread_data * getThreadData()
+   {
+      static QThreadStorage<type_thread_data *> storage;
+      if (! storage.hasLocalData()) { storage.setLocalData(new type_thread_data()); }
+      type_thread_data * pData = storage.localData();
+      if (pData->m_pOwner != this)
+      {
+         QMutexLocker locker(& m_mutex);
+         pData->m_pOwner = this; pData->m_hash.clear();
+         m_lstThreadData.append(pData);
+      }
+      return pData;
+   }
+
+   void retire(type_thread_data * pData)
+   {
+      QMutexLocker locker(& m_mutex);
+      QMutexLocker lockerData(& pData->m_mutex);
+      merge(m_hashRetired, pData->m_hash);
+      m_lstThreadData.removeAll(pData);
+      pData->m_pOwner = NULL;
+   }
+
+   static void merge(type_hash & hashTarget, const type_hash & hashSource)
+   {
+      for (typename type_hash::const_iterator itr = hashSource.constBegin(); itr != hashSource.constEnd(); ++itr)
+      {
+         typename type_hash::iterator itrTarget = hashTarget.find(itr.key());
+         if (itrTarget == hashTarget.end()) { hashTarget.insert(itr.key(), itr.value()); }
+         else { itrTarget.value().merge(itr.value()); }
+      }
+   }
+
+   QxThreadLocalAggregator(const QxThreadLocalAggregator & other) Q_DECL_EQ_DELETE;
+   QxThreadLocalAggregator & operator=(const QxThreadLocalAggregator & other) Q_DECL_EQ_DELETE;
+
+};
+
+} // namespace qx
+
+#endif // _QX_THREAD_LOCAL_AGGREGATOR_H_
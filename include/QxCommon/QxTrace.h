@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_TRACE_H_
+#define _QX_TRACE_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxTrace.h
+ * \author Lionel Marty
+ * \ingroup QxCommon
+ * \brief Lightweight request-scoped tracing spans (HTTP/service transactions, REST API, qx::dao functions, SQL execution) exported as Chrome trace-event JSON or OTLP-JSON
+ */
+
+#include <QtCore/qlist.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+
+#include <QxSingleton/QxSingleton.h>
+
+namespace qx {
+
+/*!
+ * \ingroup QxCommon
+ * \brief qx::QxTrace : lightweight tracing of requests, from qx::QxHttpTransaction (or qx::service::QxTransaction) down to SQL execution (this class is a singleton and is thread-safe)
+ *
+ * When tracing is enabled, spans are opened by :
+ * - qx::service::QxThread for each transaction (an HTTP request continues the trace of its caller if a W3C <i>traceparent</i> header is provided) ;
+ * - qx::QxRestApi for each request ;
+ * - qx::dao::detail::IxDao_Helper for each qx::dao function, with child spans built from its timers (db_open, build_sql, db_prepare, db_exec, db_next, cpp_build_instance, etc.) : a child span starts when its timer is started for the first time and its duration is the sum of all measures (for example, all next() calls of a fetch).
+ *
+ * The current span context is stored by thread : it is propagated to qx::QxDaoAsync and parallel qx::dao functions threads.
+ * To propagate it to your own threads, capture qx::QxTrace::currentContext() and create a qx::QxTraceContextScope instance in the other thread.
+ * The sampling decision is taken once by trace (root span), so a trace is always complete or not recorded at all.
+ * \code
+qx::QxTrace::getSingleton()->setOutputFile("./trace.json", qx::QxTrace::format_chrome_trace); // open this file with chrome://tracing or https://ui.perfetto.dev
+qx::QxTrace::getSingleton()->setSamplingRate(0.05); // record 5% of requests
+qx::QxTrace::setEnabled(true);
+ * \endcode
+ * A custom sink (sending spans to a collector for example) can be provided with setSink() : it receives spans by batch, toChromeTrace() and toOtlpJson() methods can be used to format them.
+ */
+class QX_DLL_EXPORT QxTrace : public QxSingleton<QxTrace>
+{
+
+   friend class QxSingleton<QxTrace>;
+
+public:
+
+   enum export_format { format_chrome_trace, format_otlp_json };
+
+   struct QX_DLL_EXPORT type_context
+   {
+      quint64 m_iTraceIdHigh;    //!< Trace id (128 bits) : high part
+      quint64 m_iTraceIdLow;     //!< Trace id (128 bits) : low part
+      quint64 m_iSpanId;         //!< Current span id
+      bool m_bSampled;           //!< Spans of this trace are recorded
+
+      type_context() : m_iTraceIdHigh(0), m_iTraceIdLow(0), m_iSpanId(0), m_bSampled(false) { ; }
+      bool isValid() const { return ((m_iTraceIdHigh != 0) || (m_iTraceIdLow != 0)); }
+
+      QByteArray toTraceParent() const;
+      static type_context fromTraceParent(const QByteArray & sTraceParent);
+   };
+
+   struct QX_DLL_EXPORT type_span
+   {
+      QString m_sName;                                   //!< Span name
+      QString m_sCategory;                               //!< Span category (transaction, rest_api, dao, sql)
+      type_context m_context;                            //!< Trace id and span id
+      quint64 m_iParentSpanId;                           //!< Parent span id (0 for a root span)
+      qint64 m_iStart;                                   //!< Start time (nano-seconds since epoch)
+      qint64 m_iDuration;                                //!< Duration (nano-seconds)
+      quint64 m_iThreadId;                               //!< Thread which has recorded the span
+      bool m_bError;                                     //!< Span ended with an error
+      QList<QPair<QString, QVariant> > m_lstAttributes;  //!< Span attributes
+
+      type_span() : m_iParentSpanId(0), m_iStart(0), m_iDuration(0), m_iThreadId(0), m_bError(false) { ; }
+   };
+
+   typedef QList<type_span> type_span_list;
+   typedef std::function<void (const type_span_list &)> type_fct_sink;
+
+private:
+
+   struct QxTraceImpl;
+   std::unique_ptr<QxTraceImpl> m_pImpl; //!< Private implementation idiom
+
+   QxTrace();
+   virtual ~QxTrace();
+
+public:
+
+   static bool isEnabled();
+   static void setEnabled(bool b);
+
+   double getSamplingRate() const;
+   void setSamplingRate(double d);
+   int getBatchSize() const;
+   void setBatchSize(int i);
+   QString getServiceName() const;
+   void setServiceName(const QString & s);
+
+   void setSink(const type_fct_sink & fct);
+   bool setOutputFile(const QString & sFileName, export_format eFormat = format_chrome_trace);
+   void record(const type_span & span);
+   void flush();
+
+   static type_context currentContext();
+   static void setCurrentContext(const type_context & ctx);
+   static type_context newRootContext();
+   static quint64 newSpanId();
+   static qint64 now();
+
+   static QByteArray toChromeTrace(const type_span_list & lst);
+   static QByteArray toOtlpJson(const type_span_list & lst, const QString & sServiceName);
+
+};
+
+/*!
+ * \ingroup QxCommon
+ * \brief qx::QxTraceSpan : scoped tracing span (using C++ RAII), it becomes the current span of the thread until it is destroyed (see qx::QxTrace class)
+ *
+ * If tracing is disabled or if the trace is not sampled, this class does nothing (no allocation).
+ */
+class QX_DLL_EXPORT QxTraceSpan
+{
+
+private:
+
+   std::unique_ptr<QxTrace::type_span> m_pSpan;    //!< Span recorded when ended (NULL if not recording)
+   QxTrace::type_context m_previousContext;        //!< Context of the thread to restore when the span is ended
+   bool m_bContextChanged;                         //!< Context of the thread has been changed by this span
+
+public:
+
+   QxTraceSpan(const char * sName, const char * sCategory);
+   QxTraceSpan(const QString & sName, const char * sCategory, const QxTrace::type_context & parent = QxTrace::type_context());
+   ~QxTraceSpan();
+
+   bool isRecording() const { return (m_pSpan.get() != NULL); }
+   QxTrace::type_context context() const;
+   qint64 startTime() const;
+
+   void setName(const QString & sName);
+   void setAttribute(const QString & sKey, const QVariant & vValue);
+   void setError(bool b);
+   void addChild(const QString & sName, const char * sCategory, qint64 iStart, qint64 iDuration, const QString & sAttrKey = QString(), const QVariant & vAttrValue = QVariant());
+   void end();
+
+private:
+
+   void begin(const QString & sName, const char * sCategory, const QxTrace::type_context & parent);
+
+   QxTraceSpan(const QxTraceSpan & other);
+   QxTraceSpan & operator=(const QxTraceSpan & other);
+
+};
+
+/*!
+ * \ingroup QxCommon
+ * \brief qx::QxTraceContextScope : install a span context (captured in another thread) as current context of the thread until this instance is destroyed (using C++ RAII)
+ */
+class QX_DLL_EXPORT QxTraceContextScope
+{
+
+private:
+
+   QxTrace::type_context m_previousContext;  //!< Context of the thread to restore
+   bool m_bContextChanged;                   //!< Context of the thread has been changed
+
+public:
+
+   QxTraceContextScope(const QxTrace::type_context & ctx);
+   ~QxTraceContextScope();
+
+private:
+
+   QxTraceContextScope(const QxTraceContextScope & other);
+   QxTraceContextScope & operator=(const QxTraceContextScope & other);
+
+};
+
+} // namespace qx
+
+QX_DLL_EXPORT_QX_SINGLETON_HPP(qx::QxTrace)
+
+#endif // _QX_TRACE_H_
@@ -43,6 +43,8 @@
  * \brief Helper class to communicate with database
  */
 
+#include <typeinfo>
+
 #include <QtSql/qsqldatabase.h>
 #include <QtSql/qsqlquery.h>
 #include <QtSql/qsqlerror.h>
@@ -77,6 +79,7 @@ namespace dao {
 namespace detail {
 
 struct IxDao_Timer;
+struct IxDao_Recycler;
 
 /*!
  * \ingroup QxDao
@@ -86,6 +89,7 @@ class QX_DLL_EXPORT IxDao_Helper
 {
 
    friend struct IxDao_Timer;
+   friend struct IxDao_Recycler;
 
 public:
 
@@ -95,6 +99,7 @@ public:
 private:
 
    struct IxDao_HelperImpl;
+   struct IxDao_HelperPool;
    std::unique_ptr<IxDao_HelperImpl> m_pImpl; //!< Private implementation idiom
 
 protected:
@@ -196,6 +201,26 @@ struct IxDao_Timer
 
 };
 
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::IxDao_Recycler : per-thread pools of dao helpers and SQL query builders, reset and reused by qx::dao functions instead of being allocated and destroyed for each call
+ *
+ * Builders are pooled by their C++ type (so by class and operation, for example qx::QxSqlQueryBuilder_FetchById<T>).
+ * This behaviour can be disabled with qx::QxSqlDatabase::getSingleton()->setRecycleDaoHelper(false).
+ */
+struct QX_DLL_EXPORT IxDao_Recycler
+{
+
+   static qx::IxSqlQueryBuilder * takeBuilder(const std::type_info & type);
+   static void releaseBuilder(qx::IxSqlQueryBuilder * pBuilder);
+   static void clearCurrentThread();
+
+   template <class T_Builder>
+   static qx::IxSqlQueryBuilder * builder()
+   { qx::IxSqlQueryBuilder * pBuilder = takeBuilder(typeid(T_Builder)); return (pBuilder ? pBuilder : new T_Builder()); }
+
+};
+
 } // namespace detail
 } // namespace dao
 } // namespace qx
@@ -106,6 +106,7 @@ public:
   void replaceSqlQueryAlias(QString &sql) const;
 
   virtual void init();
+  void reset();
   virtual void clone(const IxSqlQueryBuilder &other);
   virtual IxSqlQueryBuilder &
   buildSql(const QStringList &columns = QStringList(),
@@ -120,6 +121,8 @@ public:
   static void sql_CreateTable(QString &sql, IxSqlQueryBuilder &builder);
   static void sql_DeleteById(QString &sql, IxSqlQueryBuilder &builder,
                              bool bSoftDelete);
+  static void sql_DeleteById_In(QString &sql, IxSqlQueryBuilder &builder,
+                                bool bSoftDelete, long lCount, bool bRowValue);
   static void sql_Exist(QString &sql, IxSqlQueryBuilder &builder);
   static void sql_FetchAll(QString &sql, IxSqlQueryBuilder &builder);
   static void sql_FetchAll(QString &sql, IxSqlQueryBuilder &builder,
@@ -134,6 +137,8 @@ public:
                                          QString &sql,
                                          IxSqlQueryBuilder &builder);
   static void sql_Insert(QString &sql, IxSqlQueryBuilder &builder);
+  static void sql_Insert_MultiRow(QString &sql, IxSqlQueryBuilder &builder,
+                                  long lCount);
   static void sql_Update(QString &sql, IxSqlQueryBuilder &builder);
   static void sql_Update(QString &sql, IxSqlQueryBuilder &builder,
                          const QStringList &columns);
@@ -152,6 +157,10 @@ public:
 
   static void resolveInput_Insert(void *t, QSqlQuery &query,
                                   IxSqlQueryBuilder &builder);
+  static void resolveInput_Insert_MultiRow(void *t, QSqlQuery &query,
+                                           IxSqlQueryBuilder &builder,
+                                           long lIndex);
+  static long getInsertBindValuesCount(IxSqlQueryBuilder &builder);
   static void resolveInput_Update(void *t, QSqlQuery &query,
                                   IxSqlQueryBuilder &builder);
   static void resolveInput_Update(void *t, QSqlQuery &query,
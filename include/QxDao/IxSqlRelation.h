@@ -108,6 +108,8 @@ public:
    QString tableAliasOwner(QxSqlRelationParams & params) const;
    QString getSqlJoin(qx::dao::sql_join::join_type e = qx::dao::sql_join::no_join) const;
    bool traceSqlQuery() const;
+   bool getExtraTableDiffMode() const;
+   void setExtraTableDiffMode(bool b);
 
    virtual void init();
    virtual QString getDescription() const = 0;
@@ -176,6 +178,10 @@ protected:
 
    void createTable_ManyToOne(QxSqlRelationParams & params) const;
    QSqlError deleteFromExtraTable_ManyToMany(QxSqlRelationParams & params) const;
+   QSqlError deleteFromExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const;
+   QSqlError fetchFromExtraTable_ManyToMany(QxSqlRelationParams & params, QVariantList & lstDataIds) const;
+   QSqlError insertIntoExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const;
+   QSqlError saveExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const;
    QString createExtraTable_ManyToMany() const;
 
    bool addLazyRelation(QxSqlRelationParams & params, IxSqlRelation * pRelation) const;
@@ -56,6 +56,7 @@
 #include <QxDao/QxDaoPointer.h>
 #include <QxDao/QxSqlQuery.h>
 #include <QxDao/QxSqlSaveMode.h>
+#include <QxDao/QxDaoParallel.h>
 
 namespace qx {
 class QxSqlRelationParams;
@@ -69,6 +70,8 @@ template <class T> struct QxDao_FetchById;
 template <class T> struct QxDao_FetchById_WithRelation;
 template <class T> struct QxDao_FetchAll;
 template <class T> struct QxDao_FetchAll_WithRelation;
+template <class T> struct QxDao_FetchAll_Parallel;
+template <class T, class U> struct QxDao_FetchProjection;
 template <class T> struct QxDao_Insert;
 template <class T> struct QxDao_Insert_WithRelation;
 template <class T> struct QxDao_Update;
@@ -141,6 +144,22 @@ template <class T>
 inline QSqlError insert(T & t, QSqlDatabase * pDatabase = NULL)
 { return qx::dao::detail::QxDao_Insert<T>::insert(t, pDatabase); }
 
+/*!
+ * \ingroup QxDao
+ * \brief Insert a list of elements into database using multi-row statements (if supported by the SQL generator and if ids are not generated by the database)
+ * \param t List of elements to be inserted into database
+ * \param pDatabase Connection to database (you can manage your own connection pool for example, you can also define a transaction, etc.); if NULL, a valid connection for the current thread is provided by qx::QxSqlDatabase singleton class (optional parameter)
+ * \return Empty QSqlError object (from Qt library) if no error occurred; otherwise QSqlError contains a description of database error executing SQL query
+ *
+ * qx::dao::insert_multi_row<T>() execute following SQL query (rows per statement are limited by max bind values and max rows per insert of the SQL generator) :<br>
+ * <i>INSERT INTO my_table (my_column_1, my_column_2, etc.) VALUES (?, ?, etc.), (?, ?, etc.), etc.</i>
+ *
+ * Triggers are called by chunk of rows : on_before_insert for each element of the chunk, then the multi-row statement, then on_after_insert for each element of the chunk.
+ */
+template <class T>
+inline QSqlError insert_multi_row(T & t, QSqlDatabase * pDatabase = NULL)
+{ return qx::dao::detail::QxDao_Insert<T>::insert(t, pDatabase, true); }
+
 /*!
  * \ingroup QxDao
  * \brief Insert (if no exist) or update (if already exist) an element or a list of elements into database
@@ -664,6 +683,83 @@ template <class T>
 inline QSqlError fetch_by_query(const qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase = NULL, const QStringList & columns = QStringList())
 { return qx::dao::detail::QxDao_FetchAll<T>::fetchAll(query, t, pDatabase, columns); }
 
+/*!
+ * \ingroup QxDao
+ * \brief Fetch a list of objects of type T (container registered into QxOrm context) splitting the SQL query into several ranges of primary key (or partition column) executed concurrently on separate connections
+ * \param t Container to be fetched (retrieve all elements and properties associated); t is cleared before executing SQL query
+ * \param params Number of partitions, partition column (primary key by default, must be numeric) and whether order of parts must be preserved (optional parameter)
+ * \param pDatabase Connection to database cloned by each worker thread; if NULL, a valid connection for the current thread is provided by qx::QxSqlDatabase singleton class (optional parameter)
+ * \param columns List of database table columns (mapped to properties of C++ class T) to be fetched (optional parameter)
+ * \return Empty QSqlError object (from Qt library) if no error occurred; otherwise QSqlError contains a description of the first database error
+ *
+ * qx::dao::fetch_all_parallel<T>() execute following SQL queries (one per worker thread) :<br>
+ * <i>SELECT MIN(my_id), MAX(my_id) FROM my_table</i><br>
+ * <i>SELECT * FROM my_table WHERE ( my_id >= :from AND my_id < :to )</i>
+ *
+ * Each part runs on its own thread and connection (outside of any transaction opened by the caller), so this is not suitable for in-memory SQLite databases.
+ * Triggers (qx::dao::on_after_fetch) are called from worker threads, and settings defined only for the current thread by qx::QxSqlDatabase are not propagated to worker threads.
+ */
+template <class T>
+inline QSqlError fetch_all_parallel(T & t, const qx::dao::parallel_fetch & params = qx::dao::parallel_fetch(), QSqlDatabase * pDatabase = NULL, const QStringList & columns = QStringList())
+{ return qx::dao::detail::QxDao_FetchAll_Parallel<T>::fetchAll(qx::QxSqlQuery(), t, params, pDatabase, columns); }
+
+/*!
+ * \ingroup QxDao
+ * \brief Fetch a list of objects of type T (container registered into QxOrm context) filtered by a user SQL query, splitting the query into several ranges of primary key (or partition column) executed concurrently on separate connections
+ * \param query Define a user SQL query built with C++ methods (a query defined by a SQL string or with a LIMIT clause is executed without being split)
+ * \param t Container to be fetched (retrieve all elements and properties associated); t is cleared before executing SQL query
+ * \param params Number of partitions, partition column (primary key by default, must be numeric) and whether ORDER BY of the query must be preserved merging parts (optional parameter)
+ * \param pDatabase Connection to database cloned by each worker thread; if NULL, a valid connection for the current thread is provided by qx::QxSqlDatabase singleton class (optional parameter)
+ * \param columns List of database table columns (mapped to properties of C++ class T) to be fetched (optional parameter)
+ * \return Empty QSqlError object (from Qt library) if no error occurred; otherwise QSqlError contains a description of the first database error
+ *
+ * qx::dao::fetch_by_query_parallel<T>() execute following SQL queries (one per worker thread) :<br>
+ * <i>SELECT * FROM my_table</i> + <i>WHERE ( my_query... ) AND ( my_id >= :from AND my_id < :to )</i>
+ *
+ * If the query is ordered by the partition column, parts are appended; otherwise (ORDER BY columns must be mapped to properties of T and use the same direction) parts are merged on the calling thread.
+ * Same restrictions as qx::dao::fetch_all_parallel<T>() apply (separate connections and transactions, triggers called from worker threads).
+ */
+template <class T>
+inline QSqlError fetch_by_query_parallel(const qx::QxSqlQuery & query, T & t, const qx::dao::parallel_fetch & params = qx::dao::parallel_fetch(), QSqlDatabase * pDatabase = NULL, const QStringList & columns = QStringList())
+{ return qx::dao::detail::QxDao_FetchAll_Parallel<T>::fetchAll(query, t, params, pDatabase, columns); }
+
+/*!
+ * \ingroup QxDao
+ * \brief Fetch some columns of a table mapped to class T (registered into QxOrm context) into a list of lightweight rows (no instance of T is created)
+ * \param columns List of database table columns (mapped to properties of C++ class T) to be fetched, in the order of the row type
+ * \param rows Sequence container of rows (std::vector, QVector, std::list, QList, etc.) : a row is a std::tuple, a std::pair or a single value (if only 1 column); rows is cleared before executing SQL query
+ * \param pDatabase Connection to database (you can manage your own connection pool for example, you can also define a transaction, etc.); if NULL, a valid connection for the current thread is provided by qx::QxSqlDatabase singleton class (optional parameter)
+ * \return Empty QSqlError object (from Qt library) if no error occurred; otherwise QSqlError contains a description of database error executing SQL query
+ *
+ * qx::dao::fetch_projection<T>() execute following SQL query :<br>
+ * <i>SELECT my_id, column_1, column_2 FROM my_table</i>
+ *
+ * Each column is converted to the type of the row element using qx::cvt::from_variant() (resolved at compile-time) : triggers (qx::dao::on_before_fetch, qx::dao::on_after_fetch) and relations are not used.
+ * \code
+std::vector< std::tuple<long, QString> > rows;
+QSqlError daoError = qx::dao::fetch_projection<author>({ "author_id", "name" }, rows);
+ * \endcode
+ */
+template <class T, class U>
+inline QSqlError fetch_projection(const QStringList & columns, U & rows, QSqlDatabase * pDatabase = NULL)
+{ return qx::dao::detail::QxDao_FetchProjection<T, U>::fetch(columns, qx::QxSqlQuery(), rows, pDatabase); }
+
+/*!
+ * \ingroup QxDao
+ * \brief Fetch some columns of a table mapped to class T (registered into QxOrm context) filtered by a user SQL query into a list of lightweight rows (no instance of T is created)
+ * \param columns List of database table columns (mapped to properties of C++ class T) to be fetched, in the order of the row type
+ * \param query Define a user SQL query added to default SQL query builded by QxOrm library
+ * \param rows Sequence container of rows (std::vector, QVector, std::list, QList, etc.) : a row is a std::tuple, a std::pair or a single value (if only 1 column); rows is cleared before executing SQL query
+ * \param pDatabase Connection to database (you can manage your own connection pool for example, you can also define a transaction, etc.); if NULL, a valid connection for the current thread is provided by qx::QxSqlDatabase singleton class (optional parameter)
+ * \return Empty QSqlError object (from Qt library) if no error occurred; otherwise QSqlError contains a description of database error executing SQL query
+ *
+ * qx::dao::fetch_projection_by_query<T>() execute following SQL query :<br>
+ * <i>SELECT my_id, column_1, column_2 FROM my_table</i> + <i>WHERE my_query...</i>
+ */
+template <class T, class U>
+inline QSqlError fetch_projection_by_query(const QStringList & columns, const qx::QxSqlQuery & query, U & rows, QSqlDatabase * pDatabase = NULL)
+{ return qx::dao::detail::QxDao_FetchProjection<T, U>::fetch(columns, query, rows, pDatabase); }
+
 /*!
  * \ingroup QxDao
  * \brief Update an element or a list of elements into database
@@ -57,6 +57,7 @@
 #ifndef Q_MOC_RUN
 #include <QxDao/IxPersistable.h>
 #include <QxDao/QxSqlQuery.h>
+#include <QxCommon/QxTrace.h>
 #endif // Q_MOC_RUN
 
 namespace qx {
@@ -103,6 +104,8 @@ struct QxDaoAsyncParams {
       listRelations; //!< List of relationships parameter to execute action
   QVariant id;       //!< Current instance id parameter to execute action
   long daoCount;     //!< Dao count value returned by qx::dao::count query
+  qx::QxTrace::type_context
+      traceContext; //!< Tracing context of the caller thread (see qx::QxTrace)
 
   QxDaoAsyncParams() : daoAction(dao_none), pDatabase(NULL), daoCount(0) { ; }
   ~QxDaoAsyncParams() { ; }
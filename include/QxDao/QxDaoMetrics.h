@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_DAO_METRICS_H_
+#define _QX_DAO_METRICS_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxDaoMetrics.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief Registry of qx::dao functions metrics (timers histograms, rows and errors count) by class, operation and database
+ */
+
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+#include <QxSingleton/QxSingleton.h>
+
+namespace qx {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::QxDaoMetrics : registry of qx::dao functions metrics, aggregated by class, operation (fetch by id, insert, etc.) and database (this class is a singleton and is thread-safe)
+ *
+ * Metrics are recorded when <i>qx::QxSqlDatabase::getSingleton()->setDaoMetrics(true)</i> is enabled : each thread aggregates its own metrics (locking only its own mutex, never shared with other threads executing qx::dao functions), and a snapshot merges all threads.
+ * Timers measured by qx::dao::detail::IxDao_Helper (exec, next, prepare, build instance, etc.) are recorded into histograms with fixed bounds (see getBucketBounds()), all times are in nano-seconds.
+ * \code
+qx::QxSqlDatabase::getSingleton()->setDaoMetrics(true);
+// ... execute some qx::dao functions ...
+qx::QxDaoMetrics::type_snapshot lst = qx::QxDaoMetrics::getSingleton()->snapshot();
+for (const qx::QxDaoMetrics::type_entry & e : lst)
+{ qDebug("%s - %s : %lld calls, %lld ns", qPrintable(e.m_sClass), qPrintable(e.m_sOperation), e.m_iCalls, e.m_lstTimer[qx::QxDaoMetrics::metric_total].m_iSum); }
+ * \endcode
+ */
+class QX_DLL_EXPORT QxDaoMetrics : public QxSingleton<QxDaoMetrics>
+{
+
+   friend class QxSingleton<QxDaoMetrics>;
+
+public:
+
+   enum metric_type { metric_total, metric_db_exec, metric_db_next, metric_db_prepare, metric_cpp_build_hierarchy, metric_cpp_build_instance,
+                      metric_cpp_read_instance, metric_build_sql, metric_db_open, metric_db_transaction, metric_count };
+
+   enum { bucket_count = 17 };
+
+   struct QX_DLL_EXPORT type_histogram
+   {
+      qint64 m_iCount;                       //!< Number of values recorded
+      qint64 m_iSum;                         //!< Sum of values recorded (nano-seconds)
+      qint64 m_iMax;                         //!< Max value recorded (nano-seconds)
+      qint64 m_lstBucket[bucket_count];      //!< Number of values recorded by bucket (not cumulative, last bucket is +Inf)
+
+      type_histogram();
+      void add(qint64 iValue);
+      void merge(const type_histogram & other);
+   };
+
+   struct QX_DLL_EXPORT type_entry
+   {
+      QString m_sClass;                         //!< Class key registered into QxOrm context
+      QString m_sOperation;                     //!< qx::dao operation (fetch by id, insert, update, etc.)
+      QString m_sDatabase;                      //!< Database ([host/]database name)
+      qint64 m_iCalls;                          //!< Number of calls
+      qint64 m_iRows;                           //!< Number of SQL records read
+      qint64 m_iErrors;                         //!< Number of calls ended with an error
+      type_histogram m_lstTimer[metric_count];  //!< Histogram by timer (a timer not measured by a call is not recorded)
+
+      type_entry();
+      void merge(const type_entry & other);
+   };
+
+   typedef QList<type_entry> type_snapshot;
+
+private:
+
+   struct QxDaoMetricsImpl;
+   std::unique_ptr<QxDaoMetricsImpl> m_pImpl; //!< Private implementation idiom
+
+   QxDaoMetrics();
+   virtual ~QxDaoMetrics();
+
+public:
+
+   void record(const QString & sClass, const QString & sOperation, const QString & sDatabase, const qint64 * pTimers, qint64 iRows, bool bError);
+
+   type_snapshot snapshot() const;
+   type_snapshot snapshotAndReset();
+   void reset();
+
+   static const qint64 * getBucketBounds();
+   static QString getMetricName(metric_type e);
+
+};
+
+} // namespace qx
+
+QX_DLL_EXPORT_QX_SINGLETON_HPP(qx::QxDaoMetrics)
+
+#endif // _QX_DAO_METRICS_H_
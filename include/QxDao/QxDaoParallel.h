@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_DAO_PARALLEL_H_
+#define _QX_DAO_PARALLEL_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxDaoParallel.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief Options and helper to fetch a large table with several threads (each one with its own connection to database)
+ */
+
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqlerror.h>
+
+namespace qx {
+namespace dao {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::parallel_fetch : options of qx::dao::fetch_all_parallel() and qx::dao::fetch_by_query_parallel() functions
+ *
+ * The query is split into ranges of the partition column (the primary key by default, it must be a numeric column).
+ * Ranges are fetched by a few threads (at most QThread::idealThreadCount()), each one with its own connection to database (cloned from the connection of the caller), then all parts are merged into the result container.
+ * With Qt < 5.13 (a connection cannot be cloned from another thread), ranges are fetched sequentially with the connection of the caller.
+ */
+struct parallel_fetch
+{
+
+   int m_iPartitionCount;        //!< Number of ranges (number of threads and connections to database is bounded by QThread::idealThreadCount())
+   QString m_sPartitionColumn;   //!< Numeric column used to split the query into ranges (if empty, primary key is used)
+   bool m_bPreserveOrder;        //!< Merge parts to keep the order of the query (ORDER BY columns), without ORDER BY parts are appended in range order
+
+   parallel_fetch(int iPartitionCount = 4, const QString & sPartitionColumn = QString(), bool bPreserveOrder = true) : m_iPartitionCount(iPartitionCount), m_sPartitionColumn(sPartitionColumn), m_bPreserveOrder(bPreserveOrder) { ; }
+
+};
+
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxDaoParallel_Helper : compute partition ranges, run each part on its own thread and connection, compare values to merge parts
+ */
+class QX_DLL_EXPORT QxDaoParallel_Helper
+{
+
+public:
+
+   typedef QPair<QVariant, QVariant> type_range;
+   typedef std::function<QSqlError (int, QSqlDatabase &)> type_fct_part;
+
+   static QSqlError getRanges(QSqlDatabase * pDatabase, const QString & sTable, const QString & sColumn, int iCount, QList<type_range> & lstRanges);
+   static QSqlError run(QSqlDatabase * pDatabase, int iCount, const type_fct_part & fct);
+   static int compare(const QVariant & v1, const QVariant & v2);
+
+};
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
+
+#endif // _QX_DAO_PARALLEL_H_
@@ -71,6 +71,8 @@ namespace dao {
 
 namespace detail {
 template <class T> struct QxDao_IsDirty;
+template <class T> struct QxDao_Snapshot_Helper;
+class QxDao_Snapshot;
 } // namespace detail
 
 /*!
@@ -89,6 +91,10 @@ isDirty() : this method can return list of properties changed.
 qx::dao::update_optimized() to update in database only properties changed.
  * qx::dao::ptr<T> can be used with a simple object and with many containers :
 stl, boost, Qt and qx::QxCollection<Key, Value>.
+ * By default, qx::dao::ptr<T> keeps a full copy of the original instance : with
+setSnapshotMode(true), it keeps only a compact fingerprint per property (small
+inline value or 64 bits hash) to reduce memory usage of large cached object
+graphs (restoreFromOriginal() is not available in this mode).
  *
  * Quick sample using qx::dao::ptr<T> smart-pointer :
  * \code
@@ -162,95 +168,120 @@ private:
       m_pWork; //!< Default pointer => user works with this pointer
   QSharedPointer<T> m_pOriginal; //!< Keep original pointer containing all
                                  //!< values from database
+  QSharedPointer<qx::dao::detail::QxDao_Snapshot>
+      m_pSnapshot;     //!< Compact fingerprints of values from database
+  bool m_bSnapshotMode; //!< Keep fingerprints instead of original pointer
 
 public:
-  ptr() { ; }
-  explicit ptr(T *ptr) : m_pWork(ptr) { ; }
-  explicit ptr(T *ptr, T *original) : m_pWork(ptr), m_pOriginal(original) { ; }
+  ptr() : m_bSnapshotMode(false) { ; }
+  explicit ptr(T *ptr) : m_pWork(ptr), m_bSnapshotMode(false) { ; }
+  explicit ptr(T *ptr, T *original)
+      : m_pWork(ptr), m_pOriginal(original), m_bSnapshotMode(false) {
+    ;
+  }
   ptr(const qx::dao::ptr<T> &other)
-      : m_pWork(other.m_pWork), m_pOriginal(other.m_pOriginal) {
+      : m_pWork(other.m_pWork), m_pOriginal(other.m_pOriginal),
+        m_pSnapshot(other.m_pSnapshot), m_bSnapshotMode(other.m_bSnapshotMode) {
+    ;
+  }
+  ptr(const QSharedPointer<T> &other)
+      : m_pWork(other), m_bSnapshotMode(false) {
     ;
   }
-  ptr(const QSharedPointer<T> &other) : m_pWork(other) { ; }
   ptr(const QSharedPointer<T> &other, const QSharedPointer<T> &original)
-      : m_pWork(other), m_pOriginal(original) {
+      : m_pWork(other), m_pOriginal(original), m_bSnapshotMode(false) {
+    ;
+  }
+  ptr(const QWeakPointer<T> &other) : m_pWork(other), m_bSnapshotMode(false) {
     ;
   }
-  ptr(const QWeakPointer<T> &other) : m_pWork(other) { ; }
   ptr(const QWeakPointer<T> &other, const QWeakPointer<T> &original)
-      : m_pWork(other), m_pOriginal(original) {
+      : m_pWork(other), m_pOriginal(original), m_bSnapshotMode(false) {
     ;
   }
   virtual ~ptr() { ; }
 
   template <typename Deleter>
-  ptr(T *ptr, Deleter deleter) : m_pWork(ptr, deleter) {
+  ptr(T *ptr, Deleter deleter)
+      : m_pWork(ptr, deleter), m_bSnapshotMode(false) {
     ;
   }
   template <typename Deleter>
   ptr(T *ptr, T *original, Deleter deleter)
-      : m_pWork(ptr, deleter), m_pOriginal(original) {
+      : m_pWork(ptr, deleter), m_pOriginal(original), m_bSnapshotMode(false) {
     ;
   }
 
   template <class X>
   ptr(const qx::dao::ptr<X> &other)
       : m_pWork(qSharedPointerCast<T>(other.m_pWork)),
-        m_pOriginal(qSharedPointerCast<T>(other.m_pOriginal)) {
+        m_pOriginal(qSharedPointerCast<T>(other.m_pOriginal)),
+        m_pSnapshot(other.m_pSnapshot), m_bSnapshotMode(other.m_bSnapshotMode) {
     ;
   }
   template <class X>
-  ptr(const QSharedPointer<X> &other) : m_pWork(qSharedPointerCast<T>(other)) {
+  ptr(const QSharedPointer<X> &other)
+      : m_pWork(qSharedPointerCast<T>(other)), m_bSnapshotMode(false) {
     ;
   }
   template <class X>
   ptr(const QSharedPointer<X> &other, const QSharedPointer<T> &original)
       : m_pWork(qSharedPointerCast<T>(other)),
-        m_pOriginal(qSharedPointerCast<T>(original)) {
+        m_pOriginal(qSharedPointerCast<T>(original)), m_bSnapshotMode(false) {
     ;
   }
   template <class X>
   ptr(const QWeakPointer<X> &other)
-      : m_pWork(qSharedPointerCast<T>(other.toStrongRef())) {
+      : m_pWork(qSharedPointerCast<T>(other.toStrongRef())),
+        m_bSnapshotMode(false) {
     ;
   }
   template <class X>
   ptr(const QWeakPointer<X> &other, const QWeakPointer<X> &original)
       : m_pWork(qSharedPointerCast<T>(other.toStrongRef())),
-        m_pOriginal(qSharedPointerCast<T>(original.toStrongRef())) {
+        m_pOriginal(qSharedPointerCast<T>(original.toStrongRef())),
+        m_bSnapshotMode(false) {
     ;
   }
 
   qx::dao::ptr<T> &operator=(const qx::dao::ptr<T> &other) {
     m_pWork = other.m_pWork;
     m_pOriginal = other.m_pOriginal;
+    m_pSnapshot = other.m_pSnapshot;
+    m_bSnapshotMode = other.m_bSnapshotMode;
     return (*this);
   }
   qx::dao::ptr<T> &operator=(const QSharedPointer<T> &other) {
     m_pWork = other;
     m_pOriginal.clear();
+    m_pSnapshot.clear();
     return (*this);
   }
   qx::dao::ptr<T> &operator=(const QWeakPointer<T> &other) {
     m_pWork = other;
     m_pOriginal.clear();
+    m_pSnapshot.clear();
     return (*this);
   }
 
   template <class X> qx::dao::ptr<T> &operator=(const qx::dao::ptr<X> &other) {
     m_pWork = qSharedPointerCast<T>(other.m_pWork);
     m_pOriginal = qSharedPointerCast<T>(other.m_pOriginal);
+    m_pSnapshot = other.m_pSnapshot;
+    m_bSnapshotMode = other.m_bSnapshotMode;
     return (*this);
   }
   template <class X>
   qx::dao::ptr<T> &operator=(const QSharedPointer<X> &other) {
     m_pWork = qSharedPointerCast<T>(other);
     m_pOriginal.clear();
+    m_pSnapshot.clear();
     return (*this);
   }
   template <class X> qx::dao::ptr<T> &operator=(const QWeakPointer<X> &other) {
     m_pWork = qSharedPointerCast<T>(other.toStrongRef());
     m_pOriginal.clear();
+    m_pSnapshot.clear();
     return (*this);
   }
 
@@ -266,16 +297,27 @@ public:
   inline void clear() {
     m_pWork.clear();
     m_pOriginal.clear();
+    m_pSnapshot.clear();
   }
   inline void reset() {
     m_pWork.clear();
     m_pOriginal.clear();
+    m_pSnapshot.clear();
   }
   inline void reset(const QSharedPointer<T> &ptr) {
     m_pWork = ptr;
     m_pOriginal.clear();
+    m_pSnapshot.clear();
+  }
+  inline void resetOriginal(const QSharedPointer<T> &ptr) {
+    m_pOriginal = ptr;
+    m_pSnapshot.clear();
+  }
+  inline bool getSnapshotMode() const { return m_bSnapshotMode; }
+  inline void setSnapshotMode(bool b) { m_bSnapshotMode = b; }
+  inline QSharedPointer<qx::dao::detail::QxDao_Snapshot> getSnapshot() const {
+    return m_pSnapshot;
   }
-  inline void resetOriginal(const QSharedPointer<T> &ptr) { m_pOriginal = ptr; }
   inline bool isDirty() const {
     QStringList lstDiff;
     return isDirty(lstDiff);
@@ -283,11 +325,18 @@ public:
   inline QSharedPointer<T> toQtSharedPointer() const { return m_pWork; }
   inline void saveToOriginal() {
     m_pOriginal.clear();
-    if (m_pWork) {
+    m_pSnapshot.clear();
+    if (m_pWork && m_bSnapshotMode) {
+      m_pSnapshot =
+          qx::dao::detail::QxDao_Snapshot_Helper<T>::capture(*m_pWork);
+    } else if (m_pWork) {
       m_pOriginal = qx::clone_to_qt_shared_ptr(*m_pWork);
     }
   }
   inline void restoreFromOriginal() {
+    if (m_pOriginal.isNull() && !m_pSnapshot.isNull()) {
+      return;
+    }
     m_pWork.clear();
     if (m_pOriginal) {
       m_pWork = qx::clone_to_qt_shared_ptr(*m_pOriginal);
@@ -309,6 +358,11 @@ public:
 
   bool isDirty(QStringList &lstDiff) const {
     lstDiff.clear();
+    if (!m_pWork.isNull() && m_pOriginal.isNull() && !m_pSnapshot.isNull()) {
+      qx::dao::detail::QxDao_Snapshot_Helper<T>::compare((*m_pWork),
+                                                         m_pSnapshot, lstDiff);
+      return (!lstDiff.isEmpty());
+    }
     if (m_pWork.isNull() || m_pOriginal.isNull()) {
       lstDiff.append(QStringLiteral("*"));
       return true;
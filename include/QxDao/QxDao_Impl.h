@@ -38,6 +38,7 @@
 
 #include <QxDao/QxDao.h>
 #include <QxDao/QxDaoPointer.h>
+#include <QxDao/QxIdentityMap.h>
 #include <QxDao/QxDao_IsDirty.h>
 #include <QxDao/QxSqlDatabase.h>
 #include <QxDao/QxSqlQueryBuilder.h>
@@ -69,6 +70,8 @@
 #include "../../inl/QxDao/QxDao_FetchById.inl"
 #include "../../inl/QxDao/QxDao_FetchById_WithRelation.inl"
 #include "../../inl/QxDao/QxDao_FetchAll.inl"
+#include "../../inl/QxDao/QxDao_FetchAll_Parallel.inl"
+#include "../../inl/QxDao/QxDao_FetchProjection.inl"
 #include "../../inl/QxDao/QxDao_FetchAll_WithRelation.inl"
 #include "../../inl/QxDao/QxDao_Insert.inl"
 #include "../../inl/QxDao/QxDao_Insert_WithRelation.inl"
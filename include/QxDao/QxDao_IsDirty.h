@@ -36,7 +36,9 @@
 #pragma once
 #endif
 
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qvector.h>
 
 #include <QxDao/IxSqlRelation.h>
 #include <QxDao/QxSqlQueryBuilder.h>
@@ -53,23 +55,48 @@ namespace detail {
 template <class T>
 inline void is_dirty(const T &obj1, const T &obj2, QStringList &lstDiff);
 
-template <class T> struct QxDao_IsDirty_Generic {
+/*!
+ * \brief List of properties to compare to detect dirty instances (primary key
+ * first) : this list is computed only once per class
+ */
+template <class T> struct QxDao_IsDirty_DataMember {
 
-  static void compare(const T &obj1, const T &obj2, QStringList &lstDiff) {
+  static const QList<qx::IxDataMember *> &get() {
+    static const QList<qx::IxDataMember *> lst = build();
+    return lst;
+  }
+
+private:
+  static QList<qx::IxDataMember *> build() {
     static_assert(qx::trait::is_qx_registered<T>::value,
                   "qx::trait::is_qx_registered<T>::value");
 
+    QList<qx::IxDataMember *> lst;
     qx::QxSqlQueryBuilder_Count<T> builder;
     builder.init();
     qx::IxDataMember *pId = builder.getDataId();
-    if (pId && (!pId->isEqual((&obj1), (&obj2)))) {
-      lstDiff.append(pId->getKey());
+    if (pId) {
+      lst.append(pId);
     }
 
     long l = 0;
     qx::IxDataMember *p = NULL;
     while ((p = builder.nextData(l))) {
-      if (p && (!p->isEqual((&obj1), (&obj2)))) {
+      if (p) {
+        lst.append(p);
+      }
+    }
+    return lst;
+  }
+};
+
+template <class T> struct QxDao_IsDirty_Generic {
+
+  static void compare(const T &obj1, const T &obj2, QStringList &lstDiff) {
+    const QList<qx::IxDataMember *> &lst =
+        qx::dao::detail::QxDao_IsDirty_DataMember<T>::get();
+    for (qx::IxDataMember *p : lst) {
+      if (!p->isEqual((&obj1), (&obj2))) {
         lstDiff.append(p->getKey());
       }
     }
@@ -134,6 +161,192 @@ inline void is_dirty(const T &obj1, const T &obj2, QStringList &lstDiff) {
   return qx::dao::detail::QxDao_IsDirty<T>::compare(obj1, obj2, lstDiff);
 }
 
+/*!
+ * \brief qx::dao::detail::QxDao_Snapshot : compact per-property fingerprints
+ * of instances fetched from database (alternative to a full copy of original
+ * instances to detect dirty properties, see qx::dao::ptr<T>::setSnapshotMode())
+ *
+ * Each property is stored as a small inline value (numeric, boolean, date,
+ * time, etc.) or as a 64 bits hash (string, byte array and other types).
+ * A container is stored as one fingerprint per item (same order as the
+ * container).
+ */
+class QX_DLL_EXPORT QxDao_Snapshot {
+
+public:
+  typedef QVector<QVariant> type_fingerprint;
+
+private:
+  QVector<type_fingerprint> m_lstItem; //!< One fingerprint per item
+
+public:
+  QxDao_Snapshot() { ; }
+  ~QxDao_Snapshot() { ; }
+
+  int count() const { return m_lstItem.count(); }
+  void append(const type_fingerprint &f) { m_lstItem.append(f); }
+  const type_fingerprint &at(int i) const { return m_lstItem.at(i); }
+  void reserve(int i) { m_lstItem.reserve(i); }
+
+  static QVariant fingerprint(const qx::IxDataMember *p, const void *pOwner);
+  static type_fingerprint fingerprint(const QList<qx::IxDataMember *> &lst,
+                                      const void *pOwner);
+  static void compare(const QList<qx::IxDataMember *> &lst,
+                      const void *pOwner, const type_fingerprint &f,
+                      QStringList &lstDiff);
+};
+
+typedef QSharedPointer<qx::dao::detail::QxDao_Snapshot> QxDao_Snapshot_ptr;
+
+template <class T> struct QxDao_Snapshot_Item;
+
+template <class T> struct QxDao_Snapshot_Item_Generic {
+
+  static QxDao_Snapshot::type_fingerprint capture(const T &obj) {
+    return QxDao_Snapshot::fingerprint(
+        qx::dao::detail::QxDao_IsDirty_DataMember<T>::get(), (&obj));
+  }
+
+  static void compare(const T &obj, const QxDao_Snapshot::type_fingerprint &f,
+                      QStringList &lstDiff) {
+    QxDao_Snapshot::compare(qx::dao::detail::QxDao_IsDirty_DataMember<T>::get(),
+                            (&obj), f, lstDiff);
+  }
+};
+
+template <class T> struct QxDao_Snapshot_Item_Ptr {
+
+  static QxDao_Snapshot::type_fingerprint capture(const T &obj) {
+    if (!obj) {
+      return QxDao_Snapshot::type_fingerprint();
+    }
+    return qx::dao::detail::QxDao_Snapshot_Item<
+        typename std::remove_reference<decltype(*obj)>::type>::capture(*obj);
+  }
+
+  static void compare(const T &obj, const QxDao_Snapshot::type_fingerprint &f,
+                      QStringList &lstDiff) {
+    if (!obj) {
+      if (!f.isEmpty()) {
+        lstDiff.append(QStringLiteral("*"));
+      }
+      return;
+    }
+    qx::dao::detail::QxDao_Snapshot_Item<
+        typename std::remove_reference<decltype(*obj)>::type>::compare(*obj, f,
+                                                                      lstDiff);
+  }
+};
+
+template <class T> struct QxDao_Snapshot_Item {
+
+  typedef typename std::remove_const<T>::type type_item;
+  typedef typename std::conditional<
+      (std::is_pointer<type_item>::value ||
+       qx::trait::is_smart_ptr<type_item>::value),
+      qx::dao::detail::QxDao_Snapshot_Item_Ptr<type_item>,
+      qx::dao::detail::QxDao_Snapshot_Item_Generic<type_item>>::type type_dao;
+
+  static QxDao_Snapshot::type_fingerprint capture(const type_item &obj) {
+    return type_dao::capture(obj);
+  }
+
+  static void compare(const type_item &obj,
+                      const QxDao_Snapshot::type_fingerprint &f,
+                      QStringList &lstDiff) {
+    type_dao::compare(obj, f, lstDiff);
+  }
+};
+
+template <class U>
+inline void snapshot_compare_item(const U &item,
+                                  const QxDao_Snapshot::type_fingerprint &f,
+                                  QStringList &lstDiff) {
+  qx::dao::detail::QxDao_Snapshot_Item<U>::compare(item, f, lstDiff);
+}
+
+template <class T> struct QxDao_Snapshot_Container {
+
+  static void capture(const T &obj, QxDao_Snapshot &snapshot) {
+    snapshot.reserve(
+        static_cast<int>(qx::trait::generic_container<T>::size(obj)));
+    for (typename T::const_iterator it = obj.begin(); it != obj.end(); ++it) {
+      snapshot.append(
+          qx::dao::detail::QxDao_Snapshot_Item<typename std::remove_reference<
+              decltype(*it)>::type>::capture(*it));
+    }
+  }
+
+  static void compare(const T &obj, const QxDao_Snapshot &snapshot,
+                      QStringList &lstDiff) {
+    if (qx::trait::generic_container<T>::size(obj) <= 0) {
+      return;
+    }
+    if (static_cast<long>(qx::trait::generic_container<T>::size(obj)) !=
+        static_cast<long>(snapshot.count())) {
+      lstDiff.append(QStringLiteral("*"));
+      return;
+    }
+
+    int iCurrIndex = 0;
+    for (typename T::const_iterator it = obj.begin(); it != obj.end(); ++it) {
+      QStringList lstDiffItem;
+      qx::dao::detail::snapshot_compare_item((*it), snapshot.at(iCurrIndex),
+                                             lstDiffItem);
+      if (lstDiffItem.count() > 0) {
+        lstDiff.append(QString::number(iCurrIndex) + "|" +
+                       lstDiffItem.join(QStringLiteral("|")));
+      }
+      ++iCurrIndex;
+    }
+  }
+};
+
+template <class T> struct QxDao_Snapshot_Single {
+
+  static void capture(const T &obj, QxDao_Snapshot &snapshot) {
+    snapshot.append(qx::dao::detail::QxDao_Snapshot_Item<T>::capture(obj));
+  }
+
+  static void compare(const T &obj, const QxDao_Snapshot &snapshot,
+                      QStringList &lstDiff) {
+    if (snapshot.count() != 1) {
+      lstDiff.append(QStringLiteral("*"));
+      return;
+    }
+    qx::dao::detail::QxDao_Snapshot_Item<T>::compare(obj, snapshot.at(0),
+                                                     lstDiff);
+  }
+};
+
+/*!
+ * \brief Entry point used by qx::dao::ptr<T> to capture and compare
+ * fingerprints (qx::dao::ptr<T> only knows a forward declaration of
+ * qx::dao::detail::QxDao_Snapshot)
+ */
+template <class T> struct QxDao_Snapshot_Helper {
+
+  typedef typename std::conditional<
+      qx::trait::is_container<T>::value,
+      qx::dao::detail::QxDao_Snapshot_Container<T>,
+      qx::dao::detail::QxDao_Snapshot_Single<T>>::type type_dao;
+
+  static QxDao_Snapshot_ptr capture(const T &obj) {
+    QxDao_Snapshot_ptr pSnapshot = QxDao_Snapshot_ptr(new QxDao_Snapshot());
+    type_dao::capture(obj, (*pSnapshot));
+    return pSnapshot;
+  }
+
+  static void compare(const T &obj, const QxDao_Snapshot_ptr &pSnapshot,
+                      QStringList &lstDiff) {
+    if (!pSnapshot) {
+      lstDiff.append(QStringLiteral("*"));
+      return;
+    }
+    type_dao::compare(obj, (*pSnapshot), lstDiff);
+  }
+};
+
 } // namespace detail
 } // namespace dao
 } // namespace qx
@@ -0,0 +1,190 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_DAO_IDENTITY_MAP_H_
+#define _QX_DAO_IDENTITY_MAP_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxIdentityMap.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief Identity map of a qx::QxSession : entities already fetched, shared by class and primary key
+ */
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <QxTraits/get_class_name_primitive.h>
+
+namespace qx {
+class IxClass;
+template <class T> class QxClass;
+} // namespace qx
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxIdentityMap : entities fetched by a qx::QxSession, one shared instance per class and primary key
+ *
+ * The identity map of a session is installed for the thread which enabled it (see qx::QxSession::setIdentityMap()) : while it is installed, qx::dao::fetch_by_id() on a smart pointer and many-to-one relations (with a smart pointer data member) return the instance already fetched instead of building a new one.
+ * Only entities fetched with all their columns are registered, and only shared pointers are supported (std::shared_ptr, QSharedPointer, boost::shared_ptr, qx::dao::ptr) : entities stored by value or with a raw pointer are never shared.
+ */
+class QX_DLL_EXPORT QxIdentityMap
+{
+
+private:
+
+   struct type_entry
+   {
+      std::shared_ptr<void> m_pHolder;    //!< Copy of the smart pointer registered (keeps the entity alive)
+      const void * m_pEntity;             //!< Entity instance shared
+      QString m_sPtrType;                 //!< Smart pointer type registered (an entity is shared only with the same smart pointer type)
+      type_entry() : m_pEntity(NULL) { ; }
+   };
+
+   QHash<QString, type_entry> m_hashEntities;   //!< Key : class key + primary key
+
+public:
+
+   QxIdentityMap();
+   ~QxIdentityMap();
+
+   long count() const;
+   void clear();
+   void remove(qx::IxClass * pClass, const void * pOwner, bool bOtherInstanceOnly = false);
+
+   static QxIdentityMap * getCurrent();
+   static void setCurrent(QxIdentityMap * pMap);
+
+   static QString getIdKey(qx::IxClass * pClass, const void * pOwner);
+   static QString getIdKey(qx::IxClass * pClass, const QVariantList & lstId);
+
+   template <class P>
+   bool get(const QString & sKey, P & p) const
+   {
+      if (sKey.isEmpty()) { return false; }
+      typename QHash<QString, type_entry>::const_iterator itr = m_hashEntities.constFind(sKey);
+      if ((itr == m_hashEntities.constEnd()) || (itr.value().m_sPtrType != QString(qx::trait::get_class_name<P>::get()))) { return false; }
+      p = (* std::static_pointer_cast<P>(itr.value().m_pHolder));
+      return true;
+   }
+
+   template <class P>
+   void insert(const QString & sKey, const P & p)
+   {
+      if (sKey.isEmpty() || ! p) { return; }
+      type_entry entry; entry.m_pHolder = std::make_shared<P>(p); entry.m_pEntity = static_cast<const void *>(& (* p)); entry.m_sPtrType = qx::trait::get_class_name<P>::get();
+      m_hashEntities.insert(sKey, entry);
+   }
+
+private:
+
+   QxIdentityMap(const QxIdentityMap & other) { Q_UNUSED(other); }
+   QxIdentityMap & operator=(const QxIdentityMap & other) { Q_UNUSED(other); return (* this); }
+
+};
+
+template <typename T>
+struct QxIdentityMap_IsShared : public std::false_type { ; };
+
+template <typename T>
+struct QxIdentityMap_IsShared< std::shared_ptr<T> > : public std::true_type { ; };
+
+template <typename T>
+struct QxIdentityMap_IsShared< QSharedPointer<T> > : public std::true_type { ; };
+
+template <typename T>
+struct QxIdentityMap_IsShared< qx::dao::ptr<T> > : public std::true_type { ; };
+
+#ifdef _QX_ENABLE_BOOST
+template <typename T>
+struct QxIdentityMap_IsShared< boost::shared_ptr<T> > : public std::true_type { ; };
+#endif // _QX_ENABLE_BOOST
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxIdentityMap_Helper<T> : lookup and registration of an entity (type T) in the identity map installed for current thread, nothing is done if T is not a shared pointer
+ */
+template <class T, bool bIsShared = QxIdentityMap_IsShared<T>::value>
+struct QxIdentityMap_Helper
+{
+   static inline bool isEnabled() { return false; }
+   static inline bool find(T & t) { Q_UNUSED(t); return false; }
+   static inline bool findById(T & t, const QVariantList & lstId) { Q_UNUSED(t); Q_UNUSED(lstId); return false; }
+   static inline void insert(const T & t) { Q_UNUSED(t); }
+};
+
+template <class T>
+struct QxIdentityMap_Helper<T, true>
+{
+
+   typedef typename std::remove_reference<decltype(* std::declval<T &>())>::type type_item;
+
+   static inline bool isEnabled() { return (QxIdentityMap::getCurrent() != NULL); }
+
+   static inline bool find(T & t)
+   {
+      QxIdentityMap * pMap = QxIdentityMap::getCurrent(); if (! pMap || ! t) { return false; }
+      return pMap->get<T>(QxIdentityMap::getIdKey(qx::QxClass<type_item>::getSingleton(), (& (* t))), t);
+   }
+
+   static inline bool findById(T & t, const QVariantList & lstId)
+   {
+      QxIdentityMap * pMap = QxIdentityMap::getCurrent(); if (! pMap) { return false; }
+      return pMap->get<T>(QxIdentityMap::getIdKey(qx::QxClass<type_item>::getSingleton(), lstId), t);
+   }
+
+   static inline void insert(const T & t)
+   {
+      QxIdentityMap * pMap = QxIdentityMap::getCurrent(); if (! pMap || ! t) { return; }
+      pMap->insert<T>(QxIdentityMap::getIdKey(qx::QxClass<type_item>::getSingleton(), (& (* t))), t);
+   }
+
+};
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
+
+#endif // _QX_DAO_IDENTITY_MAP_H_
@@ -55,6 +55,8 @@
 #include <QxDao/QxDao.h>
 #include <QxDao/QxSqlQuery.h>
 #include <QxDao/QxSqlError.h>
+#include <QxDao/QxUnitOfWork.h>
+#include <QxDao/QxIdentityMap.h>
 
 #include <QxRegister/QxClass.h>
 
@@ -113,6 +115,36 @@ namespace qx {
   if (! session.isValid()) { qDebug("[QxOrm] session error : '%s'", qPrintable(session.firstError().text())); }
 
 } // End of scope : session is destroyed (transaction => automatically commit or rollback if there is an error)
+ * \endcode
+ *
+ * <i>Deferred mode (unit of work) :</i> when <i>setDeferred(true)</i> is called, <i>insert()</i>, <i>update()</i>, <i>save()</i>, <i>deleteById()</i> and <i>destroyById()</i> methods on a single entity (without relation, columns or query) are not executed immediately.
+ * They are recorded and coalesced by entity (an entity updated several times is written only once), then flushed on <i>commit()</i> (or <i>flush()</i>) as batched statements per class (multi-row insert, 'IN' list delete, 1 prepared statement for all updates).
+ * Inserts and updates are flushed from parent tables to child tables, and deletes in the reverse order (using many-to-one and one-to-many relations registered into QxOrm context).
+ * Other methods (fetch, count, operations on containers, with relations or queries, etc.) flush pending changes before being executed.
+ * Entities registered by reference (or raw pointer) must stay alive until the flush : entities registered with a smart-pointer are kept alive by the session.
+ * Triggers (<i>qx::dao::on_before_insert</i>, etc.) are called when flushing.
+ * \code
+{
+  qx::QxSession session;
+  session.setDeferred(true);
+  session.insert(my_object_1);      // recorded
+  session.update(my_object_2);      // recorded
+  session.update(my_object_2);      // coalesced with previous update
+  session.deleteById(my_object_3);  // recorded
+} // End of scope : pending changes are flushed, then transaction is committed (or rolled back if there is an error)
+ * \endcode
+ *
+ * <i>Identity map :</i> when <i>setIdentityMap(true)</i> is called, entities fetched with all their columns into a shared pointer (std::shared_ptr, QSharedPointer, boost::shared_ptr, qx::dao::ptr) are registered by class and primary key.
+ * While the session is alive, <i>qx::dao::fetch_by_id()</i> and many-to-one relations return the instance already fetched (no duplicate instance, no SQL query for <i>fetch_by_id()</i>).
+ * The identity map is installed for the thread which enabled it : all fetches executed by this thread use it (not only methods of the session), and the session must be destroyed by the same thread.
+ * Entities written by the session with another instance are removed from the identity map, and the identity map is cleared by bulk deletes (by query or all rows) and by <i>rollback()</i> : SQL executed without the session (<i>callQuery()</i>, <i>executeQuery()</i>, other connections) is not tracked.
+ * \code
+{
+  qx::QxSession session;
+  session.setIdentityMap(true);
+  std::shared_ptr<author> a1 = std::make_shared<author>(); a1->m_id = 1; session.fetchById(a1);
+  std::shared_ptr<author> a2 = std::make_shared<author>(); a2->m_id = 1; session.fetchById(a2);   // a2 == a1 (no SQL query)
+}
  * \endcode
  */
 class QX_DLL_EXPORT QxSession
@@ -126,6 +158,9 @@ private:
    bool m_bThrowable;                  //!< When a SQL error is appended, an exception of type qx::dao::sql_error is thrown
    bool m_bThrowInEvent;               //!< An exception of type qx::dao::sql_error is throwing
    bool m_bAutoOpenClose;              //!< Open and close automatically connection to database
+   std::shared_ptr<qx::dao::detail::QxUnitOfWork> m_pUnitOfWork;   //!< Pending changes in deferred mode (NULL if changes are executed immediately)
+   std::shared_ptr<qx::dao::detail::QxIdentityMap> m_pIdentityMap; //!< Entities already fetched by current thread (NULL if identity map is disabled)
+   qx::dao::detail::QxIdentityMap * m_pIdentityMapPrevious;          //!< Identity map installed for current thread before this session (restored when disabled)
 
 public:
 
@@ -133,7 +168,7 @@ public:
    QxSession(const QSqlDatabase & database);
    QxSession(const QSqlDatabase & database, bool bOpenTransaction);
    QxSession(const QSqlDatabase & database, bool bOpenTransaction, bool bThrowable);
-   virtual ~QxSession() { close(); }
+   virtual ~QxSession() { setIdentityMap(false); close(); }
 
    inline bool isThrowable() const              { return m_bThrowable; }
    inline bool isOpened() const                 { return m_bTransaction; }
@@ -143,11 +178,18 @@ public:
    inline QList<QSqlError> allErrors() const    { return m_lstSqlError; }
    inline const QSqlDatabase * database() const { return (& m_database); }
    inline QSqlDatabase * database()             { return (& m_database); }
+   inline bool isDeferred() const               { return (m_pUnitOfWork.get() != NULL); }
+   inline long pendingCount() const             { return (m_pUnitOfWork ? m_pUnitOfWork->count() : 0); }
+   inline bool hasIdentityMap() const           { return (m_pIdentityMap.get() != NULL); }
+   inline qx::dao::detail::QxIdentityMap * identityMap() const { return m_pIdentityMap.get(); }
 
    bool open();
    bool close();
    bool commit();
    bool rollback();
+   bool flush();
+   void setDeferred(bool b);
+   void setIdentityMap(bool b);
 
    QxSession & operator+= (const QSqlError & err);
 
@@ -155,16 +197,50 @@ private:
 
    void appendSqlError(const QSqlError & err);
    void clear();
+   void autoFlush()                             { if (m_pUnitOfWork && ! m_pUnitOfWork->isEmpty()) { flush(); } }
+
+   template <class T>
+   bool defer(qx::dao::detail::IxUnitOfWork_Entry::op_type e, T & t, bool bDeferrable)
+   {
+      if (! m_pUnitOfWork) { return false; }
+      if (bDeferrable && m_pUnitOfWork->append(e, t)) { return true; }
+      autoFlush(); return false;
+   }
+
+   void clearIdentityMap()                      { if (m_pIdentityMap) { m_pIdentityMap->clear(); } }
+
+   template <class T>
+   void evictIdentity(T & t, bool bOtherInstanceOnly)
+   { if (m_pIdentityMap) { evictIdentity_Helper<T, qx::trait::is_container<T>::value>::evict((* m_pIdentityMap), t, bOtherInstanceOnly); } }
+
+   template <class T, bool bIsContainer /* = false */>
+   struct evictIdentity_Helper
+   {
+      static void evict(qx::dao::detail::QxIdentityMap & map, T & t, bool bOtherInstanceOnly)
+      {
+         typedef qx::dao::detail::QxUnitOfWork_Item<T, (std::is_pointer<T>::value || qx::trait::is_smart_ptr<T>::value)> type_helper;
+         typedef typename std::remove_const<typename type_helper::type_item>::type type_item;
+         const type_item * pItem = type_helper::get(t);
+         if (pItem) { map.remove(QxClass<type_item>::getSingleton(), static_cast<const void *>(pItem), bOtherInstanceOnly); }
+      }
+   };
+
+   template <class T>
+   struct evictIdentity_Helper<T, true>
+   {
+      static void evict(qx::dao::detail::QxIdentityMap & map, T & t, bool bOtherInstanceOnly)
+      { Q_UNUSED(t); Q_UNUSED(bOtherInstanceOnly); map.clear(); }
+   };
 
 public:
 
    template <class T>
    long count(const qx::QxSqlQuery & query = qx::QxSqlQuery())
-   { return qx::dao::count<T>(query, this->database()); }
+   { autoFlush(); return qx::dao::count<T>(query, this->database()); }
 
    template <class T>
    QSqlError count(long & lCount, const qx::QxSqlQuery & query = qx::QxSqlQuery())
-   { return qx::dao::count<T>(lCount, query, this->database()); }
+   { autoFlush(); return qx::dao::count<T>(lCount, query, this->database()); }
 
    template <class T>
    T * fetchById(const QVariant & id, const QStringList & columns = QStringList(), const QStringList & relation = QStringList())
@@ -172,6 +248,7 @@ public:
       IxDataMemberX * pDataMemberX = QxClass<T>::getSingleton()->getDataMemberX();
       IxDataMember * pDataMemberId = (pDataMemberX ? pDataMemberX->getId_WithDaoStrategy() : NULL);
       if (! pDataMemberId) { qAssert(false); return NULL; }
+      autoFlush();
       T * t = new T(); QSqlError err;
       pDataMemberId->fromVariant(t, id, -1, qx::cvt::context::e_database);
       if (relation.count() == 0) { err = qx::dao::fetch_by_id((* t), this->database(), columns); }
@@ -183,6 +260,7 @@ public:
    template <class T>
    QSqlError fetchById(T & t, const QStringList & columns = QStringList(), const QStringList & relation = QStringList())
    {
+      autoFlush();
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::fetch_by_id(t, this->database(), columns); }
       else { err = qx::dao::fetch_by_id_with_relation(relation, t, this->database()); }
@@ -193,6 +271,7 @@ public:
    template <class T>
    QSqlError fetchAll(T & t, const QStringList & columns = QStringList(), const QStringList & relation = QStringList())
    {
+      autoFlush();
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::fetch_all(t, this->database(), columns); }
       else { err = qx::dao::fetch_all_with_relation(relation, t, this->database()); }
@@ -203,6 +282,7 @@ public:
    template <class T>
    QSqlError fetchByQuery(const qx::QxSqlQuery & query, T & t, const QStringList & columns = QStringList(), const QStringList & relation = QStringList())
    {
+      autoFlush();
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::fetch_by_query(query, t, this->database(), columns); }
       else { err = qx::dao::fetch_by_query_with_relation(relation, query, t, this->database()); }
@@ -213,6 +293,7 @@ public:
    template <class T>
    QSqlError insert(T & t, const QStringList & relation = QStringList())
    {
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_insert, t, relation.isEmpty())) { return QSqlError(); }
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::insert(t, this->database()); }
       else { err = qx::dao::insert_with_relation(relation, t, this->database()); }
@@ -223,6 +304,8 @@ public:
    template <class T>
    QSqlError update(T & t, const qx::QxSqlQuery & query = qx::QxSqlQuery(), const QStringList & columns = QStringList(), const QStringList & relation = QStringList())
    {
+      if (query.isEmpty()) { evictIdentity(t, true); } else { clearIdentityMap(); }
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_update, t, (query.isEmpty() && columns.isEmpty() && relation.isEmpty()))) { return QSqlError(); }
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::update_by_query(query, t, this->database(), columns); }
       else { err = qx::dao::update_by_query_with_relation(relation, query, t, this->database()); }
@@ -233,6 +316,8 @@ public:
    template <class T>
    QSqlError save(T & t, const QStringList & relation = QStringList())
    {
+      evictIdentity(t, true);
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_save, t, relation.isEmpty())) { return QSqlError(); }
       QSqlError err;
       if (relation.count() == 0) { err = qx::dao::save(t, this->database()); }
       else { err = qx::dao::save_with_relation(relation, t, this->database()); }
@@ -248,6 +333,8 @@ public:
       if (! pDataMemberId) { qAssert(false); return QSqlError(); }
       std::shared_ptr<T> t = std::make_shared<T>();
       pDataMemberId->fromVariant(t.get(), id, -1, qx::cvt::context::e_database);
+      evictIdentity(t, false);
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_delete, t, true)) { return QSqlError(); }
       QSqlError err = qx::dao::delete_by_id((* t), this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -256,6 +343,8 @@ public:
    template <class T>
    QSqlError deleteById(T & t)
    {
+      evictIdentity(t, false);
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_delete, t, true)) { return QSqlError(); }
       QSqlError err = qx::dao::delete_by_id(t, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -264,6 +353,7 @@ public:
    template <class T>
    QSqlError deleteAll()
    {
+      autoFlush(); clearIdentityMap();
       QSqlError err = qx::dao::delete_all<T>(this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -272,6 +362,7 @@ public:
    template <class T>
    QSqlError deleteByQuery(const qx::QxSqlQuery & query)
    {
+      autoFlush(); clearIdentityMap();
       QSqlError err = qx::dao::delete_by_query<T>(query, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -285,6 +376,8 @@ public:
       if (! pDataMemberId) { qAssert(false); return QSqlError(); }
       std::shared_ptr<T> t = std::make_shared<T>();
       pDataMemberId->fromVariant(t.get(), id, -1, qx::cvt::context::e_database);
+      evictIdentity(t, false);
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_destroy, t, true)) { return QSqlError(); }
       QSqlError err = qx::dao::destroy_by_id((* t), this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -293,6 +386,8 @@ public:
    template <class T>
    QSqlError destroyById(T & t)
    {
+      evictIdentity(t, false);
+      if (defer(qx::dao::detail::IxUnitOfWork_Entry::op_destroy, t, true)) { return QSqlError(); }
       QSqlError err = qx::dao::destroy_by_id(t, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -301,6 +396,7 @@ public:
    template <class T>
    QSqlError destroyAll()
    {
+      autoFlush(); clearIdentityMap();
       QSqlError err = qx::dao::destroy_all<T>(this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -309,6 +405,7 @@ public:
    template <class T>
    QSqlError destroyByQuery(const qx::QxSqlQuery & query)
    {
+      autoFlush(); clearIdentityMap();
       QSqlError err = qx::dao::destroy_by_query<T>(query, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -317,6 +414,7 @@ public:
    template <class T>
    QSqlError executeQuery(qx::QxSqlQuery & query, T & t)
    {
+      autoFlush();
       QSqlError err = qx::dao::execute_query<T>(query, t, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -324,6 +422,7 @@ public:
 
    QSqlError callQuery(qx::QxSqlQuery & query)
    {
+      autoFlush();
       QSqlError err = qx::dao::call_query(query, this->database());
       if (err.isValid()) { (* this) += err; }
       return err;
@@ -331,7 +430,7 @@ public:
 
    template <class T>
    qx_bool exist(T & t)
-   { return qx::dao::exist(t, this->database()); }
+   { autoFlush(); return qx::dao::exist(t, this->database()); }
 
 private:
 
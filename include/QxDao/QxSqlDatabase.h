@@ -122,6 +122,8 @@ public:
    int getTraceSqlOnlySlowQueriesDatabase() const;
    int getTraceSqlOnlySlowQueriesTotal() const;
    bool getDisplayTimerDetails() const;
+   bool getRecycleDaoHelper() const;
+   bool getDaoMetrics() const;
 
    void setDriverName(const QString & s, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
    void setConnectOptions(const QString & s, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
@@ -154,6 +156,8 @@ public:
    void setTraceSqlOnlySlowQueriesDatabase(int i, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
    void setTraceSqlOnlySlowQueriesTotal(int i, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
    void setDisplayTimerDetails(bool b, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
+   void setRecycleDaoHelper(bool b, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
+   void setDaoMetrics(bool b, bool bJustForCurrentThread = false, QSqlDatabase * pJustForThisDatabase = NULL);
 
    static QSqlDatabase getDatabase();
    static QSqlDatabase getDatabase(QSqlError & dbError);
@@ -162,6 +166,8 @@ public:
    static void closeAllDatabases();
    static void clearAllDatabases();
    static bool isEmpty();
+   static long getConnectionCount();
+   static QHash<QString, long> getConnectionCountByDatabaseKey(); //!< Connections opened for default database (one per thread), plus connections used by threads working on another database (see setCurrentDatabaseByThread()), by database key (driver name + host name + database name)
 
    qx::dao::detail::IxSqlGenerator * getSqlGenerator();
 
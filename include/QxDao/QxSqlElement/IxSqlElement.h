@@ -113,7 +113,7 @@ class QX_DLL_EXPORT IxSqlElement
 public:
 
    enum type_class { _no_type, _sql_compare, _sql_element_temp, _sql_expression, _sql_free_text, 
-                     _sql_in, _sql_is_between, _sql_is_null, _sql_limit, _sql_sort, _sql_embed_query };
+                     _sql_in, _sql_is_between, _sql_is_null, _sql_limit, _sql_sort, _sql_embed_query, _sql_seek };
 
 protected:
 
@@ -133,6 +133,8 @@ public:
    void setValue(const QVariant & val);
    void setValues(const QVariantList & values);
 
+   QStringList getColumns() const;
+
    virtual IxSqlElement::type_class getTypeClass() const = 0;
 
    virtual QString toString() const = 0;
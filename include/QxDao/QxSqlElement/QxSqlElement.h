@@ -47,6 +47,7 @@
 #include <QxDao/QxSqlElement/QxSqlIsBetween.h>
 #include <QxDao/QxSqlElement/QxSqlIsNull.h>
 #include <QxDao/QxSqlElement/QxSqlLimit.h>
+#include <QxDao/QxSqlElement/QxSqlSeek.h>
 #include <QxDao/QxSqlElement/QxSqlSort.h>
 
 #endif // _QX_SQL_ELEMENT_H_
@@ -71,6 +71,8 @@ public:
    QxSqlExpression(int index, QxSqlExpression::type t);
    virtual ~QxSqlExpression();
 
+   QxSqlExpression::type getType() const;
+
    virtual QString toString() const;
    virtual void resolve(QSqlQuery & query) const;
    virtual void postProcess(QString & sql) const;
@@ -0,0 +1,95 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_SQL_SEEK_H_
+#define _QX_SQL_SEEK_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxSqlSeek.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief SQL element to seek after the last row of a page (keyset pagination)
+ */
+
+#include <QxDao/QxSqlElement/IxSqlElement.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxSqlSeek : SQL element to seek after the last row of a page (keyset pagination)
+ *
+ * Columns are the ORDER BY columns and values are the ones of the last fetched row : (col1, col2) > (val1, val2).
+ * If the database doesn't support row value comparison, the expanded form is generated : (col1 > val1) OR (col1 = val1 AND col2 > val2).
+ * Columns must be NOT NULL and the last one must be unique (the primary key for example) to get a stable order.
+ */
+class QX_DLL_EXPORT QxSqlSeek : public IxSqlElement
+{
+
+protected:
+
+   bool m_bDescending;     //!< ORDER BY ... DESC => seek rows before the last one
+
+public:
+
+   QxSqlSeek();
+   QxSqlSeek(int index, bool bDescending);
+   virtual ~QxSqlSeek();
+
+   virtual QString toString() const;
+   virtual void resolve(QSqlQuery & query) const;
+   virtual void postProcess(QString & sql) const;
+
+   virtual IxSqlElement::type_class getTypeClass() const;
+
+protected:
+
+   bool useRowValue() const;
+   QString getKey(int iTerm, int iColumn) const;
+
+   virtual QString getExtraSettings() const;
+   virtual void setExtraSettings(const QString & s);
+
+};
+
+typedef std::shared_ptr<QxSqlSeek> QxSqlSeek_ptr;
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
+
+#endif // _QX_SQL_SEEK_H_
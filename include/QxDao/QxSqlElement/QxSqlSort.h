@@ -70,6 +70,8 @@ public:
    QxSqlSort(int index, QxSqlSort::type t);
    virtual ~QxSqlSort();
 
+   QxSqlSort::type getType() const;
+
    virtual QString toString() const;
    virtual void resolve(QSqlQuery & query) const;
    virtual void postProcess(QString & sql) const;
@@ -90,6 +90,11 @@ public:
    virtual void checkSqlInsert(IxDao_Helper * pDaoHelper, QString & sql) const = 0;
    virtual void onBeforeSqlPrepare(IxDao_Helper * pDaoHelper, QString & sql) const = 0;
    virtual void formatSqlQuery(IxDao_Helper * pDaoHelper, QString & sql) const = 0;
+   virtual int getMaxBindValues() const;                //!< Max bind values per query used to chunk set-based statements (<= 0 means one statement per row)
+   virtual bool getRowValueInSupported() const;         //!< Database supports '(col1, col2) IN ((?, ?), ...)' syntax for composite keys
+   virtual bool getMultiRowInsertSupported() const;     //!< Database supports 'INSERT INTO t (...) VALUES (...), (...)' syntax
+   virtual bool getRowValueCompareSupported() const;     //!< Database supports (and can use an index for) '(col1, col2) > (?, ?)' syntax (keyset pagination)
+   virtual int getMaxRowsPerInsert() const;             //!< Max rows per 'INSERT INTO t (...) VALUES (...), (...)' statement, whatever the bind values count (<= 0 means no limit)
 
 };
 
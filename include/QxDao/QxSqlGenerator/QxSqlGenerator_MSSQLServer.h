@@ -65,6 +65,8 @@ public:
    virtual QString getLimit(const QxSqlLimit * pLimit) const;
    virtual void resolveLimit(QSqlQuery & query, const QxSqlLimit * pLimit) const;
    virtual void postProcess(QString & sql, const QxSqlLimit * pLimit) const;
+   virtual int getMaxBindValues() const;
+   virtual int getMaxRowsPerInsert() const;
 
 private:
 
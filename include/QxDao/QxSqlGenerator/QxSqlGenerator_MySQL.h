@@ -62,6 +62,9 @@ public:
    virtual ~QxSqlGenerator_MySQL();
 
    virtual QString getAutoIncrement() const;
+   virtual int getMaxBindValues() const;
+   virtual bool getRowValueInSupported() const;
+   virtual bool getRowValueCompareSupported() const;
 
 private:
 
@@ -74,6 +74,9 @@ public:
    virtual void checkSqlInsert(IxDao_Helper * pDaoHelper, QString & sql) const;
    virtual void onBeforeInsert(IxDao_Helper * pDaoHelper, void * pOwner) const;
    virtual void onAfterInsert(IxDao_Helper * pDaoHelper, void * pOwner) const;
+   virtual int getMaxBindValues() const;
+   virtual bool getRowValueInSupported() const;
+   virtual bool getMultiRowInsertSupported() const;
 
    bool getOldLimitSyntax() const;
    void setOldLimitSyntax(bool b);
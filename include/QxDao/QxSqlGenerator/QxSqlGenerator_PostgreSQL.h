@@ -63,6 +63,9 @@ public:
 
    virtual void checkSqlInsert(IxDao_Helper * pDaoHelper, QString & sql) const;
    virtual void onAfterInsert(IxDao_Helper * pDaoHelper, void * pOwner) const;
+   virtual int getMaxBindValues() const;
+   virtual bool getRowValueInSupported() const;
+   virtual bool getRowValueCompareSupported() const;
 
 private:
 
@@ -60,6 +60,8 @@ public:
 
    QxSqlGenerator_SQLite();
    virtual ~QxSqlGenerator_SQLite();
+   virtual bool getRowValueInSupported() const;
+   virtual bool getRowValueCompareSupported() const;
 
 private:
 
@@ -79,6 +79,10 @@ public:
    virtual void checkSqlInsert(IxDao_Helper * pDaoHelper, QString & sql) const;
    virtual void onBeforeSqlPrepare(IxDao_Helper * pDaoHelper, QString & sql) const;
    virtual void formatSqlQuery(IxDao_Helper * pDaoHelper, QString & sql) const;
+   virtual int getMaxBindValues() const;
+   virtual bool getRowValueInSupported() const;
+   virtual bool getMultiRowInsertSupported() const;
+   virtual bool getRowValueCompareSupported() const;
 
 };
 
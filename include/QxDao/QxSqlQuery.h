@@ -78,6 +78,12 @@
 
 namespace qx {
 class QxSqlQuery;
+class QxSqlQueryCompiled;
+namespace dao {
+namespace detail {
+struct QxSqlQueryCompiledPlan;
+} // namespace detail
+} // namespace dao
 } // namespace qx
 
 #ifdef _QX_ENABLE_BOOST_SERIALIZATION
@@ -184,6 +190,28 @@ ORDER BY last_name ASC, first_name ASC, sex ASC
 LIMIT :limit_rows_count_19_0 OFFSET :offset_start_row_19_0
  * \endcode
  *
+ * <i>Keyset pagination :</i> for large tables, <i>limit(rowsCount, startRow)</i> becomes slow because the database has to read and skip all previous rows.
+ * <i>after()</i> method seeks directly after the last row of the previous page using the ORDER BY columns (the last ORDER BY column must be unique, the primary key for example, and all ORDER BY columns must be NOT NULL) :
+ * \code
+qx_query query;
+query.where("sex").isEqualTo(author::female)
+     .orderAsc("last_name", "author_id")
+     .after(QVariantList() << lastRow.last_name << lastRow.author_id, 50);
+ * \endcode
+ *
+ * This code will produce following SQL for <i>PostgreSQL</i> and <i>SQLite</i> databases (other databases get the expanded form <i>(last_name > ?) OR (last_name = ? AND author_id > ?)</i>) :
+ * \code
+WHERE ( sex = :sex_1_0 ) 
+AND ((last_name, author_id) > (:seek_3_0_0, :seek_3_0_1)) 
+ORDER BY last_name ASC, author_id ASC 
+LIMIT :limit_rows_count_7_0 OFFSET :offset_start_row_7_0
+ * \endcode
+ *
+ * <i>qx::QxSqlQuery::toCursorToken()</i> and <i>qx::QxSqlQuery::fromCursorToken()</i> static methods convert the last row values to an opaque string (to send to a client application for example).
+ *
+ * <i>partition(column, from, to)</i> method restricts the query to rows where <i>from <= column < to</i> (a null bound is ignored, and rows with a NULL value are kept when <i>from</i> is null).
+ * This condition is added to the existing WHERE clause before ORDER BY and LIMIT, it is used by <i>qx::dao::fetch_by_query_parallel()</i> to split a query into ranges.
+ *
  * Here is the list of all functions available to use <i>qx::QxSqlQuery</i> class (or its typedef <i>qx_query</i>) :
  * \code
 // with functions into namespace qx::dao
@@ -249,6 +277,8 @@ class QX_DLL_EXPORT QxSqlQuery
    template <class Archive> friend inline void boost::serialization::qx_load(Archive & ar, qx::QxSqlQuery & t, const unsigned int file_version);
 #endif // _QX_ENABLE_BOOST_SERIALIZATION
 
+   friend class qx::QxSqlQueryCompiled;
+
    friend QX_DLL_EXPORT QDataStream & ::operator<< (QDataStream & stream, const qx::QxSqlQuery & t);
    friend QX_DLL_EXPORT QDataStream & ::operator>> (QDataStream & stream, qx::QxSqlQuery & t);
 
@@ -278,6 +308,8 @@ protected:
    QString                                   m_sType;                   //!< Query type (for example : 'aggregate' or 'cursor' for MongoDB database)
    QHash<QString, QxSqlQuery>                m_lstJoinQueryUser;        //!< List of SQL queries defined by user to add inside relationships joins (LEFT OUTER JOIN, INNER JOIN), for example : INNER JOIN my_table2 m2 ON (m1.id = m2.parent_id AND (XXX))
    QList<QxSqlQuery>                         m_lstJoinQueryToResolve;   //!< List of SQL queries to resolve (in the right order) to add inside relationships joins (LEFT OUTER JOIN, INNER JOIN), for example : INNER JOIN my_table2 m2 ON (m1.id = m2.parent_id AND (XXX))
+   std::shared_ptr<qx::dao::detail::QxSqlQueryCompiledPlan> m_pCompiledPlan; //!< Final SQL and bind values layout shared by all copies of a compiled query (see qx::QxSqlQueryCompiled class)
+   QMap<int, QVariant>                       m_lstCompiledValue;        //!< Bind values by position provided to a compiled query (see qx::QxSqlQueryCompiled class)
 
 public:
 
@@ -305,6 +337,7 @@ public:
    QString type() const;
    bool isEmpty() const;
    bool isDistinct() const;
+   bool isCompiled() const;
    void clear();
    void resolve(QSqlQuery & query) const;
    void resolveOutput(QSqlQuery & query, bool bFetchSqlResult);
@@ -329,7 +362,12 @@ public:
    QVector<QString> getSqlResultAllColumns() const;
    void dumpSqlResult();
 
+   QStringList getKeysetColumns(bool * pDescending = NULL) const;
+   bool isPartitionable() const;
+
    static void dumpBoundValues(const QSqlQuery & query);
+   static QString toCursorToken(const QVariantList & lastValues);
+   static QVariantList fromCursorToken(const QString & token);
 
 private:
 
@@ -387,6 +425,10 @@ public:
 
    virtual QxSqlQuery & limit(int rowsCount, int startRow = 0, bool withTies = false);
 
+   virtual QxSqlQuery & after(const QVariantList & lastValues, int pageSize = 0);
+   virtual QxSqlQuery & after(const QStringList & columns, const QVariantList & lastValues, int pageSize = 0);
+   virtual QxSqlQuery & partition(const QString & column, const QVariant & from, const QVariant & to);
+
    virtual QxSqlQuery & like(const QString & val);
    virtual QxSqlQuery & notLike(const QString & val);
    virtual QxSqlQuery & startsWith(const QString & val);
@@ -448,6 +490,7 @@ private:
    QxSqlQuery & addSqlIsBetween(const QVariant & val1, const QVariant & val2, qx::dao::detail::QxSqlIsBetween::type type);
    QxSqlQuery & addFreeText(const QString & text, const QVariantList & values);
    QxSqlQuery & addEmbedQuery(const QxSqlQuery & query, qx::dao::detail::QxSqlEmbedQuery::type type, bool requirePreviousElement);
+   void insertCondition(const QList<qx::dao::detail::IxSqlElement_ptr> & lstCondition);
 
 };
 
@@ -554,6 +597,9 @@ virtual className & groupBy(const QString & col1, const QString & col2, const QS
 virtual className & groupBy(const QString & col1, const QString & col2, const QString & col3, const QString & col4, const QString & col5, const QString & col6, const QString & col7, const QString & col8, const QString & col9); \
 \
 virtual className & limit(int rowsCount, int startRow = 0, bool withTies = false); \
+virtual className & after(const QVariantList & lastValues, int pageSize = 0); \
+virtual className & after(const QStringList & columns, const QVariantList & lastValues, int pageSize = 0); \
+virtual className & partition(const QString & column, const QVariant & from, const QVariant & to); \
 \
 virtual className & like(const QString & val); \
 virtual className & notLike(const QString & val); \
@@ -654,6 +700,9 @@ className & className::groupBy(const QString & col1, const QString & col2, const
 className & className::groupBy(const QString & col1, const QString & col2, const QString & col3, const QString & col4, const QString & col5, const QString & col6, const QString & col7, const QString & col8, const QString & col9) { return static_cast<className &>(qx::QxSqlQuery::groupBy(col1, col2, col3, col4, col5, col6, col7, col8, col9)); } \
 \
 className & className::limit(int rowsCount, int startRow, bool withTies) { return static_cast<className &>(qx::QxSqlQuery::limit(rowsCount, startRow, withTies)); } \
+className & className::after(const QVariantList & lastValues, int pageSize) { return static_cast<className &>(qx::QxSqlQuery::after(lastValues, pageSize)); } \
+className & className::after(const QStringList & columns, const QVariantList & lastValues, int pageSize) { return static_cast<className &>(qx::QxSqlQuery::after(columns, lastValues, pageSize)); } \
+className & className::partition(const QString & column, const QVariant & from, const QVariant & to) { return static_cast<className &>(qx::QxSqlQuery::partition(column, from, to)); } \
 \
 className & className::like(const QString & val) { return static_cast<className &>(qx::QxSqlQuery::like(val)); } \
 className & className::notLike(const QString & val) { return static_cast<className &>(qx::QxSqlQuery::notLike(val)); } \
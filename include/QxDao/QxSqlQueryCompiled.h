@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_SQL_QUERY_COMPILED_H_
+#define _QX_SQL_QUERY_COMPILED_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxSqlQueryCompiled.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief Reusable query template : final SQL is built only once, next executions provide only new bind values
+ */
+
+#include <QtCore/qmutex.h>
+
+#include <QxDao/QxSqlQuery.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxSqlQueryCompiledPlan : final SQL and bind values layout shared by all copies of a qx::QxSqlQueryCompiled instance
+ */
+struct QX_DLL_EXPORT QxSqlQueryCompiledPlan
+{
+
+   struct type_entry
+   { QString sql; QVector<QVariant> values; };
+
+   QMutex m_mutex;                              //!< Mutex => qx::QxSqlQueryCompiled instances can be copied and used by several threads
+   QHash<QString, type_entry> m_lstEntry;       //!< Final SQL and bind values captured at first execution, by default SQL built for each class/action/columns
+
+};
+
+typedef std::shared_ptr<QxSqlQueryCompiledPlan> QxSqlQueryCompiledPlan_ptr;
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
+
+namespace qx {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::QxSqlQueryCompiled : reusable query template, final SQL is built only once, next executions provide only new bind values
+ *
+ * A classic qx::QxSqlQuery instance resolves all its SQL elements to build SQL text and binds values by name each time it is executed.
+ * A qx::QxSqlQueryCompiled instance is built once from a qx::QxSqlQuery : the first execution for a class (and an action : fetch, count, delete, etc...) stores the final SQL and the bind values layout.
+ * Next executions re-use this SQL and bind values by position, so a service can execute the same filter thousands of times with different parameters :
+ * \code
+qx_query query;
+query.where("author.sex").isEqualTo(author::female)
+     .and_("author.birth_date").isGreaterThan(QDate(1970, 1, 1));
+qx::QxSqlQueryCompiled compiled(query);
+
+// Slot index is the position of the bind value in the SQL query (0 => 'sex', 1 => 'birth_date')
+compiled.setValue(0, author::male).setValue(1, QDate(1980, 1, 1));
+list_author list;
+QSqlError daoError = qx::dao::fetch_by_query(compiled, list);
+ * \endcode
+ *
+ * <i>Note :</i> SQL text must not change after creating a compiled query : don't add any SQL element to a qx::QxSqlQueryCompiled instance.
+ * Copies share the same compiled SQL (thread-safe), but bind values are specific to each copy.
+ * Compiled SQL is used by qx::dao::fetch_by_query(), qx::dao::fetch_by_query_with_relation(), qx::dao::count(), qx::dao::delete_by_query() and qx::dao::destroy_by_query() functions.
+ * Other functions (qx::dao::update_by_query() for example) build SQL with the original template values.
+ */
+class QX_DLL_EXPORT QxSqlQueryCompiled : public QxSqlQuery
+{
+
+public:
+
+   QxSqlQueryCompiled();
+   QxSqlQueryCompiled(const qx::QxSqlQuery & query);
+   virtual ~QxSqlQueryCompiled();
+
+   int getSlotCount() const;
+   QVariant getValue(int slot) const;
+   QxSqlQueryCompiled & setValue(int slot, const QVariant & val);
+   QxSqlQueryCompiled & setValues(const QVariantList & values);
+   void clearValues();
+
+   static bool findSql(const qx::QxSqlQuery & query, const QString & sqlBase, QString & sql, QVector<QVariant> & values);
+   static void insertSql(const qx::QxSqlQuery & query, const QString & sqlBase, const QString & sql, QSqlQuery & q);
+   static void resolve(const qx::QxSqlQuery & query, const QVector<QVariant> & values, QSqlQuery & q);
+
+};
+
+} // namespace qx
+
+#endif // _QX_SQL_QUERY_COMPILED_H_
@@ -254,11 +254,7 @@ public:
     if (daoError.isValid()) {
       return daoError;
     }
-    daoError = this->deleteFromExtraTable(params);
-    if (daoError.isValid()) {
-      return daoError;
-    }
-    daoError = this->insertIntoExtraTable(params);
+    daoError = this->saveExtraTable(params);
     if (daoError.isValid()) {
       return daoError;
     }
@@ -281,55 +277,31 @@ private:
     return this->deleteFromExtraTable_ManyToMany(params);
   }
 
-  QSqlError insertIntoExtraTable(QxSqlRelationParams &params) const {
-    IxDataMember *pIdOwner = this->getDataIdOwner();
-    qAssert(pIdOwner);
+  QSqlError saveExtraTable(QxSqlRelationParams &params) const {
     IxDataMember *pIdData = this->getDataId();
     qAssert(pIdData);
-    if (!pIdOwner || !pIdData) {
+    if (!pIdData) {
       return QSqlError();
     }
-    QStringList lstForeignKeyOwner = this->getForeignKeyOwner().split("|");
-    QStringList lstForeignKeyDataType =
-        this->getForeignKeyDataType().split("|");
-    qAssert(pIdOwner->getNameCount() == lstForeignKeyOwner.count());
-    qAssert(pIdData->getNameCount() == lstForeignKeyDataType.count());
-
-    QString sql = "INSERT INTO " + this->getExtraTable() + " (";
-    sql += pIdOwner->getSqlName(", ", this->getForeignKeyOwner()) + ", " +
-           pIdData->getSqlName(", ", this->getForeignKeyDataType());
-    sql += QLatin1String(") VALUES (");
-    sql +=
-        pIdOwner->getSqlPlaceHolder("", -1, ", ", this->getForeignKeyOwner()) +
-        ", " +
-        pIdData->getSqlPlaceHolder("", -1, ", ",
-                                   this->getForeignKeyDataType()) +
-        ")";
-    if (this->traceSqlQuery()) {
-      qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql));
-    }
 
+    // Link rows are written in batch (multi-row VALUES or array binding) by
+    // 'qx::IxSqlRelation', in diff mode only changed links are written
+    QVariantList lstDataIds;
     type_item item;
     type_container &container = this->getContainer(params);
     type_iterator itr = type_generic_container::begin(container, item);
     type_iterator itr_end = type_generic_container::end(container);
-    QSqlQuery queryInsert(params.database());
-    if (!queryInsert.prepare(sql)) {
-      return queryInsert.lastError();
-    }
-
+    lstDataIds.reserve(static_cast<int>(type_generic_container::size(container)) *
+                       pIdData->getNameCount());
     while (itr != itr_end) {
-      pIdOwner->setSqlPlaceHolder(queryInsert, params.owner(), "",
-                                  this->getForeignKeyOwner());
-      pIdData->setSqlPlaceHolder(queryInsert, (&item.value_qx()), "",
-                                 this->getForeignKeyDataType());
-      if (!queryInsert.exec()) {
-        return queryInsert.lastError();
+      for (int i = 0; i < pIdData->getNameCount(); i++) {
+        lstDataIds.append(pIdData->toVariant((&item.value_qx()), i,
+                                             qx::cvt::context::e_database));
       }
       itr = type_generic_container::next(container, itr, item);
     }
 
-    return QSqlError();
+    return this->saveExtraTable_ManyToMany(params, lstDataIds);
   }
 };
 
@@ -44,6 +44,7 @@
  * between 2 tables in database)
  */
 
+#include <QxDao/QxIdentityMap.h>
 #include <QxDao/QxSqlRelation.h>
 
 namespace qx {
@@ -59,6 +60,7 @@ class QxSqlRelation_ManyToOne : public QxSqlRelation<DataType, Owner> {
 private:
   typedef typename QxSqlRelation<DataType, Owner>::type_owner type_owner;
   typedef typename QxSqlRelation<DataType, Owner>::type_data type_data;
+  typedef qx::dao::detail::QxIdentityMap_Helper<DataType> type_identity_map;
 
 public:
   QxSqlRelation_ManyToOne(IxDataMember *p) : QxSqlRelation<DataType, Owner>(p) {
@@ -153,7 +155,8 @@ public:
       QVariant vId = query.value(params.offset() + i);
       bValidId = (bValidId || qx::trait::is_valid_primary_key(vId));
     }
-    if (pData && bValidId) {
+    if (pData && bValidId &&
+        !findIdentity(params, params.offset(), pData->getNameCount())) {
       for (int i = 0; i < pData->getNameCount(); i++) {
         pData->fromVariant((&currOwner), query.value(params.offset() + i), i,
                            qx::cvt::context::e_database);
@@ -206,7 +209,11 @@ public:
     if (!bValidIdBis) {
       return NULL;
     }
+    if (findIdentity(params, (lOffsetOld + lOffsetData), lOffsetId)) {
+      return (&this->getData(params));
+    }
 
+    bool bAllColumns = true;
     type_data &currData = this->getData(params);
     if (!this->callTriggerBeforeFetch(currData, params)) {
       return NULL;
@@ -221,6 +228,8 @@ public:
       if (params.checkColumns(p->getKey())) {
         p->fromVariant((&currData), query.value(lOffsetRelation++), -1,
                        qx::cvt::context::e_database);
+      } else {
+        bAllColumns = false;
       }
     }
 
@@ -247,6 +256,9 @@ public:
     if (!this->callTriggerAfterFetch(currData, params)) {
       return NULL;
     }
+    if (bAllColumns) {
+      type_identity_map::insert(*this->getDataTypePtr(params));
+    }
     return (&currData);
   }
 
@@ -272,6 +284,21 @@ public:
       pData->setSqlPlaceHolder(query, (&currOwner));
     }
   }
+
+private:
+  // Identity map of current qx::QxSession : point the data member to the
+  // instance already fetched with the id read from the query (if any)
+  bool findIdentity(QxSqlRelationParams &params, long lOffset,
+                    long lCount) const {
+    if (!type_identity_map::isEnabled()) {
+      return false;
+    }
+    QVariantList lstId;
+    for (long i = 0; i < lCount; i++) {
+      lstId.append(params.query().value(lOffset + i));
+    }
+    return type_identity_map::findById(*this->getDataTypePtr(params), lstId);
+  }
 };
 
 } // namespace qx
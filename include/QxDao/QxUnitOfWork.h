@@ -0,0 +1,244 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifndef _QX_DAO_UNIT_OF_WORK_H_
+#define _QX_DAO_UNIT_OF_WORK_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxUnitOfWork.h
+ * \author Lionel Marty
+ * \ingroup QxDao
+ * \brief Pending changes recorded by a deferred qx::QxSession (unit of work), coalesced by entity and flushed as batched statements
+ */
+
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqlerror.h>
+
+#include <QxDao/QxDao.h>
+
+#include <QxRegister/QxClass.h>
+
+#include <QxTraits/is_container.h>
+#include <QxTraits/is_smart_ptr.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::IxUnitOfWork_Entry : pending changes (insert, update, save, delete) of all entities of one class
+ *
+ * Several operations on the same entity (same instance, or same primary key) are coalesced into only one operation :
+ * - insert then update/save : insert (entity state is read when flushing) ;
+ * - insert then delete : nothing to do ;
+ * - update then update : only one update ;
+ * - update/save then delete : delete ;
+ * - delete/destroy then insert : update (the row is still in the table), with a soft delete column the row is undeleted after the update.
+ */
+class QX_DLL_EXPORT IxUnitOfWork_Entry
+{
+
+public:
+
+   enum op_type { op_none, op_insert, op_update, op_save, op_delete, op_destroy };
+
+private:
+
+   struct type_pending
+   {
+      void * m_pItem;                     //!< Entity to write (its state is read when flushing)
+      std::shared_ptr<void> m_pHolder;    //!< Keep alive entities registered using a smart-pointer
+      QString m_sId;                      //!< Primary key of the entity when it was registered (empty if not valid yet)
+      op_type m_eOp;                      //!< Operation to execute when flushing
+      bool m_bUndelete;                   //!< Clear soft delete column after the update (delete then insert on a class with soft delete)
+   };
+
+   IxClass * m_pClass;                    //!< Class of all entities of this entry
+   QList<type_pending> m_lstPending;      //!< Pending operations (in order of first registration)
+   QHash<void *, int> m_hashByAddress;    //!< Index of pending operation by entity address
+   QHash<QString, int> m_hashById;        //!< Index of pending operation by primary key
+
+public:
+
+   IxUnitOfWork_Entry(IxClass * pClass);
+   virtual ~IxUnitOfWork_Entry();
+
+   IxClass * getClass() const;
+   long count() const;
+
+   void append(op_type e, void * pItem, const std::shared_ptr<void> & pHolder);
+   QSqlError flush(op_type e, QSqlDatabase * pDatabase);
+   void clear();
+
+protected:
+
+   virtual QSqlError flushItems(op_type e, const QList<void *> & lstItems, QSqlDatabase * pDatabase) = 0;
+
+private:
+
+   QString getIdKey(void * pItem, op_type e) const;
+   QSqlError undeleteItems(const QList<void *> & lstItems, QSqlDatabase * pDatabase);
+   static op_type merge(op_type ePending, op_type eNew);
+
+   IxUnitOfWork_Entry(const IxUnitOfWork_Entry & other) { Q_UNUSED(other); }
+   IxUnitOfWork_Entry & operator=(const IxUnitOfWork_Entry & other) { Q_UNUSED(other); return (* this); }
+
+};
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxUnitOfWork_Entry<T> : flush pending changes of class T using container functions of qx::dao namespace (multi-row insert, set-based delete, etc.)
+ */
+template <class T>
+class QxUnitOfWork_Entry : public IxUnitOfWork_Entry
+{
+
+public:
+
+   QxUnitOfWork_Entry() : IxUnitOfWork_Entry(qx::QxClass<T>::getSingleton()) { ; }
+   virtual ~QxUnitOfWork_Entry() { ; }
+
+protected:
+
+   virtual QSqlError flushItems(op_type e, const QList<void *> & lstItems, QSqlDatabase * pDatabase)
+   {
+      QList<T *> lst; lst.reserve(lstItems.count());
+      for (int i = 0; i < lstItems.count(); i++) { lst.append(static_cast<T *>(lstItems.at(i))); }
+      switch (e)
+      {
+         case op_insert:   return qx::dao::insert_multi_row(lst, pDatabase);
+         case op_update:   return qx::dao::update(lst, pDatabase);
+         case op_save:     return qx::dao::save(lst, pDatabase);
+         case op_delete:   return qx::dao::delete_by_id(lst, pDatabase);
+         case op_destroy:  return qx::dao::destroy_by_id(lst, pDatabase);
+         default:          break;
+      }
+      return QSqlError();
+   }
+
+};
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxUnitOfWork_Item<T> : get the entity to register from an object, a raw pointer or a smart-pointer (smart-pointers are kept alive until flush)
+ */
+template <typename T, bool bIsPointer /* = false */>
+struct QxUnitOfWork_Item
+{
+   typedef T type_item;
+   static inline type_item * get(T & t) { return (& t); }
+   static inline std::shared_ptr<void> holder(T & t) { Q_UNUSED(t); return std::shared_ptr<void>(); }
+};
+
+template <typename T>
+struct QxUnitOfWork_Item<T, true>
+{
+   typedef typename std::remove_reference<decltype(* std::declval<T &>())>::type type_item;
+   static inline type_item * get(T & t) { return (t ? (& (* t)) : NULL); }
+   static inline std::shared_ptr<void> holder(T & t) { T p(t); return std::shared_ptr<void>(static_cast<void *>(NULL), [p](void *) { ; }); }
+};
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxUnitOfWork : list of pending changes recorded by a deferred qx::QxSession, flushed in order of foreign keys dependencies
+ *
+ * When flushing, inserts, saves and updates are executed from parent tables to child tables, then deletes from child tables to parent tables.
+ * A parent table is a table referenced by a many-to-one relation (or owner of a one-to-many relation) of another class of the unit of work.
+ */
+class QX_DLL_EXPORT QxUnitOfWork
+{
+
+private:
+
+   QList<std::shared_ptr<IxUnitOfWork_Entry> > m_lstEntry;     //!< Pending changes by class (in order of first registration)
+
+public:
+
+   QxUnitOfWork();
+   virtual ~QxUnitOfWork();
+
+   long count() const;
+   bool isEmpty() const;
+   QSqlError flush(QSqlDatabase * pDatabase);
+   void clear();
+
+   template <class T>
+   bool append(IxUnitOfWork_Entry::op_type e, T & t)
+   { return QxUnitOfWork::append_Helper<T, qx::trait::is_container<T>::value>::append((* this), e, t); }
+
+private:
+
+   IxUnitOfWork_Entry * findEntry(IxClass * pClass) const;
+   QList<IxUnitOfWork_Entry *> sortByDependency() const;
+
+   template <class U>
+   IxUnitOfWork_Entry * getEntry()
+   {
+      IxUnitOfWork_Entry * pEntry = findEntry(qx::QxClass<U>::getSingleton());
+      if (! pEntry) { pEntry = new qx::dao::detail::QxUnitOfWork_Entry<U>(); m_lstEntry.append(std::shared_ptr<IxUnitOfWork_Entry>(pEntry)); }
+      return pEntry;
+   }
+
+   template <class T, bool bIsContainer /* = false */>
+   struct append_Helper
+   {
+      static bool append(QxUnitOfWork & uow, IxUnitOfWork_Entry::op_type e, T & t)
+      {
+         typedef qx::dao::detail::QxUnitOfWork_Item<T, (std::is_pointer<T>::value || qx::trait::is_smart_ptr<T>::value)> type_helper;
+         typedef typename std::remove_const<typename type_helper::type_item>::type type_item;
+         type_item * pItem = const_cast<type_item *>(type_helper::get(t));
+         if (pItem) { uow.getEntry<type_item>()->append(e, static_cast<void *>(pItem), type_helper::holder(t)); }
+         return true;
+      }
+   };
+
+   template <class T>
+   struct append_Helper<T, true>
+   {
+      static bool append(QxUnitOfWork & uow, IxUnitOfWork_Entry::op_type e, T & t)
+      { Q_UNUSED(uow); Q_UNUSED(e); Q_UNUSED(t); return false; }
+   };
+
+   QxUnitOfWork(const QxUnitOfWork & other) { Q_UNUSED(other); }
+   QxUnitOfWork & operator=(const QxUnitOfWork & other) { Q_UNUSED(other); return (* this); }
+
+};
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
+
+#endif // _QX_DAO_UNIT_OF_WORK_H_
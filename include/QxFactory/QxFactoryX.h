@@ -56,6 +56,7 @@ namespace qx {
 inline qx::any create(const QString &sKey, bool bRawPointer = false);
 template <typename T> inline T *create_nude_ptr(const QString &sKey);
 inline void *create_void_ptr(const QString &sKey);
+inline IxFactory *find_factory(const QString &sKey);
 
 class QxClassX;
 
@@ -72,6 +73,10 @@ class QX_DLL_EXPORT QxFactoryX : public QxSingleton<QxFactoryX> {
   friend inline qx::any create(const QString &sKey, bool bRawPointer);
   template <typename T> friend inline T *create_nude_ptr(const QString &sKey);
   friend inline void *create_void_ptr(const QString &sKey);
+  friend inline IxFactory *find_factory(const QString &sKey);
+
+public:
+  static int getRegistryVersion(); //!< Incremented each time a factory or a class is removed : handles (factory, function) resolved with another version must be resolved again
 
 protected:
   QHash<QString, IxFactory *>
@@ -86,7 +91,9 @@ private:
 
   void registerFactory(const QString &sKey, IxFactory *pFactory);
   void unregisterFactory(const QString &sKey);
+  static void incrementRegistryVersion();
 
+  IxFactory *getFactory(const QString &sKey) const;
   qx::any createObject(const QString &sKey, bool bRawPointer = false) const;
   void *createObjectNudePtr(const QString &sKey) const;
 
@@ -147,6 +154,56 @@ inline void *create_void_ptr(const QString &sKey) {
   return qx::QxFactoryX::createInstanceNudePtr(sKey);
 }
 
+/*!
+ * \ingroup QxFactory
+ * \brief Return the factory associated by key sKey, or return NULL if sKey is
+ * not registered into factory engine : the factory is a stable handle (valid
+ * while the class is registered, see qx::QxFactoryX::getRegistryVersion() to
+ * know when it must be resolved again), so it can be resolved only once and then used
+ * to create new instances without looking up the key each time (for example :
+ * qx::IxFactory * pFactory = qx::find_factory("drug"); then
+ * qx::create(pFactory) for each new instance)
+ */
+inline IxFactory *find_factory(const QString &sKey) {
+  return qx::QxFactoryX::getSingleton()->getFactory(sKey);
+}
+
+/*!
+ * \ingroup QxFactory
+ * \brief Return a smart-pointer new instance of object (std::shared_ptr<T>)
+ * using a factory resolved by qx::find_factory() function
+ */
+inline qx::any create(const IxFactory *pFactory, bool bRawPointer = false) {
+  return (pFactory ? pFactory->createObject(bRawPointer) : qx::any());
+}
+
+/*!
+ * \ingroup QxFactory
+ * \brief Return a void * pointer (be careful with memory leak) using a factory
+ * resolved by qx::find_factory() function, or return NULL if pFactory is NULL
+ */
+inline void *create_void_ptr(const IxFactory *pFactory) {
+  return (pFactory ? pFactory->createObjectNudePtr() : NULL);
+}
+
+/*!
+ * \ingroup QxFactory
+ * \brief Return a nude pointer (be careful with memory leak) of type T using a
+ * factory resolved by qx::find_factory() function, or return NULL if pFactory
+ * is NULL
+ */
+template <typename T>
+inline T *create_nude_ptr(const IxFactory *pFactory)
+#ifdef _QX_NO_RTTI
+{
+  return static_cast<T *>(qx::create_void_ptr(pFactory));
+}
+#else  // _QX_NO_RTTI
+{
+  return dynamic_cast<T *>(static_cast<T *>(qx::create_void_ptr(pFactory)));
+}
+#endif // _QX_NO_RTTI
+
 } // namespace qx
 
 QX_DLL_EXPORT_QX_SINGLETON_HPP(qx::QxFactoryX)
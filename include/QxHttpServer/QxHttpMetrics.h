@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+#ifndef _QX_HTTP_METRICS_H_
+#define _QX_HTTP_METRICS_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxHttpMetrics.h
+ * \author Lionel Marty
+ * \ingroup QxHttpServer
+ * \brief HTTP requests latency by route and OpenMetrics (Prometheus) endpoint exposing ORM, HTTP and service statistics
+ */
+
+#include <QxHttpServer/QxHttpRequest.h>
+#include <QxHttpServer/QxHttpResponse.h>
+
+#include <QxDao/QxDaoMetrics.h>
+
+#include <QxSingleton/QxSingleton.h>
+
+namespace qx {
+namespace service {
+class QxThreadPool;
+} // namespace service
+
+/*!
+ * \ingroup QxHttpServer
+ * \brief qx::QxHttpMetrics : HTTP requests latency by route, and OpenMetrics (Prometheus) text exposition of ORM, HTTP and service statistics (this class is a singleton and is thread-safe)
+ *
+ * HTTP requests are recorded by qx::QxHttpServer when <i>qx::QxHttpMetrics::setEnabled(true)</i> is called : like qx::QxDaoMetrics, each thread aggregates its own metrics (never locking a mutex shared with other threads handling requests).
+ * The buildResponse() handler renders (in OpenMetrics text format) :
+ * - qx::dao functions latency histograms by class, operation and database (see qx::QxDaoMetrics, enabled by <i>qx::QxSqlDatabase::getSingleton()->setDaoMetrics(true)</i>) ;
+ * - database connections by qx::QxSqlDatabase key (connections opened for default database, plus connections used by threads working on another database) ;
+ * - qx::cache hits, misses, evictions and cost ;
+ * - qx::service::QxThreadPool busy and available workers, incoming connections waiting for a worker (accept queue) and rejected ;
+ * - HTTP requests latency histograms by route (dispatcher path), method and status code ;
+ * - qx::QxHttpSessionManager sessions count.
+ * \code
+qx::QxSqlDatabase::getSingleton()->setDaoMetrics(true);
+qx::QxHttpMetrics::setEnabled(true);
+qx::QxHttpServer httpServer;
+httpServer.dispatch("GET", "/metrics", (& qx::QxHttpMetrics::buildResponse));
+httpServer.startServer();
+ * \endcode
+ */
+class QX_DLL_EXPORT QxHttpMetrics : public QxSingleton<QxHttpMetrics>
+{
+
+   friend class QxSingleton<QxHttpMetrics>;
+
+public:
+
+   struct QX_DLL_EXPORT type_entry
+   {
+      QString m_sRoute;                               //!< Dispatcher path (for example : /foo/<id:int>), <custom> for custom request handler, <none> if no route found
+      QString m_sMethod;                              //!< HTTP method (GET, POST, etc.)
+      int m_iStatus;                                  //!< HTTP status code
+      qx::QxDaoMetrics::type_histogram m_latency;     //!< Latency histogram (nano-seconds, same bounds as qx::QxDaoMetrics)
+
+      type_entry();
+      void merge(const type_entry & other);
+   };
+
+   typedef QList<type_entry> type_snapshot;
+
+private:
+
+   struct QxHttpMetricsImpl;
+   std::unique_ptr<QxHttpMetricsImpl> m_pImpl; //!< Private implementation idiom
+
+   QxHttpMetrics();
+   virtual ~QxHttpMetrics();
+
+public:
+
+   static bool isEnabled();
+   static void setEnabled(bool b);
+
+   void record(const QString & sRoute, const QString & sMethod, int iStatus, qint64 iElapsed);
+
+   type_snapshot snapshot() const;
+   void reset();
+
+   void setThreadPool(const std::shared_ptr<qx::service::QxThreadPool> & pThreadPool);
+   QByteArray toOpenMetrics() const;
+
+   static void buildResponse(qx::QxHttpRequest & request, qx::QxHttpResponse & response);
+
+};
+
+} // namespace qx
+
+QX_DLL_EXPORT_QX_SINGLETON_HPP(qx::QxHttpMetrics)
+
+#endif // _QX_HTTP_METRICS_H_
+#endif // _QX_ENABLE_QT_NETWORK
@@ -87,6 +87,7 @@ public:
    static qx::QxHttpSession_ptr getSession(qx::QxHttpRequest & request, qx::QxHttpResponse & response, const QByteArray & cookieName = QByteArray("qx_session_id"), bool autoCreateSession = true);
    static qx::QxHttpSession_ptr createSession(qx::QxHttpRequest & request, qx::QxHttpResponse & response, const QByteArray & cookieName = QByteArray("qx_session_id"));
    static void removeSession(qx::QxHttpRequest & request, qx::QxHttpResponse & response, const QByteArray & cookieName = QByteArray("qx_session_id"));
+   static long count();
 
 private Q_SLOTS:
 
@@ -157,6 +157,23 @@ Item {
  * As you can see in the 'main.qml' file, 'author_id' and 'name' properties of 'author' model ('myModel' variable) can be automatically read and write (because they are registered into QxOrm context).
  * Moreover, qx::IxModel interface provides a list of methods for QML side (Q_INVOKABLE) to communicate with database : for example, the 'Save' button will save the model in database without having to write a C++ function.
  *
+ * 3- For large tables, <i>qxFetchIncremental()</i> method fetches rows by chunks when the view needs them (Qt <i>canFetchMore()</i> / <i>fetchMore()</i> mechanism) instead of loading the whole table :
+ * \code
+qx::IxModel * pModel = new qx::QxModel<author>();
+pModel->setIncrementalFetch(200, 5000); // Fetch 200 rows at a time, keep at most 5000 rows in memory
+pModel->qxFetchIncremental(qx_query().where("sex").isEqualTo(author::female));
+ * \endcode
+ *
+ * The filter query is applied on database side : it must be written with C++ syntax and without ORDER BY or LIMIT clause.
+ * The <i>sort()</i> method (clicking on a QTableView header for example) is pushed down to database too : rows are fetched again ordered by the sort column then by primary key.
+ * With keyset pagination (default), the sort column must be NOT NULL. Rows evicted at the top of the window can be fetched again with <i>fetchPrevious()</i> method.
+ * Evicted rows are removed from memory only : save modified rows before scrolling far away.
+ *
+ * 4- With <i>e_auto_update_on_field_change</i> option, each edited cell is saved to database immediately. <i>setAutoUpdateDeferred()</i> method enables <i>e_auto_update_deferred</i> option instead :
+ * edited rows and columns are collected, then saved in one transaction (one prepared UPDATE statement per list of edited columns) after a delay or when too many rows are pending.
+ * A row which cannot be saved keeps its edited values : the <i>writeBackFailed()</i> signal is emitted and the vertical header displays '!' (the database error is the tooltip).
+ * Pending changes are saved before rows are removed from the model and when the model is destroyed, <i>qxFlushPendingChanges()</i> method saves them immediately.
+ *
  * <b>Note :</b> a <b>QxEntityEditor</b> plugin generates automatically the code to manage models with relationships. Then it is possible to work with nested C++ models.
  */
 class QX_DLL_EXPORT IxModel : public QAbstractItemModel
@@ -170,11 +187,12 @@ class QX_DLL_EXPORT IxModel : public QAbstractItemModel
 
 public:
 
-   enum e_auto_update_database { e_no_auto_update, e_auto_update_on_field_change };
+   enum e_auto_update_database { e_no_auto_update, e_auto_update_on_field_change, e_auto_update_deferred };
 
    typedef QHash<QString, IxModel *> type_relation_by_name;
    typedef QList<type_relation_by_name> type_lst_relation_by_name;
    typedef QHash<IxModel *, QPair<int, QString> > type_child_to_its_relation;
+   typedef std::function<QSqlError (QSqlDatabase *, QList<int> &, QStringList &)> type_write_back_job;
 
 protected:
 
@@ -198,6 +216,14 @@ protected:
    long m_lManualInsertIndex;                      //!< Index to insert manually items to the collection
    QHash<QString, QVariant> m_hCustomProperties;   //!< Use this generic hash-table to define extra-properties in your custom classes which inherit from qx::IxModel interface (instead of creating new properties) ==> this will ensure that sizeof(qx::IxModel) == sizeof(YourCustomClass), this is important with nested models feature
 
+private:
+
+   struct IxModelIncrementalFetch;
+   std::unique_ptr<IxModelIncrementalFetch> m_pIncrementalFetch;   //!< Incremental fetch settings and cursor (NULL if incremental fetch is disabled), see setIncrementalFetch() method
+
+   struct IxModelWriteBack;
+   std::unique_ptr<IxModelWriteBack> m_pWriteBack;                 //!< Pending changes and settings for e_auto_update_deferred mode (NULL until first used), see setAutoUpdateDeferred() method
+
 public:
 
    IxModel(QObject * parent = 0);
@@ -231,8 +257,15 @@ public:
    void setParentModel(IxModel * pParent);
    Q_INVOKABLE void setAutoUpdateDatabase_(int i);
    void setAutoUpdateDatabase(e_auto_update_database e);
+   Q_INVOKABLE void setAutoUpdateDeferred(int iFlushInterval = 500, int iMaxPendingRows = 100, bool bBackgroundConnection = false); //!< Enable e_auto_update_deferred mode : edited rows/columns are collected and saved in one transaction iFlushInterval milliseconds after last edit (or as soon as iMaxPendingRows rows are pending), bBackgroundConnection saves a copy of the rows in another thread with its own database connection (ignored with Qt < 5.13)
+   Q_INVOKABLE int getPendingChangesCount() const; //!< Number of rows waiting to be saved in e_auto_update_deferred mode
+   Q_INVOKABLE QString getWriteBackError(int row) const; //!< Error returned by the database the last time this row has been saved in e_auto_update_deferred mode (empty if no error)
    Q_INVOKABLE virtual void setShowEmptyLine(bool b) = 0;
    Q_INVOKABLE void setCustomProperty(const QString & key, const QVariant & val);
+   Q_INVOKABLE void setIncrementalFetch(int iChunkSize, int iWindowSize = 0, bool bKeysetPagination = true); //!< Enable incremental fetch used by qxFetchIncremental() method : iChunkSize rows are fetched by each fetchMore() call, if iWindowSize > 0 then far-away rows are evicted to keep at most iWindowSize rows in memory, bKeysetPagination seeks after last row instead of using LIMIT/OFFSET (iChunkSize <= 0 disables incremental fetch)
+   Q_INVOKABLE int getIncrementalChunkSize() const;
+   Q_INVOKABLE int getIncrementalWindowSize() const;
+   Q_INVOKABLE bool isIncrementalFetch() const; //!< Return true if current model content has been fetched by qxFetchIncremental() method (and has not been cleared since)
 
    Q_INVOKABLE QString toJson(int row = -1) const;                   //!< On QML side, use JSON.parse() to create a javascript object after calling this qx::IxModel::toJson() method
    Q_INVOKABLE bool fromJson(const QString & json, int row = -1);    //!< On QML side, use JSON.stringify() on a javascript object before calling this qx::IxModel::fromJson() method
@@ -245,6 +278,7 @@ public:
    virtual QSqlError qxFetchById(const QVariant & id, const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
    virtual QSqlError qxFetchAll(const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
    virtual QSqlError qxFetchByQuery(const qx::QxSqlQuery & query, const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
+   virtual QSqlError qxFetchIncremental(const qx::QxSqlQuery & query = qx::QxSqlQuery(), const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL);
    virtual QSqlError qxFetchRow(int row, const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
    virtual QSqlError qxInsert(const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
    virtual QSqlError qxInsertRow(int row, const QStringList & relation = QStringList(), QSqlDatabase * pDatabase = NULL) = 0;
@@ -270,6 +304,7 @@ public:
    Q_INVOKABLE bool qxFetchById_(const QVariant & id, const QStringList & relation = QStringList());
    Q_INVOKABLE bool qxFetchAll_(const QStringList & relation = QStringList());
    Q_INVOKABLE bool qxFetchByQuery_(const QString & sQuery, const QStringList & relation = QStringList());
+   Q_INVOKABLE bool qxFetchIncremental_(const QStringList & relation = QStringList());
    Q_INVOKABLE bool qxFetchRow_(int row, const QStringList & relation = QStringList());
    Q_INVOKABLE bool qxInsert_(const QStringList & relation = QStringList());
    Q_INVOKABLE bool qxInsertRow_(int row, const QStringList & relation = QStringList());
@@ -289,6 +324,7 @@ public:
    Q_INVOKABLE bool qxExist_(const QVariant & id);
    Q_INVOKABLE QString qxValidate_(const QStringList & groups = QStringList());
    Q_INVOKABLE QString qxValidateRow_(int row, const QStringList & groups = QStringList());
+   Q_INVOKABLE bool qxFlushPendingChanges(); //!< Save now all pending changes of e_auto_update_deferred mode (waits for a save running in background)
 
    QSqlError saveChildRelations(IxModel * pChild);
    QVariant getIdFromChild(IxModel * pChild) const; //!< Used to save foreign key in a nested model
@@ -324,12 +360,25 @@ public:
    virtual bool removeRows(int row, int count, const QModelIndex & parent = QModelIndex());
    virtual bool setHeaderData(int section, Qt::Orientation orientation, const QVariant & value, int role = Qt::EditRole);
    bool setHeaderData(const QString & sColumnName, const QVariant & value, int role = Qt::EditRole);
+   virtual bool canFetchMore(const QModelIndex & parent = QModelIndex()) const;
+   virtual void fetchMore(const QModelIndex & parent = QModelIndex());
+   Q_INVOKABLE bool canFetchPrevious() const;   //!< Return true if rows before the first row of the model have been evicted (incremental fetch with a window size) and can be fetched again
+   Q_INVOKABLE void fetchPrevious();            //!< Fetch a chunk of rows before the first row of the model (prepended to the model), evicting rows at the end if window size is reached
 
 #if (QT_VERSION >= 0x050000)
    virtual QHash<int, QByteArray> roleNames() const;
    virtual Qt::DropActions supportedDragActions() const;
 #endif // (QT_VERSION >= 0x050000)
 
+Q_SIGNALS:
+
+   void writeBackFailed(int row, const QString & error); //!< Emitted in e_auto_update_deferred mode when a row cannot be saved (conflict, constraint violation, etc.), the row keeps its edited values
+
+private Q_SLOTS:
+
+   void onWriteBackTimeout();
+   void onWriteBackFinished();
+
 protected:
 
    virtual QObject * cloneModelImpl() = 0;
@@ -350,6 +399,20 @@ protected:
    bool removeRowsGeneric(int row, int count);
    bool removeRowsAutoUpdateOnFieldChange(int row, int count);
 
+   virtual type_write_back_job createWriteBackJob(const QList<int> & rows, const QList<QStringList> & columns, bool bDetached) = 0; //!< Build a job saving columns of each row in one transaction, the job fills the list of failed positions (index in rows parameter) with their errors, if bDetached is true then the job works on a copy of the rows (it can run in another thread)
+   IxModelWriteBack * getWriteBack();
+   void addPendingChange(int row, const QString & column);
+   QSqlError flushPendingChanges(bool bWait);
+   void finishWriteBack(const QSqlError & err, const QList<void *> & items, const QList<int> & rows, const QList<int> & failed, const QStringList & errors);
+   int findRowOfItem(void * pItem, int iRowHint) const;
+   void removeWriteBackRows(int row, int count);
+
+   virtual QSqlError qxFetchChunk_Helper(const qx::QxSqlQuery & query, const QStringList & relation, QSqlDatabase * pDatabase, int row, bool bReverse, long & lFetched, long & lInserted) = 0; //!< Fetch rows and insert them at row position (in reverse order if bReverse is true), lFetched is the number of rows returned by the database and lInserted the number of rows inserted in the model (rows already in the model are skipped)
+   QSqlError fetchIncrementalChunk(bool bPrevious);
+   bool sortIncremental(int column, Qt::SortOrder order);
+   QVariantList getIncrementalKeyValues(int row) const;
+   void insertListOfChild(long row, long count);
+
 #ifndef _QX_NO_JSON
 
    virtual QString toJson_Helper(int row) const = 0;
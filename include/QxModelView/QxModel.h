@@ -215,7 +215,7 @@ public:
   QxModel(qx::IxModel *other, QObject *parent) : B(parent) {
     qx::QxModel<T, B>::initFrom(other);
   }
-  virtual ~QxModel() { ; }
+  virtual ~QxModel() { this->flushPendingChanges(true); }
 
 protected:
   void init() {
@@ -267,6 +267,10 @@ public:
     if (!pDataMember) {
       return;
     }
+    if (this->isIncrementalFetch()) {
+      this->sortIncremental(column, order);
+      return;
+    }
     m_model.sort(qx::model_view::QxModelRowCompare<
                  typename type_collection::type_pair_key_value>(
         (order == Qt::AscendingOrder), pDataMember));
@@ -968,6 +972,149 @@ protected:
     return getRowItemAt(row).get();
   }
 
+  virtual qx::IxModel::type_write_back_job
+  createWriteBackJob(const QList<int> &rows, const QList<QStringList> &columns,
+                     bool bDetached) {
+    // Rows with the same list of edited columns share one prepared UPDATE
+    // statement
+    struct type_group {
+      QStringList columns;
+      QList<int> positions;
+      type_collection items;
+    };
+    std::shared_ptr<QList<type_group>> pGroups =
+        std::make_shared<QList<type_group>>();
+    QHash<QString, int> hGroupIndex;
+    for (int i = 0; (i < rows.count()) && (i < columns.count()); i++) {
+      int row = rows.at(i);
+      if ((row < 0) || (row >= m_model.count())) {
+        continue;
+      }
+      type_ptr pItem = m_model.getByIndex(row);
+      if (bDetached && pItem) {
+        pItem = qx::clone(*pItem);
+      }
+      if (!pItem) {
+        continue;
+      }
+      QStringList lstColumns = columns.at(i);
+      lstColumns.sort();
+      QString sGroupKey = lstColumns.join(QStringLiteral("|"));
+      int iGroup = hGroupIndex.value(sGroupKey, -1);
+      if (iGroup < 0) {
+        iGroup = pGroups->count();
+        hGroupIndex.insert(sGroupKey, iGroup);
+        type_group group;
+        group.columns = lstColumns;
+        pGroups->append(group);
+      }
+      type_group &group = (*pGroups)[iGroup];
+      group.positions.append(i);
+      group.items.insert(m_model.getKeyByIndex(row), pItem);
+    }
+    if (pGroups->isEmpty()) {
+      return qx::IxModel::type_write_back_job();
+    }
+
+    return [pGroups](QSqlDatabase *pDatabase, QList<int> &failed,
+                     QStringList &errors) -> QSqlError {
+      QSqlError err;
+      QSqlDatabase db =
+          (pDatabase ? (*pDatabase) : qx::QxSqlDatabase::getDatabase(err));
+      if (err.isValid()) {
+        for (int i = 0; i < pGroups->count(); i++) {
+          for (int k = 0; k < pGroups->at(i).positions.count(); k++) {
+            failed << pGroups->at(i).positions.at(k);
+            errors << err.text();
+          }
+        }
+        return err;
+      }
+
+      // If the connection is already in a transaction, changes are part of it
+      bool bTransaction = db.transaction();
+      for (int i = 0; i < pGroups->count(); i++) {
+        type_group &group = (*pGroups)[i];
+        err = qx::dao::update(group.items, (&db), group.columns);
+        if (err.isValid()) {
+          break;
+        }
+      }
+      if (!err.isValid() && (!bTransaction || db.commit())) {
+        return err;
+      }
+      err = (err.isValid() ? err : db.lastError());
+      if (bTransaction) {
+        db.rollback();
+      }
+
+      // Save each row on its own to report which ones are in conflict
+      for (int i = 0; i < pGroups->count(); i++) {
+        type_group &group = (*pGroups)[i];
+        for (long k = 0; k < group.items.count(); k++) {
+          type_ptr pItem = group.items.getByIndex(k);
+          QSqlError errItem =
+              (pItem ? qx::dao::update((*pItem), (&db), group.columns)
+                     : QSqlError());
+          if (errItem.isValid()) {
+            failed << group.positions.at(static_cast<int>(k));
+            errors << errItem.text();
+          }
+        }
+      }
+      return err;
+    };
+  }
+
+  virtual QSqlError qxFetchChunk_Helper(const qx::QxSqlQuery &query,
+                                        const QStringList &relation,
+                                        QSqlDatabase *pDatabase, int row,
+                                        bool bReverse, long &lFetched,
+                                        long &lInserted) {
+    lFetched = 0;
+    lInserted = 0;
+    type_collection tmp;
+    if (relation.count() == 0) {
+      this->m_lastError = qx::dao::fetch_by_query(
+          query, tmp, this->database(pDatabase), this->m_lstColumns);
+    } else {
+      this->m_lastError = qx::dao::fetch_by_query_with_relation(
+          relation, query, tmp, this->database(pDatabase));
+    }
+    if (this->m_lastError.isValid()) {
+      return this->m_lastError;
+    }
+    lFetched = tmp.count();
+
+    // Skip rows already in the model (rows inserted or deleted by another
+    // connection shift LIMIT/OFFSET pages)
+    QList<long> lstIndex;
+    lstIndex.reserve(tmp.count());
+    for (long l = 0; l < tmp.count(); l++) {
+      long idx = (bReverse ? (tmp.count() - 1 - l) : l);
+      if (!m_model.exist(tmp.getKeyByIndex(idx))) {
+        lstIndex.append(idx);
+      }
+    }
+    if (lstIndex.count() <= 0) {
+      return this->m_lastError;
+    }
+
+    row = qMax(0, qMin(row, static_cast<int>(m_model.count())));
+    this->beginInsertRows(QModelIndex(), row, (row + lstIndex.count() - 1));
+    m_model.reserve(m_model.count() + lstIndex.count());
+    for (int i = 0; i < lstIndex.count(); i++) {
+      long idx = lstIndex.at(i);
+      m_model.insert((row + i), tmp.getKeyByIndex(idx),
+                     tmp.getByIndex(idx));
+    }
+    this->insertListOfChild(row, lstIndex.count());
+    this->updateShowEmptyLine();
+    this->endInsertRows();
+    lInserted = lstIndex.count();
+    return this->m_lastError;
+  }
+
   virtual void dumpModelImpl(bool bJsonFormat) const {
     qx::dump(m_model, bJsonFormat);
   }
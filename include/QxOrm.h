@@ -63,8 +63,11 @@
 #include <QxCommon/QxConfig.h>
 #include <QxCommon/QxMacro.h>
 #include <QxCommon/QxHashValue.h>
+#include <QxCommon/QxReadMostlyHash.h>
+#include <QxCommon/QxThreadLocalAggregator.h>
 #include <QxCommon/QxBool.h>
 #include <QxCommon/QxCache.h>
+#include <QxCommon/QxTrace.h>
 #include <QxCommon/QxPropertyBag.h>
 #include <QxCommon/QxSimpleCrypt.h>
 #include <QxCommon/QxException.h>
@@ -100,6 +103,7 @@
 #include <QxDao/QxSqlQueryBuilder.h>
 #include <QxDao/QxSqlQueryHelper.h>
 #include <QxDao/QxSqlQuery.h>
+#include <QxDao/QxSqlQueryCompiled.h>
 #include <QxDao/QxSqlDatabase.h>
 #include <QxDao/IxSqlRelation.h>
 #include <QxDao/QxSqlRelation.h>
@@ -118,6 +122,8 @@
 #include <QxDao/QxSoftDelete.h>
 #include <QxDao/QxSqlError.h>
 #include <QxDao/QxSession.h>
+#include <QxDao/QxUnitOfWork.h>
+#include <QxDao/QxIdentityMap.h>
 #include <QxDao/QxDateNeutral.h>
 #include <QxDao/QxTimeNeutral.h>
 #include <QxDao/QxDateTimeNeutral.h>
@@ -128,6 +134,8 @@
 #include <QxDao/QxSqlRelationLinked.h>
 #include <QxDao/QxDaoAsync.h>
 #include <QxDao/QxSqlSaveMode.h>
+#include <QxDao/QxDaoParallel.h>
+#include <QxDao/QxDaoMetrics.h>
 
 #include <QxDao/QxSqlElement/QxSqlElement.h>
 
@@ -186,6 +194,7 @@
 #include <QxHttpServer/QxHttpCookie.h>
 #include <QxHttpServer/QxHttpSession.h>
 #include <QxHttpServer/QxHttpSessionManager.h>
+#include <QxHttpServer/QxHttpMetrics.h>
 #endif // _QX_ENABLE_QT_NETWORK
 
 #endif // _QX_ORM_H_
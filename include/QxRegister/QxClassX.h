@@ -153,6 +153,27 @@ public:
    static qx_bool invokeStatic(const QString & sClassKey, const QString & sFctKey, const QString & params = QString(), qx::any * ret = NULL);
    static qx_bool invokeStatic(const QString & sClassKey, const QString & sFctKey, const type_any_params & params, qx::any * ret = NULL);
 
+   /* Invoke a function resolved only once by getFctMember() or getFctStatic() : the returned IxFunction pointer is a stable handle (valid while the class is registered), so there is no lookup by class name and function name for each call */
+
+   template <class U>
+   static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const QString & params = QString(), qx::any * ret = NULL)
+   {
+      typedef typename std::conditional< std::is_pointer<U>::value, QxClassX::invoke_ptr<U>, QxClassX::invoke_default<U> >::type type_invoke_1;
+      typedef typename std::conditional< qx::trait::is_smart_ptr<U>::value, QxClassX::invoke_ptr<U>, type_invoke_1 >::type type_invoke_2;
+      return type_invoke_2::invoke(pFct, pOwner, params, ret);
+   }
+
+   template <class U>
+   static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const type_any_params & params, qx::any * ret = NULL)
+   {
+      typedef typename std::conditional< std::is_pointer<U>::value, QxClassX::invoke_ptr<U>, QxClassX::invoke_default<U> >::type type_invoke_1;
+      typedef typename std::conditional< qx::trait::is_smart_ptr<U>::value, QxClassX::invoke_ptr<U>, type_invoke_1 >::type type_invoke_2;
+      return type_invoke_2::invoke(pFct, pOwner, params, ret);
+   }
+
+   static qx_bool invokeStatic(IxFunction * pFct, const QString & params = QString(), qx::any * ret = NULL);
+   static qx_bool invokeStatic(IxFunction * pFct, const type_any_params & params, qx::any * ret = NULL);
+
 private:
 
    template <class U>
@@ -162,6 +183,10 @@ private:
       { return QxClassX::invokeVoidPtr(sClassKey, sFctKey, static_cast<void *>(& (* pOwner)), params, ret); }
       static inline qx_bool invoke(const QString & sClassKey, const QString & sFctKey, U & pOwner, const type_any_params & params, qx::any * ret = NULL)
       { return QxClassX::invokeVoidPtr(sClassKey, sFctKey, static_cast<void *>(& (* pOwner)), params, ret); }
+      static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const QString & params = QString(), qx::any * ret = NULL)
+      { return QxClassX::invokeVoidPtr(pFct, static_cast<void *>(& (* pOwner)), params, ret); }
+      static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const type_any_params & params, qx::any * ret = NULL)
+      { return QxClassX::invokeVoidPtr(pFct, static_cast<void *>(& (* pOwner)), params, ret); }
    };
 
    template <class U>
@@ -171,10 +196,16 @@ private:
       { return QxClassX::invokeVoidPtr(sClassKey, sFctKey, static_cast<void *>(& pOwner), params, ret); }
       static inline qx_bool invoke(const QString & sClassKey, const QString & sFctKey, U & pOwner, const type_any_params & params, qx::any * ret = NULL)
       { return QxClassX::invokeVoidPtr(sClassKey, sFctKey, static_cast<void *>(& pOwner), params, ret); }
+      static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const QString & params = QString(), qx::any * ret = NULL)
+      { return QxClassX::invokeVoidPtr(pFct, static_cast<void *>(& pOwner), params, ret); }
+      static inline qx_bool invoke(IxFunction * pFct, U & pOwner, const type_any_params & params, qx::any * ret = NULL)
+      { return QxClassX::invokeVoidPtr(pFct, static_cast<void *>(& pOwner), params, ret); }
    };
 
    static qx_bool invokeVoidPtr(const QString & sClassKey, const QString & sFctKey, void * pOwner, const QString & params = QString(), qx::any * ret = NULL);
    static qx_bool invokeVoidPtr(const QString & sClassKey, const QString & sFctKey, void * pOwner, const type_any_params & params, qx::any * ret = NULL);
+   static qx_bool invokeVoidPtr(IxFunction * pFct, void * pOwner, const QString & params = QString(), qx::any * ret = NULL);
+   static qx_bool invokeVoidPtr(IxFunction * pFct, void * pOwner, const type_any_params & params, qx::any * ret = NULL);
 
    static bool isValid_DataMember(IxDataMember * p);
    static bool isValid_SqlRelation(IxDataMember * p);
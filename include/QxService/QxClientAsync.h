@@ -54,6 +54,8 @@ namespace service {
  * \ingroup QxService
  * \brief qx::service::QxClientAsync : class helper to easily execute an asynchronous transaction using a multi-thread process
  *
+ * Each call creates a thread and opens a new connection to server : to execute many transactions, qx::service::QxClientPool class (pipelined requests on persistent connections, no thread) should be preferred.
+ *
  * <a href="https://www.qxorm.com/qxorm_en/tutorial_2.html" target="_blank">Click here to access to a tutorial to explain how to work with QxService module.</a>
  */
 class QxClientAsync : public QThread
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+#ifndef _QX_SERVICE_CLIENT_POOL_H_
+#define _QX_SERVICE_CLIENT_POOL_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxClientPool.h
+ * \author Lionel Marty
+ * \ingroup QxService
+ * \brief Pool of persistent client connections to execute pipelined asynchronous transactions
+ */
+
+#ifdef _QX_NO_PRECOMPILED_HEADER
+#ifndef Q_MOC_RUN
+#include <QxPrecompiled.h> // Need to include precompiled header for the generated moc file
+#endif // Q_MOC_RUN
+#endif // _QX_NO_PRECOMPILED_HEADER
+
+#include <QtNetwork/qabstractsocket.h>
+
+#ifndef Q_MOC_RUN
+#include <QxService/IxService.h>
+#include <QxService/QxTransaction.h>
+#endif // Q_MOC_RUN
+
+namespace qx {
+namespace service {
+
+/*!
+ * \ingroup QxService
+ * \brief qx::service::QxClientPool : pool of persistent client connections to execute pipelined asynchronous transactions
+ *
+ * Unlike qx::service::QxClientAsync class (one thread and one connection per call), qx::service::QxClientPool class sends many requests on a few persistent connections without waiting for replies.
+ * Each request has a request id written in the transaction header, so replies are matched to requests even if they are received in a different order.
+ * No thread is created : sockets are managed by the event loop of the thread where the pool lives, and results are delivered by a callback function and/or by finished() signal.
+ *
+ * Server side must be built with a QxOrm version which supports request ids in transaction header (connections with request ids are kept open by qx::service::QxThread class, even if keep-alive parameter is 0).
+ *
+ * Quick sample :
+ * \code
+qx::service::QxClientPool pool;
+pool.setMaxConnections(2);
+for (int i = 0; i < 100; i++)
+{
+   std::shared_ptr<my_service> service = std::make_shared<my_service>();
+   service->setInputParameter(my_input_ptr(new my_input(i)));
+   pool.execute(service, "my_method", [](qx::service::IxService_ptr p) { qDebug() << p->getMessageReturn().getDesc(); });
+}
+pool.waitForFinished();
+ * \endcode
+ */
+class QX_DLL_EXPORT QxClientPool : public QObject
+{
+
+   Q_OBJECT
+
+public:
+
+   typedef std::function<void (qx::service::IxService_ptr)> type_fct_on_finished;
+
+private:
+
+   struct QxClientPoolImpl;
+   std::unique_ptr<QxClientPoolImpl> m_pImpl; //!< Private implementation idiom
+
+public:
+
+   QxClientPool(QObject * parent = nullptr);
+   virtual ~QxClientPool();
+
+   int getMaxConnections() const;
+   int getMaxInFlightPerConnection() const;
+   int getPendingCount() const;
+
+   void setMaxConnections(int i);
+   void setMaxInFlightPerConnection(int i);
+
+   quint32 execute(IxService_ptr pService, const QString & sMethod, type_fct_on_finished fct = type_fct_on_finished());
+   bool waitForFinished(int msecs = -1);
+   void close();
+
+Q_SIGNALS:
+
+   void finished(qx::service::IxService_ptr service);
+   void allFinished();
+
+private Q_SLOTS:
+
+   void onSocketConnected();
+   void onSocketReadyRead();
+   void onSocketDisconnected();
+   void onSocketError(QAbstractSocket::SocketError socketError);
+   void onCheckTimeout();
+
+};
+
+typedef std::shared_ptr<QxClientPool> QxClientPool_ptr;
+
+} // namespace service
+} // namespace qx
+
+#endif // _QX_SERVICE_CLIENT_POOL_H_
+#endif // _QX_ENABLE_QT_NETWORK
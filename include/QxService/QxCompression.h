@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+#ifndef _QX_SERVICE_COMPRESSION_H_
+#define _QX_SERVICE_COMPRESSION_H_
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+/*!
+ * \file QxCompression.h
+ * \author Lionel Marty
+ * \ingroup QxService
+ * \brief Pluggable compression codecs used by QxService module to compress data transfered over network
+ */
+
+#include <QtCore/qbytearray.h>
+
+#ifndef Q_MOC_RUN
+#include <QxSingleton/QxSingleton.h>
+#endif // Q_MOC_RUN
+
+#define QX_SERVICE_COMPRESSION_NONE 0
+#define QX_SERVICE_COMPRESSION_ZLIB 1
+#define QX_SERVICE_COMPRESSION_LZ4  2
+
+namespace qx {
+namespace service {
+
+/*!
+ * \ingroup QxService
+ * \brief qx::service::IxCompressionCodec : common interface for all compression codecs used by QxService module
+ *
+ * Each codec is identified by a unique id (from 1 to 8) written in the transaction header.
+ * Id 1 (zlib, same format as qCompress()) is always available, id 2 is a fast LZ4 block codec (built-in implementation, or liblz4 if _QX_ENABLE_LZ4 compilation option is defined).
+ * You can register your own codec (ids from 3 to 8) using qx::service::QxCompression::getSingleton()->registerCodec().
+ */
+class QX_DLL_EXPORT IxCompressionCodec
+{
+
+public:
+
+   IxCompressionCodec() { ; }
+   virtual ~IxCompressionCodec() { ; }
+
+   virtual quint8 getId() const = 0;
+   virtual QString getName() const = 0;
+   virtual bool compress(const QByteArray & data, QByteArray & compressed, int iLevel) const = 0;
+   virtual bool uncompress(const QByteArray & data, QByteArray & uncompressed) const = 0;
+
+};
+
+typedef std::shared_ptr<qx::service::IxCompressionCodec> IxCompressionCodec_ptr;
+
+/*!
+ * \ingroup QxService
+ * \brief qx::service::QxCompression : registry of all compression codecs available to QxService module (this class is a singleton)
+ *
+ * Codecs should be registered when application starts (before any transaction) : then getting a codec by its id doesn't lock any mutex.
+ * Codecs available on each side of a connection are exchanged in the transaction header (see getCodecMask() and qx::service::QxTools class), so a server never replies with a codec unknown by its client.
+ * Negotiation is done per message on the same socket : a reply uses the codecs advertised by the request, but a request can use a codec other than zlib only if the server has already advertised it on this socket.
+ * So with a new socket for each request (qx::service::QxClientAsync for example), requests are compressed with zlib and only replies can use other codecs : use a persistent connection (keep-alive, qx::service::QxClientPool) to compress requests with other codecs too.
+ * To stay compatible with old peers (which uncompress data with qUncompress() as soon as compression header field is not 0), a message advertising codecs to an unknown peer is always compressed with zlib.
+ */
+class QX_DLL_EXPORT QxCompression : public qx::QxSingleton<QxCompression>
+{
+
+   friend class qx::QxSingleton<QxCompression>;
+
+private:
+
+   struct QxCompressionImpl;
+   std::unique_ptr<QxCompressionImpl> m_pImpl; //!< Private implementation idiom
+
+   QxCompression();
+   virtual ~QxCompression();
+
+public:
+
+   void registerCodec(const IxCompressionCodec_ptr & pCodec);
+   IxCompressionCodec * getCodec(quint8 uiCodecId) const;
+   quint8 getCodecMask() const;
+
+   bool compress(quint8 uiCodecId, const QByteArray & data, QByteArray & compressed, int iLevel = -1) const;
+   bool uncompress(quint8 uiCodecId, const QByteArray & data, QByteArray & uncompressed) const;
+
+};
+
+} // namespace service
+} // namespace qx
+
+QX_DLL_EXPORT_QX_SINGLETON_HPP(qx::service::QxCompression)
+
+#endif // _QX_SERVICE_COMPRESSION_H_
+#endif // _QX_ENABLE_QT_NETWORK
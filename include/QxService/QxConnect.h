@@ -63,6 +63,15 @@ namespace service {
  * \ingroup QxService
  * \brief qx::service::QxConnect : define connection parameters used by QxService module of QxOrm library (this class is a singleton)
  *
+ * When data compression is enabled (setCompressData()), the compression codec is chosen by serialized data size : each call to setCompressionCodec() defines the codec (and its level) to use from a min data size.
+ * By default, data greater than 2000 bytes are compressed with zlib (default level).
+ * For example, to use the fast LZ4 codec for all data greater than 1000 bytes (useful on LAN networks where CPU is the bottleneck) :
+ * \code
+qx::service::QxConnect::getSingleton()->setCompressData(true);
+qx::service::QxConnect::getSingleton()->setCompressionCodec(QX_SERVICE_COMPRESSION_LZ4, 1000);
+ * \endcode
+ * A codec other than zlib is used only if the peer has advertised it in a previous transaction on the same connection (see qx::service::QxCompression class), otherwise zlib is used.
+ *
  * <a href="https://www.qxorm.com/qxorm_en/tutorial_2.html" target="_blank">Click here to access to a tutorial to explain how to work with QxService module.</a>
  */
 class QX_DLL_EXPORT QxConnect : public qx::QxSingleton<QxConnect>
@@ -93,6 +102,8 @@ public:
    long getThreadCount();
    int getMaxWait();
    bool getCompressData();
+   quint8 getCompressionCodec(long lDataSize, int & iLevel);
+   quint8 getCompressionCodecMask();
    bool getEncryptData();
    quint64 getEncryptKey();
    long getKeepAlive();
@@ -118,6 +129,8 @@ public:
    void setThreadCount(long l);
    void setMaxWait(int i);
    void setCompressData(bool b);
+   void setCompressionCodec(quint8 uiCodecId, long lMinDataSize = 0, int iLevel = -1);
+   void clearCompressionCodec();
    void setEncryptData(bool b, quint64 key = 0);
    void setKeepAlive(long l);
    void setModeHTTP(bool b);
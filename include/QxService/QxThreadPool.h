@@ -83,10 +83,14 @@ protected:
    QQueue<QxThread *> m_lstAvailable;        //!< List of services available to execute process
    bool m_bIsStopped;                        //!< Flag to indicate if thread has been stopped
    QMutex m_mutex;                           //!< Mutex => 'QxThreadPool' is thread-safe
+   QAtomicInt m_iThreadCount;                //!< Number of services created (can be read without locking the mutex)
+   QAtomicInt m_iAvailableCount;             //!< Number of services available (can be read without locking the mutex)
+   QAtomicInt m_iWaitingCount;               //!< Number of incoming connections waiting for an available service
+   QAtomicInt m_iRejectedCount;              //!< Number of incoming connections rejected because no service was available
 
 public:
 
-   QxThreadPool(QObject *parent = nullptr) : QThread(parent), m_bIsStopped(false) { ; }
+   QxThreadPool(QObject *parent = nullptr) : QThread(parent), m_bIsStopped(false), m_iThreadCount(0), m_iAvailableCount(0), m_iWaitingCount(0), m_iRejectedCount(0) { ; }
    virtual ~QxThreadPool() { if (isRunning()) { qDebug("[QxOrm] qx::service::QxThreadPool thread is running : %s", "quit and wait"); quit(); wait(); } }
 
    bool isStopped() const;
@@ -94,6 +98,13 @@ public:
    void setAvailable(QxThread * p);
    void raiseError(const QString & err, QxTransaction_ptr transaction);
 
+   int getThreadCount() const;
+   int getAvailableCount() const;
+   int getWaitingCount() const;
+   int getRejectedCount() const;
+   void addWaitingCount(int i);
+   void addRejectedCount();
+
    static void sleepThread(unsigned long msecs) { QThread::msleep(msecs); }
 
 protected:
@@ -46,6 +46,10 @@
 
 #include <QxService/QxTransaction.h>
 
+#define QX_SERVICE_TOOLS_HEADER_SIZE (sizeof(quint32) + sizeof(quint16) + sizeof(quint16) + sizeof(quint16)) // (serialized data size) + (serialization type) + (compression codec + codecs available) + (encrypt data + header flags)
+#define QX_SERVICE_TOOLS_HEADER_MAX_SIZE (QX_SERVICE_TOOLS_HEADER_SIZE + sizeof(quint32)) // + (request id)
+#define QX_SERVICE_TOOLS_HEADER_FLAG_REQUEST_ID 0x0100 // Header is followed by a request id (pipelined transactions, see qx::service::QxClientPool class)
+
 namespace qx {
 namespace service {
 
@@ -53,6 +57,10 @@ namespace service {
  * \ingroup QxService
  * \brief qx::service::QxTools : provide some tools to read/write on socket all datas transfered by QxService module of QxOrm library
  *
+ * Each transaction is sent on socket as a frame : a header of QX_SERVICE_TOOLS_HEADER_SIZE bytes (see qx::service::QxTools::header) followed by serialized data.
+ * If the transaction has a request id (pipelined transactions sent by qx::service::QxClientPool class), the header contains the QX_SERVICE_TOOLS_HEADER_FLAG_REQUEST_ID flag and is followed by the request id (4 bytes) : the reply contains the same request id.
+ * To limit memory copies of big transactions, serialized data are read directly into a buffer attached to the socket (reused by all transactions of a connection), decrypted in place, and deserialized without any other copy (only decompression needs another buffer, also reused).
+ *
  * <a href="https://www.qxorm.com/qxorm_en/tutorial_2.html" target="_blank">Click here to access to a tutorial to explain how to work with QxService module.</a>
  */
 class QX_DLL_EXPORT QxTools
@@ -60,10 +68,39 @@ class QX_DLL_EXPORT QxTools
 
 public:
 
-   static qx_bool readSocket(QTcpSocket & socket, QxTransaction & transaction, quint32 & size);
+   /*!
+    * \brief Transaction header written before serialized data (big-endian, same layout as QDataStream::Qt_4_5)
+    */
+   struct QX_DLL_EXPORT header
+   {
+      quint32 uiSerializedSize;     //!< Serialized data size (in bytes)
+      quint16 uiSerializationType;  //!< Serialization type (see qx::service::QxConnect::serialization_type enum)
+      quint16 uiCompressData;       //!< Compression codec id (low byte) + codecs available on sender side (high byte)
+      quint16 uiEncryptData;        //!< Data encrypted or not (low byte) + header flags (high byte)
+      quint32 uiRequestId;          //!< Request id (only if QX_SERVICE_TOOLS_HEADER_FLAG_REQUEST_ID flag is set)
+
+      header() : uiSerializedSize(0), uiSerializationType(0), uiCompressData(0), uiEncryptData(0), uiRequestId(0) { ; }
+
+      bool isEncrypted() const      { return ((uiEncryptData & 0xFF) != 0); }
+      bool hasRequestId() const     { return ((uiEncryptData & QX_SERVICE_TOOLS_HEADER_FLAG_REQUEST_ID) != 0); }
+      qint64 getHeaderSize() const  { return static_cast<qint64>(hasRequestId() ? QX_SERVICE_TOOLS_HEADER_MAX_SIZE : QX_SERVICE_TOOLS_HEADER_SIZE); }
+   };
+
+   static qx_bool readSocket(QTcpSocket & socket, QxTransaction & transaction, quint32 & size, const QByteArray & alreadyRead = QByteArray());
    static qx_bool readSocketData(QByteArray  dataSerialized,QDataStream & in,QxTransaction & transaction, quint32 & size);
+   static qx_bool readSocketData(const header & h, char * pDataSerialized, QxTransaction & transaction, quint32 & size, QByteArray * pUncompressBuffer = NULL);
    static qx_bool writeSocket(QTcpSocket & socket, QxTransaction & transaction, quint32 & size);
 
+   static header parseHeader(const char * pData);
+   static int writeHeader(const header & h, char * pData);
+   static qint64 checkFrame(const char * pData, qint64 iSize, header & h);
+
+   static QByteArray takePendingData(QTcpSocket & socket);
+   static bool hasPendingData(QTcpSocket & socket);
+
+   static void setPeerCodecMask(QTcpSocket & socket, quint16 uiCompressData);
+   static quint8 getPeerCodecMask(QTcpSocket & socket);
+
 };
 
 } // namespace service
@@ -151,10 +151,11 @@ protected:
    IxParameter_ptr      m_pOutputParameter;                 //!< List of output parameters (reply)
    IxService_ptr        m_pServiceInstance;                 //!< Service instance created by 'm_sServiceName' property
    connection_status    m_eForceConnectionStatus;           //!< Sometimes we have to force connection status
+   quint32              m_uiRequestId;                      //!< Request id written in transaction header to match pipelined requests and replies (0 means no request id, not serialized)
 
 public:
 
-   QxTransaction(QObject *parent = nullptr) : QObject(parent), m_uiInputTransactionSize(0), m_uiOutputTransactionSize(0), m_lPortSource(0), m_lPortTarget(0), m_eForceConnectionStatus(conn_none) { ; }
+   QxTransaction(QObject *parent = nullptr) : QObject(parent), m_uiInputTransactionSize(0), m_uiOutputTransactionSize(0), m_lPortSource(0), m_lPortTarget(0), m_eForceConnectionStatus(conn_none), m_uiRequestId(0) { ; }
    virtual ~QxTransaction() { ; }
    virtual void clear();
 
@@ -177,6 +178,7 @@ public:
    IxParameter_ptr getInputParameter() const             { return m_pInputParameter; }
    IxParameter_ptr getOutputParameter() const            { return m_pOutputParameter; }
    connection_status getForceConnectionStatus() const    { return m_eForceConnectionStatus; }
+   quint32 getRequestId() const                          { return m_uiRequestId; }
 
    void setTransactionId(const QString & s)                    { m_sTransactionId = s; }
    void setInputTransactionSize(quint32 ui)                    { m_uiInputTransactionSize = ui; }
@@ -197,6 +199,7 @@ public:
    void setInputParameter(IxParameter_ptr p)                   { m_pInputParameter = p; }
    void setOutputParameter(IxParameter_ptr p)                  { m_pOutputParameter = p; }
    void setForceConnectionStatus(connection_status e)          { m_eForceConnectionStatus = e; }
+   void setRequestId(quint32 ui)                               { m_uiRequestId = ui; }
 
    virtual void executeServer();
    virtual qx_bool writeSocketServer(QTcpSocket & socket);
@@ -50,6 +50,8 @@
 #include <QxService/IxParameter.h>
 #include <QxService/IxService.h>
 #include <QxService/QxClientAsync.h>
+#include <QxService/QxClientPool.h>
+#include <QxService/QxCompression.h>
 #include <QxService/QxConnect.h>
 #include <QxService/QxServer.h>
 #include <QxService/QxService.h>
@@ -45,6 +45,10 @@
 
 #include <QxCommon/QxPropertyBag.h>
 
+QT_BEGIN_NAMESPACE
+class QRegularExpression;
+QT_END_NAMESPACE
+
 namespace qx {
 
 class IxDataMember;
@@ -98,6 +102,9 @@ public:
 
    virtual void validate(void * pOwner, QxInvalidValueX & lstInvalidValues) const;
 
+   static QRegularExpression compileRegularExpression(const QString & sPattern, bool bCaseInsensitive = false); //!< Build a regular expression matching the whole value (like QRegExp::exactMatch() method), JIT-compiled when available
+   static QString getEMailPattern();
+
 protected:
 
    void initDefaultMessage();
@@ -43,6 +43,8 @@
  * \brief Common interface for a list of validators
  */
 
+#include <QtCore/qatomic.h>
+
 #include <QxCollection/QxCollection.h>
 
 #include <QxValidator/IxValidator.h>
@@ -59,12 +61,18 @@ class QxInvalidValueX;
  *
  * For more informations about <b>QxValidator module</b>, <a href="https://www.qxorm.com/qxorm_en/faq.html#faq_250" target="_blank">goto the FAQ of QxOrm website</a> :
  * <a href="https://www.qxorm.com/qxorm_en/faq.html#faq_250" target="_blank">https://www.qxorm.com/qxorm_en/faq.html#faq_250</a>
+ *
+ * On first validation, validators of each group (including base class validators) are compiled into a plan : regular expressions are built only once, constraints are converted only once,
+ * and properties of type QString, QDateTime and numeric types are read directly from the instance (without QVariant conversion).
+ * A class without validator for a group is skipped by <i>qx::validate()</i> before building any invalid values list (see <i>isEmpty()</i> method).
  */
 class QX_DLL_EXPORT IxValidatorX
 {
 
    friend class IxClass;
 
+   Q_DISABLE_COPY(IxValidatorX)
+
 protected:
 
    typedef QList<IxValidator_ptr> type_lst_validator;
@@ -74,12 +82,18 @@ protected:
    type_lst_validator_ptr_by_group m_lstValidatorByGroup;   //!< List of validator by group
    IxClass * m_pClass;                                      //!< Class registered into QxOrm context
 
+private:
+
+   struct IxValidatorXPlan;
+   mutable QAtomicPointer<IxValidatorXPlan> m_pPlan;        //!< Validators compiled by group, built on first validation and reset when a validator is added
+
 public:
 
    IxValidatorX();
    virtual ~IxValidatorX() = 0;
 
    QxInvalidValueX validate(void * pOwner, const QString & sGroup = QString()) const;
+   bool isEmpty(const QString & sGroup = QString()) const; //!< Return true if there is no validator to check for this group (including base class validators)
 
    IxValidator * add_NotNull(const QString & sPropertyKey, const QString & sMessage = QString(), const QString & sGroup = QString());
    IxValidator * add_NotEmpty(const QString & sPropertyKey, const QString & sMessage = QString(), const QString & sGroup = QString());
@@ -107,6 +121,12 @@ protected:
    IxValidator_ptr createValidator(IxValidator::validator_type type, const QString & sPropertyKey, const QString & sMessage, const QString & sGroup);
    IxDataMember * getDataMember(const QString & sPropertyKey) const;
 
+private:
+
+   const IxValidatorXPlan * getPlan() const;
+   void resetPlan();
+   void validateByPlan(void * pOwner, const QString & sGroup, QxInvalidValueX & lstInvalidValues) const;
+
 };
 
 typedef std::shared_ptr<IxValidatorX> IxValidatorX_ptr;
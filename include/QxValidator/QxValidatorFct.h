@@ -73,7 +73,7 @@ struct QxValidator_Helper_Generic
       qx::IxClass * pClass = qx::QxClass<T>::getSingleton();
       if (! pClass) { qAssert(false); return invalidValues; }
       qx::IxValidatorX * pAllValidator = pClass->getAllValidator();
-      if (! pAllValidator) { return invalidValues; }
+      if (! pAllValidator || pAllValidator->isEmpty(group)) { return invalidValues; }
       invalidValues.setCurrentPath(pClass->getName());
       invalidValues.insert(pAllValidator->validate((& t), group));
       return invalidValues;
@@ -90,8 +90,8 @@ struct QxValidator_Helper_Container
       qx::QxInvalidValueX invalidValues; long lIndex = 0;
       for (typename T::iterator it = t.begin(); it != t.end(); ++it)
       {
-         invalidValues.setCurrentPath("[" + QString::number(lIndex) + "]");
-         invalidValues.insert(validateItem((* it), group));
+         qx::QxInvalidValueX invalidItem = validateItem((* it), group);
+         if (invalidItem.count() > 0) { invalidValues.setCurrentPath("[" + QString::number(lIndex) + "]"); invalidValues.insert(invalidItem); }
          lIndex++;
       }
       return invalidValues;
@@ -40,7 +40,7 @@ struct QxDao_Count
    static long count(const qx::QxSqlQuery & query, QSqlDatabase * pDatabase)
    {
       T t; Q_UNUSED(t);
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count", new qx::QxSqlQueryBuilder_Count<T>(), (& query));
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Count<T> >(), (& query));
       if (! dao.isValid()) { return 0; }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -64,7 +64,7 @@ struct QxDao_Count
    static QSqlError count(long & lCount, const qx::QxSqlQuery & query, QSqlDatabase * pDatabase)
    {
       T t; Q_UNUSED(t); lCount = 0;
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count", new qx::QxSqlQueryBuilder_Count<T>(), (& query));
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Count<T> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -94,7 +94,7 @@ struct QxDao_Count_WithRelation
    static QSqlError count(long & lCount, const QStringList & relation, const qx::QxSqlQuery & query, QSqlDatabase * pDatabase)
    {
       T t; Q_UNUSED(t); lCount = 0;
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count with relation", new qx::QxSqlQueryBuilder_Count_WithRelation<T>(), (& query));
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "count with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Count_WithRelation<T> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
 
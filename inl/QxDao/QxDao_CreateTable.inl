@@ -40,7 +40,7 @@ struct QxDao_CreateTable
    static QSqlError createTable(QSqlDatabase * pDatabase)
    {
       T t; Q_UNUSED(t);
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "create table", new qx::QxSqlQueryBuilder_CreateTable<T>());
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "create table", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_CreateTable<T> >());
       if (! dao.isValid()) { return dao.error(); }
 
       if (dao.database().driverName() != "QSQLITE")
@@ -40,10 +40,10 @@ struct QxDao_DeleteAll
    static QSqlError deleteAll(const qx::QxSqlQuery & query, QSqlDatabase * pDatabase, bool bVerifySoftDelete)
    {
       T t; Q_UNUSED(t);
-      qx::IxSqlQueryBuilder * pBuilder = new qx::QxSqlQueryBuilder_DeleteAll<T>(); pBuilder->init();
+      qx::IxSqlQueryBuilder * pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_DeleteAll<T> >(); pBuilder->init();
       qx::QxSoftDelete oSoftDelete = pBuilder->getSoftDelete();
       if (bVerifySoftDelete && ! oSoftDelete.isEmpty())
-      { delete pBuilder; pBuilder = new qx::QxSqlQueryBuilder_SoftDeleteAll<T>(); }
+      { qx::dao::detail::IxDao_Recycler::releaseBuilder(pBuilder); pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_SoftDeleteAll<T> >(); }
 
       qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "delete all", pBuilder, (& query));
       if (! dao.isValid()) { return dao.error(); }
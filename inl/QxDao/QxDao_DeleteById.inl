@@ -39,10 +39,10 @@ struct QxDao_DeleteById_Generic
 
    static QSqlError deleteById(T & t, QSqlDatabase * pDatabase, bool bVerifySoftDelete)
    {
-      qx::IxSqlQueryBuilder * pBuilder = new qx::QxSqlQueryBuilder_DeleteById<T>(); pBuilder->init();
+      qx::IxSqlQueryBuilder * pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_DeleteById<T> >(); pBuilder->init();
       qx::QxSoftDelete oSoftDelete = pBuilder->getSoftDelete();
       if (bVerifySoftDelete && ! oSoftDelete.isEmpty())
-      { delete pBuilder; pBuilder = new qx::QxSqlQueryBuilder_SoftDeleteById<T>(); }
+      { qx::dao::detail::IxDao_Recycler::releaseBuilder(pBuilder); pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_SoftDeleteById<T> >(); }
 
       qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "delete by id", pBuilder);
       if (! dao.isValid()) { return dao.error(); }
@@ -89,10 +89,10 @@ struct QxDao_DeleteById_Container
    {
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
-      qx::IxSqlQueryBuilder * pBuilder = new qx::QxSqlQueryBuilder_DeleteById<type_item>(); pBuilder->init();
+      qx::IxSqlQueryBuilder * pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_DeleteById<type_item> >(); pBuilder->init();
       qx::QxSoftDelete oSoftDelete = pBuilder->getSoftDelete();
       if (bVerifySoftDelete && ! oSoftDelete.isEmpty())
-      { delete pBuilder; pBuilder = new qx::QxSqlQueryBuilder_SoftDeleteById<type_item>(); }
+      { qx::dao::detail::IxDao_Recycler::releaseBuilder(pBuilder); pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_SoftDeleteById<type_item> >(); }
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
       qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "delete by id", pBuilder);
@@ -102,71 +102,144 @@ struct QxDao_DeleteById_Container
 #ifdef _QX_ENABLE_MONGODB
       if (dao.isMongoDB())
       {
-         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! deleteItem((* it), dao)) { return dao.error(); } }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! deleteItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
          QStringList & itemsAsJson = dao.itemsAsJson();
          qx::dao::mongodb::QxMongoDB_Helper::deleteMany((& dao), dao.getDataMemberX()->getClass(), itemsAsJson, NULL); if (! dao.isValid()) { return dao.error(); }
          dao.qxQuery().queryAt(2, "<done>"); dao.itemsAsJson().clear();
-         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! deleteItem((* it), dao)) { return dao.error(); } }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! deleteItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
          return dao.error();
       }
 #endif // _QX_ENABLE_MONGODB
 
       QString sql = dao.builder().buildSql().getSqlQuery();
       if (sql.isEmpty()) { return dao.errEmpty(); }
-      if (! dao.prepare(sql)) { return dao.errFailed(true); }
 
-      for (typename T::iterator it = t.begin(); it != t.end(); ++it)
-      { if (! deleteItem((* it), dao)) { return dao.error(); } }
+      // Set-based delete : 'WHERE id IN (...)' chunked to the max bind values supported by the database
+      // SQL generator returning 'getMaxBindValues() <= 0' (default value, or per-row SQL into onBeforeDelete()/onAfterDelete()) keeps one statement per item and per-entity triggers order
+      IxSqlGenerator * pSqlGenerator = dao.getSqlGenerator();
+      qx::IxDataMember * pId = dao.getDataId();
+      int iNameCount = (pId ? pId->getNameCount() : 0);
+      long lItemsPerQuery = (((iNameCount > 0) && pSqlGenerator) ? static_cast<long>(pSqlGenerator->getMaxBindValues() / iNameCount) : 0);
+      if ((lItemsPerQuery <= 1) || (qx::trait::generic_container<T>::size(t) <= 1))
+      {
+         if (! dao.prepare(sql)) { return dao.errFailed(true); }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it)
+         { if (! deleteItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
+         return dao.error();
+      }
+
+      // Triggers are called chunk by chunk : on_before_delete() for each item of the chunk, then the statement, then on_after_delete() for each item of the chunk
+      bool bSoftDelete = (bVerifySoftDelete && ! oSoftDelete.isEmpty());
+      bool bRowValue = pSqlGenerator->getRowValueInSupported();
+      long lCurrCount = 0;
+      QVariantList lstIds; lstIds.reserve(static_cast<int>(lItemsPerQuery * iNameCount));
+      typename T::iterator itFirst = t.begin();
+      while (itFirst != t.end())
+      {
+         lstIds.clear();
+         typename T::iterator itLast = itFirst;
+         while ((itLast != t.end()) && ((lstIds.count() / iNameCount) < lItemsPerQuery))
+         { if (! deleteItem((* itLast), dao, step_collect_id, (& lstIds))) { return dao.error(); } ++itLast; }
+
+         long lCount = (lstIds.count() / iNameCount);
+         if (lCount > 0)
+         {
+            if (lCount != lCurrCount)
+            {
+               qx::IxSqlQueryBuilder::sql_DeleteById_In(sql, dao.builder(), bSoftDelete, lCount, bRowValue);
+               dao.builder().setSqlQuery(sql);
+               if (! dao.prepare(sql)) { return dao.errFailed(true); }
+               lCurrCount = lCount;
+            }
+
+            {
+               qx::dao::detail::IxDao_Timer timer((& dao), qx::dao::detail::IxDao_Helper::timer_cpp_read_instance);
+               resolveInputIn(dao.query(), pId, lstIds, 0, lCount);
+            }
+
+            if (! dao.exec(true)) { return dao.errFailed(); }
+         }
+
+         for (typename T::iterator it = itFirst; it != itLast; ++it)
+         { if (! deleteItem((* it), dao, step_after_delete, NULL)) { return dao.error(); } }
+         itFirst = itLast;
+      }
 
       return dao.error();
    }
 
 private:
 
+   enum delete_step { step_per_row, step_collect_id, step_after_delete };
+
+   static void resolveInputIn(QSqlQuery & query, qx::IxDataMember * pId, const QVariantList & lstIds, long lFirstId, long lCount)
+   {
+      int iNameCount = pId->getNameCount();
+      bool bQuestionMark = (qx::QxSqlDatabase::getSingleton()->getSqlPlaceHolderStyle() == qx::QxSqlDatabase::ph_style_question_mark);
+      for (long n = 0; n < lCount; n++)
+      {
+         QString sAppend = "_" + QString::number(n);
+         for (int i = 0; i < iNameCount; i++)
+         {
+            const QVariant & v = lstIds.at(lFirstId + (n * iNameCount) + i);
+            if (bQuestionMark) { query.addBindValue(v); }
+            else { query.bindValue(pId->getSqlPlaceHolder(sAppend, i, QLatin1String("")), v); }
+         }
+      }
+   }
+
    template <typename U>
-   static inline bool deleteItem(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-   { return deleteItem_Helper<U, std::is_pointer<U>::value || qx::trait::is_smart_ptr<U>::value>::deleteById(item, dao); }
+   static inline bool deleteItem(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+   { return deleteItem_Helper<U, std::is_pointer<U>::value || qx::trait::is_smart_ptr<U>::value>::deleteById(item, dao, eStep, pIds); }
 
    template <typename U, bool bIsPointer /* = true */>
    struct deleteItem_Helper
    {
-      static inline bool deleteById(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return (item ? qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem((* item), dao) : true); }
+      static inline bool deleteById(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+      { return (item ? qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem((* item), dao, eStep, pIds) : true); }
    };
 
    template <typename U1, typename U2>
    struct deleteItem_Helper<std::pair<U1, U2>, false>
    {
-      static inline bool deleteById(std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao); }
+      static inline bool deleteById(std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao, eStep, pIds); }
    };
 
    template <typename U1, typename U2>
    struct deleteItem_Helper<const std::pair<U1, U2>, false>
    {
-      static inline bool deleteById(const std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao); }
+      static inline bool deleteById(const std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao, eStep, pIds); }
    };
 
    template <typename U1, typename U2>
    struct deleteItem_Helper<QPair<U1, U2>, false>
    {
-      static inline bool deleteById(QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao); }
+      static inline bool deleteById(QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao, eStep, pIds); }
    };
 
    template <typename U1, typename U2>
    struct deleteItem_Helper<const QPair<U1, U2>, false>
    {
-      static inline bool deleteById(const QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao); }
+      static inline bool deleteById(const QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
+      { return qx::dao::detail::QxDao_DeleteById_Container<T>::deleteItem(item.second, dao, eStep, pIds); }
    };
 
    template <typename U>
    struct deleteItem_Helper<U, false>
    {
-      static bool deleteById(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
+      static bool deleteById(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, delete_step eStep, QVariantList * pIds)
       {
+         IxSqlGenerator * pSqlGenerator = dao.getSqlGenerator();
+         if (eStep == step_after_delete)
+         {
+            if (pSqlGenerator) { pSqlGenerator->onAfterDelete((& dao), (& item)); }
+            qx::dao::on_after_delete<U>((& item), (& dao));
+            return dao.isValid();
+         }
+
          if (! dao.isValidPrimaryKey(item)) { dao.errInvalidId(); return false; }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -180,10 +253,16 @@ private:
          }
 #endif // _QX_ENABLE_MONGODB
 
-         IxSqlGenerator * pSqlGenerator = dao.getSqlGenerator();
          if (pSqlGenerator) { pSqlGenerator->onBeforeDelete((& dao), (& item)); }
          qx::dao::on_before_delete<U>((& item), (& dao)); if (! dao.isValid()) { return false; }
 
+         if (eStep == step_collect_id)
+         {
+            qx::IxDataMember * pId = dao.getDataId(); if (! pId || ! pIds) { qAssert(false); return false; }
+            for (int i = 0; i < pId->getNameCount(); i++) { pIds->append(pId->toVariant((& item), i, qx::cvt::context::e_database)); }
+            return dao.isValid();
+         }
+
          {
             qx::dao::detail::IxDao_Timer timer((& dao), qx::dao::detail::IxDao_Helper::timer_cpp_read_instance);
             qx::dao::detail::QxSqlQueryHelper_DeleteById<U>::resolveInput(item, dao.query(), dao.builder());
@@ -39,7 +39,7 @@ struct QxDao_ExecuteQuery_Generic
 
    static QSqlError executeQuery(qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "execute custom sql query or stored procedure", new qx::QxSqlQueryBuilder_Count<T>());
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "execute custom sql query or stored procedure", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Count<T> >());
       if (! dao.isValid()) { return dao.error(); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -89,7 +89,7 @@ struct QxDao_ExecuteQuery_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       qx::trait::generic_container<T>::clear(t);
-      qx::IxSqlQueryBuilder * pBuilder = new qx::QxSqlQueryBuilder_Count<type_item>();
+      qx::IxSqlQueryBuilder * pBuilder = qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Count<type_item> >();
       qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "execute custom sql query or stored procedure", pBuilder);
       if (! dao.isValid()) { return dao.error(); }
 
@@ -39,7 +39,7 @@ struct QxDao_Exist_Generic
 
    static qx_bool exist(T & t, QSqlDatabase * pDatabase)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "exist", new qx::QxSqlQueryBuilder_Exist<T>());
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "exist", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Exist<T> >());
       if (! dao.isValid()) { return qx_bool(false); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -75,7 +75,7 @@ struct QxDao_Exist_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return qx_bool(false); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "exist", new qx::QxSqlQueryBuilder_Exist<type_item>());
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "exist", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Exist<type_item> >());
       if (! dao.isValid()) { return qx_bool(false); }
 
 #ifdef _QX_ENABLE_MONGODB
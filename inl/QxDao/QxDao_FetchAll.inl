@@ -39,7 +39,7 @@ struct QxDao_FetchAll_Generic
 
    static QSqlError fetchAll(const qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase, const QStringList & columns)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "fetch all", new qx::QxSqlQueryBuilder_FetchAll<T>(), (& query));
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "fetch all", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchAll<T> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -123,7 +123,7 @@ struct QxDao_FetchAll_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       qx::trait::generic_container<T>::clear(t);
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "fetch all", new qx::QxSqlQueryBuilder_FetchAll<type_item>(), (& query));
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "fetch all", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchAll<type_item> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -0,0 +1,172 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+template <class T>
+struct QxDao_FetchAll_Parallel
+{
+
+   typedef qx::trait::generic_container<T> type_generic_container;
+   typedef typename type_generic_container::type_item type_item;
+   typedef typename type_generic_container::type_value_qx type_value_qx;
+   typedef typename type_generic_container::type_iterator type_iterator;
+
+   static QSqlError fetchAll(const qx::QxSqlQuery & query, T & t, const qx::dao::parallel_fetch & params, QSqlDatabase * pDatabase, const QStringList & columns)
+   {
+      static_assert(qx::trait::is_container<T>::value, "qx::trait::is_container<T>::value");
+
+      qx::IxDataMemberX * pDataMemberX = qx::QxClass<type_value_qx>::getSingleton()->dataMemberX();
+      qx::IxDataMember * pId = (pDataMemberX ? pDataMemberX->getId_WithDaoStrategy() : NULL);
+      QString sColumn = params.m_sPartitionColumn;
+      if (sColumn.isEmpty() && pId && (pId->getNameCount() == 1)) { sColumn = pId->getName(); }
+      if ((params.m_iPartitionCount <= 1) || ! pDataMemberX) { return qx::dao::fetch_by_query(query, t, pDatabase, columns); }
+      if (sColumn.isEmpty() || ! query.isPartitionable())
+      {
+         qDebug("[QxOrm] qx::dao::fetch_by_query_parallel() : '%s'", "query is not split, it requires a partition column and a query built with C++ methods (without LIMIT clause)");
+         return qx::dao::fetch_by_query(query, t, pDatabase, columns);
+      }
+
+      QList<qx::dao::detail::QxDaoParallel_Helper::type_range> lstRanges;
+      QSqlError daoError = qx::dao::detail::QxDaoParallel_Helper::getRanges(pDatabase, pDataMemberX->getName(), sColumn, params.m_iPartitionCount, lstRanges);
+      if (daoError.isValid()) { return daoError; }
+      if (lstRanges.count() <= 1) { return qx::dao::fetch_by_query(query, t, pDatabase, columns); }
+
+      QList<qx::QxSqlQuery> lstQuery;
+      for (int i = 0; i < lstRanges.count(); i++)
+      {
+         qx::QxSqlQuery queryPart(query);
+         queryPart.partition(sColumn, lstRanges.at(i).first, lstRanges.at(i).second);
+         lstQuery.append(queryPart);
+      }
+
+      std::vector<T> lstParts(lstRanges.count());
+      daoError = qx::dao::detail::QxDaoParallel_Helper::run(pDatabase, lstRanges.count(), [&](int i, QSqlDatabase & db) -> QSqlError
+                 { return qx::dao::fetch_by_query(lstQuery.at(i), lstParts[i], (& db), columns); });
+      if (daoError.isValid()) { return daoError; }
+
+      // Parts are disjoint ranges of the partition column : if the query is ordered by this column, parts are just appended (in reverse order for DESC)
+      bool bDescending = false;
+      QStringList lstSortColumns = query.getKeysetColumns(& bDescending);
+      std::vector<qx::IxDataMember *> lstSortMembers;
+      bool bMerge = (params.m_bPreserveOrder && (lstSortColumns.count() > 0) && (getColumnName(lstSortColumns.at(0)).compare(sColumn, Qt::CaseInsensitive) != 0));
+      for (int i = 0; (bMerge && (i < lstSortColumns.count())); i++)
+      {
+         qx::IxDataMember * pMember = findDataMember(pDataMemberX, getColumnName(lstSortColumns.at(i)));
+         if (pMember) { lstSortMembers.push_back(pMember); continue; }
+         qDebug("[QxOrm] qx::dao::fetch_by_query_parallel() : ORDER BY column '%s' is not mapped to a data member, order is not preserved", qPrintable(lstSortColumns.at(i)));
+         bMerge = false;
+      }
+
+      type_generic_container::clear(t);
+      long lSize = 0;
+      for (std::size_t i = 0; i < lstParts.size(); i++) { lSize += type_generic_container::size(lstParts[i]); }
+      type_generic_container::reserve(t, lSize);
+      if (bMerge) { mergeSorted(t, lstParts, lstSortMembers, bDescending); }
+      else if (params.m_bPreserveOrder && bDescending) { for (std::size_t i = lstParts.size(); i > 0; i--) { append(t, lstParts[i - 1]); } }
+      else { for (std::size_t i = 0; i < lstParts.size(); i++) { append(t, lstParts[i]); } }
+
+      return QSqlError();
+   }
+
+private:
+
+   static QString getColumnName(const QString & sColumn)
+   { return sColumn.mid(sColumn.lastIndexOf(QLatin1Char('.')) + 1); }
+
+   static qx::IxDataMember * findDataMember(qx::IxDataMemberX * pDataMemberX, const QString & sColumn)
+   {
+      for (long l = 0; l < pDataMemberX->count_WithDaoStrategy(); l++)
+      {
+         qx::IxDataMember * pMember = pDataMemberX->get_WithDaoStrategy(l);
+         if (pMember && (pMember->getName().compare(sColumn, Qt::CaseInsensitive) == 0)) { return pMember; }
+      }
+      return NULL;
+   }
+
+   static QVariantList readValues(type_item & item, const std::vector<qx::IxDataMember *> & lstMembers)
+   {
+      QVariantList lstValues;
+      for (qx::IxDataMember * pMember : lstMembers) { lstValues.append(pMember->toVariant((& item.value_qx()), -1, qx::cvt::context::e_database)); }
+      return lstValues;
+   }
+
+   static bool isBefore(const QVariantList & lst1, const QVariantList & lst2, bool bDescending)
+   {
+      for (int i = 0; i < lst1.count(); i++)
+      {
+         int iCompare = qx::dao::detail::QxDaoParallel_Helper::compare(lst1.at(i), lst2.at(i));
+         if (iCompare != 0) { return (bDescending ? (iCompare > 0) : (iCompare < 0)); }
+      }
+      return false;
+   }
+
+   static void append(T & t, T & part)
+   {
+      type_item item = type_generic_container::createItem();
+      for (type_iterator itr = type_generic_container::begin(part, item); itr != type_generic_container::end(part); itr = type_generic_container::next(part, itr, item))
+      { type_generic_container::insertItem(t, item); }
+   }
+
+   static void mergeSorted(T & t, std::vector<T> & lstParts, const std::vector<qx::IxDataMember *> & lstMembers, bool bDescending)
+   {
+      // K-way merge : each part is already sorted by the database, ties are taken from the first part to keep a stable order
+      std::vector<type_item> lstItems; std::vector<type_iterator> lstItr; std::vector<QVariantList> lstValues;
+      for (std::size_t i = 0; i < lstParts.size(); i++)
+      {
+         lstItems.push_back(type_generic_container::createItem());
+         lstItr.push_back(type_generic_container::begin(lstParts[i], lstItems.back()));
+         bool bEnd = (lstItr.back() == type_generic_container::end(lstParts[i]));
+         lstValues.push_back(bEnd ? QVariantList() : readValues(lstItems.back(), lstMembers));
+      }
+
+      while (true)
+      {
+         int iBest = -1;
+         for (std::size_t i = 0; i < lstParts.size(); i++)
+         {
+            if (lstItr[i] == type_generic_container::end(lstParts[i])) { continue; }
+            if ((iBest < 0) || isBefore(lstValues[i], lstValues[iBest], bDescending)) { iBest = static_cast<int>(i); }
+         }
+         if (iBest < 0) { break; }
+         type_generic_container::insertItem(t, lstItems[iBest]);
+         lstItr[iBest] = type_generic_container::next(lstParts[iBest], lstItr[iBest], lstItems[iBest]);
+         if (lstItr[iBest] != type_generic_container::end(lstParts[iBest])) { lstValues[iBest] = readValues(lstItems[iBest], lstMembers); }
+      }
+   }
+
+};
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
@@ -42,7 +42,7 @@ struct QxDao_FetchAll_WithRelation_Generic
 
    static QSqlError fetchAll(const QStringList & relation, const qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase)
    {
-      type_dao_helper dao(t, pDatabase, "fetch all with relation", new qx::QxSqlQueryBuilder_FetchAll_WithRelation<T>(), (& query));
+      type_dao_helper dao(t, pDatabase, "fetch all with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchAll_WithRelation<T> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
 
@@ -189,7 +189,7 @@ struct QxDao_FetchAll_WithRelation_Container
    static QSqlError fetchAll(const QStringList & relation, const qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase)
    {
       type_generic_container::clear(t);
-      type_dao_helper dao(t, pDatabase, "fetch all with relation", new qx::QxSqlQueryBuilder_FetchAll_WithRelation<type_value_qx>(), (& query));
+      type_dao_helper dao(t, pDatabase, "fetch all with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchAll_WithRelation<type_value_qx> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
 
@@ -39,7 +39,7 @@ struct QxDao_FetchById_Generic
 
    static QSqlError fetchById(T & t, QSqlDatabase * pDatabase, const QStringList & columns)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "fetch by id", new qx::QxSqlQueryBuilder_FetchById<T>());
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "fetch by id", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchById<T> >());
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.isValidPrimaryKey(t)) { return dao.errInvalidId(); }
 
@@ -93,7 +93,7 @@ struct QxDao_FetchById_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "fetch by id", new qx::QxSqlQueryBuilder_FetchById<type_item>());
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "fetch by id", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchById<type_item> >());
       if (! dao.isValid()) { return dao.error(); }
 
 #ifdef _QX_ENABLE_MONGODB
@@ -218,7 +218,15 @@ struct QxDao_FetchById_Ptr
 {
 
    static inline QSqlError fetchById(T & t, QSqlDatabase * pDatabase, const QStringList & columns)
-   { if (! t) { qx::trait::construct_ptr<T>::get(t); }; return qx::dao::fetch_by_id((* t), pDatabase, columns); }
+   {
+      if (! t) { qx::trait::construct_ptr<T>::get(t); }
+      // Identity map of current qx::QxSession : an instance already fetched with all its columns is shared (no SQL query)
+      typedef qx::dao::detail::QxIdentityMap_Helper<T> type_identity_map;
+      if (columns.isEmpty() && type_identity_map::find(t)) { return QSqlError(); }
+      QSqlError error = qx::dao::fetch_by_id((* t), pDatabase, columns);
+      if (columns.isEmpty() && ! error.isValid()) { type_identity_map::insert(t); }
+      return error;
+   }
 
 };
 
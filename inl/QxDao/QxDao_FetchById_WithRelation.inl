@@ -42,7 +42,7 @@ struct QxDao_FetchById_WithRelation_Generic
 
    static QSqlError fetchById(const QStringList & relation, T & t, QSqlDatabase * pDatabase)
    {
-      type_dao_helper dao(t, pDatabase, "fetch by id with relation", new qx::QxSqlQueryBuilder_FetchById_WithRelation<T>());
+      type_dao_helper dao(t, pDatabase, "fetch by id with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchById_WithRelation<T> >());
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.isValidPrimaryKey(t)) { return dao.errInvalidId(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
@@ -122,7 +122,7 @@ struct QxDao_FetchById_WithRelation_Container
    static QSqlError fetchById(const QStringList & relation, T & t, QSqlDatabase * pDatabase)
    {
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      type_dao_helper dao(t, pDatabase, "fetch by id with relation", new qx::QxSqlQueryBuilder_FetchById_WithRelation<type_value_qx>());
+      type_dao_helper dao(t, pDatabase, "fetch by id with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchById_WithRelation<type_value_qx> >());
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
 
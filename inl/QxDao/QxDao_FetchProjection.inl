@@ -0,0 +1,182 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxDao_Projection_Value : convert SQL columns of a registered property to a value, a property mapped to several columns (composite key for example) is converted column by column (index of name)
+ */
+struct QxDao_Projection_Value
+{
+   template <typename V>
+   static inline void fromQuery(V & v, const QSqlQuery & query, int iIndex, int iCount)
+   {
+      if (iCount <= 1) { qx::cvt::from_variant(query.value(iIndex), v, "", -1, qx::cvt::context::e_database); return; }
+      for (int i = 0; i < iCount; i++) { qx::cvt::from_variant(query.value(iIndex + i), v, "", i, qx::cvt::context::e_database); }
+   }
+};
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxDao_Projection_Row<R> : convert columns of current SQL record to a row of type R (std::tuple, std::pair or 1 value), conversion of each column is resolved at compile-time using qx::cvt::from_variant()
+ */
+template <typename R>
+struct QxDao_Projection_Row
+{
+   enum { column_count = 1 };
+   static inline void fromQuery(R & r, const QSqlQuery & query, const int * pIndex, const int * pCount)
+   { QxDao_Projection_Value::fromQuery(r, query, pIndex[0], pCount[0]); }
+};
+
+template <typename R, std::size_t I, std::size_t N>
+struct QxDao_Projection_Tuple
+{
+   static inline void fromQuery(R & r, const QSqlQuery & query, const int * pIndex, const int * pCount)
+   {
+      QxDao_Projection_Value::fromQuery(std::get<I>(r), query, pIndex[I], pCount[I]);
+      QxDao_Projection_Tuple<R, (I + 1), N>::fromQuery(r, query, pIndex, pCount);
+   }
+};
+
+template <typename R, std::size_t N>
+struct QxDao_Projection_Tuple<R, N, N>
+{
+   static inline void fromQuery(R & r, const QSqlQuery & query, const int * pIndex, const int * pCount)
+   { Q_UNUSED(r); Q_UNUSED(query); Q_UNUSED(pIndex); Q_UNUSED(pCount); }
+};
+
+template <typename... Args>
+struct QxDao_Projection_Row< std::tuple<Args...> >
+{
+   enum { column_count = sizeof...(Args) };
+   static inline void fromQuery(std::tuple<Args...> & r, const QSqlQuery & query, const int * pIndex, const int * pCount)
+   { QxDao_Projection_Tuple<std::tuple<Args...>, 0, sizeof...(Args)>::fromQuery(r, query, pIndex, pCount); }
+};
+
+template <typename A, typename B>
+struct QxDao_Projection_Row< std::pair<A, B> >
+{
+   enum { column_count = 2 };
+   static inline void fromQuery(std::pair<A, B> & r, const QSqlQuery & query, const int * pIndex, const int * pCount)
+   {
+      QxDao_Projection_Value::fromQuery(r.first, query, pIndex[0], pCount[0]);
+      QxDao_Projection_Value::fromQuery(r.second, query, pIndex[1], pCount[1]);
+   }
+};
+
+/*!
+ * \ingroup QxDao
+ * \brief qx::dao::detail::QxDao_Projection_Container<U> : sequence container of rows (std::vector, QVector, std::list, QList, etc.), each row is built in place
+ */
+template <typename U>
+struct QxDao_Projection_Container
+{
+
+   typedef typename U::value_type type_row;
+
+   static inline void clear(U & u) { u.clear(); }
+   static inline void reserve(U & u, long lSize) { reserve_Helper(u, lSize, 0); }
+   static inline type_row & append(U & u) { u.push_back(type_row()); return u.back(); }
+
+private:
+
+   template <typename V>
+   static inline auto reserve_Helper(V & v, long lSize, int) -> decltype(v.reserve(lSize), void()) { v.reserve(lSize); }
+
+   template <typename V>
+   static inline void reserve_Helper(V & v, long lSize, long) { Q_UNUSED(v); Q_UNUSED(lSize); }
+
+};
+
+template <class T, class U>
+struct QxDao_FetchProjection
+{
+
+   typedef QxDao_Projection_Container<U> type_container;
+   typedef typename type_container::type_row type_row;
+   typedef QxDao_Projection_Row<type_row> type_row_helper;
+
+   static QSqlError fetch(const QStringList & columns, const qx::QxSqlQuery & query, U & rows, QSqlDatabase * pDatabase)
+   {
+      static_assert(qx::trait::is_qx_registered<T>::value, "qx::trait::is_qx_registered<T>::value");
+
+      type_container::clear(rows);
+      if (columns.count() != static_cast<int>(type_row_helper::column_count))
+      { return QSqlError("[QxOrm] problem with 'qx::dao::fetch_projection()' method : 'number of columns doesn't match the row type'", "", QSqlError::UnknownError); }
+
+      qx::dao::detail::QxDao_Helper<T> dao(pDatabase, "fetch projection", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_FetchAll<T> >(), (& query));
+      if (! dao.isValid()) { return dao.error(); }
+
+#ifdef _QX_ENABLE_MONGODB
+      if (dao.isMongoDB()) { return dao.updateError(QSqlError("[QxOrm] problem with 'qx::dao::fetch_projection()' method : 'not supported with MongoDB database'", "", QSqlError::UnknownError)); }
+#endif // _QX_ENABLE_MONGODB
+
+      // SQL query built by qx::QxSqlQueryBuilder_FetchAll<T> with a list of columns : primary key first, then each column (except primary key) in the order of the list, each property takes as many SQL columns as its names (getNameCount())
+      std::vector<int> lstIndex(columns.count(), -1);
+      std::vector<int> lstCount(columns.count(), 1);
+      qx::IxDataMember * pId = dao.getDataId();
+      qx::IxDataMemberX * pDataMemberX = dao.getDataMemberX();
+      int iOffset = (pId ? pId->getNameCount() : 0);
+      for (int i = 0; i < columns.count(); i++)
+      {
+         qx::IxDataMember * p = (pDataMemberX ? pDataMemberX->get_WithDaoStrategy(columns.at(i)) : NULL);
+         if (! p) { return dao.updateError(QSqlError("[QxOrm] problem with 'qx::dao::fetch_projection()' method : 'column not registered : " + columns.at(i) + "'", "", QSqlError::UnknownError)); }
+         lstCount[i] = qMax(p->getNameCount(), 1);
+         if (p == pId) { lstIndex[i] = 0; continue; }
+         lstIndex[i] = iOffset; iOffset += lstCount[i];
+      }
+
+      QString sql = dao.builder().buildSql(columns).getSqlQuery();
+      if (sql.isEmpty()) { return dao.errEmpty(); }
+      if (! query.isEmpty()) { dao.addQuery(true); sql = dao.builder().getSqlQuery(); }
+      if (! dao.exec()) { return dao.errFailed(); }
+
+      // Rows are built directly from SQL records : no entity instance, no trigger, no relation
+      if (dao.hasFeature(QSqlDriver::QuerySize) && (dao.query().size() > 0)) { type_container::reserve(rows, dao.query().size()); }
+      const int * pIndex = lstIndex.data();
+      const int * pCount = lstCount.data();
+      while (dao.nextRecord())
+      {
+         qx::dao::detail::IxDao_Timer timer((& dao), qx::dao::detail::IxDao_Helper::timer_cpp_build_instance);
+         type_row_helper::fromQuery(type_container::append(rows), dao.query(), pIndex, pCount);
+      }
+
+      return dao.error();
+   }
+
+};
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
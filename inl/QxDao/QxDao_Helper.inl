@@ -42,6 +42,7 @@ class QxDao_Helper : public IxDao_Helper
 public:
 
    QxDao_Helper(T & t, QSqlDatabase * pDatabase, const QString & sContext, qx::IxSqlQueryBuilder * pBuilder, const qx::QxSqlQuery * pQuery = NULL) : IxDao_Helper(pBuilder, pQuery) { Q_UNUSED(t); init(pDatabase, sContext); }
+   QxDao_Helper(QSqlDatabase * pDatabase, const QString & sContext, qx::IxSqlQueryBuilder * pBuilder, const qx::QxSqlQuery * pQuery = NULL) : IxDao_Helper(pBuilder, pQuery) { init(pDatabase, sContext); }
    virtual ~QxDao_Helper() { static_assert(qx::trait::is_qx_registered<typename qx::QxSqlQueryBuilder<T>::type_sql>::value, "qx::trait::is_qx_registered<typename qx::QxSqlQueryBuilder<T>::type_sql>::value"); }
 
 };
@@ -52,7 +53,7 @@ struct QxDao_Keep_Original
 
 template <typename T>
 struct QxDao_Keep_Original< qx::dao::ptr<T> >
-{ static inline void backup(qx::dao::ptr<T> & t) { if (t) { t.resetOriginal(qx::clone_to_qt_shared_ptr(* t)); } } };
+{ static inline void backup(qx::dao::ptr<T> & t) { if (t) { t.saveToOriginal(); } } };
 
 } // namespace detail
 } // namespace dao
@@ -37,9 +37,10 @@ template <class T>
 struct QxDao_Insert_Generic
 {
 
-   static QSqlError insert(T & t, QSqlDatabase * pDatabase)
+   static QSqlError insert(T & t, QSqlDatabase * pDatabase, bool bMultiRow)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "insert", new qx::QxSqlQueryBuilder_Insert<T>());
+      Q_UNUSED(bMultiRow);
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "insert", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Insert<T> >());
       if (! dao.isValid()) { return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
       if (! dao.validateInstance(t)) { return dao.error(); }
@@ -84,12 +85,12 @@ template <class T>
 struct QxDao_Insert_Container
 {
 
-   static QSqlError insert(T & t, QSqlDatabase * pDatabase)
+   static QSqlError insert(T & t, QSqlDatabase * pDatabase, bool bMultiRow)
    {
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "insert", new qx::QxSqlQueryBuilder_Insert<type_item>());
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "insert", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Insert<type_item> >());
       if (! dao.isValid()) { return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
       if (! dao.validateInstance(t)) { return dao.error(); }
@@ -97,11 +98,11 @@ struct QxDao_Insert_Container
 #ifdef _QX_ENABLE_MONGODB
       if (dao.isMongoDB())
       {
-         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! insertItem((* it), dao)) { return dao.error(); } }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! insertItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
          QStringList & itemsAsJson = dao.itemsAsJson(); QStringList insertedId;
          qx::dao::mongodb::QxMongoDB_Helper::insertMany((& dao), dao.getDataMemberX()->getClass(), itemsAsJson, insertedId); if (! dao.isValid()) { return dao.error(); }
          dao.qxQuery().queryAt(2, "<done>"); dao.itemsAsJson().clear(); dao.itemsAsJson().append(insertedId);
-         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! insertItem((* it), dao)) { return dao.error(); } }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it) { if (! insertItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
          return dao.error();
       }
 #endif // _QX_ENABLE_MONGODB
@@ -111,63 +112,110 @@ struct QxDao_Insert_Container
       if (sql.isEmpty()) { return dao.errEmpty(); }
       if (! pDatabase) { dao.transaction(); }
       if (pSqlGenerator) { pSqlGenerator->checkSqlInsert((& dao), sql); }
-      if (! dao.prepare(sql)) { return dao.errFailed(true); }
 
-      for (typename T::iterator it = t.begin(); it != t.end(); ++it)
-      { if (! insertItem((* it), dao)) { return dao.error(); } }
+      // Multi-row insert (only with qx::dao::insert_multi_row()) : 'INSERT INTO my_table (...) VALUES (...), (...)' chunked to the max bind values and max rows per insert supported by the database
+      // Ids generated by the database (auto-increment) are read back row by row, so they keep one statement per item (as databases without multi-row syntax)
+      qx::IxDataMember * pId = dao.getDataId();
+      bMultiRow = (bMultiRow && pSqlGenerator && pSqlGenerator->getMultiRowInsertSupported() && (! pId || ! pId->getAutoIncrement()));
+      long lBindValues = (bMultiRow ? qx::IxSqlQueryBuilder::getInsertBindValuesCount(dao.builder()) : 0);
+      long lItemsPerQuery = (((lBindValues > 0) && pSqlGenerator) ? static_cast<long>(pSqlGenerator->getMaxBindValues() / lBindValues) : 0);
+      long lMaxRows = (pSqlGenerator ? static_cast<long>(pSqlGenerator->getMaxRowsPerInsert()) : 0);
+      if ((lMaxRows > 0) && (lItemsPerQuery > lMaxRows)) { lItemsPerQuery = lMaxRows; }
+      if ((lItemsPerQuery <= 1) || (qx::trait::generic_container<T>::size(t) <= 1))
+      {
+         if (! dao.prepare(sql)) { return dao.errFailed(true); }
+         for (typename T::iterator it = t.begin(); it != t.end(); ++it)
+         { if (! insertItem((* it), dao, step_per_row, NULL)) { return dao.error(); } }
+         return dao.error();
+      }
+
+      // Triggers are called by chunk : 'on_before_insert' for each item of the chunk, then the multi-row statement, then 'on_after_insert' for each item of the chunk
+      QList<void *> lstItems; long lCurrCount = 0;
+      typename T::iterator itFirst = t.begin();
+      while (itFirst != t.end())
+      {
+         typename T::iterator itLast = itFirst; lstItems.clear();
+         for (; ((itLast != t.end()) && (lstItems.count() < lItemsPerQuery)); ++itLast)
+         { if (! insertItem((* itLast), dao, step_before_insert, (& lstItems))) { return dao.error(); } }
+
+         long lCount = lstItems.count();
+         if (lCount > 0)
+         {
+            if (lCount != lCurrCount)
+            {
+               qx::IxSqlQueryBuilder::sql_Insert_MultiRow(sql, dao.builder(), lCount);
+               dao.builder().setSqlQuery(sql);
+               if (! dao.prepare(sql)) { return dao.errFailed(true); }
+               lCurrCount = lCount;
+            }
+
+            {
+               qx::dao::detail::IxDao_Timer timer((& dao), qx::dao::detail::IxDao_Helper::timer_cpp_read_instance);
+               for (long n = 0; n < lCount; n++) { qx::IxSqlQueryBuilder::resolveInput_Insert_MultiRow(lstItems.at(n), dao.query(), dao.builder(), n); }
+            }
+
+            if (! dao.exec(true)) { return dao.errFailed(); }
+         }
+
+         for (typename T::iterator it = itFirst; it != itLast; ++it)
+         { if (! insertItem((* it), dao, step_after_insert, NULL)) { return dao.error(); } }
+         itFirst = itLast;
+      }
 
       return dao.error();
    }
 
 private:
 
+   enum insert_step { step_per_row, step_before_insert, step_after_insert };
+
    template <typename U>
-   static inline bool insertItem(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
+   static inline bool insertItem(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
    {
-      bool bInsertOk = insertItem_Helper<U, std::is_pointer<U>::value || qx::trait::is_smart_ptr<U>::value>::insert(item, dao);
-      if (bInsertOk) { qx::dao::detail::QxDao_Keep_Original<U>::backup(item); }
+      bool bInsertOk = insertItem_Helper<U, std::is_pointer<U>::value || qx::trait::is_smart_ptr<U>::value>::insert(item, dao, eStep, pItems);
+      if (bInsertOk && (eStep != step_before_insert)) { qx::dao::detail::QxDao_Keep_Original<U>::backup(item); }
       return bInsertOk;
    }
 
    template <typename U, bool bIsPointer /* = true */>
    struct insertItem_Helper
    {
-      static inline bool insert(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return (item ? qx::dao::detail::QxDao_Insert_Container<T>::insertItem((* item), dao) : true); }
+      static inline bool insert(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
+      { return (item ? qx::dao::detail::QxDao_Insert_Container<T>::insertItem((* item), dao, eStep, pItems) : true); }
    };
 
    template <typename U1, typename U2>
    struct insertItem_Helper<std::pair<U1, U2>, false>
    {
-      static inline bool insert(std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao); }
+      static inline bool insert(std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
+      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao, eStep, pItems); }
    };
 
    template <typename U1, typename U2>
    struct insertItem_Helper<const std::pair<U1, U2>, false>
    {
-      static inline bool insert(const std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao); }
+      static inline bool insert(const std::pair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
+      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao, eStep, pItems); }
    };
 
    template <typename U1, typename U2>
    struct insertItem_Helper<QPair<U1, U2>, false>
    {
-      static inline bool insert(QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao); }
+      static inline bool insert(QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
+      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao, eStep, pItems); }
    };
 
    template <typename U1, typename U2>
    struct insertItem_Helper<const QPair<U1, U2>, false>
    {
-      static inline bool insert(const QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
-      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao); }
+      static inline bool insert(const QPair<U1, U2> & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
+      { return qx::dao::detail::QxDao_Insert_Container<T>::insertItem(item.second, dao, eStep, pItems); }
    };
 
    template <typename U>
    struct insertItem_Helper<U, false>
    {
-      static bool insert(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao)
+      static bool insert(U & item, qx::dao::detail::QxDao_Helper_Container<T> & dao, insert_step eStep, QList<void *> * pItems)
       {
 #ifdef _QX_ENABLE_MONGODB
          if (dao.isMongoDB())
@@ -184,8 +232,15 @@ private:
 #endif // _QX_ENABLE_MONGODB
 
          IxSqlGenerator * pSqlGenerator = dao.getSqlGenerator();
+         if (eStep == step_after_insert)
+         {
+            if (pSqlGenerator) { pSqlGenerator->onAfterInsert((& dao), (& item)); }
+            qx::dao::on_after_insert<U>((& item), (& dao)); return dao.isValid();
+         }
+
          if (pSqlGenerator) { pSqlGenerator->onBeforeInsert((& dao), (& item)); }
          qx::dao::on_before_insert<U>((& item), (& dao)); if (! dao.isValid()) { return false; }
+         if (eStep == step_before_insert) { pItems->append(const_cast<void *>(static_cast<const void *>(& item))); return true; }
 
          {
             qx::dao::detail::IxDao_Timer timer((& dao), qx::dao::detail::IxDao_Helper::timer_cpp_read_instance);
@@ -207,8 +262,8 @@ template <class T>
 struct QxDao_Insert_Ptr
 {
 
-   static inline QSqlError insert(T & t, QSqlDatabase * pDatabase)
-   { return (t ? qx::dao::insert((* t), pDatabase) : QSqlError()); }
+   static inline QSqlError insert(T & t, QSqlDatabase * pDatabase, bool bMultiRow)
+   { return (t ? (bMultiRow ? qx::dao::insert_multi_row((* t), pDatabase) : qx::dao::insert((* t), pDatabase)) : QSqlError()); }
 
 };
 
@@ -216,13 +271,13 @@ template <class T>
 struct QxDao_Insert
 {
 
-   static inline QSqlError insert(T & t, QSqlDatabase * pDatabase)
+   static inline QSqlError insert(T & t, QSqlDatabase * pDatabase, bool bMultiRow = false)
    {
       typedef typename std::conditional< std::is_pointer<T>::value, qx::dao::detail::QxDao_Insert_Ptr<T>, qx::dao::detail::QxDao_Insert_Generic<T> >::type type_dao_1;
       typedef typename std::conditional< qx::trait::is_smart_ptr<T>::value, qx::dao::detail::QxDao_Insert_Ptr<T>, type_dao_1 >::type type_dao_2;
       typedef typename std::conditional< qx::trait::is_container<T>::value, qx::dao::detail::QxDao_Insert_Container<T>, type_dao_2 >::type type_dao_3;
 
-      QSqlError error = type_dao_3::insert(t, pDatabase);
+      QSqlError error = type_dao_3::insert(t, pDatabase, bMultiRow);
       if (! error.isValid()) { qx::dao::detail::QxDao_Keep_Original<T>::backup(t); }
       return error;
    }
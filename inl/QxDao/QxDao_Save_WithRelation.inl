@@ -39,7 +39,7 @@ struct QxDao_Save_WithRelation_Generic
 
    static QSqlError save(const QStringList & relation, T & t, QSqlDatabase * pDatabase)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "save with relation", new qx::QxSqlQueryBuilder_Update<T>());
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "save with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<T> >());
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
       if (! pDatabase) { dao.transaction(); }
@@ -64,7 +64,7 @@ struct QxDao_Save_WithRelation_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "save with relation", new qx::QxSqlQueryBuilder_Update<type_item>());
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "save with relation", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<type_item> >());
       if (! dao.isValid()) { return dao.error(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
       if (! pDatabase) { dao.transaction(); }
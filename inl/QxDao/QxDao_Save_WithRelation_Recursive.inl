@@ -43,7 +43,7 @@ struct QxDao_Save_WithRelation_Recursive_Generic
        qx::dao::detail::QxDao_Helper<T> dao(t,
                                             pDatabase,
                                             "save with relation recursive",
-                                            new qx::QxSqlQueryBuilder_Update<T>());
+                                            qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<T> >());
        if (!dao.isValid()) {
            return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
@@ -92,7 +92,7 @@ struct QxDao_Save_WithRelation_Recursive_Container
 
       QStringList relation(QStringLiteral("*"));
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "save with relation recursive", new qx::QxSqlQueryBuilder_Update<type_item>());
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "save with relation recursive", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<type_item> >());
       if (! dao.isValid()) { return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
       if (! dao.updateSqlRelationX(relation)) { return dao.errInvalidRelation(); }
@@ -39,7 +39,7 @@ struct QxDao_Update_Generic
 
    static QSqlError update(const qx::QxSqlQuery & query, T & t, QSqlDatabase * pDatabase, const QStringList & columns)
    {
-      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "update", new qx::QxSqlQueryBuilder_Update<T>(), (& query));
+      qx::dao::detail::QxDao_Helper<T> dao(t, pDatabase, "update", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<T> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
       if (! dao.isValidPrimaryKey(t)) { return dao.errInvalidId(); }
@@ -90,7 +90,7 @@ struct QxDao_Update_Container
       typedef typename qx::trait::generic_container<T>::type_value_qx type_item;
 
       if (qx::trait::generic_container<T>::size(t) <= 0) { return QSqlError(); }
-      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "update", new qx::QxSqlQueryBuilder_Update<type_item>(), (& query));
+      qx::dao::detail::QxDao_Helper_Container<T> dao(t, pDatabase, "update", qx::dao::detail::IxDao_Recycler::builder< qx::QxSqlQueryBuilder_Update<type_item> >(), (& query));
       if (! dao.isValid()) { return dao.error(); }
       if (dao.isReadOnly()) { return dao.errReadOnly(); }
       if (! dao.validateInstance(t)) { return dao.error(); }
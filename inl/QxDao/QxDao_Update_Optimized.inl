@@ -53,7 +53,10 @@ struct QxDao_Update_Optimized_Container
    static inline QSqlError update_optimized(const qx::QxSqlQuery & query, qx::dao::ptr<T> & ptr, QSqlDatabase * pDatabase)
    {
       if (ptr.isNull() || (qx::trait::generic_container<T>::size(* ptr) <= 0)) { return QSqlError(); }
-      if (! ptr.getOriginal() || (qx::trait::generic_container<T>::size(* ptr) != qx::trait::generic_container<T>::size(* ptr.getOriginal())))
+      qx::dao::detail::QxDao_Snapshot_ptr pSnapshot = (ptr.getOriginal() ? qx::dao::detail::QxDao_Snapshot_ptr() : ptr.getSnapshot());
+      if (pSnapshot && (static_cast<long>(qx::trait::generic_container<T>::size(* ptr)) != static_cast<long>(pSnapshot->count())))
+      { return qx::dao::update_by_query(query, (* ptr), pDatabase); }
+      else if (! pSnapshot && (! ptr.getOriginal() || (qx::trait::generic_container<T>::size(* ptr) != qx::trait::generic_container<T>::size(* ptr.getOriginal()))))
       { return qx::dao::update_by_query(query, (* ptr), pDatabase); }
 
       QStringList lstDiffItem; QSqlError errorItem;
@@ -70,14 +73,17 @@ struct QxDao_Update_Optimized_Container
          if (! pDatabase) { db.transaction(); }
       }
 
-      typename T::const_iterator it2 = ptr.getOriginal()->begin();
+      int iCurrIndex = 0;
+      typename T::const_iterator it2 = (pSnapshot ? typename T::const_iterator() : ptr.getOriginal()->begin());
       for (typename T::const_iterator it1 = ptr->begin(); it1 != ptr->end(); ++it1)
       {
          lstDiffItem.clear();
-         qx::dao::detail::is_dirty((* it1), (* it2), lstDiffItem);
+         if (pSnapshot) { qx::dao::detail::snapshot_compare_item((* it1), pSnapshot->at(iCurrIndex), lstDiffItem); }
+         else { qx::dao::detail::is_dirty((* it1), (* it2), lstDiffItem); }
          if (lstDiffItem.count() > 0) { errorItem = qx::dao::update_by_query(query, (* it1), (& db), lstDiffItem); }
          if (errorItem.isValid()) { break; }
-         else { ++it2; }
+         else if (! pSnapshot) { ++it2; }
+         ++iCurrIndex;
       }
 
       if (bCheckDatabaseTransaction)
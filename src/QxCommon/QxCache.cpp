@@ -45,6 +45,9 @@ QxCache::QxCache()
     : qx::QxSingleton<QxCache>(QStringLiteral("qx::cache::detail::QxCache"))
     , m_lMaxCost(999999999)
     , m_lCurrCost(0)
+    , m_lHitCount(0)
+    , m_lMissCount(0)
+    , m_lEvictionCount(0)
 {
     ;
 }
@@ -73,6 +76,24 @@ bool QxCache::exist(const QString & sKey) const {
 bool QxCache::contains(const QString & sKey) const {
     return this->exist(sKey); }
 
+qlonglong QxCache::getHitCount()
+{
+   QMutexLocker locker(& m_oMutexCache);
+   return m_lHitCount;
+}
+
+qlonglong QxCache::getMissCount()
+{
+   QMutexLocker locker(& m_oMutexCache);
+   return m_lMissCount;
+}
+
+qlonglong QxCache::getEvictionCount()
+{
+   QMutexLocker locker(& m_oMutexCache);
+   return m_lEvictionCount;
+}
+
 void QxCache::setMaxCost(long l)
 {
    QMutexLocker locker(& m_oMutexCache);
@@ -83,8 +104,9 @@ void QxCache::setMaxCost(long l)
 qx::any QxCache::at(const QString & sKey)
 {
    QMutexLocker locker(& m_oMutexCache);
-   if (! this->exist(sKey)) { return qx::any();
+   if (! this->exist(sKey)) { m_lMissCount++; return qx::any();
    }
+   m_lHitCount++;
    return std::get<2>(m_cache.getByKey(sKey));
 }
 
@@ -149,6 +171,7 @@ void QxCache::updateCost()
       long lCost = std::get<0>(m_cache.getByIndex(0));
       m_cache.removeByIndex(0);
       m_lCurrCost -= lCost;
+      m_lEvictionCount++;
       QString sMsg = QString(QStringLiteral("qx::cache : auto remove object in cache '")) + sKey
                      + QString(QStringLiteral("'"));
       qDebug("[QxOrm] %s", qPrintable(sMsg));
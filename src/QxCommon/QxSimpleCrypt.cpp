@@ -30,12 +30,104 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qcryptographichash.h>
+#include <QtCore/qendian.h>
+
+#include <cstring>
 
 #include <QxCommon/QxSimpleCrypt.h>
 
 #include <QxMemLeak/mem_leak.h>
 
 namespace qx {
+namespace detail {
+
+/*
+ * Data are processed 8 bytes at a time (same format as the original byte-wise algorithm) :
+ *  - the key is a 64 bits word (byte i of the key is used for position i % 8), rotated to start at any position ;
+ *  - encryption is a chained XOR (c[i] = p[i] ^ k[i] ^ c[i-1]), so each word is a prefix XOR computed with 3 shifts, then XORed with the last encrypted byte ;
+ *  - decryption has no dependency between bytes (p[i] = c[i] ^ c[i-1] ^ k[i]) ;
+ *  - checksum is the same CRC-16 as qChecksum() (ISO 3309), computed 8 bytes at a time (slicing-by-8 tables) and during decryption.
+ */
+
+struct QxSimpleCrypt_CrcTable
+{
+   quint16 t[8][256];
+   QxSimpleCrypt_CrcTable()
+   {
+      for (int n = 0; n < 256; n++) { quint16 c = static_cast<quint16>(n); for (int k = 0; k < 8; k++) { c = ((c & 1) ? ((c >> 1) ^ 0x8408) : (c >> 1)); } t[0][n] = c; }
+      for (int k = 1; k < 8; k++) { for (int n = 0; n < 256; n++) { t[k][n] = ((t[k - 1][n] >> 8) ^ t[0][t[k - 1][n] & 0xFF]); } }
+   }
+};
+
+static const QxSimpleCrypt_CrcTable & crcTable() { static const QxSimpleCrypt_CrcTable table; return table; }
+
+static inline quint16 crcWord(quint16 crc, quint64 w, const QxSimpleCrypt_CrcTable & tbl)
+{
+   w ^= crc;
+   return (tbl.t[7][w & 0xFF] ^ tbl.t[6][(w >> 8) & 0xFF] ^ tbl.t[5][(w >> 16) & 0xFF] ^ tbl.t[4][(w >> 24) & 0xFF] ^
+           tbl.t[3][(w >> 32) & 0xFF] ^ tbl.t[2][(w >> 40) & 0xFF] ^ tbl.t[1][(w >> 48) & 0xFF] ^ tbl.t[0][w >> 56]);
+}
+
+static quint16 checksum(const uchar * data, int size)
+{
+   const QxSimpleCrypt_CrcTable & tbl = crcTable();
+   quint16 crc = 0xFFFF; int i = 0;
+   for (; (i + 8) <= size; i += 8) { crc = crcWord(crc, qFromLittleEndian<quint64>(data + i), tbl); }
+   for (; i < size; ++i) { crc = ((crc >> 8) ^ tbl.t[0][(crc ^ data[i]) & 0xFF]); }
+   return static_cast<quint16>(~crc & 0xFFFF); // same value as qChecksum()
+}
+
+static inline quint64 keyAt(quint64 key, int pos)
+{
+   int r = ((pos & 7) * 8);
+   return (r ? ((key >> r) | (key << (64 - r))) : key);
+}
+
+static void encryptBuffer(const uchar * src, uchar * dst, int size, int pos, quint64 key, uchar & last)
+{
+   key = keyAt(key, pos); int i = 0;
+   for (; (i + 8) <= size; i += 8)
+   {
+      quint64 w = (qFromLittleEndian<quint64>(src + i) ^ key);
+      w ^= (w << 8); w ^= (w << 16); w ^= (w << 32);
+      w ^= (static_cast<quint64>(last) * Q_UINT64_C(0x0101010101010101));
+      qToLittleEndian<quint64>(w, (dst + i));
+      last = static_cast<uchar>(w >> 56);
+   }
+   for (int j = 0; i < size; ++i, ++j)
+   { last = static_cast<uchar>(src[i] ^ static_cast<uchar>(key >> (8 * j)) ^ last); dst[i] = last; }
+}
+
+static void decryptBuffer(const uchar * src, uchar * dst, int size, int pos, quint64 key, uchar & last, quint16 * pCrc)
+{
+   // 'src' and 'dst' can be the same buffer (decryption in place)
+   const QxSimpleCrypt_CrcTable & tbl = crcTable();
+   key = keyAt(key, pos); int i = 0;
+   for (; (i + 8) <= size; i += 8)
+   {
+      quint64 c = qFromLittleEndian<quint64>(src + i);
+      quint64 p = (c ^ ((c << 8) | last) ^ key);
+      last = static_cast<uchar>(c >> 56);
+      qToLittleEndian<quint64>(p, (dst + i));
+      if (pCrc) { (* pCrc) = crcWord((* pCrc), p, tbl); }
+   }
+   for (int j = 0; i < size; ++i, ++j)
+   {
+      uchar c = src[i];
+      dst[i] = static_cast<uchar>(c ^ last ^ static_cast<uchar>(key >> (8 * j)));
+      last = c;
+      if (pCrc) { (* pCrc) = (((* pCrc) >> 8) ^ tbl.t[0][((* pCrc) ^ dst[i]) & 0xFF]); }
+   }
+}
+
+static inline int integritySize(QxSimpleCrypt::CryptoFlags flags)
+{
+   if (flags.testFlag(QxSimpleCrypt::CryptoFlagChecksum)) { return 2; }
+   else if (flags.testFlag(QxSimpleCrypt::CryptoFlagHash)) { return 20; }
+   return 0;
+}
+
+} // namespace detail
 
 QxSimpleCrypt::QxSimpleCrypt():
    m_key(0),
@@ -89,50 +181,47 @@ QByteArray QxSimpleCrypt::encryptToByteArray(const QByteArray &plaintext)
      return QByteArray();
    }
 
-   QByteArray ba = plaintext;
+   QByteArray compressed;
+   const QByteArray * ba = (& plaintext);
 
    CryptoFlags flags = CryptoFlagNone;
    if (m_compressionMode == CompressionAlways) {
-     ba = qCompress(ba, 9); //maximum compression
+     compressed = qCompress(plaintext, 9); //maximum compression
+     ba = (& compressed);
      flags |= CryptoFlagCompression;
    } else if (m_compressionMode == CompressionAuto) {
-     QByteArray compressed = qCompress(ba, 9);
-     if (compressed.count() < ba.count()) {
-         ba = compressed;
+     compressed = qCompress(plaintext, 9);
+     if (compressed.count() < plaintext.count()) {
+         ba = (& compressed);
          flags |= CryptoFlagCompression;
      }
    }
 
-   QByteArray integrityProtection;
+   //random char + integrity protection (encrypted before the plain text)
+   uchar head[21];
+   head[0] = static_cast<uchar>(qrand() & 0xFF);
+   const uchar * plain = reinterpret_cast<const uchar *>(ba->constData());
    if (m_protectionMode == ProtectionChecksum) {
        flags |= CryptoFlagChecksum;
-       QDataStream s(&integrityProtection, QIODevice::WriteOnly);
-       s << qChecksum(ba.constData(), ba.length());
+       qToBigEndian<quint16>(detail::checksum(plain, ba->size()), (head + 1));
    } else if (m_protectionMode == ProtectionHash) {
        flags |= CryptoFlagHash;
        QCryptographicHash hash(QCryptographicHash::Sha1);
-       hash.addData(ba);
-       integrityProtection += hash.result();
+       hash.addData(* ba);
+       QByteArray result = hash.result();
+       ::memcpy((head + 1), result.constData(), 20);
    }
 
-   //prepend a random char to the string
-   char randomChar = char(qrand() & 0xFF);
-   ba = randomChar + integrityProtection + ba;
+   //version + flags + encrypted data are written in a single buffer (no intermediate copy)
+   int iHeadSize = (1 + detail::integritySize(flags));
+   QByteArray resultArray(2 + iHeadSize + ba->size(), Qt::Uninitialized);
+   resultArray[0] = char(0x03);  //version for future updates to algorithm
+   resultArray[1] = char(flags); //encryption flags
 
-   int pos(0);
-   char lastChar(0);
-   int cnt = ba.count();
-
-   while (pos < cnt) {
-     ba[pos] = ba.at(pos) ^ m_keyParts.at(pos % 8) ^ lastChar;
-     lastChar = ba.at(pos);
-     ++pos;
-   }
-
-   QByteArray resultArray;
-   resultArray.append(char(0x03));  //version for future updates to algorithm
-   resultArray.append(char(flags)); //encryption flags
-   resultArray.append(ba);
+   uchar lastChar = 0;
+   uchar * dst = reinterpret_cast<uchar *>(resultArray.data() + 2);
+   detail::encryptBuffer(head, dst, iHeadSize, 0, m_key, lastChar);
+   detail::encryptBuffer(plain, (dst + iHeadSize), ba->size(), iHeadSize, m_key, lastChar);
 
    m_lastError = ErrorNoError;
    return resultArray;
@@ -176,73 +265,90 @@ QByteArray QxSimpleCrypt::decryptToByteArray(const QString& cyphertext)
 }
 
 QByteArray QxSimpleCrypt::decryptToByteArray(const QByteArray &cypher)
+{
+   int iPlainSize = 0; int iHeadSize = 0; CryptoFlags flags = CryptoFlagNone;
+   if (! checkCypher(cypher.constData(), cypher.size(), flags, iHeadSize, iPlainSize)) {
+     return QByteArray();
+   }
+
+   QByteArray ba(iPlainSize, Qt::Uninitialized);
+   if (! decryptData(cypher.constData(), iHeadSize, iPlainSize, flags, ba.data())) {
+     return QByteArray();
+   }
+
+   if (flags.testFlag(CryptoFlagCompression))
+     ba = qUncompress(ba);
+
+   m_lastError = ErrorNoError;
+   return ba;
+}
+
+QByteArray QxSimpleCrypt::decryptInPlace(char * cypher, int size)
+{
+   int iPlainSize = 0; int iHeadSize = 0; CryptoFlags flags = CryptoFlagNone;
+   if (! checkCypher(cypher, size, flags, iHeadSize, iPlainSize)) {
+     return QByteArray();
+   }
+
+   char * plain = (cypher + 2 + iHeadSize);
+   if (! decryptData(cypher, iHeadSize, iPlainSize, flags, plain)) {
+     return QByteArray();
+   }
+
+   m_lastError = ErrorNoError;
+   if (flags.testFlag(CryptoFlagCompression))
+     return qUncompress(reinterpret_cast<const uchar *>(plain), iPlainSize);
+   return QByteArray::fromRawData(plain, iPlainSize);
+}
+
+bool QxSimpleCrypt::checkCypher(const char * cypher, int size, CryptoFlags & flags, int & headSize, int & plainSize)
 {
    if (m_keyParts.isEmpty()) {
      qWarning() << "No key set.";
      m_lastError = ErrorNoKeySet;
-     return QByteArray();
+     return false;
    }
 
-   QByteArray ba = cypher;
-   char version = ba.at(0);
-
-   if (version !=3) {  //we only work with version 3
+   if ((! cypher) || (size < 3) || (cypher[0] != 3)) {  //we only work with version 3
      m_lastError = ErrorUnknownVersion;
      qWarning() << "Invalid version or not a cyphertext.";
-     return QByteArray();
+     return false;
    }
 
-   CryptoFlags flags = CryptoFlags(ba.at(1));
-   ba = ba.mid(2);
-   int pos(0);
-   int cnt(ba.count());
-   char lastChar = 0;
-
-   while (pos < cnt) {
-     char currentChar = ba[pos];
-     ba[pos] = ba.at(pos) ^ lastChar ^ m_keyParts.at(pos % 8);
-     lastChar = currentChar;
-     ++pos;
+   flags = CryptoFlags(cypher[1]);
+   headSize = (1 + detail::integritySize(flags)); //random char + integrity protection
+   plainSize = (size - 2 - headSize);
+   if (plainSize < 0) {
+     m_lastError = ErrorIntegrityFailed;
+     return false;
    }
+   return true;
+}
 
-   ba = ba.mid(1); //chop off the random number at the start
+bool QxSimpleCrypt::decryptData(const char * cypher, int headSize, int plainSize, CryptoFlags flags, char * plain)
+{
+   //'plain' can point to the cypher text itself (decryption in place)
+   uchar head[21]; uchar lastChar = 0; quint16 crc = 0xFFFF;
+   const uchar * src = reinterpret_cast<const uchar *>(cypher + 2);
+   bool bChecksum = flags.testFlag(CryptoFlagChecksum);
+   detail::decryptBuffer(src, head, headSize, 0, m_key, lastChar, NULL);
+   detail::decryptBuffer((src + headSize), reinterpret_cast<uchar *>(plain), plainSize, headSize, m_key, lastChar, (bChecksum ? (& crc) : NULL));
 
    bool integrityOk(true);
-   if (flags.testFlag(CryptoFlagChecksum)) {
-     if (ba.length() < 2) {
-         m_lastError = ErrorIntegrityFailed;
-         return QByteArray();
-     }
-     quint16 storedChecksum;
-     {
-         QDataStream s(&ba, QIODevice::ReadOnly);
-         s >> storedChecksum;
-     }
-     ba = ba.mid(2);
-     quint16 checksum = qChecksum(ba.constData(), ba.length());
-     integrityOk = (checksum == storedChecksum);
+   if (bChecksum) {
+     quint16 storedChecksum = qFromBigEndian<quint16>(head + 1);
+     integrityOk = (static_cast<quint16>(~crc & 0xFFFF) == storedChecksum);
    } else if (flags.testFlag(CryptoFlagHash)) {
-     if (ba.length() < 20) {
-         m_lastError = ErrorIntegrityFailed;
-         return QByteArray();
-     }
-     QByteArray storedHash = ba.left(20);
-     ba = ba.mid(20);
      QCryptographicHash hash(QCryptographicHash::Sha1);
-     hash.addData(ba);
-     integrityOk = (hash.result() == storedHash);
+     hash.addData(plain, plainSize);
+     integrityOk = (hash.result() == QByteArray::fromRawData(reinterpret_cast<const char *>(head + 1), 20));
    }
 
    if (!integrityOk) {
      m_lastError = ErrorIntegrityFailed;
-     return QByteArray();
+     return false;
    }
-
-   if (flags.testFlag(CryptoFlagCompression))
-     ba = qUncompress(ba);
-
-   m_lastError = ErrorNoError;
-   return ba;
+   return true;
 }
 
 } // namespace qx
@@ -0,0 +1,474 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <QxCommon/QxTrace.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxTrace)
+
+#define QX_TRACE_SAMPLING_MAX 1000000
+
+namespace qx {
+
+// Read for each span : no thread storage lookup while tracing is disabled
+static QAtomicInt g_iTraceEnabled(0);
+
+// Sampling rate (per million) : read for each root span without locking any mutex
+static QAtomicInt g_iTraceSamplingRate(QX_TRACE_SAMPLING_MAX);
+
+struct QxTrace_ThreadData
+{
+   QxTrace::type_context m_context;    //!< Current span context of the thread
+   quint64 m_iRandom;                  //!< Random generator state of the thread (to build ids and take sampling decisions)
+   QxTrace_ThreadData() : m_iRandom(0) { ; }
+};
+
+static QxTrace_ThreadData & getTraceThreadData()
+{
+   static QThreadStorage<QxTrace_ThreadData> storage;
+   return storage.localData();
+}
+
+struct QxTrace_Clock
+{
+   QElapsedTimer m_timer; qint64 m_iEpoch;
+   QxTrace_Clock() : m_iEpoch(QDateTime::currentMSecsSinceEpoch() * Q_INT64_C(1000000)) { m_timer.start(); }
+   qint64 now() const { return (m_iEpoch + m_timer.nsecsElapsed()); }
+};
+
+static const QxTrace_Clock & getTraceClock()
+{
+   static QxTrace_Clock clock;
+   return clock;
+}
+
+static quint64 getTraceThreadId() { return static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId())); }
+
+static quint64 getTraceRandom()
+{
+   // splitmix64 generator : good enough to build unique ids and to take sampling decisions
+   QxTrace_ThreadData & data = getTraceThreadData();
+   if (data.m_iRandom == 0) { data.m_iRandom = (static_cast<quint64>(getTraceClock().now()) ^ (getTraceThreadId() * Q_UINT64_C(0x9E3779B97F4A7C15))); }
+   quint64 z = (data.m_iRandom += Q_UINT64_C(0x9E3779B97F4A7C15));
+   z = ((z ^ (z >> 30)) * Q_UINT64_C(0xBF58476D1CE4E5B9));
+   z = ((z ^ (z >> 27)) * Q_UINT64_C(0x94D049BB133111EB));
+   z = (z ^ (z >> 31));
+   return (z ? z : 1);
+}
+
+static QByteArray toHex(quint64 i) { return QByteArray::number(i, 16).rightJustified(16, '0'); }
+
+static QByteArray toJsonString(const QString & s)
+{
+   QByteArray out; out.reserve(s.size() + 2); out += '"';
+   QByteArray utf8 = s.toUtf8();
+   for (int i = 0; i < utf8.size(); i++)
+   {
+      char c = utf8.at(i);
+      switch (c)
+      {
+         case '"':   out += "\\\""; break;
+         case '\\':  out += "\\\\"; break;
+         case '\n':  out += "\\n"; break;
+         case '\r':  out += "\\r"; break;
+         case '\t':  out += "\\t"; break;
+         default:
+            if ((c >= 0) && (c < 0x20)) { out += "\\u00"; out += QByteArray::number(static_cast<int>(c), 16).rightJustified(2, '0'); }
+            else { out += c; }
+            break;
+      }
+   }
+   out += '"';
+   return out;
+}
+
+static bool isTraceNumber(const QVariant & v)
+{
+   int iType = static_cast<int>(v.type());
+   return ((iType == QMetaType::Int) || (iType == QMetaType::UInt) || (iType == QMetaType::LongLong) || (iType == QMetaType::ULongLong) || (iType == QMetaType::Long));
+}
+
+// Chrome trace-event format : 1 complete event ('X') by span, times in micro-seconds
+static QByteArray toChromeEvent(const QxTrace::type_span & span, qint64 iPid)
+{
+   QByteArray out; out.reserve(256);
+   out += "{\"name\":"; out += toJsonString(span.m_sName);
+   out += ",\"cat\":"; out += toJsonString(span.m_sCategory);
+   out += ",\"ph\":\"X\",\"ts\":"; out += QByteArray::number(span.m_iStart / 1000); out += "."; out += QByteArray::number(span.m_iStart % 1000).rightJustified(3, '0');
+   out += ",\"dur\":"; out += QByteArray::number(span.m_iDuration / 1000); out += "."; out += QByteArray::number(span.m_iDuration % 1000).rightJustified(3, '0');
+   out += ",\"pid\":"; out += QByteArray::number(iPid);
+   out += ",\"tid\":"; out += QByteArray::number(span.m_iThreadId);
+   out += ",\"args\":{\"trace_id\":\""; out += toHex(span.m_context.m_iTraceIdHigh); out += toHex(span.m_context.m_iTraceIdLow);
+   out += "\",\"span_id\":\""; out += toHex(span.m_context.m_iSpanId); out += "\"";
+   if (span.m_iParentSpanId != 0) { out += ",\"parent_span_id\":\""; out += toHex(span.m_iParentSpanId); out += "\""; }
+   if (span.m_bError) { out += ",\"error\":true"; }
+   for (const QPair<QString, QVariant> & attr : span.m_lstAttributes)
+   {
+      out += ","; out += toJsonString(attr.first); out += ":";
+      if (attr.second.type() == QVariant::Bool) { out += (attr.second.toBool() ? "true" : "false"); }
+      else if (isTraceNumber(attr.second)) { out += QByteArray::number(attr.second.toLongLong()); }
+      else if (attr.second.type() == QVariant::Double) { out += QByteArray::number(attr.second.toDouble(), 'g', 15); }
+      else { out += toJsonString(attr.second.toString()); }
+   }
+   out += "}}";
+   return out;
+}
+
+// OTLP-JSON format (OpenTelemetry protocol, JSON encoding) : ids in hexadecimal, times in nano-seconds since epoch
+static QByteArray toOtlpSpan(const QxTrace::type_span & span)
+{
+   QByteArray out; out.reserve(384);
+   out += "{\"traceId\":\""; out += toHex(span.m_context.m_iTraceIdHigh); out += toHex(span.m_context.m_iTraceIdLow);
+   out += "\",\"spanId\":\""; out += toHex(span.m_context.m_iSpanId); out += "\"";
+   if (span.m_iParentSpanId != 0) { out += ",\"parentSpanId\":\""; out += toHex(span.m_iParentSpanId); out += "\""; }
+   out += ",\"name\":"; out += toJsonString(span.m_sName);
+   out += ",\"kind\":"; out += ((span.m_sCategory == QLatin1String("transaction")) ? "2" : "1"); // SPAN_KIND_SERVER or SPAN_KIND_INTERNAL
+   out += ",\"startTimeUnixNano\":\""; out += QByteArray::number(span.m_iStart);
+   out += "\",\"endTimeUnixNano\":\""; out += QByteArray::number(span.m_iStart + span.m_iDuration);
+   out += "\",\"attributes\":[{\"key\":\"qx.category\",\"value\":{\"stringValue\":"; out += toJsonString(span.m_sCategory); out += "}}";
+   out += ",{\"key\":\"thread.id\",\"value\":{\"intValue\":\""; out += QByteArray::number(span.m_iThreadId); out += "\"}}";
+   for (const QPair<QString, QVariant> & attr : span.m_lstAttributes)
+   {
+      out += ",{\"key\":"; out += toJsonString(attr.first); out += ",\"value\":{";
+      if (attr.second.type() == QVariant::Bool) { out += "\"boolValue\":"; out += (attr.second.toBool() ? "true" : "false"); }
+      else if (isTraceNumber(attr.second)) { out += "\"intValue\":\""; out += QByteArray::number(attr.second.toLongLong()); out += "\""; }
+      else if (attr.second.type() == QVariant::Double) { out += "\"doubleValue\":"; out += QByteArray::number(attr.second.toDouble(), 'g', 15); }
+      else { out += "\"stringValue\":"; out += toJsonString(attr.second.toString()); }
+      out += "}}";
+   }
+   out += "]";
+   if (span.m_bError) { out += ",\"status\":{\"code\":2}"; } // STATUS_CODE_ERROR
+   out += "}";
+   return out;
+}
+
+// File sink : Chrome trace is written in 'JSON array format' (closing bracket is optional, so the file can be read while it is written), OTLP-JSON is written with 1 line by batch (like OpenTelemetry collector file exporter)
+struct QxTrace_FileSink
+{
+   QMutex m_mutex;
+   QFile m_file;
+   QxTrace::export_format m_eFormat;
+   bool m_bFirstEvent;
+
+   QxTrace_FileSink(const QString & sFileName, QxTrace::export_format eFormat) : m_file(sFileName), m_eFormat(eFormat), m_bFirstEvent(true) { ; }
+   ~QxTrace_FileSink() { if (m_file.isOpen() && (m_eFormat == QxTrace::format_chrome_trace)) { m_file.write("\n]\n"); } }
+
+   bool open()
+   {
+      if (! m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { return false; }
+      if (m_eFormat == QxTrace::format_chrome_trace) { m_file.write("[\n"); }
+      return true;
+   }
+
+   void write(const QxTrace::type_span_list & lst)
+   {
+      QMutexLocker locker(& m_mutex);
+      if (m_eFormat == QxTrace::format_otlp_json)
+      {
+         m_file.write(QxTrace::toOtlpJson(lst, QxTrace::getSingleton()->getServiceName()));
+         m_file.write("\n");
+      }
+      else
+      {
+         qint64 iPid = QCoreApplication::applicationPid();
+         for (const QxTrace::type_span & span : lst)
+         {
+            if (! m_bFirstEvent) { m_file.write(",\n"); }
+            m_file.write(toChromeEvent(span, iPid));
+            m_bFirstEvent = false;
+         }
+      }
+      m_file.flush();
+   }
+};
+
+struct QxTrace::QxTraceImpl
+{
+
+   QMutex m_mutex;                              //!< Mutex to protect pending spans and settings
+   QxTrace::type_span_list m_lstPending;        //!< Spans ended and not exported yet
+   QxTrace::type_fct_sink m_fctSink;            //!< Sink to export spans (by batch)
+   int m_iBatchSize;                            //!< Number of spans to export together
+   QString m_sServiceName;                      //!< Service name (OTLP-JSON resource attribute 'service.name')
+
+   QxTraceImpl() : m_iBatchSize(256) { ; }
+   ~QxTraceImpl() { ; }
+
+   void exportSpans(bool bForce)
+   {
+      QxTrace::type_span_list lst; QxTrace::type_fct_sink fct;
+      {
+         QMutexLocker locker(& m_mutex);
+         if (m_lstPending.isEmpty() || ((! bForce) && (m_lstPending.count() < m_iBatchSize))) { return; }
+         lst.swap(m_lstPending); fct = m_fctSink;
+      }
+      if (fct) { fct(lst); }
+   }
+
+};
+
+QxTrace::QxTrace() : QxSingleton<QxTrace>(QStringLiteral("qx::QxTrace")), m_pImpl(new QxTraceImpl())
+{
+   m_pImpl->m_sServiceName = (QCoreApplication::applicationName().isEmpty() ? QStringLiteral("QxOrm") : QCoreApplication::applicationName());
+}
+
+QxTrace::~QxTrace() { flush(); }
+
+bool QxTrace::isEnabled() { return (g_iTraceEnabled.loadAcquire() != 0); }
+
+void QxTrace::setEnabled(bool b) { g_iTraceEnabled.storeRelease(b ? 1 : 0); }
+
+double QxTrace::getSamplingRate() const { return (static_cast<double>(g_iTraceSamplingRate.loadAcquire()) / static_cast<double>(QX_TRACE_SAMPLING_MAX)); }
+
+void QxTrace::setSamplingRate(double d)
+{
+   d = ((d < 0.0) ? 0.0 : ((d > 1.0) ? 1.0 : d));
+   g_iTraceSamplingRate.storeRelease(static_cast<int>(d * QX_TRACE_SAMPLING_MAX));
+}
+
+int QxTrace::getBatchSize() const
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   return m_pImpl->m_iBatchSize;
+}
+
+void QxTrace::setBatchSize(int i)
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_iBatchSize = ((i < 1) ? 1 : i);
+}
+
+QString QxTrace::getServiceName() const
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   return m_pImpl->m_sServiceName;
+}
+
+void QxTrace::setServiceName(const QString & s)
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_sServiceName = s;
+}
+
+void QxTrace::setSink(const QxTrace::type_fct_sink & fct)
+{
+   flush();
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_fctSink = fct;
+}
+
+bool QxTrace::setOutputFile(const QString & sFileName, QxTrace::export_format eFormat /* = format_chrome_trace */)
+{
+   if (sFileName.isEmpty()) { setSink(QxTrace::type_fct_sink()); return true; }
+   std::shared_ptr<QxTrace_FileSink> pFileSink = std::make_shared<QxTrace_FileSink>(sFileName, eFormat);
+   if (! pFileSink->open()) { qDebug("[QxOrm] qx::QxTrace : unable to open output file '%s'", qPrintable(sFileName)); return false; }
+   setSink([pFileSink](const QxTrace::type_span_list & lst) { pFileSink->write(lst); });
+   return true;
+}
+
+void QxTrace::record(const QxTrace::type_span & span)
+{
+   {
+      QMutexLocker locker(& m_pImpl->m_mutex);
+      if (! m_pImpl->m_fctSink) { return; }
+      m_pImpl->m_lstPending.append(span);
+      if (m_pImpl->m_lstPending.count() < m_pImpl->m_iBatchSize) { return; }
+   }
+   m_pImpl->exportSpans(false);
+}
+
+void QxTrace::flush() { m_pImpl->exportSpans(true); }
+
+QxTrace::type_context QxTrace::currentContext()
+{
+   if (! QxTrace::isEnabled()) { return QxTrace::type_context(); }
+   return getTraceThreadData().m_context;
+}
+
+void QxTrace::setCurrentContext(const QxTrace::type_context & ctx) { getTraceThreadData().m_context = ctx; }
+
+QxTrace::type_context QxTrace::newRootContext()
+{
+   QxTrace::type_context ctx;
+   ctx.m_iTraceIdHigh = getTraceRandom(); ctx.m_iTraceIdLow = getTraceRandom();
+   int iSamplingRate = g_iTraceSamplingRate.loadAcquire();
+   ctx.m_bSampled = ((iSamplingRate >= QX_TRACE_SAMPLING_MAX) || ((iSamplingRate > 0) && (static_cast<int>(getTraceRandom() % QX_TRACE_SAMPLING_MAX) < iSamplingRate)));
+   return ctx;
+}
+
+quint64 QxTrace::newSpanId() { return getTraceRandom(); }
+
+qint64 QxTrace::now() { return getTraceClock().now(); }
+
+QByteArray QxTrace::toChromeTrace(const QxTrace::type_span_list & lst)
+{
+   qint64 iPid = QCoreApplication::applicationPid();
+   QByteArray out = "{\"traceEvents\":[";
+   for (int i = 0; i < lst.count(); i++) { if (i > 0) { out += ",\n"; } out += toChromeEvent(lst.at(i), iPid); }
+   out += "],\"displayTimeUnit\":\"ns\"}";
+   return out;
+}
+
+QByteArray QxTrace::toOtlpJson(const QxTrace::type_span_list & lst, const QString & sServiceName)
+{
+   QByteArray out = "{\"resourceSpans\":[{\"resource\":{\"attributes\":[{\"key\":\"service.name\",\"value\":{\"stringValue\":";
+   out += toJsonString(sServiceName);
+   out += "}}]},\"scopeSpans\":[{\"scope\":{\"name\":\"QxOrm\",\"version\":\"" QX_VERSION_STR "\"},\"spans\":[";
+   for (int i = 0; i < lst.count(); i++) { if (i > 0) { out += ","; } out += toOtlpSpan(lst.at(i)); }
+   out += "]}]}]}";
+   return out;
+}
+
+QByteArray QxTrace::type_context::toTraceParent() const
+{
+   if (! isValid()) { return QByteArray(); }
+   return ("00-" + toHex(m_iTraceIdHigh) + toHex(m_iTraceIdLow) + "-" + toHex(m_iSpanId) + (m_bSampled ? "-01" : "-00"));
+}
+
+QxTrace::type_context QxTrace::type_context::fromTraceParent(const QByteArray & sTraceParent)
+{
+   // W3C trace context : version (2 hex) - trace id (32 hex) - parent id (16 hex) - flags (2 hex)
+   QxTrace::type_context ctx;
+   QList<QByteArray> lst = sTraceParent.trimmed().split('-');
+   if ((lst.count() < 4) || (lst.at(0).size() != 2) || (lst.at(0) == "ff") || (lst.at(1).size() != 32) || (lst.at(2).size() != 16) || (lst.at(3).size() != 2)) { return ctx; }
+   bool bOk1 = false, bOk2 = false, bOk3 = false, bOk4 = false;
+   quint64 iTraceIdHigh = lst.at(1).left(16).toULongLong((& bOk1), 16);
+   quint64 iTraceIdLow = lst.at(1).right(16).toULongLong((& bOk2), 16);
+   quint64 iSpanId = lst.at(2).toULongLong((& bOk3), 16);
+   int iFlags = lst.at(3).toInt((& bOk4), 16);
+   if (! (bOk1 && bOk2 && bOk3 && bOk4) || (iSpanId == 0)) { return ctx; }
+   ctx.m_iTraceIdHigh = iTraceIdHigh; ctx.m_iTraceIdLow = iTraceIdLow; ctx.m_iSpanId = iSpanId;
+   ctx.m_bSampled = ((iFlags & 0x01) != 0);
+   return ctx;
+}
+
+QxTraceSpan::QxTraceSpan(const char * sName, const char * sCategory) : m_bContextChanged(false)
+{
+   if (QxTrace::isEnabled()) { begin(QString::fromLatin1(sName), sCategory, QxTrace::type_context()); }
+}
+
+QxTraceSpan::QxTraceSpan(const QString & sName, const char * sCategory, const QxTrace::type_context & parent /* = QxTrace::type_context() */) : m_bContextChanged(false)
+{
+   if (QxTrace::isEnabled()) { begin(sName, sCategory, parent); }
+}
+
+QxTraceSpan::~QxTraceSpan() { end(); }
+
+void QxTraceSpan::begin(const QString & sName, const char * sCategory, const QxTrace::type_context & parent)
+{
+   // Parent is the current span of the thread, except if a (remote) parent is provided
+   QxTrace::type_context current = QxTrace::currentContext();
+   QxTrace::type_context ctx = (parent.isValid() ? parent : current);
+   if (ctx.isValid() && (! ctx.m_bSampled) && (! parent.isValid())) { return; } // Trace not sampled : nothing to record, current context is already the right one
+   quint64 iParentSpanId = ctx.m_iSpanId;
+   if (! ctx.isValid()) { ctx = QxTrace::newRootContext(); iParentSpanId = 0; }
+   if (ctx.m_bSampled)
+   {
+      ctx.m_iSpanId = QxTrace::newSpanId();
+      m_pSpan.reset(new QxTrace::type_span());
+      m_pSpan->m_sName = sName;
+      m_pSpan->m_sCategory = QString::fromLatin1(sCategory);
+      m_pSpan->m_context = ctx;
+      m_pSpan->m_iParentSpanId = iParentSpanId;
+      m_pSpan->m_iThreadId = getTraceThreadId();
+      m_pSpan->m_iStart = QxTrace::now();
+   }
+   m_previousContext = current;
+   m_bContextChanged = true;
+   QxTrace::setCurrentContext(ctx);
+}
+
+void QxTraceSpan::end()
+{
+   if (m_pSpan)
+   {
+      m_pSpan->m_iDuration = (QxTrace::now() - m_pSpan->m_iStart);
+      QxTrace::getSingleton()->record(* m_pSpan);
+      m_pSpan.reset();
+   }
+   if (m_bContextChanged)
+   {
+      QxTrace::setCurrentContext(m_previousContext);
+      m_bContextChanged = false;
+   }
+}
+
+QxTrace::type_context QxTraceSpan::context() const { return (m_pSpan ? m_pSpan->m_context : QxTrace::type_context()); }
+
+qint64 QxTraceSpan::startTime() const { return (m_pSpan ? m_pSpan->m_iStart : 0); }
+
+void QxTraceSpan::setName(const QString & sName) { if (m_pSpan) { m_pSpan->m_sName = sName; } }
+
+void QxTraceSpan::setAttribute(const QString & sKey, const QVariant & vValue) { if (m_pSpan) { m_pSpan->m_lstAttributes.append(qMakePair(sKey, vValue)); } }
+
+void QxTraceSpan::setError(bool b) { if (m_pSpan) { m_pSpan->m_bError = b; } }
+
+void QxTraceSpan::addChild(const QString & sName, const char * sCategory, qint64 iStart, qint64 iDuration, const QString & sAttrKey /* = QString() */, const QVariant & vAttrValue /* = QVariant() */)
+{
+   if (! m_pSpan) { return; }
+   QxTrace::type_span child;
+   child.m_sName = sName;
+   child.m_sCategory = QString::fromLatin1(sCategory);
+   child.m_context = m_pSpan->m_context;
+   child.m_context.m_iSpanId = QxTrace::newSpanId();
+   child.m_iParentSpanId = m_pSpan->m_context.m_iSpanId;
+   child.m_iThreadId = m_pSpan->m_iThreadId;
+   child.m_iStart = iStart;
+   child.m_iDuration = iDuration;
+   if (! sAttrKey.isEmpty()) { child.m_lstAttributes.append(qMakePair(sAttrKey, vAttrValue)); }
+   QxTrace::getSingleton()->record(child);
+}
+
+QxTraceContextScope::QxTraceContextScope(const QxTrace::type_context & ctx) : m_bContextChanged(false)
+{
+   if (! QxTrace::isEnabled()) { return; }
+   m_previousContext = QxTrace::currentContext();
+   m_bContextChanged = true;
+   QxTrace::setCurrentContext(ctx);
+}
+
+QxTraceContextScope::~QxTraceContextScope()
+{
+   if (m_bContextChanged) { QxTrace::setCurrentContext(m_previousContext); }
+}
+
+} // namespace qx
@@ -32,8 +32,15 @@
 #include <QxPrecompiled.h>
 
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <typeindex>
 
 #include <QxDao/IxDao_Helper.h>
+#include <QxDao/QxDaoMetrics.h>
+#include <QxDao/QxSqlQueryCompiled.h>
+
+#include <QxCommon/QxTrace.h>
 
 #include <QxRegister/IxClass.h>
 
@@ -68,8 +75,10 @@
       m_bTransaction(false), m_bQuiet(false), m_bTraceQuery(true),             \
       m_bTraceRecord(false), m_bCartesianProduct(false),                       \
       m_bValidatorThrowable(false), m_bNeedToClearDatabaseByThread(false),     \
-      m_bMongoDB(false), m_bDisplayTimerDetails(false), m_pDataMemberX(NULL),  \
-      m_pDataId(NULL), m_pSqlGenerator(NULL)
+      m_bMongoDB(false), m_bDisplayTimerDetails(false),                        \
+      m_bTimerDetails(false), m_bDaoMetrics(false), m_lRowCount(0),            \
+      m_bTraceRecording(false),                                                \
+      m_pDataMemberX(NULL), m_pDataId(NULL), m_pSqlGenerator(NULL)
 
 #if (QT_VERSION >= 0x040800)
 #define QX_DAO_TIMER_ELAPSED(timer) timer.nsecsElapsed()
@@ -147,8 +156,19 @@ struct IxDao_Helper::IxDao_HelperImpl {
         //!< JSON (used for MongoDB database)
     bool m_bDisplayTimerDetails;  //!< Display in logs all timers details (exec(),
         //!< next(), prepare(), open(), etc...)
-
-    qx::IxSqlQueryBuilder_ptr m_pQueryBuilder; //!< Sql query builder
+    bool m_bTimerDetails; //!< Measure all timers details (displayed in logs or
+        //!< recorded into qx::QxDaoMetrics registry)
+    bool m_bDaoMetrics;   //!< Record timers, rows and errors into
+        //!< qx::QxDaoMetrics registry
+    qint64 m_lRowCount;   //!< Number of records read by QSqlQuery::next() method
+    std::unique_ptr<qx::QxTraceSpan>
+        m_pTraceSpan; //!< Tracing span of the qx::dao function (only if tracing
+        //!< is enabled, see qx::QxTrace class)
+    bool m_bTraceRecording; //!< Tracing span is recorded (trace is sampled)
+    qint64 m_lstTraceStart[qx::QxDaoMetrics::metric_count]; //!< First start
+        //!< time of each timer (to build tracing child spans)
+
+    std::unique_ptr<qx::IxSqlQueryBuilder> m_pQueryBuilder; //!< Sql query builder
     qx::IxDataMemberX *m_pDataMemberX;         //!< Collection of data member
     qx::IxDataMember *m_pDataId;               //!< Data member id
     qx::QxSqlQuery m_qxQuery;                  //!< Query sql with place-holder
@@ -160,23 +180,182 @@ struct IxDao_Helper::IxDao_HelperImpl {
         m_pSqlRelationLinked; //!< List of relation linked to build a hierarchy of
         //!< relationships
 
-    IxDao_HelperImpl(qx::IxSqlQueryBuilder *pBuilder,
-                     const qx::QxSqlQuery *pQuery)
-        : QX_CONSTRUCT_IX_DAO_HELPER() {
-        m_pQueryBuilder.reset(pBuilder);
-        if (pQuery) {
-            m_qxQuery = (*pQuery);
-        }
-    }
+    IxDao_HelperImpl() : QX_CONSTRUCT_IX_DAO_HELPER() { clearTraceStart(); }
     ~IxDao_HelperImpl() { ; }
 
     void displaySqlQuery();
+    void fillTimers(qint64 *lstTimers);
+    void recordMetrics(bool bError);
+    void beginTrace();
+    void endTrace(bool bError);
+    void clearTraceStart();
+    void recycle();
 };
 
+/*!
+ * Per-thread pools of dao helpers and sql query builders : a qx::dao function
+ * takes its instances from here and gives them back when it is done, so a
+ * tight loop of qx::dao calls doesn't allocate and destroy them each time
+ */
+struct IxDao_Helper::IxDao_HelperPool {
+
+    enum { max_helper = 8, max_builder_by_type = 4 };
+
+    typedef std::vector<qx::IxSqlQueryBuilder *> type_lst_builder;
+
+    std::vector<IxDao_HelperImpl *> m_lstHelper; //!< Dao helpers ready to be reused
+    std::unordered_map<std::type_index, type_lst_builder>
+        m_lstBuilder; //!< Sql query builders ready to be reused (by builder type : class + operation)
+
+    IxDao_HelperPool() { ; }
+    ~IxDao_HelperPool() {
+        for (IxDao_HelperImpl *p : m_lstHelper) {
+            delete p;
+        }
+        for (auto &itr : m_lstBuilder) {
+            for (qx::IxSqlQueryBuilder *p : itr.second) {
+                delete p;
+            }
+        }
+    }
+
+    static bool isEnabled() {
+        qx::QxSqlDatabase *pDatabase = qx::QxSqlDatabase::getSingleton();
+        return (pDatabase && pDatabase->getRecycleDaoHelper());
+    }
+
+    static IxDao_HelperPool *current(bool bCreate) {
+        static QThreadStorage<IxDao_HelperPool *> pool;
+        if (!pool.hasLocalData()) {
+            if (!bCreate) {
+                return NULL;
+            }
+            pool.setLocalData(new IxDao_HelperPool());
+        }
+        return pool.localData();
+    }
+
+    static IxDao_HelperImpl *takeHelper() {
+        IxDao_HelperPool *pPool = (isEnabled() ? current(false) : NULL);
+        if (!pPool || pPool->m_lstHelper.empty()) {
+            return new IxDao_HelperImpl();
+        }
+        IxDao_HelperImpl *p = pPool->m_lstHelper.back();
+        pPool->m_lstHelper.pop_back();
+        return p;
+    }
+
+    static void releaseHelper(IxDao_HelperImpl *p) {
+        if (!p) {
+            return;
+        }
+        IxDao_HelperPool *pPool = (isEnabled() ? current(true) : NULL);
+        if (!pPool || (pPool->m_lstHelper.size() >= max_helper)) {
+            delete p;
+            return;
+        }
+        p->recycle();
+        pPool->m_lstHelper.push_back(p);
+    }
+};
+
+void IxDao_Helper::IxDao_HelperImpl::recycle() {
+    IxDao_Recycler::releaseBuilder(m_pQueryBuilder.release());
+    m_database = QSqlDatabase();
+    m_query = QSqlQuery();
+    m_error = QSqlError();
+    m_context.clear();
+    m_lstColumns.clear();
+    m_lstItemsAsJson.clear();
+    m_qxQuery = qx::QxSqlQuery();
+    m_lstInvalidValues = qx::QxInvalidValueX();
+    m_pSqlRelationLinked.reset();
+    m_timeTotal = 0;
+    m_timeExec = 0;
+    m_timeNext = 0;
+    m_timePrepare = 0;
+    m_timeBuildHierarchy = 0;
+    m_timeBuildCppInstance = 0;
+    m_timeReadCppInstance = 0;
+    m_timeBuildSql = 0;
+    m_timeOpen = 0;
+    m_timeTransaction = 0;
+    m_nextCount = 0;
+    m_lDataCount = 0;
+    m_bTransaction = false;
+    m_bQuiet = false;
+    m_bTraceQuery = true;
+    m_bTraceRecord = false;
+    m_bCartesianProduct = false;
+    m_bValidatorThrowable = false;
+    m_bNeedToClearDatabaseByThread = false;
+    m_bMongoDB = false;
+    m_bDisplayTimerDetails = false;
+    m_bTimerDetails = false;
+    m_bDaoMetrics = false;
+    m_lRowCount = 0;
+    m_pTraceSpan.reset();
+    m_bTraceRecording = false;
+    clearTraceStart();
+    m_pDataMemberX = NULL;
+    m_pDataId = NULL;
+    m_pSqlGenerator = NULL;
+}
+
+qx::IxSqlQueryBuilder *IxDao_Recycler::takeBuilder(const std::type_info &type) {
+    IxDao_Helper::IxDao_HelperPool *pPool =
+        (IxDao_Helper::IxDao_HelperPool::isEnabled()
+             ? IxDao_Helper::IxDao_HelperPool::current(false)
+             : NULL);
+    if (!pPool) {
+        return NULL;
+    }
+    auto itr = pPool->m_lstBuilder.find(std::type_index(type));
+    if ((itr == pPool->m_lstBuilder.end()) || itr->second.empty()) {
+        return NULL;
+    }
+    qx::IxSqlQueryBuilder *pBuilder = itr->second.back();
+    itr->second.pop_back();
+    return pBuilder;
+}
+
+void IxDao_Recycler::releaseBuilder(qx::IxSqlQueryBuilder *pBuilder) {
+    if (!pBuilder) {
+        return;
+    }
+    IxDao_Helper::IxDao_HelperPool *pPool =
+        (IxDao_Helper::IxDao_HelperPool::isEnabled()
+             ? IxDao_Helper::IxDao_HelperPool::current(true)
+             : NULL);
+    IxDao_Helper::IxDao_HelperPool::type_lst_builder *pLst =
+        (pPool ? (&pPool->m_lstBuilder[std::type_index(typeid(*pBuilder))])
+               : NULL);
+    if (!pLst || (pLst->size() >= IxDao_Helper::IxDao_HelperPool::max_builder_by_type)) {
+        delete pBuilder;
+        return;
+    }
+    pBuilder->reset();
+    pLst->push_back(pBuilder);
+}
+
+void IxDao_Recycler::clearCurrentThread() {
+    IxDao_Helper::IxDao_HelperPool *pPool =
+        IxDao_Helper::IxDao_HelperPool::current(false);
+    if (!pPool) {
+        return;
+    }
+    IxDao_Helper::IxDao_HelperPool tmp;
+    std::swap(tmp.m_lstHelper, pPool->m_lstHelper);
+    std::swap(tmp.m_lstBuilder, pPool->m_lstBuilder);
+}
+
 IxDao_Helper::IxDao_Helper(qx::IxSqlQueryBuilder *pBuilder,
                            const qx::QxSqlQuery *pQuery /* = NULL */)
-    : m_pImpl(new IxDao_HelperImpl(pBuilder, pQuery)) {
-    ;
+    : m_pImpl(IxDao_HelperPool::takeHelper()) {
+    m_pImpl->m_pQueryBuilder.reset(pBuilder);
+    if (pQuery) {
+        m_pImpl->m_qxQuery = (*pQuery);
+    }
 }
 
 IxDao_Helper::~IxDao_Helper() {
@@ -184,6 +363,7 @@ IxDao_Helper::~IxDao_Helper() {
     if (m_pImpl->m_bNeedToClearDatabaseByThread) {
         qx::QxSqlDatabase::getSingleton()->clearCurrentDatabaseByThread();
     }
+    IxDao_HelperPool::releaseHelper(m_pImpl.release());
 }
 
 bool IxDao_Helper::isValid() const {
@@ -373,6 +553,9 @@ bool IxDao_Helper::transaction() {
 bool IxDao_Helper::nextRecord() {
     IxDao_Timer timer(this, IxDao_Helper::timer_db_next);
     bool bNext = m_pImpl->m_query.next();
+    if (bNext) {
+        m_pImpl->m_lRowCount++;
+    }
     if (bNext && m_pImpl->m_bTraceRecord) {
         dumpRecord();
     }
@@ -429,6 +612,25 @@ void IxDao_Helper::dumpRecord() const {
 }
 
 void IxDao_Helper::timerStart(IxDao_Helper::timer_type timer) {
+    if (m_pImpl->m_bTraceRecording) {
+        int iMetric = -1;
+        switch (timer) {
+        case IxDao_Helper::timer_db_exec: iMetric = qx::QxDaoMetrics::metric_db_exec; break;
+        case IxDao_Helper::timer_db_next: iMetric = qx::QxDaoMetrics::metric_db_next; break;
+        case IxDao_Helper::timer_db_prepare: iMetric = qx::QxDaoMetrics::metric_db_prepare; break;
+        case IxDao_Helper::timer_cpp_build_hierarchy: iMetric = qx::QxDaoMetrics::metric_cpp_build_hierarchy; break;
+        case IxDao_Helper::timer_cpp_build_instance: iMetric = qx::QxDaoMetrics::metric_cpp_build_instance; break;
+        case IxDao_Helper::timer_cpp_read_instance: iMetric = qx::QxDaoMetrics::metric_cpp_read_instance; break;
+        case IxDao_Helper::timer_build_sql: iMetric = qx::QxDaoMetrics::metric_build_sql; break;
+        case IxDao_Helper::timer_db_open: iMetric = qx::QxDaoMetrics::metric_db_open; break;
+        case IxDao_Helper::timer_db_transaction: iMetric = qx::QxDaoMetrics::metric_db_transaction; break;
+        default: break;
+        }
+        if ((iMetric >= 0) && (m_pImpl->m_lstTraceStart[iMetric] == 0)) {
+            m_pImpl->m_lstTraceStart[iMetric] = qx::QxTrace::now();
+        }
+    }
+
     switch (timer) {
     case IxDao_Helper::timer_total:
         m_pImpl->m_timerTotal.start();
@@ -437,49 +639,49 @@ void IxDao_Helper::timerStart(IxDao_Helper::timer_type timer) {
         m_pImpl->m_timerExec.start();
         break;
     case IxDao_Helper::timer_db_next:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerNext.start();
         break;
     case IxDao_Helper::timer_db_prepare:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerPrepare.start();
         break;
     case IxDao_Helper::timer_cpp_build_hierarchy:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerBuildHierarchy.start();
         break;
     case IxDao_Helper::timer_cpp_build_instance:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerBuildCppInstance.start();
         break;
     case IxDao_Helper::timer_cpp_read_instance:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerReadCppInstance.start();
         break;
     case IxDao_Helper::timer_build_sql:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerBuildSql.start();
         break;
     case IxDao_Helper::timer_db_open:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerOpen.start();
         break;
     case IxDao_Helper::timer_db_transaction:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         m_pImpl->m_timerTransaction.start();
@@ -501,7 +703,7 @@ qint64 IxDao_Helper::timerElapsed(IxDao_Helper::timer_type timer) {
         m_pImpl->m_timeExec += elapsed;
         break;
     case IxDao_Helper::timer_db_next:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerNext);
@@ -509,49 +711,49 @@ qint64 IxDao_Helper::timerElapsed(IxDao_Helper::timer_type timer) {
         m_pImpl->m_nextCount++;
         break;
     case IxDao_Helper::timer_db_prepare:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerPrepare);
         m_pImpl->m_timePrepare += elapsed;
         break;
     case IxDao_Helper::timer_cpp_build_hierarchy:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerBuildHierarchy);
         m_pImpl->m_timeBuildHierarchy += elapsed;
         break;
     case IxDao_Helper::timer_cpp_build_instance:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerBuildCppInstance);
         m_pImpl->m_timeBuildCppInstance += elapsed;
         break;
     case IxDao_Helper::timer_cpp_read_instance:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerReadCppInstance);
         m_pImpl->m_timeReadCppInstance += elapsed;
         break;
     case IxDao_Helper::timer_build_sql:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerBuildSql);
         m_pImpl->m_timeBuildSql += elapsed;
         break;
     case IxDao_Helper::timer_db_open:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerOpen);
         m_pImpl->m_timeOpen += elapsed;
         break;
     case IxDao_Helper::timer_db_transaction:
-        if (!m_pImpl->m_bDisplayTimerDetails) {
+        if (!m_pImpl->m_bTimerDetails) {
             break;
         }
         elapsed = QX_DAO_TIMER_ELAPSED(m_pImpl->m_timerTransaction);
@@ -569,6 +771,19 @@ void IxDao_Helper::addQuery(bool bResolve) {
     }
     IxDao_Timer timer(this, IxDao_Helper::timer_build_sql);
     QString sql = this->builder().getSqlQuery();
+    QString sqlBase = sql;
+
+    // Compiled query already executed with same default SQL : no SQL element to resolve, only bind values by position
+    QVector<QVariant> lstCompiledValues;
+    if (bResolve && qx::QxSqlQueryCompiled::findSql(m_pImpl->m_qxQuery, sqlBase, sql, lstCompiledValues)) {
+        this->builder().setSqlQuery(sql);
+        if (!this->prepare(sql)) {
+            this->errFailed(true);
+        }
+        qx::QxSqlQueryCompiled::resolve(m_pImpl->m_qxQuery, lstCompiledValues, this->query());
+        return;
+    }
+
     QString sqlToAdd = m_pImpl->m_qxQuery.query().trimmed();
     bool bAddSqlCondition = false;
     if (sqlToAdd.leftRef(6).contains(QStringLiteral("WHERE "), Qt::CaseInsensitive)) {
@@ -590,10 +805,14 @@ void IxDao_Helper::addQuery(bool bResolve) {
     this->builder().setSqlQuery(sql);
 
     if (bResolve) {
+        QString sqlToCompile = sql;
         if (!this->prepare(sql)) {
             this->errFailed(true);
         }
         m_pImpl->m_qxQuery.resolve(this->query());
+        if (m_pImpl->m_qxQuery.isCompiled() && this->isValid()) {
+            qx::QxSqlQueryCompiled::insertSql(m_pImpl->m_qxQuery, sqlBase, sqlToCompile, this->query());
+        }
     }
 }
 
@@ -646,6 +865,13 @@ void IxDao_Helper::init(QSqlDatabase *pDatabase, const QString &sContext) {
         (qx::QxSqlDatabase::getSingleton()->getDriverName() == QStringLiteral("QXMONGODB"));
     m_pImpl->m_bDisplayTimerDetails =
         qx::QxSqlDatabase::getSingleton()->getDisplayTimerDetails();
+    m_pImpl->m_bDaoMetrics = qx::QxSqlDatabase::getSingleton()->getDaoMetrics();
+    if (qx::QxTrace::isEnabled()) {
+        m_pImpl->beginTrace();
+    }
+    m_pImpl->m_bTimerDetails =
+        (m_pImpl->m_bDisplayTimerDetails || m_pImpl->m_bDaoMetrics ||
+         m_pImpl->m_bTraceRecording);
     qAssert(!m_pImpl->m_context.isEmpty());
 
 #ifndef _QX_ENABLE_MONGODB
@@ -747,6 +973,12 @@ void IxDao_Helper::terminate() {
         }
     }
 
+    if (m_pImpl->m_bDaoMetrics) {
+        m_pImpl->recordMetrics(!isValid());
+    }
+    if (m_pImpl->m_pTraceSpan) {
+        m_pImpl->endTrace(!isValid());
+    }
     m_pImpl->m_bTransaction = false;
     dumpBoundValues();
 }
@@ -767,6 +999,90 @@ void IxDao_Helper::dumpBoundValues() const {
     }
 }
 
+void IxDao_Helper::IxDao_HelperImpl::fillTimers(qint64 *lstTimers) {
+    // Total time is already computed if sql query has been traced
+    lstTimers[qx::QxDaoMetrics::metric_total] =
+        ((m_timeTotal > 0) ? m_timeTotal : QX_DAO_TIMER_ELAPSED(m_timerTotal));
+    lstTimers[qx::QxDaoMetrics::metric_db_exec] = m_timeExec;
+    lstTimers[qx::QxDaoMetrics::metric_db_next] = m_timeNext;
+    lstTimers[qx::QxDaoMetrics::metric_db_prepare] = m_timePrepare;
+    lstTimers[qx::QxDaoMetrics::metric_cpp_build_hierarchy] = m_timeBuildHierarchy;
+    lstTimers[qx::QxDaoMetrics::metric_cpp_build_instance] = m_timeBuildCppInstance;
+    lstTimers[qx::QxDaoMetrics::metric_cpp_read_instance] = m_timeReadCppInstance;
+    lstTimers[qx::QxDaoMetrics::metric_build_sql] = m_timeBuildSql;
+    lstTimers[qx::QxDaoMetrics::metric_db_open] = m_timeOpen;
+    lstTimers[qx::QxDaoMetrics::metric_db_transaction] = m_timeTransaction;
+}
+
+void IxDao_Helper::IxDao_HelperImpl::recordMetrics(bool bError) {
+    qint64 lstTimers[qx::QxDaoMetrics::metric_count];
+    fillTimers(lstTimers);
+
+    qx::IxClass *pClass = (m_pDataMemberX ? m_pDataMemberX->getClass() : NULL);
+    QString sClass = (pClass ? pClass->getKey() : QString());
+    QString sHost = m_database.hostName();
+    QString sDatabase = (sHost.isEmpty() ? m_database.databaseName()
+                                         : (sHost + QStringLiteral("/") + m_database.databaseName()));
+    qx::QxDaoMetrics::getSingleton()->record(sClass, m_context, sDatabase, lstTimers,
+                                             m_lRowCount, bError);
+}
+
+void IxDao_Helper::IxDao_HelperImpl::beginTrace() {
+    // The span is kept even if the trace is not sampled : it holds the current
+    // context of the thread, so nested qx::dao functions are not sampled again
+    m_pTraceSpan.reset(new qx::QxTraceSpan(m_context, "dao"));
+    m_bTraceRecording = m_pTraceSpan->isRecording();
+}
+
+void IxDao_Helper::IxDao_HelperImpl::endTrace(bool bError) {
+    if (m_bTraceRecording) {
+        qint64 lstTimers[qx::QxDaoMetrics::metric_count];
+        fillTimers(lstTimers);
+        qx::IxClass *pClass = (m_pDataMemberX ? m_pDataMemberX->getClass() : NULL);
+        QString sClass = (pClass ? pClass->getKey() : QString());
+        QString query = (m_bMongoDB ? m_qxQuery.queryAt(0) : QString());
+        QString sql =
+            ((query.isEmpty() && m_pQueryBuilder) ? m_pQueryBuilder->getSqlQuery()
+                                                  : query);
+
+        m_pTraceSpan->setName(sClass.isEmpty() ? m_context
+                                               : (m_context + QStringLiteral(" ") + sClass));
+        m_pTraceSpan->setAttribute(QStringLiteral("qx.class"), sClass);
+        m_pTraceSpan->setAttribute(QStringLiteral("qx.operation"), m_context);
+        m_pTraceSpan->setAttribute(QStringLiteral("db.system"), m_database.driverName());
+        m_pTraceSpan->setAttribute(QStringLiteral("db.name"), m_database.databaseName());
+        m_pTraceSpan->setAttribute(QStringLiteral("db.statement"), sql);
+        m_pTraceSpan->setAttribute(QStringLiteral("db.rows"), static_cast<qlonglong>(m_lRowCount));
+        m_pTraceSpan->setError(bError);
+
+        // Child spans : a timer can be measured several times (next() for
+        // example), so its span starts at the first measure and lasts the sum
+        // of all measures
+        for (int i = 0; i < qx::QxDaoMetrics::metric_count; i++) {
+            if ((i == qx::QxDaoMetrics::metric_total) || (lstTimers[i] <= 0) ||
+                (m_lstTraceStart[i] <= 0)) {
+                continue;
+            }
+            QString sName = qx::QxDaoMetrics::getMetricName(
+                static_cast<qx::QxDaoMetrics::metric_type>(i));
+            bool bNext = (i == qx::QxDaoMetrics::metric_db_next);
+            m_pTraceSpan->addChild(sName, (sName.startsWith(QStringLiteral("db_")) ? "sql" : "cpp"),
+                                   m_lstTraceStart[i], lstTimers[i],
+                                   (bNext ? QStringLiteral("calls") : QString()),
+                                   (bNext ? QVariant(m_nextCount) : QVariant()));
+        }
+    }
+    m_pTraceSpan.reset();
+    m_bTraceRecording = false;
+    clearTraceStart();
+}
+
+void IxDao_Helper::IxDao_HelperImpl::clearTraceStart() {
+    for (int i = 0; i < qx::QxDaoMetrics::metric_count; i++) {
+        m_lstTraceStart[i] = 0;
+    }
+}
+
 void IxDao_Helper::IxDao_HelperImpl::displaySqlQuery() {
     QString query = (m_bMongoDB ? m_qxQuery.queryAt(0) : QString());
     QString sql =
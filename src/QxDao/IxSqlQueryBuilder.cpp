@@ -38,6 +38,8 @@
 
 #include <QxRegister/IxClass.h>
 
+#include <QxCommon/QxReadMostlyHash.h>
+
 #include <QxMemLeak/mem_leak.h>
 
 namespace qx {
@@ -67,18 +69,32 @@ struct IxSqlQueryBuilder::IxSqlQueryBuilderImpl
    IxDataMemberX * m_pDataMemberX;                                   //!< QxDataMemberX<type_sql> singleton reference
    bool m_bInitDone;                                                 //!< Class initialisation finished
 
-   static QHash<QString, QString> m_lstSqlQuery;                     //!< Store here all SQL queries generated by child classes
-   static QHash<QString, QHash<QString, QString> > m_lstSqlAlias;    //!< Store here all SQL aliases generated by child classes
-   static QMutex m_mutex;                                            //!< Mutex => qx::IxSqlQueryBuilder is thread-safe
+   typedef qx::QxReadMostlyHash<QString, QString> type_lst_sql_query;
+   typedef qx::QxReadMostlyHash<QString, QHash<QString, QString> > type_lst_sql_alias;
+
+   static type_lst_sql_query & getLstSqlQuery() { static type_lst_sql_query lst; return lst; }    //!< Store here all SQL queries generated by child classes (thread-safe, no lock to read)
+   static type_lst_sql_alias & getLstSqlAlias() { static type_lst_sql_alias lst; return lst; }    //!< Store here all SQL aliases generated by child classes (thread-safe, no lock to read)
 
    IxSqlQueryBuilderImpl() : m_pDataMemberId(NULL), m_bCartesianProduct(false), m_pDaoHelper(NULL), m_pDataMemberX(NULL), m_bInitDone(false) { ; }
    ~IxSqlQueryBuilderImpl() { ; }
 
+   typedef QList<QPair<IxDataMember *, bool> > type_lst_insert_member;
+   static type_lst_insert_member getInsertMembers(IxSqlQueryBuilder & builder);
+
 };
 
-QHash<QString, QString> IxSqlQueryBuilder::IxSqlQueryBuilderImpl::m_lstSqlQuery;
-QHash<QString, QHash<QString, QString> > IxSqlQueryBuilder::IxSqlQueryBuilderImpl::m_lstSqlAlias;
-QMutex IxSqlQueryBuilder::IxSqlQueryBuilderImpl::m_mutex;
+IxSqlQueryBuilder::IxSqlQueryBuilderImpl::type_lst_insert_member IxSqlQueryBuilder::IxSqlQueryBuilderImpl::getInsertMembers(IxSqlQueryBuilder & builder)
+{
+   // Same columns as 'sql_Insert()' : id (if not auto-increment), data members, then foreign keys of many-to-one relations (the only relations writing a column)
+   type_lst_insert_member lst; long l1(0), l2(0);
+   qx::IxDataMember * p = NULL;
+   qx::IxDataMember * pId = builder.getDataId();
+   qx::IxSqlRelation * pRelation = NULL;
+   if (pId && ! pId->getAutoIncrement() && ! pId->getSqlName(QStringLiteral(", "), QLatin1String(""), true).isEmpty()) { lst.append(qMakePair(pId, true)); }
+   while ((p = builder.nextData(l1))) { lst.append(qMakePair(p, false)); }
+   while ((pRelation = builder.nextRelation(l2))) { if ((pRelation->getRelationType() == qx::IxSqlRelation::many_to_one) && pRelation->getDataMember()) { lst.append(qMakePair(pRelation->getDataMember(), false)); } }
+   return lst;
+}
 
 IxSqlQueryBuilder::IxSqlQueryBuilder() : m_pImpl(new IxSqlQueryBuilderImpl()) { ; }
 
@@ -154,39 +170,42 @@ void IxSqlQueryBuilder::init()
    m_pImpl->m_bInitDone = true;
 }
 
+void IxSqlQueryBuilder::reset()
+{
+   // Clear only the state built for one call (class initialisation is kept) : used to recycle the builder for next call
+   m_pImpl->m_sSqlQuery.clear();
+   m_pImpl->m_sHashRelation.clear();
+   m_pImpl->m_bCartesianProduct = false;
+   m_pImpl->m_pIdX.reset();
+   m_pImpl->m_lstSqlQueryAlias.clear();
+   m_pImpl->m_pDaoHelper = NULL;
+}
+
 void IxSqlQueryBuilder::setSqlQuery(const QString & sql, const QString & key /* = QString() */)
 {
    m_pImpl->m_sSqlQuery = sql;
-   if (! key.isEmpty())
-   {
-      QMutexLocker locker(& IxSqlQueryBuilderImpl::m_mutex);
-      IxSqlQueryBuilderImpl::m_lstSqlQuery.insert(key, sql);
-   }
+   if (! key.isEmpty()) { IxSqlQueryBuilderImpl::getLstSqlQuery().insert(key, sql); }
 }
 
 bool IxSqlQueryBuilder::findSqlQuery(const QString & key)
 {
    if (key.isEmpty()) { return false; }
-   QMutexLocker locker(& IxSqlQueryBuilderImpl::m_mutex);
-   QString sql = IxSqlQueryBuilderImpl::m_lstSqlQuery.value(key);
-   if (! sql.isEmpty()) { m_pImpl->m_sSqlQuery = sql; }
-   return (! sql.isEmpty());
+   QString sql;
+   if (! IxSqlQueryBuilderImpl::getLstSqlQuery().find(key, sql) || sql.isEmpty()) { return false; }
+   m_pImpl->m_sSqlQuery = sql;
+   return true;
 }
 
 bool IxSqlQueryBuilder::findSqlAlias(const QString & key)
 {
    if (key.isEmpty()) { return false; }
-   QMutexLocker locker(& IxSqlQueryBuilderImpl::m_mutex);
-   if (! IxSqlQueryBuilderImpl::m_lstSqlAlias.contains(key)) { return false; }
-   m_pImpl->m_lstSqlQueryAlias = IxSqlQueryBuilderImpl::m_lstSqlAlias.value(key);
-   return true;
+   return IxSqlQueryBuilderImpl::getLstSqlAlias().find(key, m_pImpl->m_lstSqlQueryAlias);
 }
 
 void IxSqlQueryBuilder::insertSqlAlias(const QString & key)
 {
    if (key.isEmpty()) { return; }
-   QMutexLocker locker(& IxSqlQueryBuilderImpl::m_mutex);
-   IxSqlQueryBuilderImpl::m_lstSqlAlias.insert(key, m_pImpl->m_lstSqlQueryAlias);
+   IxSqlQueryBuilderImpl::getLstSqlAlias().insert(key, m_pImpl->m_lstSqlQueryAlias);
 }
 
 void IxSqlQueryBuilder::initIdX(long lAllRelationCount)
@@ -311,6 +330,40 @@ void IxSqlQueryBuilder::sql_DeleteById(QString & sql, IxSqlQueryBuilder & builde
    sql += pId->getSqlNameEqualToPlaceHolder(QLatin1String(""), QStringLiteral(" AND "));
 }
 
+void IxSqlQueryBuilder::sql_DeleteById_In(QString & sql, IxSqlQueryBuilder & builder, bool bSoftDelete, long lCount, bool bRowValue)
+{
+   qx::IxDataMember * pId = builder.getDataId(); qAssert(pId);
+   qx::QxSoftDelete oSoftDelete = builder.getSoftDelete();
+   QString table = builder.table();
+   if (bSoftDelete && ! oSoftDelete.isEmpty()) { sql = "UPDATE " + qx::IxDataMember::getSqlTableName(table) + " SET " + oSoftDelete.buildSqlQueryToUpdate(); }
+   else { sql = "DELETE FROM " + qx::IxDataMember::getSqlFromTable(table); }
+   sql += IxSqlQueryBuilder::addSqlCondition(sql);
+   if (! pId || (lCount <= 0)) { qAssert(false); return; }
+
+   // Each item 'n' gets its own placeholders (suffix '_n') so that named placeholder styles stay unique
+   int iNameCount = pId->getNameCount();
+   if ((iNameCount > 1) && ! bRowValue)
+   {
+      sql += "(";
+      for (long n = 0; n < lCount; n++)
+      {
+         QString sAppend = "_" + QString::number(n);
+         sql += ((n > 0) ? QStringLiteral(" OR (") : QStringLiteral("("));
+         sql += pId->getSqlNameEqualToPlaceHolder(sAppend, QStringLiteral(" AND ")) + ")";
+      }
+      sql += ")";
+      return;
+   }
+
+   sql += ((iNameCount > 1) ? ("(" + pId->getSqlName(QStringLiteral(", ")) + ")") : pId->getSqlName()) + " IN (";
+   for (long n = 0; n < lCount; n++)
+   {
+      QString sPlaceHolders = pId->getSqlPlaceHolder(("_" + QString::number(n)), -1, QStringLiteral(", "));
+      sql += ((n > 0) ? QStringLiteral(", ") : QString()) + ((iNameCount > 1) ? ("(" + sPlaceHolders + ")") : sPlaceHolders);
+   }
+   sql += ")";
+}
+
 void IxSqlQueryBuilder::sql_Exist(QString & sql, IxSqlQueryBuilder & builder)
 {
    qx::IxDataMember * pId = builder.getDataId(); qAssert(pId);
@@ -465,6 +518,23 @@ void IxSqlQueryBuilder::sql_Insert(QString & sql, IxSqlQueryBuilder & builder)
    sql += QLatin1String(")");
 }
 
+void IxSqlQueryBuilder::sql_Insert_MultiRow(QString & sql, IxSqlQueryBuilder & builder, long lCount)
+{
+   IxSqlQueryBuilderImpl::type_lst_insert_member lst = IxSqlQueryBuilderImpl::getInsertMembers(builder);
+   QString table = builder.table(); QStringList lstColumns;
+   if (lst.isEmpty() || (lCount <= 0)) { qAssert(false); sql = QString(); return; }
+   for (int i = 0; i < lst.count(); i++) { lstColumns.append(lst.at(i).first->getSqlName(QStringLiteral(", "), QLatin1String(""), lst.at(i).second)); }
+   sql = "INSERT INTO " + qx::IxDataMember::getSqlTableName(table) + " (" + lstColumns.join(QStringLiteral(", ")) + ") VALUES ";
+
+   // Each row 'n' gets its own placeholders (suffix '_n') so that named placeholder styles stay unique
+   for (long n = 0; n < lCount; n++)
+   {
+      QString sAppend = "_" + QString::number(n); QStringList lstValues;
+      for (int i = 0; i < lst.count(); i++) { lstValues.append(lst.at(i).first->getSqlPlaceHolder(sAppend, -1, QStringLiteral(", "), QLatin1String(""), lst.at(i).second)); }
+      sql += ((n > 0) ? QStringLiteral(", (") : QStringLiteral("(")) + lstValues.join(QStringLiteral(", ")) + ")";
+   }
+}
+
 void IxSqlQueryBuilder::sql_Update(QString & sql, IxSqlQueryBuilder & builder)
 {
    long l1(0), l2(0);
@@ -598,6 +668,21 @@ void IxSqlQueryBuilder::resolveInput_Insert(void * t, QSqlQuery & query, IxSqlQu
    while ((pRelation = builder.nextRelation(l2))) { params.setIndex(l2); pRelation->lazyInsert_ResolveInput(params); }
 }
 
+void IxSqlQueryBuilder::resolveInput_Insert_MultiRow(void * t, QSqlQuery & query, IxSqlQueryBuilder & builder, long lIndex)
+{
+   IxSqlQueryBuilderImpl::type_lst_insert_member lst = IxSqlQueryBuilderImpl::getInsertMembers(builder);
+   QString sAppend = "_" + QString::number(lIndex);
+   for (int i = 0; i < lst.count(); i++) { lst.at(i).first->setSqlPlaceHolder(query, t, sAppend, QLatin1String(""), lst.at(i).second); }
+}
+
+long IxSqlQueryBuilder::getInsertBindValuesCount(IxSqlQueryBuilder & builder)
+{
+   IxSqlQueryBuilderImpl::type_lst_insert_member lst = IxSqlQueryBuilderImpl::getInsertMembers(builder);
+   long lCount = 0;
+   for (int i = 0; i < lst.count(); i++) { lCount += lst.at(i).first->getNameCount(); }
+   return lCount;
+}
+
 void IxSqlQueryBuilder::resolveInput_Update(void * t, QSqlQuery & query, IxSqlQueryBuilder & builder)
 {
    long l1(0), l2(0);
@@ -61,7 +61,9 @@
 m_pClass(NULL), m_pClassOwner(NULL), m_pDataMember(p), m_pDataMemberX(NULL), \
 m_pDataMemberId(NULL), m_pDataMemberIdOwner(NULL), m_lOffsetRelation(100), \
 m_eJoinType(qx::dao::sql_join::left_outer_join), m_eRelationType(IxSqlRelation::no_relation), \
-m_bInitInEvent(false), m_bInitDone(false), m_iIsSameDataOwner(0), m_mutex(QMutex::Recursive)
+m_bInitInEvent(false), m_bInitDone(false), m_iIsSameDataOwner(0), m_bExtraTableDiffMode(false), m_mutex(QMutex::Recursive)
+
+#define QX_EXTRA_TABLE_MAX_ROWS_PER_QUERY 1000
 
 namespace qx {
 
@@ -88,6 +90,7 @@ struct IxSqlRelation::IxSqlRelationImpl
    bool                             m_bInitInEvent;         //!< Class initialization in progress
    bool                             m_bInitDone;            //!< Class initialization finished
    int                              m_iIsSameDataOwner;     //!< Check if relationship source entity and target entity are equal
+   bool                             m_bExtraTableDiffMode;  //!< Save extra-table (n-n) inserting/deleting only changed links instead of delete-all/reinsert-all
    QMutex                           m_mutex;                //!< Mutex => 'qx::IxSqlRelation' is thread-safe (initialization process)
 
    type_lst_data_member_ptr m_lstDataMemberPtr;             //!< Optimization : handle to collection of 'IxDataMember'
@@ -116,6 +119,42 @@ struct IxSqlRelation::IxSqlRelationImpl
       return (bIsValid ? p : NULL);
    }
 
+   QString getSqlWhereOwner_ManyToMany() const
+   {
+      QString sql; QStringList lstForeignKeyOwner = m_sForeignKeyOwner.split(QStringLiteral("|"));
+      if (! m_pDataMemberIdOwner) { qAssert(false); return sql; }
+      qAssert(m_pDataMemberIdOwner->getNameCount() == lstForeignKeyOwner.count());
+      for (int i = 0; i < lstForeignKeyOwner.count(); i++)
+      { sql += ((i > 0) ? QStringLiteral(" AND ") : QString()) + m_sExtraTable + "." + lstForeignKeyOwner.at(i) + " = " + m_pDataMemberIdOwner->getSqlPlaceHolder(QString(), i); }
+      return sql;
+   }
+
+   static int getRowsPerQuery(int iBindValuesPerRow, int iBindValuesFixed)
+   {
+      qx::dao::detail::IxSqlGenerator * pSqlGenerator = qx::QxSqlDatabase::getSingleton()->getSqlGenerator();
+      int iMaxBindValues = ((pSqlGenerator ? pSqlGenerator->getMaxBindValues() : 0) - iBindValuesFixed);
+      int iRows = ((iBindValuesPerRow > 0) ? (iMaxBindValues / iBindValuesPerRow) : 0);
+      return qBound(1, iRows, QX_EXTRA_TABLE_MAX_ROWS_PER_QUERY);
+   }
+
+   static void bindValue(QSqlQuery & query, bool bQuestionMark, const QString & sPlaceHolder, const QVariant & v)
+   { if (bQuestionMark) { query.addBindValue(v); } else { query.bindValue(sPlaceHolder, v); } }
+
+   static QString getLinkKey(const QVariantList & lstIds, int iFirst, int iCount, const QVector<int> & lstTypes)
+   {
+      // Values read from database are converted to the type of the values read from entities (double, QDateTime, QUuid, etc...) before building the key
+      QString sKey;
+      for (int i = 0; i < iCount; i++)
+      {
+         QVariant v = lstIds.at(iFirst + i);
+         int iType = ((i < lstTypes.count()) ? lstTypes.at(i) : static_cast<int>(QMetaType::UnknownType));
+         if (! v.isNull() && (iType != QMetaType::UnknownType) && (v.userType() != iType)) { QVariant vConverted = v; if (vConverted.convert(iType)) { v = vConverted; } }
+         QString sValue = ((v.userType() == QMetaType::QDateTime) ? v.toDateTime().toString(QStringLiteral("yyyy-MM-ddTHH:mm:ss.zzz")) : ((v.userType() == QMetaType::QTime) ? v.toTime().toString(QStringLiteral("HH:mm:ss.zzz")) : v.toString()));
+         sKey += ((i > 0) ? QStringLiteral("|") : QString()) + sValue;
+      }
+      return sKey;
+   }
+
 };
 
 bool IxSqlRelation::IxSqlRelationImpl::m_bTraceRelationInit = false;
@@ -154,6 +193,10 @@ IxDataMember * IxSqlRelation::getDataId() const { return m_pImpl->m_pDataMemberI
 
 IxDataMember * IxSqlRelation::getDataIdOwner() const { return m_pImpl->m_pDataMemberIdOwner; }
 
+bool IxSqlRelation::getExtraTableDiffMode() const { return m_pImpl->m_bExtraTableDiffMode; }
+
+void IxSqlRelation::setExtraTableDiffMode(bool b) { m_pImpl->m_bExtraTableDiffMode = b; }
+
 void IxSqlRelation::setIsSameDataOwner(int i) { m_pImpl->m_iIsSameDataOwner = i; }
 
 bool IxSqlRelation::canInit() const { if (m_pImpl->m_bInitDone) { return false; } { QMutexLocker locker(& m_pImpl->m_mutex); return (! m_pImpl->m_bInitInEvent); } }
@@ -855,12 +898,7 @@ QString IxSqlRelation::createExtraTable_ManyToMany() const
 QSqlError IxSqlRelation::deleteFromExtraTable_ManyToMany(QxSqlRelationParams & params) const
 {
    IxDataMember * pIdOwner = this->getDataIdOwner(); qAssert(pIdOwner);
-   QString sql = "DELETE FROM " + this->m_pImpl->m_sExtraTable + " WHERE ";
-   QStringList lstForeignKeyOwner = this->m_pImpl->m_sForeignKeyOwner.split(QStringLiteral("|"));
-   qAssert(pIdOwner->getNameCount() == lstForeignKeyOwner.count());
-   for (int i = 0; i < pIdOwner->getNameCount(); i++) { sql += this->m_pImpl->m_sExtraTable + "." + lstForeignKeyOwner.at(i) + " = " + pIdOwner->getSqlPlaceHolder(QLatin1String("", i)) + " AND ";
-   }
-   sql = sql.left(sql.count() - 5); // Remove last " AND "
+   QString sql = "DELETE FROM " + this->m_pImpl->m_sExtraTable + " WHERE " + this->m_pImpl->getSqlWhereOwner_ManyToMany();
    if (this->traceSqlQuery()) { qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql)); }
 
    QSqlQuery queryDelete(params.database());
@@ -870,6 +908,189 @@ QSqlError IxSqlRelation::deleteFromExtraTable_ManyToMany(QxSqlRelationParams & p
    return QSqlError();
 }
 
+QSqlError IxSqlRelation::deleteFromExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const
+{
+   IxDataMember * pIdOwner = this->getDataIdOwner(); qAssert(pIdOwner);
+   IxDataMember * pIdData = this->getDataId(); qAssert(pIdData);
+   if (! pIdOwner || ! pIdData) { return QSqlError(); }
+   int iDataCount = pIdData->getNameCount();
+   int iRowsCount = ((iDataCount > 0) ? (lstDataIds.count() / iDataCount) : 0);
+   if (iRowsCount <= 0) { return QSqlError(); }
+   QStringList lstForeignKeyDataType = this->m_pImpl->m_sForeignKeyDataType.split(QStringLiteral("|"));
+   qAssert(iDataCount == lstForeignKeyDataType.count());
+
+   bool bQuestionMark = (qx::QxSqlDatabase::getSingleton()->getSqlPlaceHolderStyle() == qx::QxSqlDatabase::ph_style_question_mark);
+   int iRowsPerQuery = IxSqlRelationImpl::getRowsPerQuery(iDataCount, pIdOwner->getNameCount());
+   QSqlQuery queryDelete(params.database()); int iCurrRows = 0;
+   for (int iFirst = 0; iFirst < iRowsCount; iFirst += iRowsPerQuery)
+   {
+      int iRows = qMin(iRowsPerQuery, (iRowsCount - iFirst));
+      if (iRows != iCurrRows)
+      {
+         QString sql = "DELETE FROM " + this->m_pImpl->m_sExtraTable + " WHERE " + this->m_pImpl->getSqlWhereOwner_ManyToMany() + " AND (";
+         if (iDataCount == 1) { sql += this->m_pImpl->m_sExtraTable + "." + lstForeignKeyDataType.at(0) + " IN ("; }
+         for (int r = 0; r < iRows; r++)
+         {
+            QString sAppend = "_" + QString::number(r);
+            if (iDataCount == 1) { sql += ((r > 0) ? QStringLiteral(", ") : QString()) + pIdData->getSqlPlaceHolder(sAppend, 0, QString(), this->m_pImpl->m_sForeignKeyDataType); continue; }
+            sql += ((r > 0) ? QStringLiteral(" OR (") : QStringLiteral("("));
+            for (int i = 0; i < iDataCount; i++) { sql += ((i > 0) ? QStringLiteral(" AND ") : QString()) + this->m_pImpl->m_sExtraTable + "." + lstForeignKeyDataType.at(i) + " = " + pIdData->getSqlPlaceHolder(sAppend, i, QString(), this->m_pImpl->m_sForeignKeyDataType); }
+            sql += ")";
+         }
+         sql += ((iDataCount == 1) ? QStringLiteral("))") : QStringLiteral(")"));
+         if (this->traceSqlQuery()) { qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql)); }
+         if (! queryDelete.prepare(sql)) { return queryDelete.lastError(); }
+         iCurrRows = iRows;
+      }
+
+      pIdOwner->setSqlPlaceHolder(queryDelete, params.owner());
+      for (int r = 0; r < iRows; r++)
+      {
+         QString sAppend = "_" + QString::number(r);
+         for (int i = 0; i < iDataCount; i++)
+         { IxSqlRelationImpl::bindValue(queryDelete, bQuestionMark, pIdData->getSqlPlaceHolder(sAppend, i, QString(), this->m_pImpl->m_sForeignKeyDataType), lstDataIds.at(((iFirst + r) * iDataCount) + i)); }
+      }
+      if (! queryDelete.exec()) { return queryDelete.lastError(); }
+   }
+   return QSqlError();
+}
+
+QSqlError IxSqlRelation::fetchFromExtraTable_ManyToMany(QxSqlRelationParams & params, QVariantList & lstDataIds) const
+{
+   IxDataMember * pIdOwner = this->getDataIdOwner(); qAssert(pIdOwner);
+   IxDataMember * pIdData = this->getDataId(); qAssert(pIdData);
+   if (! pIdOwner || ! pIdData) { return QSqlError(); }
+   QString sql = "SELECT " + pIdData->getSqlName(QStringLiteral(", "), this->m_pImpl->m_sForeignKeyDataType) + " FROM " + this->m_pImpl->m_sExtraTable;
+   sql += " WHERE " + this->m_pImpl->getSqlWhereOwner_ManyToMany();
+   if (this->traceSqlQuery()) { qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql)); }
+
+   QSqlQuery querySelect(params.database());
+   querySelect.setForwardOnly(true);
+   if (! querySelect.prepare(sql)) { return querySelect.lastError(); }
+   pIdOwner->setSqlPlaceHolder(querySelect, params.owner());
+   if (! querySelect.exec()) { return querySelect.lastError(); }
+   int iDataCount = pIdData->getNameCount();
+   while (querySelect.next()) { for (int i = 0; i < iDataCount; i++) { lstDataIds.append(querySelect.value(i)); } }
+   return QSqlError();
+}
+
+QSqlError IxSqlRelation::insertIntoExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const
+{
+   IxDataMember * pIdOwner = this->getDataIdOwner(); qAssert(pIdOwner);
+   IxDataMember * pIdData = this->getDataId(); qAssert(pIdData);
+   if (! pIdOwner || ! pIdData) { return QSqlError(); }
+   int iOwnerCount = pIdOwner->getNameCount(); int iDataCount = pIdData->getNameCount();
+   int iRowsCount = ((iDataCount > 0) ? (lstDataIds.count() / iDataCount) : 0);
+   if (iRowsCount <= 0) { return QSqlError(); }
+   qAssert(iOwnerCount == this->m_pImpl->m_sForeignKeyOwner.split(QStringLiteral("|")).count());
+   qAssert(iDataCount == this->m_pImpl->m_sForeignKeyDataType.split(QStringLiteral("|")).count());
+
+   QVariantList lstOwnerIds;
+   for (int i = 0; i < iOwnerCount; i++) { lstOwnerIds.append(pIdOwner->toVariant(params.owner(), i, qx::cvt::context::e_database)); }
+   const QString & sForeignKeyOwner = this->m_pImpl->m_sForeignKeyOwner;
+   const QString & sForeignKeyDataType = this->m_pImpl->m_sForeignKeyDataType;
+   bool bQuestionMark = (qx::QxSqlDatabase::getSingleton()->getSqlPlaceHolderStyle() == qx::QxSqlDatabase::ph_style_question_mark);
+   qx::dao::detail::IxSqlGenerator * pSqlGenerator = qx::QxSqlDatabase::getSingleton()->getSqlGenerator();
+   QString sqlInsert = "INSERT INTO " + this->m_pImpl->m_sExtraTable + " (" + pIdOwner->getSqlName(QStringLiteral(", "), sForeignKeyOwner) + ", " + pIdData->getSqlName(QStringLiteral(", "), sForeignKeyDataType) + ") VALUES ";
+   QSqlQuery queryInsert(params.database());
+
+   if (pSqlGenerator && ! pSqlGenerator->getMultiRowInsertSupported())
+   {
+      // Database without multi-row VALUES syntax : 1 prepared statement executed with array binding (native batch if supported by the driver)
+      QString sql = sqlInsert + "(" + pIdOwner->getSqlPlaceHolder(QString(), -1, QStringLiteral(", "), sForeignKeyOwner) + ", " + pIdData->getSqlPlaceHolder(QString(), -1, QStringLiteral(", "), sForeignKeyDataType) + ")";
+      if (this->traceSqlQuery()) { qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql)); }
+      if (! queryInsert.prepare(sql)) { return queryInsert.lastError(); }
+      for (int i = 0; i < iOwnerCount; i++)
+      {
+         QVariantList lstValues; lstValues.reserve(iRowsCount);
+         for (int r = 0; r < iRowsCount; r++) { lstValues.append(lstOwnerIds.at(i)); }
+         IxSqlRelationImpl::bindValue(queryInsert, bQuestionMark, pIdOwner->getSqlPlaceHolder(QString(), i, QString(), sForeignKeyOwner), lstValues);
+      }
+      for (int i = 0; i < iDataCount; i++)
+      {
+         QVariantList lstValues; lstValues.reserve(iRowsCount);
+         for (int r = 0; r < iRowsCount; r++) { lstValues.append(lstDataIds.at((r * iDataCount) + i)); }
+         IxSqlRelationImpl::bindValue(queryInsert, bQuestionMark, pIdData->getSqlPlaceHolder(QString(), i, QString(), sForeignKeyDataType), lstValues);
+      }
+      if (! queryInsert.execBatch()) { return queryInsert.lastError(); }
+      return QSqlError();
+   }
+
+   int iRowsPerQuery = IxSqlRelationImpl::getRowsPerQuery((iOwnerCount + iDataCount), 0); int iCurrRows = 0;
+   for (int iFirst = 0; iFirst < iRowsCount; iFirst += iRowsPerQuery)
+   {
+      int iRows = qMin(iRowsPerQuery, (iRowsCount - iFirst));
+      if (iRows != iCurrRows)
+      {
+         QString sql = sqlInsert;
+         for (int r = 0; r < iRows; r++)
+         {
+            QString sAppend = "_" + QString::number(r);
+            sql += ((r > 0) ? QStringLiteral(", (") : QStringLiteral("("));
+            sql += pIdOwner->getSqlPlaceHolder(sAppend, -1, QStringLiteral(", "), sForeignKeyOwner) + ", " + pIdData->getSqlPlaceHolder(sAppend, -1, QStringLiteral(", "), sForeignKeyDataType) + ")";
+         }
+         if (this->traceSqlQuery()) { qDebug("[QxOrm] sql query (extra-table) : %s", qPrintable(sql)); }
+         if (! queryInsert.prepare(sql)) { return queryInsert.lastError(); }
+         iCurrRows = iRows;
+      }
+
+      for (int r = 0; r < iRows; r++)
+      {
+         QString sAppend = "_" + QString::number(r);
+         for (int i = 0; i < iOwnerCount; i++) { IxSqlRelationImpl::bindValue(queryInsert, bQuestionMark, pIdOwner->getSqlPlaceHolder(sAppend, i, QString(), sForeignKeyOwner), lstOwnerIds.at(i)); }
+         for (int i = 0; i < iDataCount; i++) { IxSqlRelationImpl::bindValue(queryInsert, bQuestionMark, pIdData->getSqlPlaceHolder(sAppend, i, QString(), sForeignKeyDataType), lstDataIds.at(((iFirst + r) * iDataCount) + i)); }
+      }
+      if (! queryInsert.exec()) { return queryInsert.lastError(); }
+   }
+   return QSqlError();
+}
+
+QSqlError IxSqlRelation::saveExtraTable_ManyToMany(QxSqlRelationParams & params, const QVariantList & lstDataIds) const
+{
+   QSqlError daoError;
+   if (! this->m_pImpl->m_bExtraTableDiffMode)
+   {
+      daoError = this->deleteFromExtraTable_ManyToMany(params); if (daoError.isValid()) { return daoError; }
+      return this->insertIntoExtraTable_ManyToMany(params, lstDataIds);
+   }
+
+   // Diff mode : compare with links already stored in database, then delete only removed links and insert only new links
+   IxDataMember * pIdData = this->getDataId(); qAssert(pIdData);
+   int iDataCount = (pIdData ? pIdData->getNameCount() : 0); if (iDataCount <= 0) { return QSqlError(); }
+   QVariantList lstExistingIds;
+   daoError = this->fetchFromExtraTable_ManyToMany(params, lstExistingIds); if (daoError.isValid()) { return daoError; }
+
+   // Keys of links are compared using the types of the values read from entities
+   QVector<int> lstTypes(iDataCount, static_cast<int>(QMetaType::UnknownType));
+   for (int i = 0; (i < iDataCount) && (i < lstDataIds.count()); i++) { lstTypes[i] = lstDataIds.at(i).userType(); }
+
+   QHash<QString, bool> lstExisting; // Value is true if link is still referenced by the relation container
+   for (int l = 0; (l + iDataCount) <= lstExistingIds.count(); l += iDataCount) { lstExisting.insert(IxSqlRelationImpl::getLinkKey(lstExistingIds, l, iDataCount, lstTypes), false); }
+
+   QVariantList lstToInsert; QSet<QString> lstKeysToInsert;
+   for (int l = 0; (l + iDataCount) <= lstDataIds.count(); l += iDataCount)
+   {
+      QString sKey = IxSqlRelationImpl::getLinkKey(lstDataIds, l, iDataCount, lstTypes);
+      QHash<QString, bool>::iterator itr = lstExisting.find(sKey);
+      if (itr != lstExisting.end()) { itr.value() = true; continue; }
+      if (lstKeysToInsert.contains(sKey)) { continue; }
+      lstKeysToInsert.insert(sKey);
+      for (int i = 0; i < iDataCount; i++) { lstToInsert.append(lstDataIds.at(l + i)); }
+   }
+
+   QVariantList lstToDelete;
+   for (int l = 0; (l + iDataCount) <= lstExistingIds.count(); l += iDataCount)
+   {
+      QHash<QString, bool>::iterator itr = lstExisting.find(IxSqlRelationImpl::getLinkKey(lstExistingIds, l, iDataCount, lstTypes));
+      if ((itr == lstExisting.end()) || itr.value()) { continue; }
+      itr.value() = true; // Delete each removed link only once
+      for (int i = 0; i < iDataCount; i++) { lstToDelete.append(lstExistingIds.at(l + i)); }
+   }
+
+   daoError = this->deleteFromExtraTable_ManyToMany(params, lstToDelete); if (daoError.isValid()) { return daoError; }
+   return this->insertIntoExtraTable_ManyToMany(params, lstToInsert);
+}
+
 bool IxSqlRelation::addLazyRelation(QxSqlRelationParams & params, IxSqlRelation * pRelation) const
 {
    if (! params.relationX() || ! pRelation || ! params.checkColumns(pRelation->getKey())) { return false; }
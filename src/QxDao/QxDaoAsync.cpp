@@ -84,6 +84,7 @@ void QxDaoAsync::startQuery() {
     qAssert(false);
     return;
   }
+  m_pDaoParams->traceContext = qx::QxTrace::currentContext();
   if (isRunning()) {
     Q_EMIT queryStarted(m_pDaoParams);
   } else {
@@ -409,7 +410,12 @@ QxDaoAsyncRunner::~QxDaoAsyncRunner() { ; }
 
 void QxDaoAsyncRunner::onQueryStarted(
     qx::dao::detail::QxDaoAsyncParams_ptr pDaoParams) {
+  qx::QxTraceContextScope traceScope(pDaoParams ? pDaoParams->traceContext
+                                                : qx::QxTrace::type_context());
+  qx::QxTraceSpan traceSpan("QxDaoAsync", "dao_async");
   QSqlError daoError = this->runQuery(pDaoParams);
+  traceSpan.setError(daoError.isValid());
+  traceSpan.end();
   Q_EMIT queryFinished(daoError, pDaoParams);
 }
 
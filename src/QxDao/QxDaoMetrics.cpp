@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/qhash.h>
+
+#include <QxDao/QxDaoMetrics.h>
+
+#include <QxCommon/QxThreadLocalAggregator.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxDaoMetrics)
+
+namespace qx {
+
+// Upper bounds (nano-seconds) of histograms buckets : from 50 micro-seconds to 5 seconds (last bucket is +Inf)
+static const qint64 g_lstDaoMetricsBounds[QxDaoMetrics::bucket_count - 1] = {
+   50000LL, 100000LL, 250000LL, 500000LL, 1000000LL, 2500000LL, 5000000LL, 10000000LL,
+   25000000LL, 50000000LL, 100000000LL, 250000000LL, 500000000LL, 1000000000LL, 2500000000LL, 5000000000LL };
+
+struct QxDaoMetrics_Key
+{
+   QString m_sClass; QString m_sOperation; QString m_sDatabase;
+   QxDaoMetrics_Key(const QString & sClass, const QString & sOperation, const QString & sDatabase) : m_sClass(sClass), m_sOperation(sOperation), m_sDatabase(sDatabase) { ; }
+   bool operator==(const QxDaoMetrics_Key & other) const { return ((m_sClass == other.m_sClass) && (m_sOperation == other.m_sOperation) && (m_sDatabase == other.m_sDatabase)); }
+};
+
+inline uint qHash(const QxDaoMetrics_Key & key, uint seed = 0)
+{ return (qHash(key.m_sClass, seed) ^ (qHash(key.m_sOperation, seed) * 31U) ^ (qHash(key.m_sDatabase, seed) * 17U)); }
+
+struct QxDaoMetrics::QxDaoMetricsImpl
+{
+
+   qx::QxThreadLocalAggregator<QxDaoMetrics_Key, QxDaoMetrics::type_entry> m_aggregator; //!< Metrics recorded by each thread
+
+   QxDaoMetricsImpl() { ; }
+   ~QxDaoMetricsImpl() { ; }
+
+   QxDaoMetrics::type_snapshot snapshot(bool bReset)
+   {
+      QxDaoMetrics::type_snapshot lst = m_aggregator.snapshot(bReset).values();
+      std::sort(lst.begin(), lst.end(), [](const QxDaoMetrics::type_entry & e1, const QxDaoMetrics::type_entry & e2) {
+         if (e1.m_sClass != e2.m_sClass) { return (e1.m_sClass < e2.m_sClass); }
+         if (e1.m_sOperation != e2.m_sOperation) { return (e1.m_sOperation < e2.m_sOperation); }
+         return (e1.m_sDatabase < e2.m_sDatabase);
+      });
+      return lst;
+   }
+
+};
+
+QxDaoMetrics::type_histogram::type_histogram() : m_iCount(0), m_iSum(0), m_iMax(0)
+{
+   for (int i = 0; i < bucket_count; i++) { m_lstBucket[i] = 0; }
+}
+
+void QxDaoMetrics::type_histogram::add(qint64 iValue)
+{
+   int idx = 0;
+   while ((idx < (bucket_count - 1)) && (iValue > g_lstDaoMetricsBounds[idx])) { idx++; }
+   m_lstBucket[idx]++; m_iCount++; m_iSum += iValue;
+   if (iValue > m_iMax) { m_iMax = iValue; }
+}
+
+void QxDaoMetrics::type_histogram::merge(const type_histogram & other)
+{
+   for (int i = 0; i < bucket_count; i++) { m_lstBucket[i] += other.m_lstBucket[i]; }
+   m_iCount += other.m_iCount; m_iSum += other.m_iSum;
+   if (other.m_iMax > m_iMax) { m_iMax = other.m_iMax; }
+}
+
+QxDaoMetrics::type_entry::type_entry() : m_iCalls(0), m_iRows(0), m_iErrors(0) { ; }
+
+void QxDaoMetrics::type_entry::merge(const type_entry & other)
+{
+   m_iCalls += other.m_iCalls; m_iRows += other.m_iRows; m_iErrors += other.m_iErrors;
+   for (int i = 0; i < metric_count; i++) { m_lstTimer[i].merge(other.m_lstTimer[i]); }
+}
+
+QxDaoMetrics::QxDaoMetrics() : QxSingleton<QxDaoMetrics>(QStringLiteral("qx::QxDaoMetrics")), m_pImpl(new QxDaoMetricsImpl()) { ; }
+
+QxDaoMetrics::~QxDaoMetrics() { ; }
+
+void QxDaoMetrics::record(const QString & sClass, const QString & sOperation, const QString & sDatabase, const qint64 * pTimers, qint64 iRows, bool bError)
+{
+   m_pImpl->m_aggregator.update(QxDaoMetrics_Key(sClass, sOperation, sDatabase), [&](type_entry & entry, bool bInserted) {
+      if (bInserted) { entry.m_sClass = sClass; entry.m_sOperation = sOperation; entry.m_sDatabase = sDatabase; }
+      entry.m_iCalls++; entry.m_iRows += iRows;
+      if (bError) { entry.m_iErrors++; }
+      for (int i = 0; i < metric_count; i++) { if (pTimers && (pTimers[i] > 0)) { entry.m_lstTimer[i].add(pTimers[i]); } }
+   });
+}
+
+QxDaoMetrics::type_snapshot QxDaoMetrics::snapshot() const { return m_pImpl->snapshot(false); }
+
+QxDaoMetrics::type_snapshot QxDaoMetrics::snapshotAndReset() { return m_pImpl->snapshot(true); }
+
+void QxDaoMetrics::reset() { m_pImpl->snapshot(true); }
+
+const qint64 * QxDaoMetrics::getBucketBounds() { return g_lstDaoMetricsBounds; }
+
+QString QxDaoMetrics::getMetricName(metric_type e)
+{
+   switch (e)
+   {
+      case metric_total:                  return QStringLiteral("total");
+      case metric_db_exec:                return QStringLiteral("db_exec");
+      case metric_db_next:                return QStringLiteral("db_next");
+      case metric_db_prepare:             return QStringLiteral("db_prepare");
+      case metric_cpp_build_hierarchy:    return QStringLiteral("cpp_build_hierarchy");
+      case metric_cpp_build_instance:     return QStringLiteral("cpp_build_instance");
+      case metric_cpp_read_instance:      return QStringLiteral("cpp_read_instance");
+      case metric_build_sql:              return QStringLiteral("build_sql");
+      case metric_db_open:                return QStringLiteral("db_open");
+      case metric_db_transaction:         return QStringLiteral("db_transaction");
+      default:                            break;
+   }
+   return QString();
+}
+
+} // namespace qx
@@ -0,0 +1,194 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <thread>
+
+#include <QtCore/quuid.h>
+#include <QtCore/qthread.h>
+
+#include <QxDao/QxDaoParallel.h>
+#include <QxDao/QxSqlDatabase.h>
+
+#include <QxDataMember/IxDataMember.h>
+
+#include <QxCommon/QxTrace.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+QSqlError QxDaoParallel_Helper::getRanges(QSqlDatabase * pDatabase, const QString & sTable, const QString & sColumn, int iCount, QList<QxDaoParallel_Helper::type_range> & lstRanges)
+{
+   lstRanges.clear();
+   QSqlError dbError;
+   QSqlDatabase db = (pDatabase ? (* pDatabase) : qx::QxSqlDatabase::getDatabase(dbError));
+   if (dbError.isValid()) { return dbError; }
+
+   // Ranges are computed on the whole table (without WHERE clause of the query) : first range has no lower bound (to get NULL values too), last range has no upper bound
+   QString sColumnSql = qx::IxDataMember::getSqlColumnName(sColumn);
+   QString sql = "SELECT MIN(" + sColumnSql + "), MAX(" + sColumnSql + ") FROM " + qx::IxDataMember::getSqlFromTable(sTable);
+   QSqlQuery query(db); query.setForwardOnly(true);
+   if (! query.exec(sql)) { return query.lastError(); }
+   if (! query.next()) { return QSqlError(); }
+   QVariant vMin = query.value(0); QVariant vMax = query.value(1);
+   if (vMin.isNull() || vMax.isNull() || (iCount <= 1)) { return QSqlError(); }
+
+   bool bMin = false; bool bMax = false;
+   bool bDouble = ((vMin.type() == QVariant::Double) || (vMax.type() == QVariant::Double));
+   qlonglong lMin = vMin.toLongLong(& bMin); qlonglong lMax = vMax.toLongLong(& bMax);
+   if (! bDouble && bMin && bMax)
+   {
+      double dSpan = (static_cast<double>(lMax) - static_cast<double>(lMin) + 1.0);
+      if (dSpan < static_cast<double>(iCount)) { iCount = static_cast<int>(dSpan); }
+      if (iCount <= 1) { return QSqlError(); }
+      qlonglong lStep = static_cast<qlonglong>(dSpan / iCount);
+      QVariant vFrom;
+      for (int i = 1; i < iCount; i++)
+      {
+         QVariant vTo = QVariant(lMin + (lStep * i));
+         lstRanges.append(type_range(vFrom, vTo)); vFrom = vTo;
+      }
+      lstRanges.append(type_range(vFrom, QVariant()));
+      return QSqlError();
+   }
+
+   double dMin = vMin.toDouble(& bMin); double dMax = vMax.toDouble(& bMax);
+   if (! bMin || ! bMax || (dMax <= dMin))
+   {
+      if (! bMin || ! bMax) { qDebug("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : partition column '%s' is not numeric, query is not split", qPrintable(sColumn)); }
+      return QSqlError();
+   }
+   double dStep = ((dMax - dMin) / iCount);
+   QVariant vFrom;
+   for (int i = 1; i < iCount; i++)
+   {
+      QVariant vTo = QVariant(dMin + (dStep * i));
+      lstRanges.append(type_range(vFrom, vTo)); vFrom = vTo;
+   }
+   lstRanges.append(type_range(vFrom, QVariant()));
+   return QSqlError();
+}
+
+QSqlError QxDaoParallel_Helper::run(QSqlDatabase * pDatabase, int iCount, const QxDaoParallel_Helper::type_fct_part & fct)
+{
+   QSqlError dbError;
+   QSqlDatabase source = (pDatabase ? (* pDatabase) : qx::QxSqlDatabase::getDatabase(dbError));
+   if (dbError.isValid()) { return dbError; }
+   if (! source.isValid()) { return QSqlError("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : 'invalid connection to database'", "", QSqlError::ConnectionError); }
+   if (! fct || (iCount <= 0)) { return QSqlError(); }
+
+#if (QT_VERSION < 0x050D00)
+   // Before Qt 5.13, a connection cannot be cloned from another thread, and a connection cloned here cannot be used by another thread : parts are fetched sequentially with the connection of the caller
+   for (int i = 0; i < iCount; i++)
+   {
+      QSqlError err;
+      try { err = fct(i, source); }
+      catch (const std::exception & e) { err = QSqlError(QString("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : exception thrown by part ") + QString::number(i) + " : " + e.what(), "", QSqlError::UnknownError); }
+      catch (...) { err = QSqlError(QString("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : unknown exception thrown by part ") + QString::number(i), "", QSqlError::UnknownError); }
+      if (err.isValid()) { return err; }
+   }
+   return QSqlError();
+#else // (QT_VERSION < 0x050D00)
+   // Number of threads is bounded by the number of cores : each thread gets its own connection and fetches parts until all parts are done
+   int iThreadCount = qMin(iCount, qMax(1, QThread::idealThreadCount()));
+   QVector<QSqlError> lstErrors(iCount);
+   QString sKeyPrefix = "qx_parallel_" + QUuid::createUuid().toString() + "_";
+   QStringList lstKeys;
+   for (int t = 0; t < iThreadCount; t++) { lstKeys.append(sKeyPrefix + QString::number(t)); }
+
+   // Since Qt 5.13, a connection can be cloned by its name from any thread : each thread clones its own connection
+   QString sSourceName = source.connectionName();
+
+   QAtomicInt iNextPart(0);
+   qx::QxSqlDatabase::type_fct_db_open fctOpen = qx::QxSqlDatabase::getSingleton()->getFctDatabaseOpen();
+   qx::QxTrace::type_context traceContext = qx::QxTrace::currentContext(); // Each part belongs to the trace of the caller thread
+   std::vector<std::thread> lstThreads; lstThreads.reserve(iThreadCount);
+   for (int t = 0; t < iThreadCount; t++)
+   {
+      lstThreads.push_back(std::thread([&, t]() {
+         qx::QxTraceContextScope traceScope(traceContext);
+         QSqlDatabase db = QSqlDatabase::cloneDatabase(sSourceName, lstKeys.at(t));
+         bool bOpened = db.open();
+         if (bOpened && fctOpen) { fctOpen(db); }
+         for (int i = iNextPart.fetchAndAddOrdered(1); i < iCount; i = iNextPart.fetchAndAddOrdered(1))
+         {
+            if (! bOpened) { lstErrors[i] = db.lastError(); continue; }
+            try { lstErrors[i] = fct(i, db); }
+            catch (const std::exception & e) { lstErrors[i] = QSqlError(QString("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : exception thrown by part ") + QString::number(i) + " : " + e.what(), "", QSqlError::UnknownError); }
+            catch (...) { lstErrors[i] = QSqlError(QString("[QxOrm] qx::dao::detail::QxDaoParallel_Helper : unknown exception thrown by part ") + QString::number(i), "", QSqlError::UnknownError); }
+         }
+         db.close();
+      }));
+   }
+   for (std::thread & th : lstThreads) { th.join(); }
+   for (int t = 0; t < iThreadCount; t++) { QSqlDatabase::removeDatabase(lstKeys.at(t)); }
+
+   for (int i = 0; i < lstErrors.count(); i++)
+   { if (lstErrors.at(i).isValid()) { return lstErrors.at(i); } }
+   return QSqlError();
+#endif // (QT_VERSION < 0x050D00)
+}
+
+int QxDaoParallel_Helper::compare(const QVariant & v1, const QVariant & v2)
+{
+   // NULL values first (same as ORDER BY ... ASC with SQLite, MySQL and SQL Server)
+   if (v1.isNull() || v2.isNull()) { return (v1.isNull() ? (v2.isNull() ? 0 : -1) : 1); }
+
+   switch (v1.type())
+   {
+      case QVariant::Int: case QVariant::UInt: case QVariant::LongLong: case QVariant::ULongLong: case QVariant::Bool:
+      {
+         if (v2.type() == QVariant::Double) { double d1 = v1.toDouble(); double d2 = v2.toDouble(); return ((d1 < d2) ? -1 : ((d1 > d2) ? 1 : 0)); }
+         qlonglong l1 = v1.toLongLong(); qlonglong l2 = v2.toLongLong(); return ((l1 < l2) ? -1 : ((l1 > l2) ? 1 : 0));
+      }
+      case QVariant::Double:
+      { double d1 = v1.toDouble(); double d2 = v2.toDouble(); return ((d1 < d2) ? -1 : ((d1 > d2) ? 1 : 0)); }
+      case QVariant::Date:
+      { QDate d1 = v1.toDate(); QDate d2 = v2.toDate(); return ((d1 < d2) ? -1 : ((d1 > d2) ? 1 : 0)); }
+      case QVariant::Time:
+      { QTime t1 = v1.toTime(); QTime t2 = v2.toTime(); return ((t1 < t2) ? -1 : ((t1 > t2) ? 1 : 0)); }
+      case QVariant::DateTime:
+      { QDateTime dt1 = v1.toDateTime(); QDateTime dt2 = v2.toDateTime(); return ((dt1 < dt2) ? -1 : ((dt1 > dt2) ? 1 : 0)); }
+      default:
+         break;
+   }
+
+   // Binary comparison of strings : can be different from the collation used by the database
+   return v1.toString().compare(v2.toString());
+}
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/qdatastream.h>
+
+#include <QxDao/QxDao_IsDirty.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+static inline qulonglong qxSnapshotHash(const char * p, int iSize)
+{
+   // FNV-1a 64 bits : fast and stable (doesn't depend on qHash() random seed)
+   qulonglong h = 14695981039346656037ULL;
+   for (int i = 0; i < iSize; ++i) { h ^= static_cast<uchar>(p[i]); h *= 1099511628211ULL; }
+   return (h ^ static_cast<qulonglong>(iSize));
+}
+
+QVariant QxDao_Snapshot::fingerprint(const qx::IxDataMember * p, const void * pOwner)
+{
+   if (! p) { return QVariant(); }
+   QVariant v = p->toVariant(pOwner);
+   if (v.isNull()) { return v; }
+
+   switch (static_cast<int>(v.type()))
+   {
+      case QMetaType::Bool: case QMetaType::Int: case QMetaType::UInt:
+      case QMetaType::LongLong: case QMetaType::ULongLong: case QMetaType::Double:
+      case QMetaType::Long: case QMetaType::ULong: case QMetaType::Short: case QMetaType::UShort:
+      case QMetaType::Char: case QMetaType::SChar: case QMetaType::UChar: case QMetaType::Float:
+      case QMetaType::QChar: case QMetaType::QDate: case QMetaType::QTime: case QMetaType::QDateTime:
+      case QMetaType::QUuid:
+         return v;
+      case QMetaType::QString:
+      {
+         QString s = v.toString();
+         return QVariant(qxSnapshotHash(reinterpret_cast<const char *>(s.constData()), (s.size() * static_cast<int>(sizeof(QChar)))));
+      }
+      case QMetaType::QByteArray:
+      {
+         QByteArray b = v.toByteArray();
+         return QVariant(qxSnapshotHash(b.constData(), b.size()));
+      }
+      default:
+         break;
+   }
+
+   QByteArray bytes;
+   {
+      QDataStream stream((& bytes), QIODevice::WriteOnly);
+      stream << v;
+   }
+   return QVariant(qxSnapshotHash(bytes.constData(), bytes.size()));
+}
+
+QxDao_Snapshot::type_fingerprint QxDao_Snapshot::fingerprint(const QList<qx::IxDataMember *> & lst, const void * pOwner)
+{
+   type_fingerprint f;
+   f.reserve(lst.count());
+   for (qx::IxDataMember * p : lst) { f.append(QxDao_Snapshot::fingerprint(p, pOwner)); }
+   return f;
+}
+
+void QxDao_Snapshot::compare(const QList<qx::IxDataMember *> & lst, const void * pOwner, const type_fingerprint & f, QStringList & lstDiff)
+{
+   if (f.count() != lst.count()) { lstDiff.append(QStringLiteral("*")); return; }
+   for (int i = 0; i < lst.count(); ++i)
+   {
+      qx::IxDataMember * p = lst.at(i);
+      if (p && (QxDao_Snapshot::fingerprint(p, pOwner) != f.at(i))) { lstDiff.append(p->getKey()); }
+   }
+}
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
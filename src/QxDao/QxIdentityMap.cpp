@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qthreadstorage.h>
+
+#include <QxDao/QxIdentityMap.h>
+
+#include <QxRegister/IxClass.h>
+
+#include <QxDataMember/IxDataMemberX.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+struct QxIdentityMap_Current
+{
+   QxIdentityMap * m_pMap;
+   QxIdentityMap_Current() : m_pMap(NULL) { ; }
+};
+
+// Number of identity maps installed in all threads : no thread storage lookup while no session uses an identity map
+static QAtomicInt g_iIdentityMapInstalled(0);
+
+static QThreadStorage<QxIdentityMap_Current> & getIdentityMapStorage()
+{
+   static QThreadStorage<QxIdentityMap_Current> storage;
+   return storage;
+}
+
+QxIdentityMap::QxIdentityMap() { ; }
+
+QxIdentityMap::~QxIdentityMap() { ; }
+
+long QxIdentityMap::count() const { return static_cast<long>(m_hashEntities.count()); }
+
+void QxIdentityMap::clear() { m_hashEntities.clear(); }
+
+void QxIdentityMap::remove(qx::IxClass * pClass, const void * pOwner, bool bOtherInstanceOnly)
+{
+   QString sKey = getIdKey(pClass, pOwner);
+   if (sKey.isEmpty()) { return; }
+   QHash<QString, type_entry>::iterator itr = m_hashEntities.find(sKey);
+   if (itr == m_hashEntities.end()) { return; }
+   // The instance shared is already up to date if it is the one written to database
+   if (bOtherInstanceOnly && (itr.value().m_pEntity == pOwner)) { return; }
+   m_hashEntities.erase(itr);
+}
+
+QxIdentityMap * QxIdentityMap::getCurrent()
+{
+   if (g_iIdentityMapInstalled.loadAcquire() <= 0) { return NULL; }
+   QThreadStorage<QxIdentityMap_Current> & storage = getIdentityMapStorage();
+   return (storage.hasLocalData() ? storage.localData().m_pMap : NULL);
+}
+
+void QxIdentityMap::setCurrent(QxIdentityMap * pMap)
+{
+   QThreadStorage<QxIdentityMap_Current> & storage = getIdentityMapStorage();
+   QxIdentityMap * pOld = (storage.hasLocalData() ? storage.localData().m_pMap : NULL);
+   if (pOld == pMap) { return; }
+   if (pOld) { g_iIdentityMapInstalled.fetchAndAddOrdered(-1); }
+   if (pMap) { g_iIdentityMapInstalled.fetchAndAddOrdered(1); }
+   QxIdentityMap_Current current; current.m_pMap = pMap;
+   storage.setLocalData(current);
+}
+
+QString QxIdentityMap::getIdKey(qx::IxClass * pClass, const void * pOwner)
+{
+   IxDataMemberX * pDataMemberX = (pClass ? pClass->getDataMemberX() : NULL);
+   IxDataMember * pId = (pDataMemberX ? pDataMemberX->getId_WithDaoStrategy() : NULL);
+   if (! pId || ! pOwner) { return QString(); }
+
+   QVariantList lstId;
+   for (int i = 0; i < pId->getNameCount(); i++) { lstId.append(pId->toVariant(pOwner, i, qx::cvt::context::e_database)); }
+   return getIdKey(pClass, lstId);
+}
+
+QString QxIdentityMap::getIdKey(qx::IxClass * pClass, const QVariantList & lstId)
+{
+   if (! pClass || lstId.isEmpty()) { return QString(); }
+   QString sKey = pClass->getKey();
+   for (int i = 0; i < lstId.count(); i++)
+   {
+      const QVariant & v = lstId.at(i); QString s = v.toString();
+      if (v.isNull() || s.isEmpty() || (s == QStringLiteral("0"))) { return QString(); }
+      sKey += QStringLiteral("|") + s;
+   }
+   return sKey;
+}
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
@@ -38,26 +38,26 @@
 
 namespace qx {
 
-QxSession::QxSession() : m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false)
+QxSession::QxSession() : m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false), m_pIdentityMapPrevious(NULL)
 {
    m_database = qx::QxSqlDatabase::getDatabaseCloned();
    m_bThrowable = qx::QxSqlDatabase::getSingleton()->getSessionThrowable();
    if (qx::QxSqlDatabase::getSingleton()->getSessionAutoTransaction()) { open(); }
 }
 
-QxSession::QxSession(const QSqlDatabase & database) : m_database(database), m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false)
+QxSession::QxSession(const QSqlDatabase & database) : m_database(database), m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false), m_pIdentityMapPrevious(NULL)
 {
    m_bThrowable = qx::QxSqlDatabase::getSingleton()->getSessionThrowable();
    if (qx::QxSqlDatabase::getSingleton()->getSessionAutoTransaction()) { open(); }
 }
 
-QxSession::QxSession(const QSqlDatabase & database, bool bOpenTransaction) : m_database(database), m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false)
+QxSession::QxSession(const QSqlDatabase & database, bool bOpenTransaction) : m_database(database), m_bTransaction(false), m_bThrowInEvent(false), m_bAutoOpenClose(false), m_pIdentityMapPrevious(NULL)
 {
    m_bThrowable = qx::QxSqlDatabase::getSingleton()->getSessionThrowable();
    if (bOpenTransaction) { open(); }
 }
 
-QxSession::QxSession(const QSqlDatabase & database, bool bOpenTransaction, bool bThrowable) : m_database(database), m_bTransaction(false), m_bThrowable(bThrowable), m_bThrowInEvent(false), m_bAutoOpenClose(false)
+QxSession::QxSession(const QSqlDatabase & database, bool bOpenTransaction, bool bThrowable) : m_database(database), m_bTransaction(false), m_bThrowable(bThrowable), m_bThrowInEvent(false), m_bAutoOpenClose(false), m_pIdentityMapPrevious(NULL)
 {
    if (bOpenTransaction) { open(); }
 }
@@ -74,6 +74,13 @@ bool QxSession::open()
 bool QxSession::close()
 {
    bool bCloseOk = true;
+   if (m_pUnitOfWork && isValid())
+   {
+      // Called by destructor : an error flushing pending changes is stored (so transaction is rolled back) but no exception is thrown
+      try { flush(); }
+      catch (const qx::dao::sql_error & err) { Q_UNUSED(err); }
+   }
+   if (m_pUnitOfWork) { m_pUnitOfWork->clear(); }
    if (m_bTransaction && isValid()) { bCloseOk = commit(); }
    else if (m_bTransaction) { bCloseOk = rollback(); }
    if (m_bAutoOpenClose) { m_database.close(); m_bAutoOpenClose = false; }
@@ -82,6 +89,7 @@ bool QxSession::close()
 
 bool QxSession::commit()
 {
+   if (m_pUnitOfWork && isValid() && ! flush()) { return false; }
    if (m_bTransaction && ! isValid()) { qDebug("[QxOrm] %s", "qx::QxSession is not valid and 'commit()' method is called"); }
    if (! m_bTransaction) { clear(); return false; }
    bool bCommit = m_database.commit();
@@ -93,6 +101,8 @@ bool QxSession::commit()
 
 bool QxSession::rollback()
 {
+   if (m_pUnitOfWork) { m_pUnitOfWork->clear(); }
+   if (m_pIdentityMap) { m_pIdentityMap->clear(); }
    if (! m_bTransaction) { clear(); return false; }
    qDebug("[QxOrm] qx::QxSession : '%s'", "rollback transaction");
    bool bRollback = m_database.rollback();
@@ -102,6 +112,37 @@ bool QxSession::rollback()
    return false;
 }
 
+bool QxSession::flush()
+{
+   if (! m_pUnitOfWork || m_pUnitOfWork->isEmpty()) { return true; }
+   QSqlError err = m_pUnitOfWork->flush(this->database());
+   if (! err.isValid()) { return true; }
+   appendSqlError(err);
+   return false;
+}
+
+void QxSession::setDeferred(bool b)
+{
+   if (b && ! m_pUnitOfWork) { m_pUnitOfWork = std::make_shared<qx::dao::detail::QxUnitOfWork>(); }
+   else if (! b && m_pUnitOfWork) { flush(); m_pUnitOfWork.reset(); }
+}
+
+void QxSession::setIdentityMap(bool b)
+{
+   if (b && ! m_pIdentityMap)
+   {
+      m_pIdentityMap = std::make_shared<qx::dao::detail::QxIdentityMap>();
+      m_pIdentityMapPrevious = qx::dao::detail::QxIdentityMap::getCurrent();
+      qx::dao::detail::QxIdentityMap::setCurrent(m_pIdentityMap.get());
+   }
+   else if (! b && m_pIdentityMap)
+   {
+      // Restore identity map of the outer session (only if this one is still installed for current thread)
+      if (qx::dao::detail::QxIdentityMap::getCurrent() == m_pIdentityMap.get()) { qx::dao::detail::QxIdentityMap::setCurrent(m_pIdentityMapPrevious); }
+      m_pIdentityMap.reset(); m_pIdentityMapPrevious = NULL;
+   }
+}
+
 void QxSession::appendSqlError(const QSqlError & err)
 {
    if (! err.isValid()) { return; }
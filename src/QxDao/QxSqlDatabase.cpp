@@ -55,7 +55,8 @@
       m_bAddSqlSquareBracketsForColumnName(false),                             \
       m_bFormatSqlQueryBeforeLogging(false),                                   \
       m_iTraceSqlOnlySlowQueriesDatabase(-1),                                  \
-      m_iTraceSqlOnlySlowQueriesTotal(-1), m_bDisplayTimerDetails(false)
+      m_iTraceSqlOnlySlowQueriesTotal(-1), m_bDisplayTimerDetails(false),      \
+      m_bRecycleDaoHelper(true), m_bDaoMetrics(false)
 
 QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxSqlDatabase)
 
@@ -142,6 +143,10 @@ struct QxSqlDatabase::QxSqlDatabaseImpl {
                                           //!< milliseconds)
   bool m_bDisplayTimerDetails; //!< Display in logs all timers details (exec(),
                                //!< next(), prepare(), open(), etc...)
+  bool m_bRecycleDaoHelper;    //!< Recycle (per thread) dao helpers and sql
+                               //!< query builders used by qx::dao functions
+  bool m_bDaoMetrics; //!< Record timers of qx::dao functions into
+                      //!< qx::QxDaoMetrics registry
 
   QHash<QPair<Qt::HANDLE, QString>, QVariant>
       m_lstSettingsByThread; //!< List of settings per thread (override global
@@ -587,6 +592,30 @@ bool QxSqlDatabase::getDisplayTimerDetails() const {
   return m_pImpl->m_bDisplayTimerDetails;
 }
 
+bool QxSqlDatabase::getRecycleDaoHelper() const {
+  if ((m_pImpl->m_lstSettingsByThread.count() <= 0) &&
+      (m_pImpl->m_lstSettingsByDatabase.count() <= 0)) {
+    return m_pImpl->m_bRecycleDaoHelper;
+  }
+  QVariant setting = m_pImpl->getSetting(QStringLiteral("RecycleDaoHelper"));
+  if (!setting.isNull()) {
+    return setting.toBool();
+  }
+  return m_pImpl->m_bRecycleDaoHelper;
+}
+
+bool QxSqlDatabase::getDaoMetrics() const {
+  if ((m_pImpl->m_lstSettingsByThread.count() <= 0) &&
+      (m_pImpl->m_lstSettingsByDatabase.count() <= 0)) {
+    return m_pImpl->m_bDaoMetrics;
+  }
+  QVariant setting = m_pImpl->getSetting(QStringLiteral("DaoMetrics"));
+  if (!setting.isNull()) {
+    return setting.toBool();
+  }
+  return m_pImpl->m_bDaoMetrics;
+}
+
 void QxSqlDatabase::setDriverName(
     const QString &s, bool bJustForCurrentThread /* = false */,
     QSqlDatabase *pJustForThisDatabase /* = NULL */) {
@@ -930,6 +959,25 @@ void QxSqlDatabase::setDisplayTimerDetails(
   }
 }
 
+void QxSqlDatabase::setRecycleDaoHelper(
+    bool b, bool bJustForCurrentThread /* = false */,
+    QSqlDatabase *pJustForThisDatabase /* = NULL */) {
+  bool bUpdateGlobal = m_pImpl->setSetting(
+      QStringLiteral("RecycleDaoHelper"), b, bJustForCurrentThread, pJustForThisDatabase);
+  if (bUpdateGlobal) {
+    m_pImpl->m_bRecycleDaoHelper = b;
+  }
+}
+
+void QxSqlDatabase::setDaoMetrics(bool b, bool bJustForCurrentThread /* = false */,
+                                  QSqlDatabase *pJustForThisDatabase /* = NULL */) {
+  bool bUpdateGlobal = m_pImpl->setSetting(
+      QStringLiteral("DaoMetrics"), b, bJustForCurrentThread, pJustForThisDatabase);
+  if (bUpdateGlobal) {
+    m_pImpl->m_bDaoMetrics = b;
+  }
+}
+
 QSqlDatabase QxSqlDatabase::getDatabase(QSqlError &dbError) {
   return QxSqlDatabase::getSingleton()->m_pImpl->getDatabaseByCurrThreadId(
       dbError);
@@ -1185,6 +1233,32 @@ bool QxSqlDatabase::isEmpty() {
   return pSingleton->m_pImpl->m_lstDbByThread.isEmpty();
 }
 
+long QxSqlDatabase::getConnectionCount() {
+  qx::QxSqlDatabase *pSingleton = qx::QxSqlDatabase::getSingleton();
+  if (!pSingleton) {
+    qAssert(false);
+    return 0;
+  }
+  QMutexLocker locker(&pSingleton->m_pImpl->m_oDbMutex);
+  return static_cast<long>(pSingleton->m_pImpl->m_lstDbByThread.count());
+}
+
+QHash<QString, long> QxSqlDatabase::getConnectionCountByDatabaseKey() {
+  QHash<QString, long> lst;
+  qx::QxSqlDatabase *pSingleton = qx::QxSqlDatabase::getSingleton();
+  if (!pSingleton) {
+    qAssert(false);
+    return lst;
+  }
+  QMutexLocker locker(&pSingleton->m_pImpl->m_oDbMutex);
+  QString sDefaultKey = pSingleton->m_pImpl->computeDatabaseKey(NULL);
+  lst.insert(sDefaultKey, static_cast<long>(pSingleton->m_pImpl->m_lstDbByThread.count()));
+  Q_FOREACH (QString sDatabaseKey, pSingleton->m_pImpl->m_lstCurrDatabaseKeyByThread) {
+    lst[sDatabaseKey] += 1;
+  }
+  return lst;
+}
+
 bool QxSqlDatabase::setCurrentDatabaseByThread(QSqlDatabase *p) {
   if (!p) {
     return false;
@@ -76,6 +76,8 @@ void IxSqlElement::setValues(const QVariantList & values)
    m_lstValues = values;
 }
 
+QStringList IxSqlElement::getColumns() const { return m_lstColumns; }
+
 void IxSqlElement::clone(IxSqlElement * other)
 {
    if (! other) { return; }
@@ -119,6 +121,7 @@ IxSqlElement_ptr create_sql_element(IxSqlElement::type_class e)
       case IxSqlElement::_sql_is_null:          p = std::make_shared<QxSqlIsNull>(); break;
       case IxSqlElement::_sql_limit:            p = std::make_shared<QxSqlLimit>(); break;
       case IxSqlElement::_sql_sort:             p = std::make_shared<QxSqlSort>(); break;
+      case IxSqlElement::_sql_seek:             p = std::make_shared<QxSqlSeek>(); break;
       default:                                  qAssert(false);
    }
    return p;
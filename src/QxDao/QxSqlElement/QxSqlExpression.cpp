@@ -45,6 +45,8 @@ QxSqlExpression::QxSqlExpression(int index, QxSqlExpression::type t) : IxSqlElem
 
 QxSqlExpression::~QxSqlExpression() { ; }
 
+QxSqlExpression::type QxSqlExpression::getType() const { return m_type; }
+
 IxSqlElement::type_class QxSqlExpression::getTypeClass() const { return IxSqlElement::_sql_expression; }
 
 QString QxSqlExpression::toString() const
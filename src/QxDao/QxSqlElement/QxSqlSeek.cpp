@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QxDao/QxSqlElement/QxSqlSeek.h>
+
+#include <QxDao/QxSqlDatabase.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+QxSqlSeek::QxSqlSeek() : IxSqlElement(0), m_bDescending(false) { ; }
+
+QxSqlSeek::QxSqlSeek(int index, bool bDescending) : IxSqlElement(index), m_bDescending(bDescending) { ; }
+
+QxSqlSeek::~QxSqlSeek() { ; }
+
+IxSqlElement::type_class QxSqlSeek::getTypeClass() const { return IxSqlElement::_sql_seek; }
+
+bool QxSqlSeek::useRowValue() const { return ((m_lstColumns.count() > 1) && m_pSqlGenerator && m_pSqlGenerator->getRowValueCompareSupported()); }
+
+QString QxSqlSeek::getKey(int iTerm, int iColumn) const
+{
+   QString sKey(QStringLiteral("seek"));
+   sKey += "_" + QString::number(m_iIndex) + "_" + QString::number(iTerm) + "_" + QString::number(iColumn);
+   switch (qx::QxSqlDatabase::getSingleton()->getSqlPlaceHolderStyle())
+   {
+      case qx::QxSqlDatabase::ph_style_question_mark:    sKey = QStringLiteral("?");   break;
+      case qx::QxSqlDatabase::ph_style_at_name:          sKey = "@" + sKey;            break;
+      default:                                           sKey = ":" + sKey;            break;
+   }
+   return sKey;
+}
+
+QString QxSqlSeek::toString() const
+{
+   qAssert((m_lstColumns.count() >= 1) && (m_lstColumns.count() == m_lstValues.count()));
+   QString sOperator = (m_bDescending ? QStringLiteral(" < ") : QStringLiteral(" > "));
+   QString sReturn;
+
+   if (m_lstColumns.count() == 1) { return ("(" + m_lstColumns.at(0) + sOperator + getKey(0, 0) + ")"); }
+   if (useRowValue())
+   {
+      QString sKeys;
+      for (int i = 0; i < m_lstColumns.count(); i++) { sKeys += ((i == 0) ? QString() : QStringLiteral(", ")) + getKey(0, i); }
+      return ("((" + m_lstColumns.join(QStringLiteral(", ")) + ")" + sOperator + "(" + sKeys + "))");
+   }
+
+   for (int i = 0; i < m_lstColumns.count(); i++)
+   {
+      sReturn += ((i == 0) ? QStringLiteral("(") : QStringLiteral(" OR ("));
+      for (int j = 0; j < i; j++) { sReturn += m_lstColumns.at(j) + " = " + getKey(i, j) + " AND "; }
+      sReturn += m_lstColumns.at(i) + sOperator + getKey(i, i) + ")";
+   }
+   return ("(" + sReturn + ")");
+}
+
+void QxSqlSeek::resolve(QSqlQuery & query) const
+{
+   qAssert(m_lstColumns.count() == m_lstValues.count());
+   bool bQuestionMark = (qx::QxSqlDatabase::getSingleton()->getSqlPlaceHolderStyle() == qx::QxSqlDatabase::ph_style_question_mark);
+   bool bSingleTerm = ((m_lstColumns.count() == 1) || useRowValue());
+   int iTermCount = (bSingleTerm ? 1 : m_lstValues.count());
+
+   for (int i = 0; i < iTermCount; i++)
+   {
+      int iColumnCount = (bSingleTerm ? m_lstValues.count() : (i + 1));
+      for (int j = 0; j < iColumnCount; j++)
+      {
+         if (bQuestionMark) { query.addBindValue(m_lstValues.at(j)); }
+         else { query.bindValue(getKey(i, j), m_lstValues.at(j)); }
+      }
+   }
+}
+
+void QxSqlSeek::postProcess(QString & sql) const { Q_UNUSED(sql); }
+
+QString QxSqlSeek::getExtraSettings() const { return (m_bDescending ? QStringLiteral("1") : QStringLiteral("0")); }
+
+void QxSqlSeek::setExtraSettings(const QString & s) { m_bDescending = (s == QLatin1String("1")); }
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
@@ -45,6 +45,8 @@ QxSqlSort::QxSqlSort(int index, QxSqlSort::type t) : IxSqlElement(index), m_type
 
 QxSqlSort::~QxSqlSort() { ; }
 
+QxSqlSort::type QxSqlSort::getType() const { return m_type; }
+
 IxSqlElement::type_class QxSqlSort::getTypeClass() const { return IxSqlElement::_sql_sort; }
 
 QString QxSqlSort::toString() const
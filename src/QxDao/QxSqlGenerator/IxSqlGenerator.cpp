@@ -43,6 +43,16 @@ IxSqlGenerator::IxSqlGenerator() { ; }
 
 IxSqlGenerator::~IxSqlGenerator() { ; }
 
+int IxSqlGenerator::getMaxBindValues() const { return 0; }
+
+bool IxSqlGenerator::getRowValueInSupported() const { return false; }
+
+bool IxSqlGenerator::getMultiRowInsertSupported() const { return false; }
+
+int IxSqlGenerator::getMaxRowsPerInsert() const { return 0; }
+
+bool IxSqlGenerator::getRowValueCompareSupported() const { return false; }
+
 } // namespace detail
 } // namespace dao
 } // namespace qx
@@ -49,6 +49,10 @@ QxSqlGenerator_MSSQLServer::~QxSqlGenerator_MSSQLServer() { ; }
 
 void QxSqlGenerator_MSSQLServer::init() { qx::QxSqlDatabase::getSingleton()->setAddAutoIncrementIdToUpdateQuery(false); }
 
+int QxSqlGenerator_MSSQLServer::getMaxBindValues() const { return 2000; }
+
+int QxSqlGenerator_MSSQLServer::getMaxRowsPerInsert() const { return 1000; } // Table value constructor is limited to 1000 rows
+
 QString QxSqlGenerator_MSSQLServer::getLimit(const QxSqlLimit *pLimit) const
 {
     Q_UNUSED(pLimit); return QLatin1String("");
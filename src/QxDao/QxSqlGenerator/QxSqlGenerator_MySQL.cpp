@@ -45,6 +45,13 @@ QxSqlGenerator_MySQL::QxSqlGenerator_MySQL() : QxSqlGenerator_Standard() { this-
 
 QxSqlGenerator_MySQL::~QxSqlGenerator_MySQL() { ; }
 
+int QxSqlGenerator_MySQL::getMaxBindValues() const { return 65535; }
+
+bool QxSqlGenerator_MySQL::getRowValueInSupported() const { return true; }
+
+// '(a, b) > (?, ?)' is valid MySQL syntax but its optimizer doesn't always turn it into a range scan : keep the expanded form
+bool QxSqlGenerator_MySQL::getRowValueCompareSupported() const { return false; }
+
 QString QxSqlGenerator_MySQL::getAutoIncrement() const
 {
     return QStringLiteral("AUTO_INCREMENT");
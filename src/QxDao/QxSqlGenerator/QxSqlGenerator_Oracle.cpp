@@ -58,6 +58,12 @@ bool QxSqlGenerator_Oracle::getManageLastInsertId() const { return m_bManageLast
 
 void QxSqlGenerator_Oracle::setManageLastInsertId(bool b) { m_bManageLastInsertId = b; }
 
+int QxSqlGenerator_Oracle::getMaxBindValues() const { return 1000; }
+
+bool QxSqlGenerator_Oracle::getRowValueInSupported() const { return true; }
+
+bool QxSqlGenerator_Oracle::getMultiRowInsertSupported() const { return false; }
+
 QString QxSqlGenerator_Oracle::getTableAliasSep() const
 {
     return QStringLiteral(" ");
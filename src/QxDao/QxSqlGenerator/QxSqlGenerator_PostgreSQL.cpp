@@ -48,6 +48,12 @@ QxSqlGenerator_PostgreSQL::QxSqlGenerator_PostgreSQL() : QxSqlGenerator_Standard
 
 QxSqlGenerator_PostgreSQL::~QxSqlGenerator_PostgreSQL() { ; }
 
+int QxSqlGenerator_PostgreSQL::getMaxBindValues() const { return 32767; }
+
+bool QxSqlGenerator_PostgreSQL::getRowValueInSupported() const { return true; }
+
+bool QxSqlGenerator_PostgreSQL::getRowValueCompareSupported() const { return true; }
+
 void QxSqlGenerator_PostgreSQL::checkSqlInsert(IxDao_Helper * pDaoHelper, QString & sql) const
 {
    if (! pDaoHelper) { qAssert(false); return; }
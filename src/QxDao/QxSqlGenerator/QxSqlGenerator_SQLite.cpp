@@ -45,6 +45,10 @@ QxSqlGenerator_SQLite::QxSqlGenerator_SQLite() : QxSqlGenerator_Standard() { thi
 
 QxSqlGenerator_SQLite::~QxSqlGenerator_SQLite() { ; }
 
+bool QxSqlGenerator_SQLite::getRowValueInSupported() const { return true; }
+
+bool QxSqlGenerator_SQLite::getRowValueCompareSupported() const { return true; }
+
 void QxSqlGenerator_SQLite::initSqlTypeByClassName() const
 {
    QHash<QString, QString> * lstSqlType = qx::QxClassX::getAllSqlTypeByClassName();
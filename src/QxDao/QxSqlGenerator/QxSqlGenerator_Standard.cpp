@@ -102,6 +102,14 @@ void QxSqlGenerator_Standard::checkSqlInsert(IxDao_Helper * pDaoHelper, QString
 
 void QxSqlGenerator_Standard::onBeforeSqlPrepare(IxDao_Helper * pDaoHelper, QString & sql) const { Q_UNUSED(pDaoHelper); Q_UNUSED(sql); }
 
+int QxSqlGenerator_Standard::getMaxBindValues() const { return 999; }
+
+bool QxSqlGenerator_Standard::getRowValueInSupported() const { return false; }
+
+bool QxSqlGenerator_Standard::getMultiRowInsertSupported() const { return true; }
+
+bool QxSqlGenerator_Standard::getRowValueCompareSupported() const { return false; }
+
 void QxSqlGenerator_Standard::formatSqlQuery(IxDao_Helper * pDaoHelper, QString & sql) const
 {
    Q_UNUSED(pDaoHelper);
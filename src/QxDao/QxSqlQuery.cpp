@@ -235,6 +235,8 @@ bool QxSqlQuery::isEmpty() const {
 
 bool QxSqlQuery::isDistinct() const { return m_bDistinct; }
 
+bool QxSqlQuery::isCompiled() const { return (m_pCompiledPlan ? true : false); }
+
 void QxSqlQuery::clear() {
   m_sQuery.clear();
   m_lstValue.clear();
@@ -246,6 +248,8 @@ void QxSqlQuery::clear() {
   m_sType = QLatin1String("");
   m_lstJoinQueryUser.clear();
   m_lstJoinQueryToResolve.clear();
+  m_pCompiledPlan.reset();
+  m_lstCompiledValue.clear();
 }
 
 QxSqlQuery &QxSqlQuery::query(const QString &sQuery) {
@@ -524,6 +528,65 @@ void QxSqlQuery::dumpSqlResult() {
   qDebug("[QxOrm] end dump sql result : '%s'", qPrintable(sql));
 }
 
+QStringList QxSqlQuery::getKeysetColumns(bool *pDescending /* = NULL */) const {
+  QStringList lstColumns;
+  bool bDescending = false;
+  for (int i = 0; i < m_lstSqlElement.count(); i++) {
+    if (m_lstSqlElement.at(i)->getTypeClass() !=
+        qx::dao::detail::IxSqlElement::_sql_sort) {
+      continue;
+    }
+    qx::dao::detail::QxSqlSort *pSort =
+        static_cast<qx::dao::detail::QxSqlSort *>(m_lstSqlElement.at(i).get());
+    if (pSort->getType() == qx::dao::detail::QxSqlSort::_group_by) {
+      continue;
+    }
+    bool bDesc = (pSort->getType() == qx::dao::detail::QxSqlSort::_order_desc);
+    if ((lstColumns.count() > 0) && (bDesc != bDescending)) {
+      qDebug("[QxOrm] qx::QxSqlQuery::getKeysetColumns() : '%s'",
+             "keyset pagination requires the same direction for all ORDER BY "
+             "columns");
+      if (pDescending) {
+        (*pDescending) = false;
+      }
+      return QStringList();
+    }
+    bDescending = bDesc;
+    lstColumns << pSort->getColumns();
+  }
+  if (pDescending) {
+    (*pDescending) = bDescending;
+  }
+  return lstColumns;
+}
+
+QString QxSqlQuery::toCursorToken(const QVariantList &lastValues) {
+  QByteArray data;
+  QDataStream out(&data, QIODevice::WriteOnly);
+  out.setVersion(QDataStream::Qt_5_0);
+  out << lastValues;
+  return QString::fromLatin1(data.toBase64(QByteArray::Base64UrlEncoding |
+                                           QByteArray::OmitTrailingEquals));
+}
+
+QVariantList QxSqlQuery::fromCursorToken(const QString &token) {
+  QVariantList lastValues;
+  if (token.isEmpty()) {
+    return lastValues;
+  }
+  QByteArray data = QByteArray::fromBase64(token.toLatin1(),
+                                           QByteArray::Base64UrlEncoding);
+  QDataStream in(&data, QIODevice::ReadOnly);
+  in.setVersion(QDataStream::Qt_5_0);
+  in >> lastValues;
+  if (in.status() != QDataStream::Ok) {
+    qDebug("[QxOrm] qx::QxSqlQuery::fromCursorToken() : '%s'",
+           "invalid cursor token");
+    return QVariantList();
+  }
+  return lastValues;
+}
+
 void QxSqlQuery::postProcess(QString &sql) const {
   verifyQuery();
   for (int i = 0; i < m_lstSqlElement.count(); i++) {
@@ -776,6 +839,191 @@ QxSqlQuery &QxSqlQuery::limit(int rowsCount, int startRow /* = 0 */,
   return (*this);
 }
 
+QxSqlQuery &QxSqlQuery::after(const QVariantList &lastValues,
+                              int pageSize /* = 0 */) {
+  return after(QStringList(), lastValues, pageSize);
+}
+
+QxSqlQuery &QxSqlQuery::after(const QStringList &columns,
+                              const QVariantList &lastValues,
+                              int pageSize /* = 0 */) {
+  verifyQuery();
+  while (m_iParenthesisCount > 0) {
+    closeParenthesis();
+  }
+
+  bool bDescending = false;
+  QStringList lstColumns = getKeysetColumns(&bDescending);
+  if (lstColumns.isEmpty() && !columns.isEmpty()) {
+    orderAsc(columns);
+    lstColumns = columns;
+  } else if (!columns.isEmpty() && (columns != lstColumns)) {
+    qDebug("[QxOrm] qx::QxSqlQuery::after() : '%s'",
+           "keyset columns must be the same as ORDER BY columns");
+    qAssert(false);
+    return (*this);
+  }
+
+  if (lstColumns.isEmpty()) {
+    qDebug("[QxOrm] qx::QxSqlQuery::after() : '%s'",
+           "keyset pagination requires an ORDER BY clause");
+    qAssert(false);
+    return (*this);
+  }
+
+  if (pageSize > 0) {
+    for (int i = (m_lstSqlElement.count() - 1); i >= 0; i--) {
+      if (m_lstSqlElement.at(i)->getTypeClass() ==
+          qx::dao::detail::IxSqlElement::_sql_limit) {
+        m_lstSqlElement.removeAt(i);
+      }
+    }
+  }
+
+  // First page : no value to seek after
+  if (lastValues.isEmpty()) {
+    return ((pageSize > 0) ? limit(pageSize) : (*this));
+  }
+
+  if (lastValues.count() != lstColumns.count()) {
+    qDebug("[QxOrm] qx::QxSqlQuery::after() : '%s'",
+           "keyset values count doesn't match ORDER BY columns count");
+    qAssert(false);
+    return (*this);
+  }
+
+  qx::dao::detail::QxSqlSeek_ptr pSeek;
+  pSeek = std::make_shared<qx::dao::detail::QxSqlSeek>(m_iSqlElementIndex++,
+                                                       bDescending);
+  pSeek->setColumns(lstColumns);
+  pSeek->setValues(lastValues);
+  QList<qx::dao::detail::IxSqlElement_ptr> lstSeek;
+  lstSeek << pSeek;
+  insertCondition(lstSeek);
+  return ((pageSize > 0) ? limit(pageSize) : (*this));
+}
+
+QxSqlQuery &QxSqlQuery::partition(const QString &column, const QVariant &from,
+                                  const QVariant &to) {
+  verifyQuery();
+  while (m_iParenthesisCount > 0) {
+    closeParenthesis();
+  }
+
+  if (column.isEmpty() || !isPartitionable()) {
+    qDebug("[QxOrm] qx::QxSqlQuery::partition() : '%s'",
+           "a partition requires a column and a query built with C++ methods "
+           "(not a SQL string) without LIMIT clause");
+    qAssert(false);
+    return (*this);
+  }
+  if (from.isNull() && to.isNull()) {
+    return (*this);
+  }
+
+  QList<qx::dao::detail::IxSqlElement_ptr> lstCondition;
+  lstCondition << std::make_shared<qx::dao::detail::QxSqlExpression>(
+      m_iSqlElementIndex++,
+      qx::dao::detail::QxSqlExpression::_open_parenthesis);
+  if (!from.isNull()) {
+    qx::dao::detail::QxSqlCompare_ptr pFrom;
+    pFrom = std::make_shared<qx::dao::detail::QxSqlCompare>(
+        m_iSqlElementIndex++,
+        qx::dao::detail::QxSqlCompare::_is_greater_than_or_equal_to);
+    pFrom->setColumn(column);
+    pFrom->setValue(from);
+    lstCondition << pFrom;
+  }
+  if (!from.isNull() && !to.isNull()) {
+    lstCondition << std::make_shared<qx::dao::detail::QxSqlExpression>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlExpression::_and);
+  }
+  if (!to.isNull()) {
+    qx::dao::detail::QxSqlCompare_ptr pTo;
+    pTo = std::make_shared<qx::dao::detail::QxSqlCompare>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlCompare::_is_less_than);
+    pTo->setColumn(column);
+    pTo->setValue(to);
+    lstCondition << pTo;
+  }
+  if (from.isNull()) {
+    lstCondition << std::make_shared<qx::dao::detail::QxSqlExpression>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlExpression::_or);
+    qx::dao::detail::QxSqlIsNull_ptr pNull;
+    pNull = std::make_shared<qx::dao::detail::QxSqlIsNull>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlIsNull::_is_null);
+    pNull->setColumn(column);
+    lstCondition << pNull;
+  }
+  lstCondition << std::make_shared<qx::dao::detail::QxSqlExpression>(
+      m_iSqlElementIndex++,
+      qx::dao::detail::QxSqlExpression::_close_parenthesis);
+  insertCondition(lstCondition);
+  return (*this);
+}
+
+bool QxSqlQuery::isPartitionable() const {
+  if ((m_lstSqlElement.count() <= 0) && !queryAt(0).isEmpty()) {
+    return false;
+  }
+  for (int i = 0; i < m_lstSqlElement.count(); i++) {
+    if (m_lstSqlElement.at(i)->getTypeClass() ==
+        qx::dao::detail::IxSqlElement::_sql_limit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void QxSqlQuery::insertCondition(
+    const QList<qx::dao::detail::IxSqlElement_ptr> &lstCondition) {
+  // Condition must be inserted before ORDER BY / GROUP BY / LIMIT elements,
+  // existing WHERE clause is put inside parenthesis to keep OR operators out
+  // of the new condition
+  int iInsert = m_lstSqlElement.count();
+  int iWhere = -1;
+  for (int i = 0; i < m_lstSqlElement.count(); i++) {
+    qx::dao::detail::IxSqlElement::type_class eType =
+        m_lstSqlElement.at(i)->getTypeClass();
+    if ((eType == qx::dao::detail::IxSqlElement::_sql_sort) ||
+        (eType == qx::dao::detail::IxSqlElement::_sql_limit)) {
+      iInsert = i;
+      break;
+    }
+    if ((iWhere < 0) &&
+        (eType == qx::dao::detail::IxSqlElement::_sql_expression) &&
+        (static_cast<qx::dao::detail::QxSqlExpression *>(
+             m_lstSqlElement.at(i).get())
+             ->getType() == qx::dao::detail::QxSqlExpression::_where)) {
+      iWhere = i;
+    }
+  }
+
+  QList<qx::dao::detail::IxSqlElement_ptr> lstInsert;
+  if (iWhere >= 0) {
+    m_lstSqlElement.insert(
+        (iWhere + 1),
+        std::make_shared<qx::dao::detail::QxSqlExpression>(
+            m_iSqlElementIndex++,
+            qx::dao::detail::QxSqlExpression::_open_parenthesis));
+    iInsert++;
+    lstInsert << std::make_shared<qx::dao::detail::QxSqlExpression>(
+        m_iSqlElementIndex++,
+        qx::dao::detail::QxSqlExpression::_close_parenthesis);
+    lstInsert << std::make_shared<qx::dao::detail::QxSqlExpression>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlExpression::_and);
+  } else {
+    lstInsert << std::make_shared<qx::dao::detail::QxSqlExpression>(
+        m_iSqlElementIndex++, qx::dao::detail::QxSqlExpression::_where);
+  }
+  lstInsert << lstCondition;
+
+  for (int i = 0; i < lstInsert.count(); i++) {
+    m_lstSqlElement.insert((iInsert + i), lstInsert.at(i));
+  }
+  m_pSqlElementTemp.reset();
+}
+
 QxSqlQuery &QxSqlQuery::like(const QString &val) {
   return addSqlCompare(QVariant(val), qx::dao::detail::QxSqlCompare::_like);
 }
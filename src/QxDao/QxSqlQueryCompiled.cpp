@@ -0,0 +1,120 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QxDao/QxSqlQueryCompiled.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+
+QxSqlQueryCompiled::QxSqlQueryCompiled() : QxSqlQuery() { m_pCompiledPlan = std::make_shared<qx::dao::detail::QxSqlQueryCompiledPlan>(); }
+
+QxSqlQueryCompiled::QxSqlQueryCompiled(const qx::QxSqlQuery & query) : QxSqlQuery(query)
+{
+   m_pCompiledPlan = std::make_shared<qx::dao::detail::QxSqlQueryCompiledPlan>();
+   m_lstCompiledValue.clear();
+   while (m_iParenthesisCount > 0) { closeParenthesis(); }
+}
+
+QxSqlQueryCompiled::~QxSqlQueryCompiled() { ; }
+
+int QxSqlQueryCompiled::getSlotCount() const
+{
+   if (! m_pCompiledPlan) { return -1; }
+   QMutexLocker locker(& m_pCompiledPlan->m_mutex);
+   if (m_pCompiledPlan->m_lstEntry.isEmpty()) { return -1; }
+   return m_pCompiledPlan->m_lstEntry.constBegin().value().values.count();
+}
+
+QVariant QxSqlQueryCompiled::getValue(int slot) const { return m_lstCompiledValue.value(slot); }
+
+QxSqlQueryCompiled & QxSqlQueryCompiled::setValue(int slot, const QVariant & val)
+{
+   qAssert(slot >= 0);
+   m_lstCompiledValue.insert(slot, val);
+   return (* this);
+}
+
+QxSqlQueryCompiled & QxSqlQueryCompiled::setValues(const QVariantList & values)
+{
+   m_lstCompiledValue.clear();
+   for (int i = 0; i < values.count(); i++) { m_lstCompiledValue.insert(i, values.at(i)); }
+   return (* this);
+}
+
+void QxSqlQueryCompiled::clearValues() { m_lstCompiledValue.clear(); }
+
+bool QxSqlQueryCompiled::findSql(const qx::QxSqlQuery & query, const QString & sqlBase, QString & sql, QVector<QVariant> & values)
+{
+   if (! query.m_pCompiledPlan) { return false; }
+   QMutexLocker locker(& query.m_pCompiledPlan->m_mutex);
+   QHash<QString, qx::dao::detail::QxSqlQueryCompiledPlan::type_entry>::const_iterator itr = query.m_pCompiledPlan->m_lstEntry.constFind(sqlBase);
+   if (itr == query.m_pCompiledPlan->m_lstEntry.constEnd()) { return false; }
+   sql = itr.value().sql;
+   values = itr.value().values;
+   return true;
+}
+
+void QxSqlQueryCompiled::insertSql(const qx::QxSqlQuery & query, const QString & sqlBase, const QString & sql, QSqlQuery & q)
+{
+   if (! query.m_pCompiledPlan) { return; }
+
+   // Bind values have just been resolved by name from SQL elements : read them back by position to get the slots layout
+   qx::dao::detail::QxSqlQueryCompiledPlan::type_entry entry;
+   long lCount = q.boundValues().count();
+   entry.sql = sql;
+   entry.values.reserve(lCount);
+   for (int i = 0; i < lCount; i++) { entry.values.append(q.boundValue(i)); }
+
+   {
+      QMutexLocker locker(& query.m_pCompiledPlan->m_mutex);
+      query.m_pCompiledPlan->m_lstEntry.insert(sqlBase, entry);
+   }
+
+   QMap<int, QVariant>::const_iterator itr = query.m_lstCompiledValue.constBegin();
+   for (; itr != query.m_lstCompiledValue.constEnd(); ++itr)
+   { if (itr.key() < entry.values.count()) { q.bindValue(itr.key(), itr.value()); } }
+}
+
+void QxSqlQueryCompiled::resolve(const qx::QxSqlQuery & query, const QVector<QVariant> & values, QSqlQuery & q)
+{
+   for (int i = 0; i < values.count(); i++)
+   {
+      QMap<int, QVariant>::const_iterator itr = query.m_lstCompiledValue.constFind(i);
+      q.bindValue(i, ((itr != query.m_lstCompiledValue.constEnd()) ? itr.value() : values.at(i)));
+   }
+   if (! query.m_lstCompiledValue.isEmpty() && ((query.m_lstCompiledValue.lastKey()) >= values.count()))
+   { qDebug("[QxOrm] qx::QxSqlQueryCompiled : slot index '%d' out of range (%d slots)", query.m_lstCompiledValue.lastKey(), values.count()); }
+}
+
+} // namespace qx
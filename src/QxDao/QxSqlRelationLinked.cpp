@@ -37,6 +37,8 @@
 
 #include <QxRegister/IxClass.h>
 
+#include <QxCommon/QxReadMostlyHash.h>
+
 #include <QxCollection/QxCollectionIterator.h>
 
 #include <QxTraits/is_valid_primary_key.h>
@@ -80,10 +82,8 @@ struct QxSqlRelationLinked::QxSqlRelationLinkedImpl {
         //!< column1, column2, etc... }
     QString m_sRootCustomAlias;    //!< Root custom alias using <my_alias> syntax
 
-    static QMutex m_mutex; //!< Mutex => qx::QxSqlRelationLinked is thread-safe
-    static QHash<QPair<IxClass *, QByteArray>, type_ptr>
-        m_relationLinkedSaved; //!< Keep relations linked in memory for
-        //!< optimization (to avoid too many parsing)
+    typedef qx::QxReadMostlyHash<QPair<IxClass *, QByteArray>, type_ptr>
+        type_relation_linked_saved;
 
     QxSqlRelationLinkedImpl(bool bRoot)
         : m_allRelationX(NULL), m_bRoot(bRoot), m_lRootColumnsOffset(0),
@@ -212,23 +212,25 @@ struct QxSqlRelationLinked::QxSqlRelationLinkedImpl {
         }
     }
 
+    //! Keep relations linked in memory for optimization (to avoid too many
+    //! parsing), thread-safe and no lock to read
+    static type_relation_linked_saved &relationLinkedSaved() {
+        static type_relation_linked_saved lst;
+        return lst;
+    }
     static std::shared_ptr<QxSqlRelationLinked>
     getRelationLinkedSaved(const QPair<IxClass *, QByteArray> &key) {
-        QMutexLocker locker(&m_mutex);
-        return m_relationLinkedSaved.value(key);
+        type_ptr ptr;
+        relationLinkedSaved().find(key, ptr);
+        return ptr;
     }
     static void
     insertRelationLinkedSaved(const QPair<IxClass *, QByteArray> &key,
                               std::shared_ptr<QxSqlRelationLinked> ptr) {
-        QMutexLocker locker(&m_mutex);
-        m_relationLinkedSaved.insert(key, ptr);
+        relationLinkedSaved().insert(key, ptr);
     }
 };
 
-QMutex QxSqlRelationLinked::QxSqlRelationLinkedImpl::m_mutex;
-QHash<QPair<IxClass *, QByteArray>, std::shared_ptr<QxSqlRelationLinked>>
-    QxSqlRelationLinked::QxSqlRelationLinkedImpl::m_relationLinkedSaved;
-
 QxSqlRelationLinked::QxSqlRelationLinked()
     : m_pImpl(new QxSqlRelationLinkedImpl(true)) {
     ;
@@ -0,0 +1,247 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#include <QxPrecompiled.h>
+
+#include <QxDao/QxUnitOfWork.h>
+#include <QxDao/IxSqlRelation.h>
+#include <QxDao/QxSqlDatabase.h>
+#include <QxDao/QxSoftDelete.h>
+
+#include <QxDataMember/IxDataMemberX.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+namespace qx {
+namespace dao {
+namespace detail {
+
+IxUnitOfWork_Entry::IxUnitOfWork_Entry(IxClass * pClass) : m_pClass(pClass) { qAssert(m_pClass); }
+
+IxUnitOfWork_Entry::~IxUnitOfWork_Entry() { ; }
+
+IxClass * IxUnitOfWork_Entry::getClass() const { return m_pClass; }
+
+long IxUnitOfWork_Entry::count() const
+{
+   long lCount = 0;
+   for (int i = 0; i < m_lstPending.count(); i++) { if (m_lstPending.at(i).m_eOp != op_none) { lCount++; } }
+   return lCount;
+}
+
+void IxUnitOfWork_Entry::clear()
+{
+   m_lstPending.clear();
+   m_hashByAddress.clear();
+   m_hashById.clear();
+}
+
+void IxUnitOfWork_Entry::append(op_type e, void * pItem, const std::shared_ptr<void> & pHolder)
+{
+   if (! pItem || (e == op_none)) { qAssert(false); return; }
+   QString sId = getIdKey(pItem, e);
+   int idx = m_hashByAddress.value(pItem, -1);
+   if ((idx < 0) && ! sId.isEmpty()) { idx = m_hashById.value(sId, -1); }
+   if (idx < 0)
+   {
+      type_pending pending; pending.m_pItem = pItem; pending.m_pHolder = pHolder; pending.m_sId = sId; pending.m_eOp = e; pending.m_bUndelete = false;
+      m_lstPending.append(pending); idx = (m_lstPending.count() - 1);
+      m_hashByAddress.insert(pItem, idx);
+      if (! sId.isEmpty()) { m_hashById.insert(sId, idx); }
+      return;
+   }
+
+   // The last instance registered is the one written to database (its state is read when flushing)
+   type_pending & pending = m_lstPending[idx];
+   if (pending.m_pItem != pItem) { m_hashByAddress.remove(pending.m_pItem); }
+   if (! pending.m_sId.isEmpty() && (pending.m_sId != sId)) { m_hashById.remove(pending.m_sId); }
+   bool bPendingDelete = ((pending.m_eOp == op_delete) || (pending.m_eOp == op_destroy));
+   pending.m_eOp = merge(pending.m_eOp, e);
+   pending.m_bUndelete = ((pending.m_eOp == op_update) && (pending.m_bUndelete || (bPendingDelete && (e == op_insert))) && m_pClass && ! m_pClass->getSoftDelete().isEmpty());
+   if (pending.m_eOp == op_none) { m_hashById.remove(sId); m_hashByAddress.remove(pItem); pending.m_pItem = NULL; pending.m_pHolder.reset(); return; }
+   pending.m_pItem = pItem; pending.m_pHolder = pHolder; pending.m_sId = sId;
+   m_hashByAddress.insert(pItem, idx);
+   if (! sId.isEmpty()) { m_hashById.insert(sId, idx); }
+}
+
+QSqlError IxUnitOfWork_Entry::flush(op_type e, QSqlDatabase * pDatabase)
+{
+   QList<void *> lstItems;
+   for (int i = 0; i < m_lstPending.count(); i++) { if (m_lstPending.at(i).m_eOp == e) { lstItems.append(m_lstPending.at(i).m_pItem); } }
+   if (lstItems.isEmpty()) { return QSqlError(); }
+   QSqlError daoError = flushItems(e, lstItems, pDatabase);
+   if (daoError.isValid() || (e != op_update)) { return daoError; }
+
+   QList<void *> lstUndelete;
+   for (int i = 0; i < m_lstPending.count(); i++) { if ((m_lstPending.at(i).m_eOp == op_update) && m_lstPending.at(i).m_bUndelete) { lstUndelete.append(m_lstPending.at(i).m_pItem); } }
+   return (lstUndelete.isEmpty() ? QSqlError() : undeleteItems(lstUndelete, pDatabase));
+}
+
+QSqlError IxUnitOfWork_Entry::undeleteItems(const QList<void *> & lstItems, QSqlDatabase * pDatabase)
+{
+   // Soft delete column is not a data member (so not written by the update) : NULL value means not deleted whatever the soft delete mode
+   QxSoftDelete oSoftDelete = m_pClass->getSoftDelete();
+   IxDataMemberX * pDataMemberX = m_pClass->getDataMemberX();
+   IxDataMember * pId = (pDataMemberX ? pDataMemberX->getId_WithDaoStrategy() : NULL);
+   if (! pId) { return QSqlError("[QxOrm] qx::dao::detail::IxUnitOfWork_Entry : 'unable to undelete entities without primary key'", "", QSqlError::UnknownError); }
+
+   QSqlError dbError;
+   QSqlDatabase db = (pDatabase ? (* pDatabase) : qx::QxSqlDatabase::getDatabase(dbError));
+   if (dbError.isValid()) { return dbError; }
+   QString sql = "UPDATE " + qx::IxDataMember::getSqlFromTable(pDataMemberX->getName()) + " SET " + oSoftDelete.getColumnName() + " = NULL WHERE " + pId->getSqlNameEqualToPlaceHolder();
+   QSqlQuery query(db);
+   if (! query.prepare(sql)) { return query.lastError(); }
+   for (int i = 0; i < lstItems.count(); i++)
+   {
+      pId->setSqlPlaceHolder(query, lstItems.at(i));
+      if (! query.exec()) { return query.lastError(); }
+   }
+   return QSqlError();
+}
+
+QString IxUnitOfWork_Entry::getIdKey(void * pItem, op_type e) const
+{
+   IxDataMemberX * pDataMemberX = (m_pClass ? m_pClass->getDataMemberX() : NULL);
+   IxDataMember * pId = (pDataMemberX ? pDataMemberX->getId_WithDaoStrategy() : NULL);
+   if (! pId || ((e == op_insert) && pId->getAutoIncrement())) { return QString(); }
+
+   QString sId;
+   for (int i = 0; i < pId->getNameCount(); i++)
+   {
+      QVariant v = pId->toVariant(pItem, i, qx::cvt::context::e_database);
+      QString s = v.toString();
+      if (v.isNull() || s.isEmpty() || (s == QStringLiteral("0"))) { return QString(); }
+      sId += ((i > 0) ? QStringLiteral("|") : QString()) + s;
+   }
+   return sId;
+}
+
+IxUnitOfWork_Entry::op_type IxUnitOfWork_Entry::merge(op_type ePending, op_type eNew)
+{
+   bool bDelete = ((eNew == op_delete) || (eNew == op_destroy));
+   switch (ePending)
+   {
+      case op_insert:   return (bDelete ? op_none : op_insert);
+      case op_update:   return ((eNew == op_save) ? op_update : eNew);
+      case op_save:     return (bDelete ? eNew : op_save);
+      case op_delete:   return ((eNew == op_insert) ? op_update : ((eNew == op_save) ? op_save : op_delete));
+      case op_destroy:  return ((eNew == op_insert) ? op_update : (((eNew == op_save) || (eNew == op_delete)) ? eNew : op_destroy));
+      default:          break;
+   }
+   return eNew;
+}
+
+QxUnitOfWork::QxUnitOfWork() { ; }
+
+QxUnitOfWork::~QxUnitOfWork() { ; }
+
+long QxUnitOfWork::count() const
+{
+   long lCount = 0;
+   for (int i = 0; i < m_lstEntry.count(); i++) { lCount += m_lstEntry.at(i)->count(); }
+   return lCount;
+}
+
+bool QxUnitOfWork::isEmpty() const { return (count() <= 0); }
+
+void QxUnitOfWork::clear() { m_lstEntry.clear(); }
+
+IxUnitOfWork_Entry * QxUnitOfWork::findEntry(IxClass * pClass) const
+{
+   for (int i = 0; i < m_lstEntry.count(); i++) { if (m_lstEntry.at(i)->getClass() == pClass) { return m_lstEntry.at(i).get(); } }
+   return NULL;
+}
+
+QSqlError QxUnitOfWork::flush(QSqlDatabase * pDatabase)
+{
+   QList<IxUnitOfWork_Entry *> lstEntry = sortByDependency();
+   QList<IxUnitOfWork_Entry::op_type> lstWrite = QList<IxUnitOfWork_Entry::op_type>() << IxUnitOfWork_Entry::op_insert << IxUnitOfWork_Entry::op_save << IxUnitOfWork_Entry::op_update;
+   QList<IxUnitOfWork_Entry::op_type> lstDelete = QList<IxUnitOfWork_Entry::op_type>() << IxUnitOfWork_Entry::op_delete << IxUnitOfWork_Entry::op_destroy;
+
+   // Entry-major in dependency order : all pending writes of a parent table (insert, save, update) are flushed before any write of its children
+   QSqlError daoError;
+   for (int i = 0; i < lstEntry.count(); i++)
+   {
+      for (int op = 0; op < lstWrite.count(); op++)
+      { daoError = lstEntry.at(i)->flush(lstWrite.at(op), pDatabase); if (daoError.isValid()) { clear(); return daoError; } }
+   }
+   for (int op = 0; op < lstDelete.count(); op++)
+   {
+      for (int i = (lstEntry.count() - 1); i >= 0; i--)
+      { daoError = lstEntry.at(i)->flush(lstDelete.at(op), pDatabase); if (daoError.isValid()) { clear(); return daoError; } }
+   }
+
+   clear();
+   return QSqlError();
+}
+
+QList<IxUnitOfWork_Entry *> QxUnitOfWork::sortByDependency() const
+{
+   // lstParent[i] : entries to flush before entry 'i' (the table of entry 'i' has a foreign key to these tables)
+   int iCount = m_lstEntry.count();
+   QVector<QSet<int> > lstParent(iCount);
+   for (int i = 0; i < iCount; i++)
+   {
+      IxClass * pClass = m_lstEntry.at(i)->getClass();
+      std::shared_ptr<IxSqlRelationX> pRelationX = (pClass ? pClass->getSqlRelationX() : std::shared_ptr<IxSqlRelationX>());
+      for (long l = 0; (pRelationX && (l < pRelationX->count())); l++)
+      {
+         IxSqlRelation * pRelation = pRelationX->getByIndex(l); if (! pRelation) { continue; }
+         pRelation->init();
+         int j = -1;
+         for (int k = 0; k < iCount; k++) { if (m_lstEntry.at(k)->getClass() == pRelation->getClass()) { j = k; break; } }
+         if ((j < 0) || (j == i)) { continue; }
+         if (pRelation->getRelationType() == IxSqlRelation::many_to_one) { lstParent[i].insert(j); }
+         else if (pRelation->getRelationType() == IxSqlRelation::one_to_many) { lstParent[j].insert(i); }
+      }
+   }
+
+   // Stable topological sort (order of first registration is kept when there is no dependency), a cycle keeps order of registration
+   QList<IxUnitOfWork_Entry *> lstSorted; QVector<bool> lstDone(iCount, false);
+   while (lstSorted.count() < iCount)
+   {
+      int iNext = -1;
+      for (int i = 0; ((i < iCount) && (iNext < 0)); i++)
+      {
+         if (lstDone.at(i)) { continue; }
+         bool bReady = true;
+         Q_FOREACH(int j, lstParent.at(i)) { if (! lstDone.at(j)) { bReady = false; break; } }
+         if (bReady) { iNext = i; }
+      }
+      if (iNext < 0) { for (int i = 0; i < iCount; i++) { if (! lstDone.at(i)) { iNext = i; break; } } }
+      lstDone[iNext] = true; lstSorted.append(m_lstEntry.at(iNext).get());
+   }
+   return lstSorted;
+}
+
+} // namespace detail
+} // namespace dao
+} // namespace qx
@@ -39,6 +39,18 @@ QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxFactoryX)
 
 namespace qx {
 
+static QAtomicInt g_iFactoryRegistryVersion(0);
+
+int QxFactoryX::getRegistryVersion()
+{
+   return g_iFactoryRegistryVersion.loadAcquire();
+}
+
+void QxFactoryX::incrementRegistryVersion()
+{
+   g_iFactoryRegistryVersion.fetchAndAddOrdered(1);
+}
+
 void QxFactoryX::registerFactory(const QString & sKey, IxFactory * pFactory)
 {
    QMutexLocker locker(& m_oMutexFactoryX);
@@ -53,12 +65,17 @@ void QxFactoryX::registerFactory(const QString & sKey, IxFactory * pFactory)
 void QxFactoryX::unregisterFactory(const QString & sKey)
 {
    QMutexLocker locker(& m_oMutexFactoryX);
-   m_mapFactoryX.remove(sKey);
+   if (m_mapFactoryX.remove(sKey) > 0) { incrementRegistryVersion(); }
+}
+
+IxFactory * QxFactoryX::getFactory(const QString & sKey) const
+{
+   return m_mapFactoryX.value(sKey, NULL);
 }
 
 qx::any QxFactoryX::createObject(const QString & sKey, bool bRawPointer /* = false */) const
 {
-   IxFactory * pFactory = (m_mapFactoryX.contains(sKey) ? m_mapFactoryX.value(sKey) : NULL);
+   IxFactory * pFactory = getFactory(sKey);
    if (! pFactory) { qDebug("[QxOrm] cannot create an instance of type '%s'", qPrintable(sKey)); }
 
    return (pFactory ? pFactory->createObject(bRawPointer) : qx::any());
@@ -66,7 +83,7 @@ qx::any QxFactoryX::createObject(const QString & sKey, bool bRawPointer /* = fal
 
 void * QxFactoryX::createObjectNudePtr(const QString & sKey) const
 {
-   IxFactory * pFactory = (m_mapFactoryX.contains(sKey) ? m_mapFactoryX.value(sKey) : NULL);
+   IxFactory * pFactory = getFactory(sKey);
    if (! pFactory) { qDebug("[QxOrm] cannot create an instance of type '%s'", qPrintable(sKey)); }
 
    return (pFactory ? pFactory->createObjectNudePtr() : NULL);
@@ -75,7 +92,7 @@ void * QxFactoryX::createObjectNudePtr(const QString & sKey) const
 #ifndef _QX_NO_RTTI
 const std::type_info & QxFactoryX::typeInfo(const QString & sKey) const
 {
-   IxFactory * pFactory = (m_mapFactoryX.contains(sKey) ? m_mapFactoryX.value(sKey) : NULL);
+   IxFactory * pFactory = getFactory(sKey);
    if (! pFactory) { qDebug("[QxOrm] cannot get informations about type '%s'", qPrintable(sKey)); }
 
    return (pFactory ? pFactory->typeInfo() : typeid(void));
@@ -0,0 +1,245 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
+#include <QxHttpServer/QxHttpMetrics.h>
+#include <QxHttpServer/QxHttpSessionManager.h>
+
+#include <QxService/QxThreadPool.h>
+
+#include <QxDao/QxSqlDatabase.h>
+
+#include <QxCommon/QxCache.h>
+#include <QxCommon/QxThreadLocalAggregator.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxHttpMetrics)
+
+namespace qx {
+
+// Read by qx::QxHttpServer for each request : no singleton access while HTTP metrics are disabled
+static QAtomicInt g_iHttpMetricsEnabled(0);
+
+struct QxHttpMetrics_Key
+{
+   QString m_sRoute; QString m_sMethod; int m_iStatus;
+   QxHttpMetrics_Key(const QString & sRoute, const QString & sMethod, int iStatus) : m_sRoute(sRoute), m_sMethod(sMethod), m_iStatus(iStatus) { ; }
+   bool operator==(const QxHttpMetrics_Key & other) const { return ((m_iStatus == other.m_iStatus) && (m_sRoute == other.m_sRoute) && (m_sMethod == other.m_sMethod)); }
+};
+
+inline uint qHash(const QxHttpMetrics_Key & key, uint seed = 0)
+{ return (qHash(key.m_sRoute, seed) ^ (qHash(key.m_sMethod, seed) * 31U) ^ (static_cast<uint>(key.m_iStatus) * 17U)); }
+
+struct QxHttpMetrics::QxHttpMetricsImpl
+{
+
+   qx::QxThreadLocalAggregator<QxHttpMetrics_Key, QxHttpMetrics::type_entry> m_aggregator; //!< Metrics recorded by each thread
+   QMutex m_mutex;                                          //!< Mutex to protect thread pool
+   std::weak_ptr<qx::service::QxThreadPool> m_pThreadPool;  //!< Thread pool of the running HTTP server
+
+   QxHttpMetricsImpl() { ; }
+   ~QxHttpMetricsImpl() { ; }
+
+   QxHttpMetrics::type_snapshot snapshot(bool bReset)
+   {
+      QxHttpMetrics::type_snapshot lst = m_aggregator.snapshot(bReset).values();
+      std::sort(lst.begin(), lst.end(), [](const QxHttpMetrics::type_entry & e1, const QxHttpMetrics::type_entry & e2) {
+         if (e1.m_sRoute != e2.m_sRoute) { return (e1.m_sRoute < e2.m_sRoute); }
+         if (e1.m_sMethod != e2.m_sMethod) { return (e1.m_sMethod < e2.m_sMethod); }
+         return (e1.m_iStatus < e2.m_iStatus);
+      });
+      return lst;
+   }
+
+   static QByteArray label(const char * sName, const QString & sValue)
+   {
+      QString s = sValue;
+      s.replace(QLatin1Char('\\'), QLatin1String("\\\\")).replace(QLatin1Char('"'), QLatin1String("\\\"")).replace(QLatin1Char('\n'), QLatin1String("\\n"));
+      return (QByteArray(sName) + "=\"" + s.toUtf8() + "\"");
+   }
+
+   static QByteArray seconds(qint64 iNanoSeconds) { return QByteArray::number((static_cast<double>(iNanoSeconds) / 1000000000.0), 'g', 12); }
+
+   static void family(QByteArray & out, const char * sName, const char * sType, const char * sHelp, const char * sUnit = NULL)
+   {
+      out += "# TYPE "; out += sName; out += " "; out += sType; out += "\n";
+      if (sUnit) { out += "# UNIT "; out += sName; out += " "; out += sUnit; out += "\n"; }
+      out += "# HELP "; out += sName; out += " "; out += sHelp; out += "\n";
+   }
+
+   static void sample(QByteArray & out, const char * sName, const QByteArray & labels, const QByteArray & value)
+   {
+      out += sName;
+      if (! labels.isEmpty()) { out += "{"; out += labels; out += "}"; }
+      out += " "; out += value; out += "\n";
+   }
+
+   static void histogram(QByteArray & out, const char * sName, const QByteArray & labels, const qx::QxDaoMetrics::type_histogram & h)
+   {
+      const qint64 * pBounds = qx::QxDaoMetrics::getBucketBounds();
+      QByteArray sBucket = (QByteArray(sName) + "_bucket"); QByteArray prefix = (labels.isEmpty() ? QByteArray() : (labels + ","));
+      qint64 iCumulative = 0;
+      for (int i = 0; i < (qx::QxDaoMetrics::bucket_count - 1); i++)
+      {
+         iCumulative += h.m_lstBucket[i];
+         sample(out, sBucket.constData(), (prefix + "le=\"" + seconds(pBounds[i]) + "\""), QByteArray::number(iCumulative));
+      }
+      sample(out, sBucket.constData(), (prefix + "le=\"+Inf\""), QByteArray::number(h.m_iCount));
+      sample(out, (QByteArray(sName) + "_sum").constData(), labels, seconds(h.m_iSum));
+      sample(out, (QByteArray(sName) + "_count").constData(), labels, QByteArray::number(h.m_iCount));
+   }
+
+};
+
+QxHttpMetrics::type_entry::type_entry() : m_iStatus(0) { ; }
+
+void QxHttpMetrics::type_entry::merge(const type_entry & other) { m_latency.merge(other.m_latency); }
+
+QxHttpMetrics::QxHttpMetrics() : QxSingleton<QxHttpMetrics>(QStringLiteral("qx::QxHttpMetrics")), m_pImpl(new QxHttpMetricsImpl()) { ; }
+
+QxHttpMetrics::~QxHttpMetrics() { ; }
+
+bool QxHttpMetrics::isEnabled() { return (g_iHttpMetricsEnabled.loadAcquire() != 0); }
+
+void QxHttpMetrics::setEnabled(bool b) { g_iHttpMetricsEnabled.storeRelease(b ? 1 : 0); }
+
+void QxHttpMetrics::record(const QString & sRoute, const QString & sMethod, int iStatus, qint64 iElapsed)
+{
+   m_pImpl->m_aggregator.update(QxHttpMetrics_Key(sRoute, sMethod, iStatus), [&](type_entry & entry, bool bInserted) {
+      if (bInserted) { entry.m_sRoute = sRoute; entry.m_sMethod = sMethod; entry.m_iStatus = iStatus; }
+      entry.m_latency.add(iElapsed);
+   });
+}
+
+QxHttpMetrics::type_snapshot QxHttpMetrics::snapshot() const { return m_pImpl->snapshot(false); }
+
+void QxHttpMetrics::reset() { m_pImpl->snapshot(true); }
+
+void QxHttpMetrics::setThreadPool(const std::shared_ptr<qx::service::QxThreadPool> & pThreadPool)
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_pThreadPool = pThreadPool;
+}
+
+QByteArray QxHttpMetrics::toOpenMetrics() const
+{
+   typedef QxHttpMetricsImpl impl;
+   QByteArray out; out.reserve(16384);
+
+   // qx::dao functions metrics (see qx::QxDaoMetrics class)
+   qx::QxDaoMetrics::type_snapshot lstDao = qx::QxDaoMetrics::getSingleton()->snapshot();
+   impl::family(out, "qx_dao_duration_seconds", "histogram", "Duration of qx::dao functions by class, operation, database and timer", "seconds");
+   for (const qx::QxDaoMetrics::type_entry & e : lstDao)
+   {
+      QByteArray labels = (impl::label("class", e.m_sClass) + "," + impl::label("operation", e.m_sOperation) + "," + impl::label("database", e.m_sDatabase));
+      for (int i = 0; i < qx::QxDaoMetrics::metric_count; i++)
+      {
+         const qx::QxDaoMetrics::type_histogram & h = e.m_lstTimer[i]; if (h.m_iCount <= 0) { continue; }
+         impl::histogram(out, "qx_dao_duration_seconds", (labels + "," + impl::label("timer", qx::QxDaoMetrics::getMetricName(static_cast<qx::QxDaoMetrics::metric_type>(i)))), h);
+      }
+   }
+   impl::family(out, "qx_dao_calls", "counter", "Number of qx::dao functions calls");
+   for (const qx::QxDaoMetrics::type_entry & e : lstDao) { impl::sample(out, "qx_dao_calls_total", (impl::label("class", e.m_sClass) + "," + impl::label("operation", e.m_sOperation) + "," + impl::label("database", e.m_sDatabase)), QByteArray::number(e.m_iCalls)); }
+   impl::family(out, "qx_dao_rows", "counter", "Number of SQL records read by qx::dao functions");
+   for (const qx::QxDaoMetrics::type_entry & e : lstDao) { impl::sample(out, "qx_dao_rows_total", (impl::label("class", e.m_sClass) + "," + impl::label("operation", e.m_sOperation) + "," + impl::label("database", e.m_sDatabase)), QByteArray::number(e.m_iRows)); }
+   impl::family(out, "qx_dao_errors", "counter", "Number of qx::dao functions calls ended with an error");
+   for (const qx::QxDaoMetrics::type_entry & e : lstDao) { impl::sample(out, "qx_dao_errors_total", (impl::label("class", e.m_sClass) + "," + impl::label("operation", e.m_sOperation) + "," + impl::label("database", e.m_sDatabase)), QByteArray::number(e.m_iErrors)); }
+
+   // Database connections by qx::QxSqlDatabase key : connections opened for default database (1 connection by thread), plus connections used by threads working on another database
+   QHash<QString, long> lstConnections = qx::QxSqlDatabase::getConnectionCountByDatabaseKey();
+   impl::family(out, "qx_db_connections", "gauge", "Number of database connections by qx::QxSqlDatabase key (driver name + host name + database name)");
+   for (QHash<QString, long>::const_iterator it = lstConnections.constBegin(); it != lstConnections.constEnd(); ++it)
+   { impl::sample(out, "qx_db_connections", impl::label("database_key", it.key()), QByteArray::number(static_cast<qlonglong>(it.value()))); }
+
+   // qx::cache statistics
+   qx::cache::detail::QxCache * pCache = qx::cache::detail::QxCache::getSingleton();
+   impl::family(out, "qx_cache_hits", "counter", "Number of objects found in qx::cache");
+   impl::sample(out, "qx_cache_hits_total", QByteArray(), QByteArray::number(pCache->getHitCount()));
+   impl::family(out, "qx_cache_misses", "counter", "Number of keys not found in qx::cache");
+   impl::sample(out, "qx_cache_misses_total", QByteArray(), QByteArray::number(pCache->getMissCount()));
+   impl::family(out, "qx_cache_evictions", "counter", "Number of objects removed from qx::cache when max cost is reached");
+   impl::sample(out, "qx_cache_evictions_total", QByteArray(), QByteArray::number(pCache->getEvictionCount()));
+   impl::family(out, "qx_cache_objects", "gauge", "Number of objects in qx::cache");
+   impl::sample(out, "qx_cache_objects", QByteArray(), QByteArray::number(static_cast<qlonglong>(pCache->count())));
+   impl::family(out, "qx_cache_cost", "gauge", "Current cost of qx::cache");
+   impl::sample(out, "qx_cache_cost", QByteArray(), QByteArray::number(static_cast<qlonglong>(pCache->getCurrCost())));
+   impl::family(out, "qx_cache_max_cost", "gauge", "Max cost of qx::cache");
+   impl::sample(out, "qx_cache_max_cost", QByteArray(), QByteArray::number(static_cast<qlonglong>(pCache->getMaxCost())));
+
+   // Thread pool of the running HTTP server (counters are read without locking the thread pool mutex)
+   std::shared_ptr<qx::service::QxThreadPool> pThreadPool;
+   { QMutexLocker locker(& m_pImpl->m_mutex); pThreadPool = m_pImpl->m_pThreadPool.lock(); }
+   if (pThreadPool)
+   {
+      int iThreadCount = pThreadPool->getThreadCount(); int iAvailableCount = pThreadPool->getAvailableCount();
+      impl::family(out, "qx_thread_pool_workers", "gauge", "Number of qx::service::QxThreadPool workers by state");
+      impl::sample(out, "qx_thread_pool_workers", impl::label("state", QStringLiteral("busy")), QByteArray::number(qMax(0, (iThreadCount - iAvailableCount))));
+      impl::sample(out, "qx_thread_pool_workers", impl::label("state", QStringLiteral("available")), QByteArray::number(iAvailableCount));
+      impl::family(out, "qx_http_accept_queue", "gauge", "Number of incoming connections waiting for an available worker");
+      impl::sample(out, "qx_http_accept_queue", QByteArray(), QByteArray::number(pThreadPool->getWaitingCount()));
+      impl::family(out, "qx_http_accept_rejected", "counter", "Number of incoming connections rejected because no worker was available");
+      impl::sample(out, "qx_http_accept_rejected_total", QByteArray(), QByteArray::number(pThreadPool->getRejectedCount()));
+   }
+
+   // HTTP requests latency by route
+   qx::QxHttpMetrics::type_snapshot lstHttp = m_pImpl->snapshot(false);
+   impl::family(out, "qx_http_request_duration_seconds", "histogram", "Duration of HTTP requests by route, method and status code", "seconds");
+   for (const type_entry & e : lstHttp)
+   {
+      QByteArray labels = (impl::label("route", e.m_sRoute) + "," + impl::label("method", e.m_sMethod) + "," + impl::label("code", QString::number(e.m_iStatus)));
+      impl::histogram(out, "qx_http_request_duration_seconds", labels, e.m_latency);
+   }
+
+   // HTTP sessions
+   impl::family(out, "qx_http_sessions", "gauge", "Number of HTTP sessions managed by qx::QxHttpSessionManager");
+   impl::sample(out, "qx_http_sessions", QByteArray(), QByteArray::number(static_cast<qlonglong>(qx::QxHttpSessionManager::count())));
+
+   out += "# EOF\n";
+   return out;
+}
+
+void QxHttpMetrics::buildResponse(qx::QxHttpRequest & request, qx::QxHttpResponse & response)
+{
+   Q_UNUSED(request);
+   response.headers().insert("Content-Type", "application/openmetrics-text; version=1.0.0; charset=utf-8");
+   response.data() = QxHttpMetrics::getSingleton()->toOpenMetrics();
+}
+
+} // namespace qx
+
+#endif // _QX_ENABLE_QT_NETWORK
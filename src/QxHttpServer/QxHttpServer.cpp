@@ -36,6 +36,7 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qmutex.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qabstracteventdispatcher.h>
 
 #if (QT_VERSION >= 0x050000)
@@ -51,6 +52,7 @@
 #endif // (QT_VERSION >= 0x050000)
 
 #include <QxHttpServer/QxHttpServer.h>
+#include <QxHttpServer/QxHttpMetrics.h>
 
 #include <QxService/QxThreadPool.h>
 #include <QxService/QxConnect.h>
@@ -167,12 +169,14 @@ void QxHttpServer::startServer()
    QObject::connect(m_pImpl->m_pThreadPool.get(), SIGNAL(transactionStarted(qx::service::QxTransaction_ptr)), this, SLOT(onTransactionStarted(qx::service::QxTransaction_ptr)));
    QObject::connect(m_pImpl->m_pThreadPool.get(), SIGNAL(transactionFinished(qx::service::QxTransaction_ptr)), this, SLOT(onTransactionFinished(qx::service::QxTransaction_ptr)));
    QObject::connect(m_pImpl->m_pThreadPool.get(), SIGNAL(customRequestHandler(qx::service::QxTransaction_ptr)), this, SLOT(onCustomRequestHandler(qx::service::QxTransaction_ptr)), Qt::DirectConnection);
+   qx::QxHttpMetrics::getSingleton()->setThreadPool(m_pImpl->m_pThreadPool);
    m_pImpl->m_pThreadPool->start();
 }
 
 void QxHttpServer::stopServer()
 {
    if (! m_pImpl->m_pThreadPool) { return; }
+   qx::QxHttpMetrics::getSingleton()->setThreadPool(qx::service::QxThreadPool_ptr());
    m_pImpl->m_pThreadPool.reset();
    Q_EMIT serverStatusChanged(false);
 }
@@ -278,6 +282,10 @@ void QxHttpServer::onCustomRequestHandler(qx::service::QxTransaction_ptr transac
    qx::QxHttpRequest & request = httpTransaction->request();
    qx::QxHttpResponse & response = httpTransaction->response();
 
+   // Measure request latency by route only if HTTP metrics are enabled (see qx::QxHttpMetrics class)
+   bool bMetrics = qx::QxHttpMetrics::isEnabled();
+   QElapsedTimer timerMetrics; if (bMetrics) { timerMetrics.start(); }
+
    // Get custom request handler + before/after dispatching callbacks (thread-safe)
    std::shared_ptr<QxHttpServer::type_fct_custom_request_handler> fctCustomHandler;
    std::shared_ptr<QxHttpServer::type_fct_custom_request_handler> fctBeforeDispatching;
@@ -331,6 +339,15 @@ void QxHttpServer::onCustomRequestHandler(qx::service::QxTransaction_ptr transac
           httpTransaction->setMessageReturn(qx_bool(500, QStringLiteral("[QxOrm] Unknown server error (after dispatching)")));
       }
    }
+
+   // Record request latency : status code is the transaction message return code if an error occurred (see qx::QxHttpTransaction::writeSocketServer())
+   if (bMetrics)
+   {
+      qx_bool bMessageReturn = httpTransaction->getMessageReturn();
+      int iStatus = (bMessageReturn ? response.status() : static_cast<int>(bMessageReturn.getCode()));
+      QString sRoute = ((itemDispatch && itemDispatch->m_fct) ? itemDispatch->m_path : ((fctCustomHandler && (* fctCustomHandler)) ? QStringLiteral("<custom>") : QStringLiteral("<none>")));
+      qx::QxHttpMetrics::getSingleton()->record(sRoute, request.command(), iStatus, timerMetrics.nsecsElapsed());
+   }
 }
 
 void QxHttpServerDispatcher::dispatch(const QString &command,
@@ -46,6 +46,9 @@ QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::QxHttpSessionManager)
 
 namespace qx {
 
+// Number of sessions : updated when the list of sessions is modified, so it can be read without locking the session manager mutex
+static QAtomicInt g_iHttpSessionCount(0);
+
 struct QxHttpSessionManager::QxHttpSessionManagerImpl
 {
 
@@ -54,7 +57,7 @@ struct QxHttpSessionManager::QxHttpSessionManagerImpl
    QHash<QByteArray, qx::QxHttpSession_ptr> m_sessions;  //!< List of sessions
 
    QxHttpSessionManagerImpl() { ; }
-   ~QxHttpSessionManagerImpl() { ; }
+   ~QxHttpSessionManagerImpl() { g_iHttpSessionCount.storeRelease(0); }
 
    QByteArray getSessionId(qx::QxHttpRequest & request, qx::QxHttpResponse & response, const QByteArray & cookieName)
    {
@@ -87,6 +90,7 @@ struct QxHttpSessionManager::QxHttpSessionManagerImpl
       qx::QxHttpSession_ptr session(new qx::QxHttpSession(), (& QxHttpSessionManager::deleteSession));
       QByteArray id = session->id();
       m_sessions.insert(id, session);
+      g_iHttpSessionCount.storeRelease(m_sessions.count());
 
       qx::QxHttpCookie cookie;
       cookie.name = cookieName;
@@ -101,6 +105,7 @@ struct QxHttpSessionManager::QxHttpSessionManagerImpl
       QByteArray id = getSessionId(request, response, cookieName);
       if (id.isEmpty() || (! m_sessions.contains(id))) { return; }
       m_sessions.remove(id);
+      g_iHttpSessionCount.storeRelease(m_sessions.count());
    }
 
 };
@@ -130,6 +135,11 @@ void QxHttpSessionManager::removeSession(qx::QxHttpRequest & request, qx::QxHttp
    QxHttpSessionManager::getSingleton()->m_pImpl->removeSession(request, response, cookieName);
 }
 
+long QxHttpSessionManager::count()
+{
+   return static_cast<long>(g_iHttpSessionCount.loadAcquire());
+}
+
 void QxHttpSessionManager::onCheckSessionTimeOut()
 {
    QMutexLocker locker(& m_pImpl->m_mutex);
@@ -146,6 +156,7 @@ void QxHttpSessionManager::onCheckSessionTimeOut()
       if (! lastAccess.isValid()) { qAssert(false); itr.remove(); continue; }
       if (lastAccess.addMSecs(lTimeOut) < dt) { itr.remove(); continue; }
    }
+   g_iHttpSessionCount.storeRelease(m_pImpl->m_sessions.count());
 }
 
 } // namespace qx
@@ -43,7 +43,6 @@
 #include <QxService/QxTools.h>
 #include <QBuffer>
 
-#define QX_SERVICE_TOOLS_HEADER_SIZE (sizeof(quint32) + sizeof(quint16) + sizeof(quint16) + sizeof(quint16)) // (serialized data size) + (serialization type) + (compress data) + (encrypt data)
 #define QX_SERVICE_MIN_SIZE_TO_COMPRESS_DATA 2000
 namespace qx {
 
@@ -274,7 +273,9 @@ qx_bool QxHttpTransaction::readSocketServer(QTcpSocket &socket) {
     m_pImpl->m_request.sourceAddress() = socket.peerAddress().toString();
     m_pImpl->m_request.sourcePort() = static_cast<long>(socket.peerPort());
     m_pImpl->m_socket = (&socket);
-    if (!m_pImpl->waitForReadSocket(socket)) {
+    // Bytes of pipelined QxService transactions may have already been read from socket
+    QByteArray overAll = qx::service::QxTools::takePendingData(socket);
+    if (overAll.isEmpty() && !m_pImpl->waitForReadSocket(socket)) {
         setMessageReturn(
                 qx_bool(500,
                         "Internal server error : cannot read socket to parse HTTP request first line ("
@@ -282,7 +283,7 @@ qx_bool QxHttpTransaction::readSocketServer(QTcpSocket &socket) {
         return qx_bool(true);
     }
     QByteArray nextData;
-    QByteArray overAll = socket.read(socket.bytesAvailable());
+    overAll += socket.read(socket.bytesAvailable());
     QBuffer overAllStream(&overAll);
     overAllStream.open(QBuffer::ReadWrite);
     int readPos = 0;
@@ -297,63 +298,12 @@ qx_bool QxHttpTransaction::readSocketServer(QTcpSocket &socket) {
     if (lst.length() < 3 || !lst.at(2).contains(QLatin1String("HTTP"))) {
 
         this->http = false;
-        bool bReadOk = true;
+        // QxService binary protocol : bytes already read from socket are the beginning of the transaction frame
         quint32 uiTransactionSize = 0;
-        while (overAllStream.size() < (qint64) (QX_SERVICE_TOOLS_HEADER_SIZE)) {
-            if (!m_pImpl->waitForReadSocket(socket)) {
-                setMessageReturn(
-                        qx_bool(500,
-                                "Internal server error : cannot read socket to parse HTTP request first line ("
-                                        + socket.errorString() + ")"));
-                return qx_bool(true);
-            }
-            nextData = socket.read(socket.bytesAvailable());
-            overAllStream.seek(overAllStream.size() - 1);
-            overAllStream.write(nextData);
-        }
-        quint32 uiSerializedSize = 0;
-        quint16 uiSerializationType(0), uiCompressData(0), uiEncryptData(0);
-        overAllStream.seek(0);
-        QByteArray dataHeader = overAllStream.read(
-                (qint64) (QX_SERVICE_TOOLS_HEADER_SIZE));
-
-        readPos = dataHeader.length() - 1;
-        qAssert(dataHeader.size() == (int)(QX_SERVICE_TOOLS_HEADER_SIZE));
-        QDataStream in(&dataHeader, QIODevice::ReadOnly);
-        in.setVersion(QDataStream::Qt_4_5);
-        in >> uiSerializedSize;
-        in >> uiSerializationType;
-        in >> uiCompressData;
-        in >> uiEncryptData;
-
-        while (overAllStream.bytesAvailable()
-                < (qint64) (uiSerializedSize)) {
-            if (!m_pImpl->waitForReadSocket(socket)) {
-                setMessageReturn(
-                        qx_bool(500,
-                                "Internal server error : cannot read socket to parse HTTP request first line ("
-                                        + socket.errorString() + ")"));
-                return qx_bool(true);
-            }
-            nextData = socket.read(socket.bytesAvailable());
-            overAllStream.seek(overAllStream.size() - 1);
-            overAllStream.write(nextData);
-            overAllStream.seek(readPos);
-        }
-        QByteArray dataSerialized = overAllStream.read(
-                (qint64) (uiSerializedSize));
-        readPos = dataSerialized.length() + QX_SERVICE_TOOLS_HEADER_SIZE - 1;
-        qAssert(dataSerialized.size() == (int)(uiSerializedSize));
-        uiTransactionSize = (quint32) (QX_SERVICE_TOOLS_HEADER_SIZE
-                + uiSerializedSize);
-        QDataStream in2(&dataHeader, QIODevice::ReadOnly);
-        bReadOk = qx::service::QxTools::readSocketData(dataSerialized, in2,
-                (*this), uiTransactionSize);
+        qx_bool bReadOk = qx::service::QxTools::readSocket(socket, (*this), uiTransactionSize, overAll);
         if (bReadOk) {
             setInputTransactionSize(uiTransactionSize);
             setTransactionRequestReceived(QDateTime::currentDateTime());
-            return bReadOk;
-
         }
         return bReadOk;
     } else {
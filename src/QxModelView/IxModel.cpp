@@ -31,8 +31,17 @@
 
 #include <QxPrecompiled.h>
 
+#include <thread>
+
+#include <QtCore/qtimer.h>
+#include <QtCore/quuid.h>
+
 #include <QxModelView/IxModel.h>
 
+#include <QxDao/QxSqlDatabase.h>
+
+#include <QxTraits/is_valid_primary_key.h>
+
 #include <QxMemLeak/mem_leak.h>
 
 #define QX_CONSTRUCT_IX_MODEL()                                                \
@@ -43,6 +52,77 @@
 
 namespace qx {
 
+struct IxModel::IxModelIncrementalFetch {
+  int m_iChunkSize;           //!< Number of rows fetched by each fetchMore() call
+  int m_iWindowSize;          //!< Max number of rows kept in memory (0 means no eviction)
+  bool m_bKeysetPagination;   //!< Seek after last row instead of LIMIT/OFFSET when possible
+  bool m_bKeyset;             //!< Keyset pagination used by current fetch (requires a single column primary key)
+  bool m_bActive;             //!< Model content comes from qxFetchIncremental() method
+  bool m_bAtBegin;            //!< First row of the model is the first row of the query
+  bool m_bAtEnd;              //!< Last row of the model is the last row of the query
+  bool m_bFetching;           //!< A view may call fetchMore() again while rows are inserted
+  qx::QxSqlQuery m_filter;    //!< User filter (WHERE clause only)
+  QStringList m_relation;     //!< Relationships fetched with each chunk
+  QSqlDatabase m_database;    //!< Database connection given to qxFetchIncremental() method
+  bool m_bDatabase;           //!< m_database is valid
+  IxDataMember *m_pSortDataMember; //!< Sort column pushed down to the query (NULL means sort by primary key)
+  bool m_bSortDescending;     //!< Sort direction
+  QVariantList m_firstValues; //!< Keyset values of the first row of the model
+  QVariantList m_lastValues;  //!< Keyset values of the last row of the model
+  long m_lFirstOffset;        //!< LIMIT/OFFSET pagination : offset of the first row of the model
+  long m_lEndOffset;          //!< LIMIT/OFFSET pagination : offset after the last row of the model
+
+  IxModelIncrementalFetch()
+      : m_iChunkSize(0), m_iWindowSize(0), m_bKeysetPagination(true),
+        m_bKeyset(false), m_bActive(false), m_bAtBegin(true), m_bAtEnd(true),
+        m_bFetching(false), m_bDatabase(false), m_pSortDataMember(NULL),
+        m_bSortDescending(false), m_lFirstOffset(0), m_lEndOffset(0) {
+    ;
+  }
+
+  void resetCursor() {
+    m_bActive = false;
+    m_bAtBegin = true;
+    m_bAtEnd = true;
+    m_firstValues.clear();
+    m_lastValues.clear();
+    m_lFirstOffset = 0;
+    m_lEndOffset = 0;
+  }
+};
+
+struct IxModel::IxModelWriteBack {
+  int m_iFlushInterval;   //!< Delay (in ms) after last edit before saving pending changes
+  int m_iMaxPendingRows;  //!< Pending changes are saved as soon as this number of rows is reached
+  bool m_bBackground;     //!< Save a copy of pending rows in another thread with its own connection
+  QTimer m_timer;         //!< Single-shot timer restarted by each edit
+  QList<void *> m_lstPendingItem;                    //!< Pending rows in edit order
+  QHash<void *, QPair<int, QStringList>> m_hPending; //!< Pending row => (last known row index, edited columns)
+  QHash<void *, QString> m_hError;                   //!< Rows which failed to be saved => database error
+  std::thread m_thread;   //!< Thread saving pending changes in background
+  bool m_bRunning;        //!< A background save is running (accessed only by the model thread)
+
+  QMutex m_mutex;         //!< Protects the result of the background save
+  bool m_bResultReady;
+  QSqlError m_resultError;
+  QList<void *> m_resultItems;
+  QList<int> m_resultRows;
+  QList<int> m_resultFailed;
+  QStringList m_resultErrors;
+
+  IxModelWriteBack()
+      : m_iFlushInterval(500), m_iMaxPendingRows(100), m_bBackground(false),
+        m_bRunning(false), m_bResultReady(false) {
+    m_timer.setSingleShot(true);
+  }
+
+  ~IxModelWriteBack() {
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+};
+
 IxModel::IxModel(QObject *parent /* = 0 */)
     : QAbstractItemModel(parent), QX_CONSTRUCT_IX_MODEL() {
   ;
@@ -188,17 +268,73 @@ void IxModel::setParentModel(IxModel *pParent) {
 }
 
 void IxModel::setAutoUpdateDatabase_(int i) {
-  m_eAutoUpdateDatabase = static_cast<IxModel::e_auto_update_database>(i);
+  setAutoUpdateDatabase(static_cast<IxModel::e_auto_update_database>(i));
 }
 
 void IxModel::setAutoUpdateDatabase(IxModel::e_auto_update_database e) {
+  if ((m_eAutoUpdateDatabase == IxModel::e_auto_update_deferred) &&
+      (e != IxModel::e_auto_update_deferred)) {
+    flushPendingChanges(true);
+  }
   m_eAutoUpdateDatabase = e;
 }
 
+void IxModel::setAutoUpdateDeferred(int iFlushInterval /* = 500 */,
+                                    int iMaxPendingRows /* = 100 */,
+                                    bool bBackgroundConnection /* = false */) {
+  IxModel::IxModelWriteBack *p = getWriteBack();
+  p->m_iFlushInterval = qMax(0, iFlushInterval);
+  p->m_iMaxPendingRows = qMax(1, iMaxPendingRows);
+  p->m_bBackground = bBackgroundConnection;
+  m_eAutoUpdateDatabase = IxModel::e_auto_update_deferred;
+}
+
+int IxModel::getPendingChangesCount() const {
+  return (m_pWriteBack ? static_cast<int>(m_pWriteBack->m_lstPendingItem.count())
+                       : 0);
+}
+
+QString IxModel::getWriteBackError(int row) const {
+  void *pItem = (m_pWriteBack ? getRowItemAsVoidPtr(row) : NULL);
+  return (pItem ? m_pWriteBack->m_hError.value(pItem) : QString());
+}
+
 void IxModel::setCustomProperty(const QString &key, const QVariant &val) {
   m_hCustomProperties.insert(key, val);
 }
 
+void IxModel::setIncrementalFetch(int iChunkSize, int iWindowSize /* = 0 */,
+                                  bool bKeysetPagination /* = true */) {
+  if (iChunkSize <= 0) {
+    m_pIncrementalFetch.reset();
+    return;
+  }
+  if (!m_pIncrementalFetch) {
+    m_pIncrementalFetch.reset(new IxModel::IxModelIncrementalFetch());
+  }
+  if ((iWindowSize > 0) && (iWindowSize < (2 * iChunkSize))) {
+    qDebug("[QxOrm] qx::IxModel::setIncrementalFetch() : '%s'",
+           "window size must be at least twice the chunk size, window size "
+           "has been increased");
+    iWindowSize = (2 * iChunkSize);
+  }
+  m_pIncrementalFetch->m_iChunkSize = iChunkSize;
+  m_pIncrementalFetch->m_iWindowSize = ((iWindowSize > 0) ? iWindowSize : 0);
+  m_pIncrementalFetch->m_bKeysetPagination = bKeysetPagination;
+}
+
+int IxModel::getIncrementalChunkSize() const {
+  return (m_pIncrementalFetch ? m_pIncrementalFetch->m_iChunkSize : 0);
+}
+
+int IxModel::getIncrementalWindowSize() const {
+  return (m_pIncrementalFetch ? m_pIncrementalFetch->m_iWindowSize : 0);
+}
+
+bool IxModel::isIncrementalFetch() const {
+  return (m_pIncrementalFetch && m_pIncrementalFetch->m_bActive);
+}
+
 int IxModel::qxCount_(const QString &sQuery) {
   qx_query query(sQuery);
   return static_cast<int>(qxCount(query, database(NULL)));
@@ -219,6 +355,12 @@ bool IxModel::qxFetchByQuery_(
   return (!qxFetchByQuery(query, relation, database(NULL)).isValid());
 }
 
+bool IxModel::qxFetchIncremental_(
+    const QStringList &relation /* = QStringList() */) {
+  return (!qxFetchIncremental(qx::QxSqlQuery(), relation, database(NULL))
+               .isValid());
+}
+
 bool IxModel::qxFetchRow_(int row,
                           const QStringList &relation /* = QStringList() */) {
   return (!qxFetchRow(row, relation, database(NULL)).isValid());
@@ -309,6 +451,239 @@ IxModel::qxValidateRow_(int row,
   return (invalidValueX ? QString() : invalidValueX.text());
 }
 
+bool IxModel::qxFlushPendingChanges() {
+  return (!flushPendingChanges(true).isValid());
+}
+
+IxModel::IxModelWriteBack *IxModel::getWriteBack() {
+  if (!m_pWriteBack) {
+    m_pWriteBack.reset(new IxModel::IxModelWriteBack());
+    QObject::connect((&m_pWriteBack->m_timer), SIGNAL(timeout()), this,
+                     SLOT(onWriteBackTimeout()));
+  }
+  return m_pWriteBack.get();
+}
+
+void IxModel::addPendingChange(int row, const QString &column) {
+  void *pItem = getRowItemAsVoidPtr(row);
+  if (!pItem) {
+    return;
+  }
+  IxModel::IxModelWriteBack *p = getWriteBack();
+  p->m_hError.remove(pItem);
+  if (!p->m_hPending.contains(pItem)) {
+    p->m_lstPendingItem.append(pItem);
+    p->m_hPending.insert(pItem, qMakePair(row, QStringList()));
+  }
+  QPair<int, QStringList> &pending = p->m_hPending[pItem];
+  pending.first = row;
+  if (!pending.second.contains(column)) {
+    pending.second.append(column);
+  }
+  if ((p->m_lstPendingItem.count() >= p->m_iMaxPendingRows) &&
+      !p->m_bRunning) {
+    flushPendingChanges(false);
+    return;
+  }
+  p->m_timer.start(p->m_iFlushInterval);
+}
+
+void IxModel::onWriteBackTimeout() { flushPendingChanges(false); }
+
+QSqlError IxModel::flushPendingChanges(bool bWait) {
+  IxModel::IxModelWriteBack *p = m_pWriteBack.get();
+  if (!p) {
+    return QSqlError();
+  }
+  if (p->m_bRunning && !bWait) {
+    return QSqlError(); // onWriteBackFinished() restarts the timer
+  } else if (p->m_bRunning) {
+    p->m_thread.join();
+    onWriteBackFinished();
+  }
+  p->m_timer.stop();
+
+  QList<void *> items;
+  QList<int> rows;
+  QList<QStringList> columns;
+  for (int i = 0; i < p->m_lstPendingItem.count(); i++) {
+    void *pItem = p->m_lstPendingItem.at(i);
+    QPair<int, QStringList> pending = p->m_hPending.value(pItem);
+    int row = findRowOfItem(pItem, pending.first);
+    if (row < 0) {
+      continue;
+    }
+    items << pItem;
+    rows << row;
+    columns << pending.second;
+  }
+  p->m_lstPendingItem.clear();
+  p->m_hPending.clear();
+  if (rows.isEmpty()) {
+    return QSqlError();
+  }
+
+  // A connection set by setDatabase() belongs to the model thread, so it
+  // cannot be used in background
+  bool bBackground = (p->m_bBackground && !bWait && !m_database.isValid());
+#if (QT_VERSION < 0x050D00)
+  // Before Qt 5.13, a connection cannot be cloned from another thread, and a
+  // connection cloned by the model thread cannot be used by another thread
+  bBackground = false;
+#endif // (QT_VERSION < 0x050D00)
+  IxModel::type_write_back_job job =
+      createWriteBackJob(rows, columns, bBackground);
+  if (!job) {
+    return QSqlError();
+  }
+  if (!bBackground) {
+    QList<int> failed;
+    QStringList errors;
+    QSqlError err = job(database(NULL), failed, errors);
+    finishWriteBack(err, items, rows, failed, errors);
+    return err;
+  }
+
+  QSqlError dbError;
+  QSqlDatabase source = qx::QxSqlDatabase::getDatabase(dbError);
+  if (dbError.isValid()) {
+    m_lastError = dbError;
+    return dbError;
+  }
+  if (p->m_thread.joinable()) {
+    p->m_thread.join();
+  }
+  p->m_bRunning = true;
+  QString sKey = "qx_model_write_back_" + QUuid::createUuid().toString();
+  // Since Qt 5.13, a connection can be cloned by its name from any thread
+  QString sSourceName = source.connectionName();
+  qx::QxSqlDatabase::type_fct_db_open fctOpen =
+      qx::QxSqlDatabase::getSingleton()->getFctDatabaseOpen();
+  p->m_thread = std::thread([this, p, job, sSourceName, sKey, fctOpen, items,
+                             rows]() {
+    QList<int> failed;
+    QStringList errors;
+    QSqlError err;
+    {
+#if (QT_VERSION >= 0x050D00)
+      QSqlDatabase db = QSqlDatabase::cloneDatabase(sSourceName, sKey);
+#else  // (QT_VERSION >= 0x050D00)
+      Q_UNUSED(sSourceName);
+      QSqlDatabase db; // Never reached : no background write-back before Qt 5.13
+#endif // (QT_VERSION >= 0x050D00)
+      if (!db.open()) {
+        err = db.lastError();
+        for (int i = 0; i < rows.count(); i++) {
+          failed << i;
+          errors << err.text();
+        }
+      } else {
+        if (fctOpen) {
+          fctOpen(db);
+        }
+        err = job((&db), failed, errors);
+      }
+      db.close();
+    }
+    QSqlDatabase::removeDatabase(sKey);
+    {
+      QMutexLocker locker(&p->m_mutex);
+      p->m_bResultReady = true;
+      p->m_resultError = err;
+      p->m_resultItems = items;
+      p->m_resultRows = rows;
+      p->m_resultFailed = failed;
+      p->m_resultErrors = errors;
+    }
+    QMetaObject::invokeMethod(this, "onWriteBackFinished",
+                              Qt::QueuedConnection);
+  });
+  return QSqlError();
+}
+
+void IxModel::onWriteBackFinished() {
+  IxModel::IxModelWriteBack *p = m_pWriteBack.get();
+  if (!p || !p->m_bRunning) {
+    return;
+  }
+  QSqlError err;
+  QList<void *> items;
+  QList<int> rows;
+  QList<int> failed;
+  QStringList errors;
+  {
+    QMutexLocker locker(&p->m_mutex);
+    if (!p->m_bResultReady) {
+      return; // Queued call of a previous save already processed
+    }
+    p->m_bResultReady = false;
+    err = p->m_resultError;
+    items = p->m_resultItems;
+    rows = p->m_resultRows;
+    failed = p->m_resultFailed;
+    errors = p->m_resultErrors;
+  }
+  if (p->m_thread.joinable()) {
+    p->m_thread.join();
+  }
+  p->m_bRunning = false;
+  finishWriteBack(err, items, rows, failed, errors);
+  if (!p->m_lstPendingItem.isEmpty()) {
+    p->m_timer.start(p->m_iFlushInterval);
+  }
+}
+
+void IxModel::finishWriteBack(const QSqlError &err,
+                              const QList<void *> &items,
+                              const QList<int> &rows, const QList<int> &failed,
+                              const QStringList &errors) {
+  IxModel::IxModelWriteBack *p = getWriteBack();
+  m_lastError = err;
+  for (int i = 0; i < failed.count(); i++) {
+    int pos = failed.at(i);
+    if ((pos < 0) || (pos >= items.count())) {
+      continue;
+    }
+    void *pItem = items.at(pos);
+    int row = findRowOfItem(pItem, rows.at(pos));
+    if (row < 0) {
+      continue;
+    }
+    QString sError = ((i < errors.count()) ? errors.at(i) : err.text());
+    p->m_hError.insert(pItem, sError);
+    qDebug("[QxOrm] qx::IxModel::flushPendingChanges() : unable to save row "
+           "%d : %s",
+           row, qPrintable(sError));
+    raiseEvent_headerDataChanged(Qt::Vertical, row, row);
+    Q_EMIT writeBackFailed(row, sError);
+  }
+}
+
+int IxModel::findRowOfItem(void *pItem, int iRowHint) const {
+  if (!pItem || !m_pCollection) {
+    return -1;
+  }
+  if (getRowItemAsVoidPtr(iRowHint) == pItem) {
+    return iRowHint;
+  }
+  for (long l = 0; l < m_pCollection->_count(); l++) {
+    if (getRowItemAsVoidPtr(static_cast<int>(l)) == pItem) {
+      return static_cast<int>(l);
+    }
+  }
+  return -1;
+}
+
+void IxModel::removeWriteBackRows(int row, int count) {
+  if (!m_pWriteBack) {
+    return;
+  }
+  flushPendingChanges(true);
+  for (int i = row; i < (row + count); i++) {
+    m_pWriteBack->m_hError.remove(getRowItemAsVoidPtr(i));
+  }
+}
+
 void IxModel::raiseEvent_headerDataChanged(Qt::Orientation orientation,
                                            int first, int last) {
   Q_EMIT headerDataChanged(orientation, first, last);
@@ -358,6 +733,13 @@ void IxModel::clear(bool bUpdateColumns /* = false */) {
     qAssert(false);
     return;
   }
+  if (m_pIncrementalFetch) {
+    m_pIncrementalFetch->resetCursor();
+  }
+  if (m_pWriteBack) {
+    flushPendingChanges(true);
+    m_pWriteBack->m_hError.clear();
+  }
   if (!bUpdateColumns && (m_pCollection->_count() <= 0)) {
     return;
   }
@@ -420,6 +802,22 @@ void IxModel::removeListOfChild(long row) {
   m_lstChild.removeAt(row);
 }
 
+void IxModel::insertListOfChild(long row, long count) {
+  if ((row < 0) || (row >= m_lstChild.count()) || (count <= 0)) {
+    return;
+  }
+  for (long l = 0; l < count; l++) {
+    m_lstChild.insert(row, IxModel::type_relation_by_name());
+  }
+  QMutableHashIterator<IxModel *, QPair<int, QString>> itr(m_hChild);
+  while (itr.hasNext()) {
+    itr.next();
+    if (itr.value().first >= row) {
+      itr.value().first += static_cast<int>(count);
+    }
+  }
+}
+
 QSqlError IxModel::saveChildRelations(IxModel *pChild) {
   if (!m_hChild.contains(pChild)) {
     return QSqlError();
@@ -500,8 +898,15 @@ bool IxModel::setData(const QModelIndex &index, const QVariant &value,
       return true;
     }
     qx_bool bSetData = pDataMember->fromVariant(pItem, value);
-    if (bSetData &&
-        (m_eAutoUpdateDatabase == qx::IxModel::e_auto_update_on_field_change)) {
+    bool bDeferred =
+        ((m_eAutoUpdateDatabase == qx::IxModel::e_auto_update_deferred) &&
+         !bDirtyRow && m_pDataMemberId && (pDataMember != m_pDataMemberId) &&
+         !pDataMember->hasSqlRelation() &&
+         qx::trait::is_valid_primary_key(m_pDataMemberId->toVariant(pItem)));
+    if (bSetData && bDeferred) {
+      addPendingChange(index.row(), pDataMember->getKey());
+    } else if (bSetData &&
+               (m_eAutoUpdateDatabase != qx::IxModel::e_no_auto_update)) {
       qxSaveRowData(index.row(), (QStringList() << pDataMember->getKey()));
       if (!m_lastError.isValid() && bDirtyRow) {
         insertDirtyRowToModel();
@@ -586,6 +991,14 @@ QVariant IxModel::headerData(int section, Qt::Orientation orientation,
       (isDirtyRow(section))) {
     return QString(QStringLiteral("*"));
   }
+  if ((orientation == Qt::Vertical) && m_pWriteBack &&
+      ((role == Qt::DisplayRole) || (role == Qt::ToolTipRole))) {
+    QString sError = getWriteBackError(section);
+    if (!sError.isEmpty()) {
+      return ((role == Qt::DisplayRole) ? QString(QStringLiteral("!"))
+                                        : sError);
+    }
+  }
   if (orientation != Qt::Horizontal) {
     return QAbstractItemModel::headerData(section, orientation, role);
   }
@@ -631,12 +1044,204 @@ Qt::DropActions IxModel::supportedDropActions() const {
   return QAbstractItemModel::supportedDropActions();
 }
 
+bool IxModel::canFetchMore(
+    const QModelIndex &parent /* = QModelIndex() */) const {
+  if (parent.isValid() || !isIncrementalFetch()) {
+    return QAbstractItemModel::canFetchMore(parent);
+  }
+  return (!m_pIncrementalFetch->m_bAtEnd &&
+          !m_pIncrementalFetch->m_bFetching);
+}
+
+void IxModel::fetchMore(const QModelIndex &parent /* = QModelIndex() */) {
+  if (parent.isValid() || !isIncrementalFetch()) {
+    QAbstractItemModel::fetchMore(parent);
+    return;
+  }
+  m_lastError = fetchIncrementalChunk(false);
+}
+
+bool IxModel::canFetchPrevious() const {
+  return (isIncrementalFetch() && !m_pIncrementalFetch->m_bAtBegin &&
+          !m_pIncrementalFetch->m_bFetching);
+}
+
+void IxModel::fetchPrevious() {
+  if (!isIncrementalFetch()) {
+    return;
+  }
+  m_lastError = fetchIncrementalChunk(true);
+}
+
+QSqlError IxModel::qxFetchIncremental(
+    const qx::QxSqlQuery &query /* = qx::QxSqlQuery() */,
+    const QStringList &relation /* = QStringList() */,
+    QSqlDatabase *pDatabase /* = NULL */) {
+  if (!m_pIncrementalFetch) {
+    m_lastError = QSqlError("[QxOrm] problem with 'qxFetchIncremental()' "
+                            "method : 'incremental fetch is disabled, call "
+                            "setIncrementalFetch() method first'",
+                            QLatin1String(""), QSqlError::UnknownError);
+    return m_lastError;
+  }
+  if (!query.queryAt(0).isEmpty()) {
+    m_lastError = QSqlError("[QxOrm] problem with 'qxFetchIncremental()' "
+                            "method : 'filter query must be written with C++ "
+                            "syntax (classic SQL is not supported)'",
+                            QLatin1String(""), QSqlError::UnknownError);
+    return m_lastError;
+  }
+  if (!query.getKeysetColumns().isEmpty()) {
+    m_lastError = QSqlError("[QxOrm] problem with 'qxFetchIncremental()' "
+                            "method : 'filter query must not contain an ORDER "
+                            "BY clause (use sort() method instead)'",
+                            QLatin1String(""), QSqlError::UnknownError);
+    return m_lastError;
+  }
+
+  clear();
+  IxModel::IxModelIncrementalFetch *p = m_pIncrementalFetch.get();
+  QSqlDatabase *pDb = database(pDatabase);
+  p->m_filter = query;
+  p->m_relation = relation;
+  p->m_bDatabase = (pDb != NULL);
+  p->m_database = (pDb ? (*pDb) : QSqlDatabase());
+  p->m_bKeyset = (p->m_bKeysetPagination && m_pDataMemberId &&
+                  (m_pDataMemberId->getNameCount() == 1));
+  p->resetCursor();
+  p->m_bActive = true;
+  p->m_bAtEnd = false;
+  m_lastError = fetchIncrementalChunk(false);
+  return m_lastError;
+}
+
+QSqlError IxModel::fetchIncrementalChunk(bool bPrevious) {
+  IxModel::IxModelIncrementalFetch *p = m_pIncrementalFetch.get();
+  if (!p || !p->m_bActive || p->m_bFetching || !m_pCollection) {
+    return QSqlError();
+  }
+  if (bPrevious ? p->m_bAtBegin : p->m_bAtEnd) {
+    return QSqlError();
+  }
+
+  // Sort is pushed down to the query, primary key makes the order unique
+  QStringList lstColumns;
+  if (p->m_pSortDataMember) {
+    lstColumns << p->m_pSortDataMember->getName();
+  }
+  if (m_pDataMemberId && (m_pDataMemberId->getNameCount() == 1)) {
+    lstColumns << m_pDataMemberId->getName();
+  }
+
+  // Keyset pagination fetches previous rows in reverse order, then they are
+  // reversed again before being prepended to the model
+  qx::QxSqlQuery query = p->m_filter;
+  bool bReverse = (p->m_bKeyset && bPrevious);
+  bool bDescending = (p->m_bSortDescending != bReverse);
+  long lRequested = p->m_iChunkSize;
+  if (!lstColumns.isEmpty() && bDescending) {
+    query.orderDesc(lstColumns);
+  } else if (!lstColumns.isEmpty()) {
+    query.orderAsc(lstColumns);
+  }
+  if (p->m_bKeyset) {
+    query.after((bPrevious ? p->m_firstValues : p->m_lastValues),
+                p->m_iChunkSize);
+  } else {
+    long lStart = (bPrevious ? qMax(0L, (p->m_lFirstOffset - p->m_iChunkSize))
+                             : p->m_lEndOffset);
+    lRequested = (bPrevious ? (p->m_lFirstOffset - lStart) : lRequested);
+    query.limit(static_cast<int>(lRequested), static_cast<int>(lStart));
+  }
+
+  p->m_bFetching = true;
+  long lFetched = 0;
+  long lInserted = 0;
+  bool bWasEmpty = (m_pCollection->_count() <= 0);
+  int row = (bPrevious ? 0 : static_cast<int>(m_pCollection->_count()));
+  QSqlDatabase *pDatabase = (p->m_bDatabase ? (&p->m_database) : NULL);
+  QSqlError err = qxFetchChunk_Helper(query, p->m_relation, pDatabase, row,
+                                      bReverse, lFetched, lInserted);
+  if (err.isValid()) {
+    p->m_bFetching = false;
+    return err;
+  }
+
+  if (bPrevious) {
+    p->m_bAtBegin = ((lFetched < lRequested) ||
+                     (!p->m_bKeyset && (p->m_lFirstOffset <= lFetched)));
+    p->m_lFirstOffset = qMax(0L, (p->m_lFirstOffset - lFetched));
+  } else {
+    p->m_bAtEnd = (lFetched < lRequested);
+    p->m_lEndOffset += lFetched;
+  }
+  if (lInserted > 0) {
+    p->m_firstValues =
+        ((bPrevious || bWasEmpty) ? getIncrementalKeyValues(0)
+                                  : p->m_firstValues);
+    p->m_lastValues = (bPrevious ? p->m_lastValues
+                                 : getIncrementalKeyValues(static_cast<int>(
+                                       row + lInserted - 1)));
+  }
+
+  // Evict far-away rows : at the top when scrolling down, at the bottom when
+  // scrolling up
+  long lCount = m_pCollection->_count();
+  long lExcess = ((p->m_iWindowSize > 0) ? (lCount - p->m_iWindowSize) : 0);
+  if (lExcess > 0) {
+    int iFirst = (bPrevious ? static_cast<int>(lCount - lExcess) : 0);
+    removeRowsGeneric(iFirst, static_cast<int>(lExcess));
+    lCount = m_pCollection->_count();
+    if (bPrevious) {
+      p->m_bAtEnd = false;
+      p->m_lEndOffset -= lExcess;
+      p->m_lastValues = getIncrementalKeyValues(static_cast<int>(lCount - 1));
+    } else {
+      p->m_bAtBegin = false;
+      p->m_lFirstOffset += lExcess;
+      p->m_firstValues = getIncrementalKeyValues(0);
+    }
+  }
+
+  p->m_bFetching = false;
+  return err;
+}
+
+bool IxModel::sortIncremental(int column, Qt::SortOrder order) {
+  IxDataMember *pDataMember = getDataMember(column);
+  if (!pDataMember || !isIncrementalFetch()) {
+    return false;
+  }
+  IxModel::IxModelIncrementalFetch *p = m_pIncrementalFetch.get();
+  p->m_pSortDataMember = ((pDataMember == m_pDataMemberId) ? NULL : pDataMember);
+  p->m_bSortDescending = (order == Qt::DescendingOrder);
+  qx::QxSqlQuery filter = p->m_filter;
+  QStringList relation = p->m_relation;
+  QSqlDatabase db = p->m_database;
+  qxFetchIncremental(filter, relation, (p->m_bDatabase ? (&db) : NULL));
+  return true;
+}
+
+QVariantList IxModel::getIncrementalKeyValues(int row) const {
+  QVariantList lst;
+  void *pItem = getRowItemAsVoidPtr(row);
+  IxModel::IxModelIncrementalFetch *p = m_pIncrementalFetch.get();
+  if (!pItem || !p || !p->m_bKeyset) {
+    return lst;
+  }
+  if (p->m_pSortDataMember) {
+    lst << p->m_pSortDataMember->toVariant(pItem);
+  }
+  lst << m_pDataMemberId->toVariant(pItem);
+  return lst;
+}
+
 bool IxModel::removeRows(int row, int count,
                          const QModelIndex &parent /* = QModelIndex() */) {
   if (parent.isValid()) {
     return false;
   }
-  if (m_eAutoUpdateDatabase == IxModel::e_auto_update_on_field_change) {
+  if (m_eAutoUpdateDatabase != IxModel::e_no_auto_update) {
     return removeRowsAutoUpdateOnFieldChange(row, count);
   }
   return removeRowsGeneric(row, count);
@@ -647,6 +1252,7 @@ bool IxModel::removeRowsGeneric(int row, int count) {
     qAssert(false);
     return false;
   }
+  removeWriteBackRows(row, count);
   beginRemoveRows(QModelIndex(), row, (row + count - 1));
   for (int i = 0; i < count; ++i) {
     m_pCollection->_remove(row);
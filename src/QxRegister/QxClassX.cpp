@@ -82,12 +82,15 @@ bool QxClassX::insert(const QString & sKey, IxClass * pClass)
 
 bool QxClassX::remove(const QString & sKey)
 {
-   return m_lstClass.removeByKey(sKey);
+   bool bRemoved = m_lstClass.removeByKey(sKey);
+   if (bRemoved) { qx::QxFactoryX::incrementRegistryVersion(); }
+   return bRemoved;
 }
 
 void QxClassX::clear()
 {
    m_lstClass.clear();
+   qx::QxFactoryX::incrementRegistryVersion();
 }
 
 qx::any QxClassX::create(const QString & sKey)
@@ -135,32 +138,32 @@ IxDataMember * QxClassX::getDataMember(const QString & sClassKey, const QString
 
 IxFunction * QxClassX::getFctMember(const QString & sClassKey, const QString & sFctKey, bool bRecursive /* = true */)
 {
-   QString sBaseClassKey = sClassKey;
-   IxClass * pClass(NULL); IxFunctionX * pFctX(NULL); IxFunction * pFct(NULL);
+   // Walk through base classes using IxClass pointers : the class key is looked up only once
+   IxClass * pClass = QxClassX::getClass(sClassKey); IxFunction * pFct(NULL);
 
-   do {
-      pClass = QxClassX::getClass(sBaseClassKey);
-      pFctX = QxClassX::getFctMemberX(sBaseClassKey);
+   while (pClass)
+   {
+      IxFunctionX * pFctX = pClass->getFctMemberX();
       pFct = ((pFctX && pFctX->exist(sFctKey)) ? pFctX->getByKey(sFctKey).get() : NULL);
-      sBaseClassKey = ((pClass && pClass->getBaseClass()) ? pClass->getBaseClass()->getKey()
-                                                          : QLatin1String(""));
-   } while (bRecursive && ! pFct && pClass && ! sBaseClassKey.isEmpty() && ! pClass->isFinalClass());
+      if (pFct || ! bRecursive || pClass->isFinalClass()) { break; }
+      pClass = pClass->getBaseClass();
+   }
 
    return pFct;
 }
 
 IxFunction * QxClassX::getFctStatic(const QString & sClassKey, const QString & sFctKey, bool bRecursive /* = true */)
 {
-   QString sBaseClassKey = sClassKey;
-   IxClass * pClass(NULL); IxFunctionX * pFctX(NULL); IxFunction * pFct(NULL);
+   // Walk through base classes using IxClass pointers : the class key is looked up only once
+   IxClass * pClass = QxClassX::getClass(sClassKey); IxFunction * pFct(NULL);
 
-   do {
-      pClass = QxClassX::getClass(sBaseClassKey);
-      pFctX = QxClassX::getFctStaticX(sBaseClassKey);
+   while (pClass)
+   {
+      IxFunctionX * pFctX = pClass->getFctStaticX();
       pFct = ((pFctX && pFctX->exist(sFctKey)) ? pFctX->getByKey(sFctKey).get() : NULL);
-      sBaseClassKey = ((pClass && pClass->getBaseClass()) ? pClass->getBaseClass()->getKey()
-                                                                : QLatin1String(""));
-   } while (bRecursive && ! pFct && pClass && ! sBaseClassKey.isEmpty() && ! pClass->isFinalClass());
+      if (pFct || ! bRecursive || pClass->isFinalClass()) { break; }
+      pClass = pClass->getBaseClass();
+   }
 
    return pFct;
 }
@@ -197,6 +200,26 @@ qx_bool QxClassX::invokeStatic(const QString & sClassKey, const QString & sFctKe
    return (pFct ? pFct->invoke(params, ret) : qx_bool(false));
 }
 
+qx_bool QxClassX::invokeStatic(IxFunction * pFct, const QString & params /* = QString() */, qx::any * ret /* = NULL */)
+{
+   return (pFct ? pFct->invoke(params, ret) : qx_bool(false));
+}
+
+qx_bool QxClassX::invokeStatic(IxFunction * pFct, const type_any_params & params, qx::any * ret /* = NULL */)
+{
+   return (pFct ? pFct->invoke(params, ret) : qx_bool(false));
+}
+
+qx_bool QxClassX::invokeVoidPtr(IxFunction * pFct, void * pOwner, const QString & params /* = QString() */, qx::any * ret /* = NULL */)
+{
+   return ((pOwner && pFct) ? pFct->invoke(pOwner, params, ret) : qx_bool(false));
+}
+
+qx_bool QxClassX::invokeVoidPtr(IxFunction * pFct, void * pOwner, const type_any_params & params, qx::any * ret /* = NULL */)
+{
+   return ((pOwner && pFct) ? pFct->invoke(pOwner, params, ret) : qx_bool(false));
+}
+
 #ifndef _QX_NO_RTTI
 const std::type_info & QxClassX::typeInfo(const QString & sKey) const
 {
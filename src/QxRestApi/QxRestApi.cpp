@@ -59,11 +59,89 @@
 
 #include <QxCommon/QxException.h>
 #include <QxCommon/QxExceptionCode.h>
+#include <QxCommon/QxTrace.h>
 
 #include <QxMemLeak/mem_leak.h>
 
 namespace qx {
 
+// Handles resolved only once by entity (factory of qx::IxPersistable classes)
+// and by (entity, function) (static functions called by action
+// 'call_entity_function') : only resolved handles are stored, so invalid
+// requests cannot grow the cache ; handles are dropped when a class or a
+// factory is removed (plugin unloaded for example)
+struct QxRestApi_HandleCache {
+  QMutex m_mutex;
+  int m_iRegistryVersion;
+  QHash<QString, qx::IxFactory *> m_lstPersistableFactory;
+  QHash<QPair<QString, QString>, qx::IxFunction *> m_lstEntityFct;
+
+  QxRestApi_HandleCache() : m_iRegistryVersion(0) { ; }
+
+  void sync(int iRegistryVersion) {
+    if (m_iRegistryVersion != iRegistryVersion) {
+      m_lstPersistableFactory.clear();
+      m_lstEntityFct.clear();
+      m_iRegistryVersion = iRegistryVersion;
+    }
+  }
+};
+
+static QxRestApi_HandleCache &getRestApiHandleCache() {
+  static QxRestApi_HandleCache cache;
+  return cache;
+}
+
+static qx::IxFactory *getPersistableFactory(const QString &sEntity,
+                                            bool &bPersistable) {
+  QxRestApi_HandleCache &cache = getRestApiHandleCache();
+  bPersistable = true;
+  int iRegistryVersion = qx::QxFactoryX::getRegistryVersion();
+  {
+    QMutexLocker locker(&cache.m_mutex);
+    cache.sync(iRegistryVersion);
+    qx::IxFactory *pFactory = cache.m_lstPersistableFactory.value(sEntity, NULL);
+    if (pFactory) {
+      return pFactory;
+    }
+  }
+  bPersistable = qx::QxClassX::implementIxPersistable(sEntity);
+  if (!bPersistable) {
+    return NULL;
+  }
+  qx::IxFactory *pFactory = qx::find_factory(sEntity);
+  if (pFactory) {
+    QMutexLocker locker(&cache.m_mutex);
+    if (cache.m_iRegistryVersion == iRegistryVersion) {
+      cache.m_lstPersistableFactory.insert(sEntity, pFactory);
+    }
+  }
+  return pFactory;
+}
+
+static qx::IxFunction *getEntityFct(const QString &sEntity,
+                                    const QString &sFunction) {
+  QxRestApi_HandleCache &cache = getRestApiHandleCache();
+  QPair<QString, QString> key(sEntity, sFunction);
+  int iRegistryVersion = qx::QxFactoryX::getRegistryVersion();
+  {
+    QMutexLocker locker(&cache.m_mutex);
+    cache.sync(iRegistryVersion);
+    qx::IxFunction *pFct = cache.m_lstEntityFct.value(key, NULL);
+    if (pFct) {
+      return pFct;
+    }
+  }
+  qx::IxFunction *pFct = qx::QxClassX::getFctStatic(sEntity, sFunction, true);
+  if (pFct) {
+    QMutexLocker locker(&cache.m_mutex);
+    if (cache.m_iRegistryVersion == iRegistryVersion) {
+      cache.m_lstEntityFct.insert(key, pFct);
+    }
+  }
+  return pFct;
+}
+
 struct QxRestApi::QxRestApiImpl {
 
   QString m_requestId; //!< Request identifier (GUID for example)
@@ -88,6 +166,9 @@ struct QxRestApi::QxRestApiImpl {
   qx_bool m_existResult;            //!< Result after a exist query
   QxInvalidValueX m_validateResult; //!< Result after a validate query
   qx::dao::save_mode::e_save_mode m_eSaveMode; //!< Save mode for 'save' action
+  QString m_cursor;     //!< Keyset cursor (last row of previous page) for action 'fetch_by_query'
+  int m_pageSize;       //!< Page size for action 'fetch_by_query' (keyset pagination)
+  QString m_nextCursor; //!< Keyset cursor to fetch next page (when page is full)
 
 #ifndef _QX_NO_JSON
 
@@ -101,7 +182,9 @@ struct QxRestApi::QxRestApiImpl {
 
 #endif // _QX_NO_JSON
 
-  QxRestApiImpl() : m_countResult(0), m_eSaveMode(qx::dao::save_mode::e_none) {
+  QxRestApiImpl()
+      : m_countResult(0), m_eSaveMode(qx::dao::save_mode::e_none),
+        m_pageSize(0) {
     ;
   }
   ~QxRestApiImpl() { ; }
@@ -121,10 +204,12 @@ struct QxRestApi::QxRestApiImpl {
   bool buildResponse();
   bool formatResponse();
   bool doRequest();
+  bool doRequestSteps();
   void getMetaData();
   QJsonValue getMetaData(IxClass *pClass);
   qx_bool callEntityFunction();
   void getDatabases();
+  QString getNextCursor() const;
 
 #endif // _QX_NO_JSON
 };
@@ -259,6 +344,17 @@ QxRestApi::QxRestApiImpl::processRequestAsArray(const QJsonValue &request) {
 }
 
 bool QxRestApi::QxRestApiImpl::doRequest() {
+  qx::QxTraceSpan traceSpan("QxRestApi", "rest_api");
+  bool bOk = doRequestSteps();
+  if (traceSpan.isRecording()) {
+    traceSpan.setAttribute(QStringLiteral("qx.entity"), m_entity);
+    traceSpan.setAttribute(QStringLiteral("qx.action"), m_action);
+    traceSpan.setError(!bOk);
+  }
+  return bOk;
+}
+
+bool QxRestApi::QxRestApiImpl::doRequestSteps() {
   if (!decodeRequest()) {
     return false;
   }
@@ -300,6 +396,9 @@ void QxRestApi::QxRestApiImpl::resetRequest() {
     m_dataJson = QJsonValue();
     m_requestJson = QJsonValue();
     m_responseJson = QJsonValue();
+    m_cursor = QLatin1String("");
+    m_pageSize = 0;
+    m_nextCursor = QLatin1String("");
     m_eSaveMode = qx::dao::save_mode::e_none;
     m_columns.clear();
     m_relations.clear();
@@ -361,13 +460,15 @@ bool QxRestApi::QxRestApiImpl::createInstance() {
       buildError(9999, QStringLiteral("JSON request is invalid : 'entity' field is empty"));
       return false;
   }
-  if (!qx::QxClassX::implementIxPersistable(m_entity)) {
+  bool bPersistable = false;
+  qx::IxFactory *pFactory = getPersistableFactory(m_entity, bPersistable);
+  if (!bPersistable) {
     buildError(9999, "Entity '" + m_entity +
                          "' must implement qx::IxPersistable interface");
     return false;
   }
   m_instance = qx::IxPersistable_ptr(
-      static_cast<qx::IxPersistable *>(qx::create_void_ptr(m_entity)));
+      static_cast<qx::IxPersistable *>(qx::create_void_ptr(pFactory)));
   if (!m_instance) {
     buildError(9999, "Entity '" + m_entity +
                          "' is not valid : unable to create a new "
@@ -562,6 +663,14 @@ bool QxRestApi::QxRestApiImpl::decodeRequest() {
     m_qxQuery = qx_query(m_query);
   }
 
+  // Extract keyset pagination parameters for 'fetch_by_query' action
+  if (request.contains(QStringLiteral("cursor"))) {
+    m_cursor = request.value(QStringLiteral("cursor")).toString();
+  }
+  if (request.contains(QStringLiteral("page_size"))) {
+    m_pageSize = request.value(QStringLiteral("page_size")).toInt();
+  }
+
   return true;
 }
 
@@ -620,6 +729,30 @@ bool QxRestApi::QxRestApiImpl::checkRequest() {
     return false;
   }
 
+  bool isKeysetPagination = (!m_cursor.isEmpty() || (m_pageSize > 0));
+  if (isKeysetPagination && (m_action != QLatin1String("fetch_by_query"))) {
+    buildError(9999, "Parameters 'cursor' and 'page_size' are not supported "
+                     "for action '" + m_action + "'");
+    return false;
+  }
+  if (isKeysetPagination &&
+      (!m_qxQuery.queryAt(0).isEmpty() ||
+       m_qxQuery.getKeysetColumns().isEmpty())) {
+    buildError(9999, "Parameters 'cursor' and 'page_size' require a 'query' "
+                     "with an ORDER BY clause for action '" + m_action + "'");
+    return false;
+  }
+  if (isKeysetPagination) {
+    QVariantList lastValues = qx::QxSqlQuery::fromCursorToken(m_cursor);
+    if (!m_cursor.isEmpty() &&
+        (lastValues.count() != m_qxQuery.getKeysetColumns().count())) {
+      buildError(9999, "Parameter 'cursor' is invalid for action '" +
+                           m_action + "'");
+      return false;
+    }
+    m_qxQuery.after(lastValues, m_pageSize);
+  }
+
   bool isFunctionRequired = (m_action == QLatin1String("call_entity_function"));
   if (isFunctionRequired && (m_function.isEmpty())) {
     buildError(9999,
@@ -766,15 +899,70 @@ bool QxRestApi::QxRestApiImpl::buildResponse() {
       outputFormat = QStringLiteral(QX_JSON_SERIALIZE_ONLY_ID);
   }
   m_responseJson = m_instance->toJson_(outputFormat);
+  if ((m_action == QLatin1String("fetch_by_query")) && (m_pageSize > 0)) {
+    m_nextCursor = getNextCursor();
+  }
   return true;
 }
 
+QString QxRestApi::QxRestApiImpl::getNextCursor() const {
+  // A partial page means there is no more row to fetch
+  std::shared_ptr<qx::IxPersistableCollection> lst =
+      std::dynamic_pointer_cast<qx::IxPersistableCollection>(m_instance);
+  long lCount = (lst ? lst->__count() : 0);
+  if ((lCount <= 0) || (lCount < m_pageSize)) {
+    return QString();
+  }
+
+  IxClass *pClass = qx::QxClassX::getClass(m_entity);
+  IxDataMemberX *pDataMemberX = (pClass ? pClass->getDataMemberX() : NULL);
+  if (!pDataMemberX) {
+    return QString();
+  }
+
+  // Values are read from the last fetched entity (not from JSON output) to keep
+  // their types (qint64 above 2^53, QDateTime, QDate, etc...)
+  qx::IxPersistable_ptr pLastRow = lst->__at(lCount - 1);
+  const void *pOwner = (pLastRow ? dynamic_cast<const void *>(pLastRow.get()) : NULL);
+  if (!pOwner) {
+    return QString();
+  }
+
+  // Map each ORDER BY column to its data member
+  QStringList lstColumns = m_qxQuery.getKeysetColumns();
+  QVariantList lastValues;
+  for (int i = 0; i < lstColumns.count(); i++) {
+    QString sColumn = lstColumns.at(i);
+    sColumn = sColumn.mid(sColumn.lastIndexOf(QLatin1Char('.')) + 1);
+    IxDataMember *pFound = NULL;
+    for (long l = 0; l < pDataMemberX->count_WithDaoStrategy(); l++) {
+      IxDataMember *p = pDataMemberX->get_WithDaoStrategy(l);
+      if (p && (p->getNameCount() == 1) &&
+          (p->getName().compare(sColumn, Qt::CaseInsensitive) == 0)) {
+        pFound = p;
+        break;
+      }
+    }
+    if (!pFound) {
+      qDebug("[QxOrm] qx::QxRestApi : unable to build next cursor, ORDER BY "
+             "column '%s' not found in entity",
+             qPrintable(lstColumns.at(i)));
+      return QString();
+    }
+    lastValues.append(pFound->toVariant(pOwner));
+  }
+  return qx::QxSqlQuery::toCursorToken(lastValues);
+}
+
 bool QxRestApi::QxRestApiImpl::formatResponse() {
   QJsonObject response;
   if (!m_requestId.isEmpty()) {
       response.insert(QStringLiteral("request_id"), m_requestId);
   }
   response.insert(QStringLiteral("data"), m_responseJson);
+  if (!m_nextCursor.isEmpty()) {
+    response.insert(QStringLiteral("next_cursor"), m_nextCursor);
+  }
   m_responseJson = response;
   return true;
 }
@@ -791,15 +979,16 @@ qx_bool QxRestApi::QxRestApiImpl::callEntityFunction() {
       buildError(9999, QStringLiteral("Unable to QStringLiteral(call entity function : 'fct' field is empt)y"));
       return qx_bool(false);
   }
-  if (!qx::QxClassX::getFctStatic(m_entity, m_function, true)) {
+  qx::IxFunction *pFct = getEntityFct(m_entity, m_function);
+  if (!pFct) {
     buildError(9999,
                "Unable to call entity function : '" + m_entity +
                    "::" + m_function +
                    "' function not found (or not registered in QxOrm context)");
     return qx_bool(false);
   }
-  qx_bool bInvokeFct = qx::QxClassX::invokeStatic(m_entity, m_function,
-                                                  anyRequest, (&anyResponse));
+  qx_bool bInvokeFct =
+      qx::QxClassX::invokeStatic(pFct, anyRequest, (&anyResponse));
   if (bInvokeFct) {
     m_responseJson = qx::any_cast<QJsonValue>(anyResponse);
   } else {
@@ -0,0 +1,438 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+
+#include <QxPrecompiled.h>
+
+#include <QtCore/quuid.h>
+#include <QtCore/qtimer.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qeventloop.h>
+#include <QtCore/qelapsedtimer.h>
+
+#include <QtNetwork/qhostaddress.h>
+
+#include <QxService/QxClientPool.h>
+#include <QxService/QxConnect.h>
+#include <QxService/QxTools.h>
+
+#include <QxCommon/QxExceptionCode.h>
+
+#include <QxMemLeak/mem_leak.h>
+
+#define QX_SERVICE_CLIENT_POOL_DEFAULT_MAX_CONNECTIONS 4
+#define QX_SERVICE_CLIENT_POOL_DEFAULT_MAX_IN_FLIGHT 64
+#define QX_SERVICE_CLIENT_POOL_CHECK_TIMEOUT_INTERVAL 500
+
+namespace qx {
+namespace service {
+
+struct QxClientPool::QxClientPoolImpl
+{
+
+   struct QxRequest
+   {
+      quint32 m_uiRequestId;                    //!< Request id written in transaction header
+      IxService_ptr m_pService;                 //!< Service to execute
+      QxTransaction_ptr m_pTransaction;         //!< Transaction sent to server
+      type_fct_on_finished m_fct;               //!< Function called when reply is received (or if an error occured)
+      QElapsedTimer m_timer;                    //!< Time elapsed since request has been created (to check timeout)
+
+      QxRequest() : m_uiRequestId(0) { ; }
+   };
+
+   typedef std::shared_ptr<QxRequest> QxRequest_ptr;
+
+   struct QxConnection
+   {
+      QTcpSocket * m_pSocket;                            //!< Persistent connection to server (NULL when connection is closed)
+      bool m_bReady;                                     //!< Socket connected (and encrypted if SSL is enabled)
+      QByteArray m_buffer;                               //!< Bytes read from socket (replies not completely received yet)
+      QByteArray m_uncompressed;                         //!< Buffer reused to uncompress replies
+      QHash<quint32, QxRequest_ptr> m_lstInFlight;       //!< Requests sent (or waiting for connection) without reply
+      QList<QxRequest_ptr> m_lstToWrite;                 //!< Requests waiting for connection to be written
+
+      QxConnection() : m_pSocket(NULL), m_bReady(false) { ; }
+   };
+
+   typedef std::shared_ptr<QxConnection> QxConnection_ptr;
+
+   QxClientPool * m_pParent;                    //!< Parent pool (to emit signals)
+   QList<QxConnection_ptr> m_lstConnection;     //!< List of connections to server
+   QQueue<QxRequest_ptr> m_lstQueue;            //!< Requests waiting for an available connection
+   quint32 m_uiLastRequestId;                   //!< Last request id generated
+   int m_iMaxConnections;                       //!< Max connections opened to server
+   int m_iMaxInFlight;                          //!< Max requests without reply per connection
+   QTimer m_timerTimeout;                       //!< Timer to check requests timeout (based on qx::service::QxConnect::getMaxWait())
+
+   QxClientPoolImpl(QxClientPool * parent) : m_pParent(parent), m_uiLastRequestId(0), m_iMaxConnections(QX_SERVICE_CLIENT_POOL_DEFAULT_MAX_CONNECTIONS), m_iMaxInFlight(QX_SERVICE_CLIENT_POOL_DEFAULT_MAX_IN_FLIGHT) { qAssert(m_pParent); }
+   ~QxClientPoolImpl() { ; }
+
+   int pendingCount() const
+   {
+      int iCount = m_lstQueue.count();
+      Q_FOREACH(QxConnection_ptr pConnection, m_lstConnection) { iCount += pConnection->m_lstInFlight.count(); }
+      return iCount;
+   }
+
+   QxConnection_ptr findConnection(QObject * pSocket) const
+   {
+      Q_FOREACH(QxConnection_ptr pConnection, m_lstConnection) { if (pConnection->m_pSocket == pSocket) { return pConnection; } }
+      return QxConnection_ptr();
+   }
+
+   QxConnection_ptr getConnection()
+   {
+      // Requests are spread over connections : a new connection is opened if all existing connections have requests in flight
+      QxConnection_ptr pBest;
+      Q_FOREACH(QxConnection_ptr pConnection, m_lstConnection)
+      { if ((! pBest) || (pConnection->m_lstInFlight.count() < pBest->m_lstInFlight.count())) { pBest = pConnection; } }
+      bool bCanCreate = (m_lstConnection.count() < qMax(m_iMaxConnections, 1));
+      if ((! pBest) || ((pBest->m_lstInFlight.count() > 0) && bCanCreate)) { return createConnection(); }
+      return ((pBest->m_lstInFlight.count() < qMax(m_iMaxInFlight, 1)) ? pBest : QxConnection_ptr());
+   }
+
+   QxConnection_ptr createConnection()
+   {
+      QxConnection_ptr pConnection = std::make_shared<QxConnection>();
+      QString serverName = QxConnect::getSingleton()->getIp();
+      long serverPort = QxConnect::getSingleton()->getPort();
+
+#ifndef QT_NO_SSL
+      bool bSSLEnabled = QxConnect::getSingleton()->getSSLEnabled();
+      if (bSSLEnabled)
+      {
+         QSslSocket * socket = initSocketSSL();
+         QObject::connect(socket, SIGNAL(encrypted()), m_pParent, SLOT(onSocketConnected()));
+         pConnection->m_pSocket = socket;
+      }
+      else
+      {
+         pConnection->m_pSocket = new QTcpSocket(m_pParent);
+         QObject::connect(pConnection->m_pSocket, SIGNAL(connected()), m_pParent, SLOT(onSocketConnected()));
+      }
+#else // QT_NO_SSL
+      pConnection->m_pSocket = new QTcpSocket(m_pParent);
+      QObject::connect(pConnection->m_pSocket, SIGNAL(connected()), m_pParent, SLOT(onSocketConnected()));
+#endif // QT_NO_SSL
+
+      QObject::connect(pConnection->m_pSocket, SIGNAL(readyRead()), m_pParent, SLOT(onSocketReadyRead()));
+      QObject::connect(pConnection->m_pSocket, SIGNAL(disconnected()), m_pParent, SLOT(onSocketDisconnected()));
+      QObject::connect(pConnection->m_pSocket, SIGNAL(error(QAbstractSocket::SocketError)), m_pParent, SLOT(onSocketError(QAbstractSocket::SocketError)));
+      m_lstConnection.append(pConnection);
+
+#ifndef QT_NO_SSL
+      if (bSSLEnabled) { static_cast<QSslSocket *>(pConnection->m_pSocket)->connectToHostEncrypted(serverName, serverPort); }
+      else { pConnection->m_pSocket->connectToHost(serverName, serverPort); }
+#else // QT_NO_SSL
+      pConnection->m_pSocket->connectToHost(serverName, serverPort);
+#endif // QT_NO_SSL
+
+      return pConnection;
+   }
+
+#ifndef QT_NO_SSL
+   QSslSocket * initSocketSSL()
+   {
+      QSslSocket * socket = new QSslSocket(m_pParent);
+      QxConnect * settings = QxConnect::getSingleton();
+      QSslConfiguration config = settings->getSSLConfiguration();
+      if (config.isNull()) { config = QSslConfiguration::defaultConfiguration(); }
+      QList<QSslCertificate> allCACertificates = settings->getSSLCACertificates();
+      config.setCaCertificates(allCACertificates); // because QSslSocket::setCaCertificates() is obsolete
+
+      socket->setSslConfiguration(config);
+      socket->ignoreSslErrors(settings->getSSLIgnoreErrors());
+      socket->setProtocol(settings->getSSLProtocol());
+      socket->setPeerVerifyName(settings->getSSLPeerVerifyName());
+      socket->setPeerVerifyMode(settings->getSSLPeerVerifyMode());
+      socket->setPeerVerifyDepth(settings->getSSLPeerVerifyDepth());
+      socket->setPrivateKey(settings->getSSLPrivateKey());
+      socket->setLocalCertificate(settings->getSSLLocalCertificate());
+
+      return socket;
+   }
+#endif // QT_NO_SSL
+
+   void dispatch()
+   {
+      while (! m_lstQueue.isEmpty())
+      {
+         QxConnection_ptr pConnection = getConnection();
+         if (! pConnection) { break; }
+         QxRequest_ptr pRequest = m_lstQueue.dequeue();
+         pConnection->m_lstInFlight.insert(pRequest->m_uiRequestId, pRequest);
+         if (pConnection->m_bReady) { send(pConnection, pRequest); }
+         else { pConnection->m_lstToWrite.append(pRequest); }
+      }
+   }
+
+   void send(QxConnection_ptr pConnection, QxRequest_ptr pRequest)
+   {
+      QTcpSocket * socket = pConnection->m_pSocket;
+      QxTransaction_ptr pTransaction = pRequest->m_pTransaction;
+      pTransaction->setIpSource(socket->localAddress().toString());
+      pTransaction->setPortSource(socket->localPort());
+
+      quint32 uiTransactionSize = 0;
+      qx_bool bWriteOk = QxTools::writeSocket((* socket), (* pTransaction), uiTransactionSize);
+      if (! bWriteOk)
+      {
+         pConnection->m_lstInFlight.remove(pRequest->m_uiRequestId);
+         finish(pRequest, NULL, 0, qx_bool(QX_ERROR_SERVICE_WRITE_ERROR, QStringLiteral("[QxOrm] unable to write to socket : '") + bWriteOk.getDesc() + QStringLiteral("'")));
+         return;
+      }
+      pTransaction->setTransactionRequestSent(QDateTime::currentDateTime());
+      pTransaction->setInputTransactionSize(uiTransactionSize);
+   }
+
+   void finish(QxRequest_ptr pRequest, QxTransaction * pReply, quint32 uiReplySize, const qx_bool & bError)
+   {
+      IxService_ptr pService = pRequest->m_pService;
+      QxTransaction_ptr pTransaction = pRequest->m_pTransaction;
+      if (pReply)
+      {
+         pTransaction->setTransactionReplyReceived(QDateTime::currentDateTime());
+         pTransaction->setTransactionRequestReceived(pReply->getTransactionRequestReceived());
+         pTransaction->setTransactionReplySent(pReply->getTransactionReplySent());
+         pTransaction->setOutputParameter(pReply->getOutputParameter());
+         pTransaction->setMessageReturn(pReply->getMessageReturn());
+         pTransaction->setOutputTransactionSize(uiReplySize);
+         pService->setOutputParameter(pTransaction->getOutputParameter());
+         pService->setMessageReturn(pTransaction->getMessageReturn());
+      }
+      else
+      {
+         pTransaction->setMessageReturn(bError);
+         pService->setMessageReturn(bError);
+      }
+
+      pTransaction->setTransactionEnd(QDateTime::currentDateTime());
+      if (pRequest->m_fct) { pRequest->m_fct(pService); }
+      Q_EMIT m_pParent->finished(pService);
+   }
+
+   void closeConnection(QxConnection_ptr pConnection, const qx_bool & bError)
+   {
+      if (! pConnection->m_pSocket) { return; }
+      QTcpSocket * socket = pConnection->m_pSocket;
+      pConnection->m_pSocket = NULL;
+      pConnection->m_bReady = false;
+      m_lstConnection.removeAll(pConnection);
+      socket->disconnect(m_pParent);
+      socket->abort();
+      socket->deleteLater();
+
+      QList<QxRequest_ptr> lstInFlight = pConnection->m_lstInFlight.values();
+      pConnection->m_lstInFlight.clear();
+      pConnection->m_lstToWrite.clear();
+      pConnection->m_buffer.clear();
+      Q_FOREACH(QxRequest_ptr pRequest, lstInFlight) { finish(pRequest, NULL, 0, bError); }
+   }
+
+   void checkAllFinished()
+   {
+      if (pendingCount() > 0) { return; }
+      m_timerTimeout.stop();
+      Q_EMIT m_pParent->allFinished();
+   }
+
+};
+
+QxClientPool::QxClientPool(QObject * parent /* = nullptr */) : QObject(parent), m_pImpl(new QxClientPoolImpl(this))
+{
+   m_pImpl->m_timerTimeout.setInterval(QX_SERVICE_CLIENT_POOL_CHECK_TIMEOUT_INTERVAL);
+   QObject::connect((& m_pImpl->m_timerTimeout), SIGNAL(timeout()), this, SLOT(onCheckTimeout()));
+}
+
+QxClientPool::~QxClientPool()
+{
+   int iPending = m_pImpl->pendingCount();
+   if (iPending > 0) { qDebug("[QxOrm] qx::service::QxClientPool destroyed with %d pending request(s)", iPending); }
+   Q_FOREACH(QxClientPoolImpl::QxConnection_ptr pConnection, m_pImpl->m_lstConnection)
+   { if (pConnection->m_pSocket) { pConnection->m_pSocket->disconnect(this); pConnection->m_pSocket->abort(); } }
+}
+
+int QxClientPool::getMaxConnections() const { return m_pImpl->m_iMaxConnections; }
+
+int QxClientPool::getMaxInFlightPerConnection() const { return m_pImpl->m_iMaxInFlight; }
+
+int QxClientPool::getPendingCount() const { return m_pImpl->pendingCount(); }
+
+void QxClientPool::setMaxConnections(int i) { m_pImpl->m_iMaxConnections = i; m_pImpl->dispatch(); }
+
+void QxClientPool::setMaxInFlightPerConnection(int i) { m_pImpl->m_iMaxInFlight = i; m_pImpl->dispatch(); }
+
+quint32 QxClientPool::execute(IxService_ptr pService, const QString & sMethod, type_fct_on_finished fct /* = type_fct_on_finished() */)
+{
+   if ((! pService) || sMethod.isEmpty()) { qAssert(false); return 0; }
+   QxClientPoolImpl::QxRequest_ptr pRequest = std::make_shared<QxClientPoolImpl::QxRequest>();
+   pRequest->m_uiRequestId = (++m_pImpl->m_uiLastRequestId);
+   if (pRequest->m_uiRequestId == 0) { pRequest->m_uiRequestId = (++m_pImpl->m_uiLastRequestId); }
+   pRequest->m_pService = pService;
+   pRequest->m_pTransaction = std::make_shared<QxTransaction>();
+   pRequest->m_fct = fct;
+   pRequest->m_timer.start();
+
+   QxTransaction_ptr pTransaction = pRequest->m_pTransaction;
+   pService->setTransaction(pTransaction);
+   if (pService->getServiceName().isEmpty())
+   { m_pImpl->finish(pRequest, NULL, 0, qx_bool(QX_ERROR_SERVICE_NOT_SPECIFIED, QStringLiteral("[QxOrm] empty service name"))); return 0; }
+
+   pService->registerClass();
+   pTransaction->setTransactionId(QUuid::createUuid().toString());
+   pTransaction->setRequestId(pRequest->m_uiRequestId);
+   pTransaction->setIpTarget(QxConnect::getSingleton()->getIp());
+   pTransaction->setPortTarget(QxConnect::getSingleton()->getPort());
+   pTransaction->setServiceName(pService->getServiceName());
+   pTransaction->setServiceMethod(sMethod);
+   pTransaction->setTransactionBegin(QDateTime::currentDateTime());
+   pTransaction->setInputParameter(pService->getInputParameter_BaseClass());
+
+   m_pImpl->m_lstQueue.enqueue(pRequest);
+   m_pImpl->dispatch();
+   if (! m_pImpl->m_timerTimeout.isActive()) { m_pImpl->m_timerTimeout.start(); }
+   return pRequest->m_uiRequestId;
+}
+
+bool QxClientPool::waitForFinished(int msecs /* = -1 */)
+{
+   if (m_pImpl->pendingCount() <= 0) { return true; }
+   QEventLoop loop; QTimer timer;
+   QObject::connect(this, SIGNAL(allFinished()), (& loop), SLOT(quit()));
+   if (msecs >= 0) { timer.setSingleShot(true); QObject::connect((& timer), SIGNAL(timeout()), (& loop), SLOT(quit())); timer.start(msecs); }
+   loop.exec();
+   return (m_pImpl->pendingCount() <= 0);
+}
+
+void QxClientPool::close()
+{
+   qx_bool bError(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("[QxOrm] client pool closed before receiving reply"));
+   QList<QxClientPoolImpl::QxConnection_ptr> lstConnection = m_pImpl->m_lstConnection;
+   Q_FOREACH(QxClientPoolImpl::QxConnection_ptr pConnection, lstConnection) { m_pImpl->closeConnection(pConnection, bError); }
+   while (! m_pImpl->m_lstQueue.isEmpty()) { m_pImpl->finish(m_pImpl->m_lstQueue.dequeue(), NULL, 0, bError); }
+   m_pImpl->checkAllFinished();
+}
+
+void QxClientPool::onSocketConnected()
+{
+   QxClientPoolImpl::QxConnection_ptr pConnection = m_pImpl->findConnection(sender());
+   if (! pConnection) { return; }
+   pConnection->m_bReady = true;
+   QList<QxClientPoolImpl::QxRequest_ptr> lstToWrite = pConnection->m_lstToWrite;
+   pConnection->m_lstToWrite.clear();
+   Q_FOREACH(QxClientPoolImpl::QxRequest_ptr pRequest, lstToWrite) { if (pConnection->m_pSocket) { m_pImpl->send(pConnection, pRequest); } }
+   m_pImpl->checkAllFinished();
+}
+
+void QxClientPool::onSocketReadyRead()
+{
+   QxClientPoolImpl::QxConnection_ptr pConnection = m_pImpl->findConnection(sender());
+   if (! pConnection) { return; }
+
+   // Bytes available are read directly at the end of the connection buffer
+   QTcpSocket * socket = pConnection->m_pSocket;
+   qint64 iAvailable = socket->bytesAvailable();
+   if (iAvailable > 0)
+   {
+      int iOldSize = pConnection->m_buffer.size();
+      pConnection->m_buffer.resize(iOldSize + static_cast<int>(iAvailable));
+      qint64 iRead = socket->read((pConnection->m_buffer.data() + iOldSize), iAvailable);
+      pConnection->m_buffer.resize(iOldSize + static_cast<int>(qMax(iRead, static_cast<qint64>(0))));
+   }
+
+   // Each complete reply is deserialized in place and matched to its request using request id
+   qint64 iPos = 0;
+   while (pConnection->m_pSocket)
+   {
+      QxTools::header h;
+      qint64 iFrameSize = QxTools::checkFrame((pConnection->m_buffer.constData() + iPos), (pConnection->m_buffer.size() - iPos), h);
+      if (iFrameSize <= 0) { break; }
+      QxTools::setPeerCodecMask((* socket), h.uiCompressData);
+
+      QxTransaction reply; quint32 uiReplySize = 0;
+      qx_bool bReadOk = QxTools::readSocketData(h, (pConnection->m_buffer.data() + iPos + h.getHeaderSize()), reply, uiReplySize, (& pConnection->m_uncompressed));
+      iPos += iFrameSize;
+
+      QxClientPoolImpl::QxRequest_ptr pRequest = pConnection->m_lstInFlight.take(h.uiRequestId);
+      if (! pRequest) { qDebug("[QxOrm] qx::service::QxClientPool : reply received with an unknown request id (%u)", static_cast<uint>(h.uiRequestId)); continue; }
+      if (bReadOk) { m_pImpl->finish(pRequest, (& reply), uiReplySize, qx_bool(true)); }
+      else { m_pImpl->finish(pRequest, NULL, 0, qx_bool(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("[QxOrm] unable to read return : '") + bReadOk.getDesc() + QStringLiteral("'"))); }
+   }
+
+   if (pConnection->m_pSocket && (iPos > 0)) { pConnection->m_buffer.remove(0, static_cast<int>(iPos)); }
+   m_pImpl->dispatch();
+   m_pImpl->checkAllFinished();
+}
+
+void QxClientPool::onSocketDisconnected()
+{
+   QxClientPoolImpl::QxConnection_ptr pConnection = m_pImpl->findConnection(sender());
+   if (! pConnection) { return; }
+   m_pImpl->closeConnection(pConnection, qx_bool(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("[QxOrm] connection closed by server before receiving reply")));
+   m_pImpl->dispatch();
+   m_pImpl->checkAllFinished();
+}
+
+void QxClientPool::onSocketError(QAbstractSocket::SocketError socketError)
+{
+   Q_UNUSED(socketError);
+   QxClientPoolImpl::QxConnection_ptr pConnection = m_pImpl->findConnection(sender());
+   if (! pConnection || ! pConnection->m_pSocket) { return; }
+   QString sError = pConnection->m_pSocket->errorString();
+   if (pConnection->m_bReady) { m_pImpl->closeConnection(pConnection, qx_bool(QX_ERROR_SERVICE_READ_ERROR, "[QxOrm] socket error : " + sError)); }
+   else { m_pImpl->closeConnection(pConnection, qx_bool(QX_ERROR_SERVER_NOT_FOUND, "[QxOrm] unable to connect to server : " + sError)); }
+   m_pImpl->dispatch();
+   m_pImpl->checkAllFinished();
+}
+
+void QxClientPool::onCheckTimeout()
+{
+   // Replies on a connection are expected in order : if a request has timed out, the whole connection is closed
+   long lMaxWait = QxConnect::getSingleton()->getMaxWait();
+   if (lMaxWait < 0) { return; }
+   QList<QxClientPoolImpl::QxConnection_ptr> lstConnection = m_pImpl->m_lstConnection;
+   Q_FOREACH(QxClientPoolImpl::QxConnection_ptr pConnection, lstConnection)
+   {
+      bool bTimeout = false;
+      Q_FOREACH(QxClientPoolImpl::QxRequest_ptr pRequest, pConnection->m_lstInFlight)
+      { if (pRequest->m_timer.elapsed() > static_cast<qint64>(lMaxWait)) { bTimeout = true; break; } }
+      if (bTimeout) { m_pImpl->closeConnection(pConnection, qx_bool(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("[QxOrm] timeout waiting for reply"))); }
+   }
+   m_pImpl->dispatch();
+   m_pImpl->checkAllFinished();
+}
+
+} // namespace service
+} // namespace qx
+
+#endif // _QX_ENABLE_QT_NETWORK
@@ -0,0 +1,273 @@
+/****************************************************************************
+**
+** https://www.qxorm.com/
+** Copyright (C) 2013 Lionel Marty (contact@qxorm.com)
+**
+** This file is part of the QxOrm library
+**
+** This software is provided 'as-is', without any express or implied
+** warranty. In no event will the authors be held liable for any
+** damages arising from the use of this software
+**
+** Commercial Usage
+** Licensees holding valid commercial QxOrm licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and Lionel Marty
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3.0 as published by the Free Software
+** Foundation and appearing in the file 'license.gpl3.txt' included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU General Public License version 3.0 requirements will be
+** met : http://www.gnu.org/copyleft/gpl.html
+**
+** If you are unsure which license is appropriate for your use, or
+** if you have questions regarding the use of this file, please contact :
+** contact@qxorm.com
+**
+****************************************************************************/
+
+#ifdef _QX_ENABLE_QT_NETWORK
+
+#include <QxPrecompiled.h>
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <QxService/QxCompression.h>
+
+#ifdef _QX_ENABLE_LZ4
+#include <lz4.h>
+#endif // _QX_ENABLE_LZ4
+
+#include <QxMemLeak/mem_leak.h>
+
+#define QX_SERVICE_COMPRESSION_MAX_CODEC_ID 8
+
+#define QX_LZ4_MIN_MATCH 4
+#define QX_LZ4_LAST_LITERALS 5
+#define QX_LZ4_MF_LIMIT 12
+#define QX_LZ4_MAX_OFFSET 65535
+#define QX_LZ4_HASH_LOG 12
+
+QX_DLL_EXPORT_QX_SINGLETON_CPP(qx::service::QxCompression)
+
+namespace qx {
+namespace service {
+namespace detail {
+
+/*!
+ * \brief zlib codec : same format as qCompress() / qUncompress() functions, so compatible with all versions of QxService module
+ */
+class QxCompressionCodec_Zlib : public IxCompressionCodec
+{
+
+public:
+
+   virtual quint8 getId() const { return QX_SERVICE_COMPRESSION_ZLIB; }
+   virtual QString getName() const { return QStringLiteral("zlib"); }
+
+   virtual bool compress(const QByteArray & data, QByteArray & compressed, int iLevel) const
+   { compressed = qCompress(data, ((iLevel < -1) ? -1 : ((iLevel > 9) ? 9 : iLevel))); return (! compressed.isEmpty()); }
+
+   virtual bool uncompress(const QByteArray & data, QByteArray & uncompressed) const
+   { uncompressed = qUncompress(data); return (! uncompressed.isEmpty()); }
+
+};
+
+/*!
+ * \brief LZ4 codec (block format) : much faster than zlib with a lower compression ratio (useful on LAN networks)
+ *
+ * Compressed data = 4 bytes (big-endian) to store uncompressed size + LZ4 block.
+ * If _QX_ENABLE_LZ4 compilation option is defined, liblz4 is used, otherwise a built-in implementation of the same block format is used (both are compatible).
+ * Compression level is used as LZ4 acceleration factor (greater value means faster compression and lower ratio).
+ */
+class QxCompressionCodec_LZ4 : public IxCompressionCodec
+{
+
+public:
+
+   virtual quint8 getId() const { return QX_SERVICE_COMPRESSION_LZ4; }
+   virtual QString getName() const { return QStringLiteral("lz4"); }
+
+   virtual bool compress(const QByteArray & data, QByteArray & compressed, int iLevel) const
+   {
+      int iSrcSize = data.size();
+      int iAcceleration = ((iLevel <= 0) ? 1 : iLevel);
+      compressed.resize(4 + iSrcSize + (iSrcSize / 255) + 16);
+      uchar * dst = reinterpret_cast<uchar *>(compressed.data());
+      dst[0] = static_cast<uchar>((iSrcSize >> 24) & 0xFF); dst[1] = static_cast<uchar>((iSrcSize >> 16) & 0xFF);
+      dst[2] = static_cast<uchar>((iSrcSize >> 8) & 0xFF); dst[3] = static_cast<uchar>(iSrcSize & 0xFF);
+#ifdef _QX_ENABLE_LZ4
+      int iSize = LZ4_compress_fast(data.constData(), reinterpret_cast<char *>(dst + 4), iSrcSize, (compressed.size() - 4), iAcceleration);
+      if (iSize <= 0) { compressed.clear(); return false; }
+#else // _QX_ENABLE_LZ4
+      int iSize = compressBlock(reinterpret_cast<const uchar *>(data.constData()), iSrcSize, (dst + 4), iAcceleration);
+#endif // _QX_ENABLE_LZ4
+      compressed.resize(4 + iSize);
+      return true;
+   }
+
+   virtual bool uncompress(const QByteArray & data, QByteArray & uncompressed) const
+   {
+      uncompressed.resize(0); // keep reserved capacity (buffer reused by QxService module)
+      if (data.size() < 5) { return false; }
+      const uchar * src = reinterpret_cast<const uchar *>(data.constData());
+      quint32 uiDstSize = ((static_cast<quint32>(src[0]) << 24) | (static_cast<quint32>(src[1]) << 16) | (static_cast<quint32>(src[2]) << 8) | static_cast<quint32>(src[3]));
+      if ((uiDstSize == 0) || (uiDstSize > static_cast<quint32>(std::numeric_limits<int>::max() - 1)) || (static_cast<quint64>(uiDstSize) > (static_cast<quint64>(data.size() - 4) * 255))) { return false; }
+      uncompressed.resize(static_cast<int>(uiDstSize));
+#ifdef _QX_ENABLE_LZ4
+      int iSize = LZ4_decompress_safe(reinterpret_cast<const char *>(src + 4), uncompressed.data(), (data.size() - 4), static_cast<int>(uiDstSize));
+      bool bOk = (iSize == static_cast<int>(uiDstSize));
+#else // _QX_ENABLE_LZ4
+      bool bOk = uncompressBlock((src + 4), (data.size() - 4), reinterpret_cast<uchar *>(uncompressed.data()), static_cast<int>(uiDstSize));
+#endif // _QX_ENABLE_LZ4
+      if (! bOk) { uncompressed.clear(); }
+      return bOk;
+   }
+
+private:
+
+   static inline quint32 read32(const uchar * p) { quint32 v; memcpy((& v), p, sizeof(quint32)); return v; }
+   static inline quint32 hash(quint32 v) { return ((v * 2654435761U) >> (32 - QX_LZ4_HASH_LOG)); }
+   static inline uchar * writeLength(uchar * op, int iLen) { while (iLen >= 255) { (* op++) = 255; iLen -= 255; } (* op++) = static_cast<uchar>(iLen); return op; }
+
+   static int compressBlock(const uchar * src, int iSrcSize, uchar * dst, int iAcceleration)
+   {
+      uchar * op = dst; int anchor = 0;
+      if (iSrcSize >= (QX_LZ4_MF_LIMIT + 1))
+      {
+         std::vector<int> table((1 << QX_LZ4_HASH_LOG), -1);
+         const int iMatchLimit = (iSrcSize - QX_LZ4_LAST_LITERALS);
+         const int iMfLimit = (iSrcSize - QX_LZ4_MF_LIMIT);
+         const int iSkipShift = (6 - ((iAcceleration > 5) ? 5 : iAcceleration));
+         int ip = 0;
+         while (ip < iMfLimit)
+         {
+            quint32 v = read32(src + ip); quint32 h = hash(v);
+            int ref = table[h]; table[h] = ip;
+            if ((ref < 0) || ((ip - ref) > QX_LZ4_MAX_OFFSET) || (read32(src + ref) != v))
+            { ip += (1 + ((ip - anchor) >> iSkipShift)); continue; }
+
+            int iMatchLen = QX_LZ4_MIN_MATCH;
+            while (((ip + iMatchLen) < iMatchLimit) && (src[ref + iMatchLen] == src[ip + iMatchLen])) { ++iMatchLen; }
+
+            int iLitLen = (ip - anchor); int iMatchCode = (iMatchLen - QX_LZ4_MIN_MATCH); int iOffset = (ip - ref);
+            uchar * token = op++;
+            (* token) = static_cast<uchar>(((iLitLen >= 15) ? 15 : iLitLen) << 4);
+            if (iLitLen >= 15) { op = writeLength(op, (iLitLen - 15)); }
+            memcpy(op, (src + anchor), iLitLen); op += iLitLen;
+            (* op++) = static_cast<uchar>(iOffset & 0xFF); (* op++) = static_cast<uchar>((iOffset >> 8) & 0xFF);
+            (* token) |= static_cast<uchar>((iMatchCode >= 15) ? 15 : iMatchCode);
+            if (iMatchCode >= 15) { op = writeLength(op, (iMatchCode - 15)); }
+
+            ip += iMatchLen; anchor = ip;
+            if (ip < iMfLimit) { table[hash(read32(src + ip - 2))] = (ip - 2); }
+         }
+      }
+
+      int iLastLit = (iSrcSize - anchor);
+      (* op++) = static_cast<uchar>(((iLastLit >= 15) ? 15 : iLastLit) << 4);
+      if (iLastLit >= 15) { op = writeLength(op, (iLastLit - 15)); }
+      memcpy(op, (src + anchor), iLastLit); op += iLastLit;
+      return static_cast<int>(op - dst);
+   }
+
+   static bool uncompressBlock(const uchar * src, int iSrcSize, uchar * dst, int iDstSize)
+   {
+      int ip = 0; int op = 0;
+      while (ip < iSrcSize)
+      {
+         int token = src[ip++];
+         int iLitLen = (token >> 4);
+         if (iLitLen == 15) { int s = 255; while ((s == 255) && (ip < iSrcSize)) { s = src[ip++]; iLitLen += s; } if (s == 255) { return false; } }
+         if (((iSrcSize - ip) < iLitLen) || ((iDstSize - op) < iLitLen)) { return false; }
+         memcpy((dst + op), (src + ip), iLitLen); ip += iLitLen; op += iLitLen;
+         if (ip >= iSrcSize) { break; }
+
+         if ((iSrcSize - ip) < 2) { return false; }
+         int iOffset = (src[ip] | (src[ip + 1] << 8)); ip += 2;
+         if ((iOffset == 0) || (iOffset > op)) { return false; }
+         int iMatchLen = (token & 15);
+         if (iMatchLen == 15) { int s = 255; while ((s == 255) && (ip < iSrcSize)) { s = src[ip++]; iMatchLen += s; } if (s == 255) { return false; } }
+         iMatchLen += QX_LZ4_MIN_MATCH;
+         if ((iDstSize - op) < iMatchLen) { return false; }
+
+         const uchar * ref = (dst + op - iOffset); uchar * out = (dst + op);
+         if (iOffset >= iMatchLen) { memcpy(out, ref, iMatchLen); }
+         else { for (int i = 0; i < iMatchLen; ++i) { out[i] = ref[i]; } }
+         op += iMatchLen;
+      }
+      return (op == iDstSize);
+   }
+
+};
+
+} // namespace detail
+
+struct QxCompression::QxCompressionImpl
+{
+
+   QMutex m_mutex;                                                                        //!< Mutex => only to register new codecs
+   QList<IxCompressionCodec_ptr> m_lstCodec;                                              //!< List of all codecs registered (ownership)
+   QAtomicPointer<IxCompressionCodec> m_arrCodec[QX_SERVICE_COMPRESSION_MAX_CODEC_ID + 1]; //!< Codecs by id => read without any lock
+   QAtomicInt m_iCodecMask;                                                               //!< Bit (id - 1) is set if codec id is registered
+
+   QxCompressionImpl() : m_iCodecMask(0) { ; }
+   ~QxCompressionImpl() { ; }
+
+};
+
+QxCompression::QxCompression() : qx::QxSingleton<QxCompression>(QStringLiteral("qx::service::QxCompression")), m_pImpl(new QxCompressionImpl())
+{
+   registerCodec(std::make_shared<qx::service::detail::QxCompressionCodec_Zlib>());
+   registerCodec(std::make_shared<qx::service::detail::QxCompressionCodec_LZ4>());
+}
+
+QxCompression::~QxCompression() { ; }
+
+void QxCompression::registerCodec(const IxCompressionCodec_ptr & pCodec)
+{
+   if (! pCodec) { qAssert(false); return; }
+   quint8 uiCodecId = pCodec->getId();
+   if ((uiCodecId == QX_SERVICE_COMPRESSION_NONE) || (uiCodecId > QX_SERVICE_COMPRESSION_MAX_CODEC_ID))
+   { qDebug("[QxOrm] qx::service::QxCompression::registerCodec() : invalid codec id '%d' for codec '%s' (must be from 1 to %d)", static_cast<int>(uiCodecId), qPrintable(pCodec->getName()), QX_SERVICE_COMPRESSION_MAX_CODEC_ID); qAssert(false); return; }
+
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_lstCodec.append(pCodec);
+   m_pImpl->m_arrCodec[uiCodecId].storeRelease(pCodec.get());
+   m_pImpl->m_iCodecMask.fetchAndOrOrdered(1 << (uiCodecId - 1));
+}
+
+IxCompressionCodec * QxCompression::getCodec(quint8 uiCodecId) const
+{
+   if ((uiCodecId == QX_SERVICE_COMPRESSION_NONE) || (uiCodecId > QX_SERVICE_COMPRESSION_MAX_CODEC_ID)) { return NULL; }
+   return m_pImpl->m_arrCodec[uiCodecId].loadAcquire();
+}
+
+quint8 QxCompression::getCodecMask() const
+{
+   return static_cast<quint8>(m_pImpl->m_iCodecMask.loadAcquire() & 0xFF);
+}
+
+bool QxCompression::compress(quint8 uiCodecId, const QByteArray & data, QByteArray & compressed, int iLevel /* = -1 */) const
+{
+   IxCompressionCodec * pCodec = getCodec(uiCodecId);
+   if (! pCodec) { compressed.clear(); return false; }
+   return pCodec->compress(data, compressed, iLevel);
+}
+
+bool QxCompression::uncompress(quint8 uiCodecId, const QByteArray & data, QByteArray & uncompressed) const
+{
+   IxCompressionCodec * pCodec = getCodec(uiCodecId);
+   if (! pCodec) { uncompressed.clear(); return false; }
+   return pCodec->uncompress(data, uncompressed);
+}
+
+} // namespace service
+} // namespace qx
+
+#endif // _QX_ENABLE_QT_NETWORK
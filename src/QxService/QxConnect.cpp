@@ -34,6 +34,7 @@
 #include <QxPrecompiled.h>
 
 #include <QxService/QxConnect.h>
+#include <QxService/QxCompression.h>
 
 #include <QxMemLeak/mem_leak.h>
 
@@ -60,6 +61,7 @@
 #endif // QX_SERVICE_DEFAULT_SERIALIZATION_TYPE
 
 #define QX_SERVICE_DEFAULT_ENCRYPT_KEY Q_UINT64_C(0x0f2aac3b24358a1a)
+#define QX_SERVICE_DEFAULT_MIN_SIZE_TO_COMPRESS_DATA 2000
 
 #ifndef QT_NO_SSL
 #define QX_CONSTRUCT_QX_SERVICE_CONNECT_SSL() \
@@ -93,6 +95,7 @@ struct QxConnect::QxConnectImpl
    long                             m_lKeepAlive;              //!< Keep socket opened during X milliseconds (-1 means never disconnect)
    bool                             m_bModeHTTP;               //!< Put QxService module in mode HTTP (see QxHttpServer module)
    qlonglong                        m_lSessionTimeOut;         //!< HTTP session time-out (expiration) in milliseconds
+   QMap<long, QPair<quint8, int> >  m_lstCompressionCodec;     //!< Compression codec (and level) to use by min data size (in bytes)
 
 #ifndef QT_NO_SSL
    bool                             m_sslEnabled;              //!< Is secure connection enabled
@@ -107,9 +110,16 @@ struct QxConnect::QxConnectImpl
    int                              m_sslPeerVerifyDepth;      //!< Peer depth level for certificate validation
 #endif // QT_NO_SSL
 
-   QxConnectImpl() : QX_CONSTRUCT_QX_SERVICE_CONNECT() { m_uiEncryptKey = QX_SERVICE_DEFAULT_ENCRYPT_KEY; ignoreAllSSLErrors(); }
+   QxConnectImpl() : QX_CONSTRUCT_QX_SERVICE_CONNECT() { m_uiEncryptKey = QX_SERVICE_DEFAULT_ENCRYPT_KEY; initCompressionCodec(); ignoreAllSSLErrors(); }
    ~QxConnectImpl() { ; }
 
+   void initCompressionCodec()
+   {
+      m_lstCompressionCodec.clear();
+      m_lstCompressionCodec.insert(0, qMakePair(static_cast<quint8>(QX_SERVICE_COMPRESSION_NONE), -1));
+      m_lstCompressionCodec.insert(QX_SERVICE_DEFAULT_MIN_SIZE_TO_COMPRESS_DATA + 1, qMakePair(static_cast<quint8>(QX_SERVICE_COMPRESSION_ZLIB), -1));
+   }
+
    void ignoreAllSSLErrors()
    {
 #ifndef QT_NO_SSL
@@ -189,6 +199,26 @@ bool QxConnect::getCompressData()
    return m_pImpl->m_bCompressData;
 }
 
+quint8 QxConnect::getCompressionCodec(long lDataSize, int & iLevel)
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   iLevel = -1;
+   QMap<long, QPair<quint8, int> >::const_iterator itr = m_pImpl->m_lstCompressionCodec.upperBound(lDataSize);
+   if (itr == m_pImpl->m_lstCompressionCodec.constBegin()) { return QX_SERVICE_COMPRESSION_NONE; }
+   --itr; iLevel = itr.value().second;
+   return itr.value().first;
+}
+
+quint8 QxConnect::getCompressionCodecMask()
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   quint8 uiMask = 0;
+   QMap<long, QPair<quint8, int> >::const_iterator itr = m_pImpl->m_lstCompressionCodec.constBegin();
+   for (; itr != m_pImpl->m_lstCompressionCodec.constEnd(); ++itr)
+   { quint8 uiCodecId = itr.value().first; if ((uiCodecId > QX_SERVICE_COMPRESSION_NONE) && (uiCodecId <= 8)) { uiMask |= static_cast<quint8>(1 << (uiCodecId - 1)); } }
+   return uiMask;
+}
+
 bool QxConnect::getEncryptData()
 {
    QMutexLocker locker(& m_pImpl->m_mutex);
@@ -321,6 +351,19 @@ void QxConnect::setCompressData(bool b)
    m_pImpl->m_bCompressData = b;
 }
 
+void QxConnect::setCompressionCodec(quint8 uiCodecId, long lMinDataSize /* = 0 */, int iLevel /* = -1 */)
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   if (lMinDataSize < 0) { lMinDataSize = 0; }
+   m_pImpl->m_lstCompressionCodec.insert(lMinDataSize, qMakePair(uiCodecId, iLevel));
+}
+
+void QxConnect::clearCompressionCodec()
+{
+   QMutexLocker locker(& m_pImpl->m_mutex);
+   m_pImpl->m_lstCompressionCodec.clear();
+}
+
 void QxConnect::setEncryptData(bool b, quint64 key /* = 0 */)
 {
    QMutexLocker locker(& m_pImpl->m_mutex);
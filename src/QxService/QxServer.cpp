@@ -54,7 +54,7 @@ void QxServer::incomingConnection(int socketDescriptor)
    QxThread * pThread = getAvailable();
    if (m_pThreadPool && m_pThreadPool->isStopped()) { return; }
    if (!pThread) {
-       if (m_pThreadPool) { m_pThreadPool->raiseError(QStringLiteral("[QxOrm] no service available : cannot accept incoming connection (increase thread count value)"), QxTransaction_ptr());
+       if (m_pThreadPool) { m_pThreadPool->addRejectedCount(); m_pThreadPool->raiseError(QStringLiteral("[QxOrm] no service available : cannot accept incoming connection (increase thread count value)"), QxTransaction_ptr());
        }
        return;
    }
@@ -71,13 +71,15 @@ QxThread * QxServer::getAvailable() const
 
    int iCurrRetryCount = 0;
    int iMaxRetryCount = QxConnect::getSingleton()->getMaxWait();
+   m_pThreadPool->addWaitingCount(1);
    while ((! pThread) && (iCurrRetryCount < iMaxRetryCount))
    {
-      if (m_pThreadPool->isStopped()) { return NULL; }
+      if (m_pThreadPool->isStopped()) { break; }
       qx::service::QxThreadPool::sleepThread(1);
       pThread = m_pThreadPool->getAvailable();
       iCurrRetryCount++;
    }
+   m_pThreadPool->addWaitingCount(-1);
 
    return pThread;
 }
@@ -44,6 +44,7 @@
 
 #include <QxCommon/QxException.h>
 #include <QxCommon/QxExceptionCode.h>
+#include <QxCommon/QxTrace.h>
 
 #include <QxMemLeak/mem_leak.h>
 
@@ -144,7 +145,10 @@ void QxThread::onIncomingConnection()
 bool QxThread::checkKeepAlive(QTcpSocket & socket)
 {
    if (m_pTransaction && (m_pTransaction->getForceConnectionStatus() == qx::service::QxTransaction::conn_close)) { return false; }
+   bool bPipelined = (m_pTransaction && (m_pTransaction->getRequestId() != 0));
+   if (bPipelined && (QxTools::hasPendingData(socket) || (socket.bytesAvailable() > 0))) { return true; }
    long lKeepAlive = QxConnect::getSingleton()->getKeepAlive();
+   if ((lKeepAlive == 0) && bPipelined) { lKeepAlive = QxConnect::getSingleton()->getMaxWait(); } // A pipelined client (qx::service::QxClientPool) keeps its connection open
    if (lKeepAlive == 0) { return false; }
 
    long lCurrRetry = 0;
@@ -222,7 +226,18 @@ void QxThread::doProcess(QTcpSocket & socket)
        return;
    }
    if (hasBeenStopped() || m_bIsDisconnected) { return; }
-   socket.readAll();
+   if (m_pTransaction->getRequestId() == 0) { socket.readAll(); } // Pipelined requests (with a request id) are not discarded, they are processed by next calls
+
+   // Tracing span of the transaction (see qx::QxTrace class) : an HTTP request continues the trace of its caller if a W3C 'traceparent' header is provided
+   std::unique_ptr<qx::QxTraceSpan> pTraceSpan;
+   qx::QxHttpTransaction * pHttpTransaction = (bModeHTTP ? static_cast<qx::QxHttpTransaction *>(m_pTransaction.get()) : NULL);
+   if (pHttpTransaction && pHttpTransaction->request().command().isEmpty()) { pHttpTransaction = NULL; }
+   if (qx::QxTrace::isEnabled())
+   {
+      QString sName = (pHttpTransaction ? (pHttpTransaction->request().command() + QStringLiteral(" ") + pHttpTransaction->request().url().path()) : (m_pTransaction->getServiceName() + QStringLiteral("::") + m_pTransaction->getServiceMethod()));
+      qx::QxTrace::type_context parent = (pHttpTransaction ? qx::QxTrace::type_context::fromTraceParent(pHttpTransaction->request().header("traceparent")) : qx::QxTrace::type_context());
+      pTraceSpan.reset(new qx::QxTraceSpan(sName, "transaction", parent));
+   }
 
    Q_EMIT transactionStarted(m_pTransaction);
    try { m_pTransaction->executeServer(); }
@@ -240,6 +255,13 @@ void QxThread::doProcess(QTcpSocket & socket)
    long lCurrRetry = 0;
    while ((socket.bytesToWrite() > 0) && ((lMaxWait == -1) || (lCurrRetry < lMaxWait)) && (! hasBeenStopped()) && (! m_bIsDisconnected))
    { socket.waitForBytesWritten(1); QCoreApplication::processEvents(); lCurrRetry++; }
+
+   if (pTraceSpan && pTraceSpan->isRecording())
+   {
+      if (pHttpTransaction) { pTraceSpan->setAttribute(QStringLiteral("http.status_code"), pHttpTransaction->response().status()); }
+      pTraceSpan->setError(! m_pTransaction->getMessageReturn());
+   }
+   pTraceSpan.reset();
    Q_EMIT transactionFinished(m_pTransaction);
 }
 
@@ -53,6 +53,7 @@ QxThread * QxThreadPool::getAvailable()
    if (m_bIsStopped) { return NULL; }
    QMutexLocker locker(& m_mutex);
    QxThread * p = (m_lstAvailable.isEmpty() ? NULL : m_lstAvailable.dequeue());
+   m_iAvailableCount.storeRelease(m_lstAvailable.count());
    if (p) { qAssert(p->isAvailable()); }
    return ((p && p->isAvailable()) ? p : NULL);
 }
@@ -65,8 +66,21 @@ void QxThreadPool::setAvailable(QxThread * p)
    for (long l = 0; l < m_lstAvailable.count(); l++)
    { if (m_lstAvailable.at(l) == p) { qAssert(false); return; } }
    m_lstAvailable.enqueue(p);
+   m_iAvailableCount.storeRelease(m_lstAvailable.count());
 }
 
+int QxThreadPool::getThreadCount() const { return m_iThreadCount.loadAcquire(); }
+
+int QxThreadPool::getAvailableCount() const { return m_iAvailableCount.loadAcquire(); }
+
+int QxThreadPool::getWaitingCount() const { return m_iWaitingCount.loadAcquire(); }
+
+int QxThreadPool::getRejectedCount() const { return m_iRejectedCount.loadAcquire(); }
+
+void QxThreadPool::addWaitingCount(int i) { m_iWaitingCount.fetchAndAddOrdered(i); }
+
+void QxThreadPool::addRejectedCount() { m_iRejectedCount.fetchAndAddOrdered(1); }
+
 void QxThreadPool::raiseError(const QString & err, QxTransaction_ptr transaction)
 {
    qAssert(! err.isEmpty());
@@ -122,6 +136,8 @@ void QxThreadPool::initServices()
       pWorker->init();
       pThread->start();
    }
+   m_iThreadCount.storeRelease(m_lstAllServices.count());
+   m_iAvailableCount.storeRelease(m_lstAvailable.count());
 }
 
 void QxThreadPool::clearServices()
@@ -132,6 +148,8 @@ void QxThreadPool::clearServices()
    for (long l = 0; l < m_lstAllServices.count(); l++) { delete m_lstAllServices.at(l); }
    m_lstAllServices.clear();
    m_lstAvailable.clear();
+   m_iThreadCount.storeRelease(0);
+   m_iAvailableCount.storeRelease(0);
 }
 
 } // namespace service
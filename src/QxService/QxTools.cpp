@@ -35,6 +35,7 @@
 
 #include <QxService/QxTools.h>
 #include <QxService/QxConnect.h>
+#include <QxService/QxCompression.h>
 
 #include <QxCommon/QxSimpleCrypt.h>
 #include <QxCommon/QxExceptionCode.h>
@@ -43,69 +44,144 @@
 #include <QxSerialize/QxSerializeQJson.h>
 #include <QxSerialize/QJson/QxSerializeQJson_QxTransaction.h>
 
+#include <QtCore/qendian.h>
+
+#include <cstring>
+#include <limits>
+
 #include <QxMemLeak/mem_leak.h>
 
-#define QX_SERVICE_TOOLS_HEADER_SIZE (sizeof(quint32) + sizeof(quint16) + sizeof(quint16) + sizeof(quint16)) // (serialized data size) + (serialization type) + (compress data) + (encrypt data)
-#define QX_SERVICE_MIN_SIZE_TO_COMPRESS_DATA 2000
+#define QX_SERVICE_PEER_CODEC_MASK_PROPERTY "qx_service_peer_codec_mask"
+#define QX_SERVICE_SOCKET_BUFFER_NAME "qx_service_socket_buffer"
+#define QX_SERVICE_MAX_REUSABLE_BUFFER_SIZE (16 * 1024 * 1024)
 
 namespace qx {
 namespace service {
 
-qx_bool QxTools::readSocket(QTcpSocket & socket, QxTransaction & transaction, quint32 & size)
+namespace detail {
+
+/*!
+ * \internal Buffers attached to a socket (child object) and reused by all transactions read on this connection
+ */
+class QxSocketBuffer : public QObject
+{
+
+public:
+
+   QByteArray m_data;            //!< Transaction serialized data (maybe encrypted and/or compressed)
+   QByteArray m_uncompressed;    //!< Transaction serialized data uncompressed
+   QByteArray m_pending;         //!< Bytes already read from socket which belong to next transactions (pipelined transactions)
+
+   QxSocketBuffer(QObject * parent) : QObject(parent) { setObjectName(QX_SERVICE_SOCKET_BUFFER_NAME); }
+   virtual ~QxSocketBuffer() { ; }
+
+   static QxSocketBuffer * find(QTcpSocket & socket)
+   { return dynamic_cast<QxSocketBuffer *>(socket.findChild<QObject *>(QX_SERVICE_SOCKET_BUFFER_NAME, Qt::FindDirectChildrenOnly)); }
+
+   static QxSocketBuffer * get(QTcpSocket & socket)
+   { QxSocketBuffer * pBuffer = find(socket); return (pBuffer ? pBuffer : new QxSocketBuffer(& socket)); }
+
+   void release()
+   {
+      // Big buffers are not kept in memory, other buffers are reused by next transactions (capacity reserved)
+      if (m_data.capacity() > QX_SERVICE_MAX_REUSABLE_BUFFER_SIZE) { m_data = QByteArray(); }
+      if (m_uncompressed.capacity() > QX_SERVICE_MAX_REUSABLE_BUFFER_SIZE) { m_uncompressed = QByteArray(); }
+      else { m_uncompressed.reserve(m_uncompressed.capacity()); }
+   }
+
+};
+
+static qx_bool readBytes(QTcpSocket & socket, const QByteArray & input, qint64 & iInputPos, char * pDest, qint64 iSize, const char * sWhat)
+{
+   // Bytes already read from socket are consumed first
+   qint64 iRead = qMin((static_cast<qint64>(input.size()) - iInputPos), iSize);
+   if (iRead > 0) { ::memcpy(pDest, (input.constData() + iInputPos), static_cast<size_t>(iRead)); iInputPos += iRead; }
+   else { iRead = 0; }
+
+   while (iRead < iSize)
+   {
+      if ((socket.bytesAvailable() <= 0) && (! socket.waitForReadyRead(QxConnect::getSingleton()->getMaxWait()))) { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, QString("invalid bytes count available to retrieve transaction ") + sWhat + " (" + socket.errorString() + ")"); }
+      qint64 iCurrRead = socket.read((pDest + iRead), (iSize - iRead));
+      if (iCurrRead < 0) { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, QString("unable to read transaction ") + sWhat + " from socket (" + socket.errorString() + ")"); }
+      iRead += iCurrRead;
+   }
+   return qx_bool(true);
+}
+
+} // namespace detail
+
+qx_bool QxTools::readSocket(QTcpSocket & socket, QxTransaction & transaction, quint32 & size, const QByteArray & alreadyRead)
+{
+   // Some bytes may have already been read from socket by caller (for example to detect HTTP protocol) or by a previous pipelined transaction
+   detail::QxSocketBuffer * pBuffer = detail::QxSocketBuffer::get(socket);
+   QByteArray input = alreadyRead;
+   if (! pBuffer->m_pending.isEmpty()) { input.prepend(pBuffer->m_pending); pBuffer->m_pending.clear(); }
+   qint64 iInputPos = 0;
+
+   char pHeader[QX_SERVICE_TOOLS_HEADER_MAX_SIZE];
+   qx_bool bReadOk = detail::readBytes(socket, input, iInputPos, pHeader, static_cast<qint64>(QX_SERVICE_TOOLS_HEADER_SIZE), "header"); if (! bReadOk) { return bReadOk; }
+   QxTools::header h = QxTools::parseHeader(pHeader);
+   if (h.hasRequestId())
+   {
+      bReadOk = detail::readBytes(socket, input, iInputPos, (pHeader + QX_SERVICE_TOOLS_HEADER_SIZE), static_cast<qint64>(sizeof(quint32)), "request id"); if (! bReadOk) { return bReadOk; }
+      h.uiRequestId = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(pHeader + QX_SERVICE_TOOLS_HEADER_SIZE));
+   }
+   QxTools::setPeerCodecMask(socket, h.uiCompressData);
+   if (h.uiSerializedSize > static_cast<quint32>(std::numeric_limits<int>::max() - 1)) { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, "invalid transaction serialized data size (" + QString::number(h.uiSerializedSize) + " bytes)"); }
+
+   // Serialized data are read directly (and incrementally) into the buffer attached to the socket
+   const qint64 iDataSize = static_cast<qint64>(h.uiSerializedSize);
+   pBuffer->m_data.reserve(static_cast<int>(iDataSize));
+   pBuffer->m_data.resize(static_cast<int>(iDataSize));
+   char * pData = pBuffer->m_data.data();
+   bReadOk = detail::readBytes(socket, input, iInputPos, pData, iDataSize, "serialized data");
+   if (! bReadOk) { pBuffer->release(); return bReadOk; }
+
+   // Bytes which belong to next transactions are kept for next call
+   if (iInputPos < static_cast<qint64>(input.size())) { pBuffer->m_pending = input.mid(static_cast<int>(iInputPos)); }
+
+   bReadOk = QxTools::readSocketData(h, pData, transaction, size, (& pBuffer->m_uncompressed));
+   pBuffer->release();
+   return bReadOk;
+}
+
+qx_bool QxTools::readSocketData(QByteArray dataSerialized, QDataStream & in, QxTransaction & transaction, quint32 & size)
 {
-   while (socket.bytesAvailable() < (qint64)(QX_SERVICE_TOOLS_HEADER_SIZE))
-   { if (! socket.waitForReadyRead(QxConnect::getSingleton()->getMaxWait())) { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, "invalid bytes count available to retrieve transaction header (" + socket.errorString() + ")"); } }
-
-   quint32 uiSerializedSize = 0;
-   quint16 uiSerializationType(0), uiCompressData(0), uiEncryptData(0);
-   QByteArray dataHeader = socket.read((qint64)(QX_SERVICE_TOOLS_HEADER_SIZE));
-   qAssert(dataHeader.size() == (int)(QX_SERVICE_TOOLS_HEADER_SIZE));
-   QDataStream in(& dataHeader, QIODevice::ReadOnly);
-   in.setVersion(QDataStream::Qt_4_5);
-   in >> uiSerializedSize;
-   in >> uiSerializationType;
-   in >> uiCompressData;
-   in >> uiEncryptData;
-
-   while (socket.bytesAvailable() < (qint64)(uiSerializedSize))
-   { if (! socket.waitForReadyRead(QxConnect::getSingleton()->getMaxWait())) { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, "invalid bytes count available to retrieve transaction serialized data (" + socket.errorString() + ")"); } }
-
-   QByteArray dataSerialized = socket.read((qint64)(uiSerializedSize));
-   qAssert(dataSerialized.size() == (int)(uiSerializedSize));
-   size = (quint32)(QX_SERVICE_TOOLS_HEADER_SIZE + uiSerializedSize);
-   QDataStream in2(& dataHeader, QIODevice::ReadOnly);
-   return QxTools::readSocketData(dataSerialized, in2, transaction, size);
+   char pHeader[QX_SERVICE_TOOLS_HEADER_SIZE];
+   if (in.readRawData(pHeader, static_cast<int>(QX_SERVICE_TOOLS_HEADER_SIZE)) != static_cast<int>(QX_SERVICE_TOOLS_HEADER_SIZE))
+   { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("unable to read transaction header")); }
+   QxTools::header h = QxTools::parseHeader(pHeader);
+   if (dataSerialized.size() != static_cast<int>(h.uiSerializedSize))
+   { return qx_bool(QX_ERROR_SERVICE_READ_ERROR, QStringLiteral("invalid transaction serialized data size")); }
+   return QxTools::readSocketData(h, dataSerialized.data(), transaction, size, NULL);
 }
 
-qx_bool QxTools::readSocketData(QByteArray dataSerialized,QDataStream &in, QxTransaction & transaction, quint32 & size)
+qx_bool QxTools::readSocketData(const QxTools::header & h, char * pDataSerialized, QxTransaction & transaction, quint32 & size, QByteArray * pUncompressBuffer)
 {
-   quint32 uiSerializedSize = 0;
-   quint16 uiSerializationType(0), uiCompressData(0), uiEncryptData(0);
-   in.setVersion(QDataStream::Qt_4_5);
-   in >> uiSerializedSize;
-   in >> uiSerializationType;
-   in >> uiCompressData;
-   in >> uiEncryptData;
-
-   qAssert(dataSerialized.size() == (int)(uiSerializedSize));
-   size = (quint32)(QX_SERVICE_TOOLS_HEADER_SIZE + uiSerializedSize);
-
-   if (uiEncryptData != 0)
+   size = static_cast<quint32>(h.getHeaderSize() + h.uiSerializedSize);
+   transaction.setRequestId(h.uiRequestId);
+   QByteArray dataSerialized = QByteArray::fromRawData(pDataSerialized, static_cast<int>(h.uiSerializedSize));
+
+   if (h.isEncrypted())
    {
       QxSimpleCrypt crypto(QxConnect::getSingleton()->getEncryptKey());
-      QByteArray decrypted = crypto.decryptToByteArray(dataSerialized);
-      if ((crypto.lastError() != QxSimpleCrypt::ErrorNoError) || decrypted.isEmpty()) {
-          return qx_bool(QX_ERROR_UNKNOWN,
-                         QStringLiteral("an error occured during decryption of data"));
-      }
-      dataSerialized = decrypted;
+      dataSerialized = crypto.decryptInPlace(pDataSerialized, static_cast<int>(h.uiSerializedSize));
+      if ((crypto.lastError() != QxSimpleCrypt::ErrorNoError) || dataSerialized.isEmpty())
+      { return qx_bool(QX_ERROR_UNKNOWN, QStringLiteral("an error occured during decryption of data")); }
    }
 
-   if (uiCompressData != 0)
-   { QByteArray uncompressed = qUncompress(dataSerialized); if (! uncompressed.isEmpty()) { dataSerialized = uncompressed; } }
+   QByteArray uncompressed;
+   quint8 uiCodecId = static_cast<quint8>(h.uiCompressData & 0xFF);
+   if (uiCodecId != QX_SERVICE_COMPRESSION_NONE)
+   {
+      // Same behaviour as previous versions of QxService module : if data cannot be uncompressed, try to deserialize them as is
+      QByteArray & buffer = (pUncompressBuffer ? (* pUncompressBuffer) : uncompressed);
+      if (QxCompression::getSingleton()->uncompress(uiCodecId, dataSerialized, buffer)) { dataSerialized = QByteArray::fromRawData(buffer.constData(), buffer.size()); }
+      else { qDebug("[QxOrm] qx::service::QxTools::readSocketData() : unable to uncompress data using codec id '%d', data are read as is", static_cast<int>(uiCodecId)); }
+   }
 
    qx_bool bDeserializeOk;
-   switch (static_cast<QxConnect::serialization_type>(uiSerializationType))
+   switch (static_cast<QxConnect::serialization_type>(h.uiSerializationType))
    {
 #if _QX_SERIALIZE_BINARY
       case QxConnect::serialization_binary:                 bDeserializeOk = qx::serialization::binary::from_byte_array(transaction, dataSerialized); break;
@@ -193,8 +269,33 @@ qx_bool QxTools::writeSocket(QTcpSocket & socket, QxTransaction & transaction, q
    }
 
    quint16 uiCompressData = 0;
-   if (QxConnect::getSingleton()->getCompressData() && (dataSerialized.size() > QX_SERVICE_MIN_SIZE_TO_COMPRESS_DATA))
-   { QByteArray compressed = qCompress(dataSerialized, -1); if (! compressed.isEmpty()) { dataSerialized = compressed; uiCompressData = 1; } }
+   if (QxConnect::getSingleton()->getCompressData())
+   {
+      int iLevel = -1;
+      quint8 uiCodecId = QxConnect::getSingleton()->getCompressionCodec(dataSerialized.size(), iLevel);
+      quint8 uiPeerCodecMask = QxTools::getPeerCodecMask(socket);
+      bool bPeerCodecMaskKnown = (uiPeerCodecMask != 0);
+      bool bAdvertiseCodecs = (bPeerCodecMaskKnown || ((QxConnect::getSingleton()->getCompressionCodecMask() & ~(1 << (QX_SERVICE_COMPRESSION_ZLIB - 1))) != 0));
+
+      // Codecs other than zlib are used only if peer has advertised them (old peers know only zlib)
+      if ((uiCodecId > QX_SERVICE_COMPRESSION_ZLIB) && ((uiCodecId > 8) || ! (uiPeerCodecMask & (1 << (uiCodecId - 1)))))
+      { uiCodecId = QX_SERVICE_COMPRESSION_ZLIB; iLevel = -1; }
+
+      QByteArray compressed;
+      if ((uiCodecId != QX_SERVICE_COMPRESSION_NONE) && QxCompression::getSingleton()->compress(uiCodecId, dataSerialized, compressed, iLevel) && (compressed.size() < dataSerialized.size()))
+      { dataSerialized = compressed; uiCompressData = uiCodecId; }
+
+      // Old peers uncompress data (qUncompress()) as soon as this header field is not 0 : so low byte must be a real codec id when codecs are advertised to a peer which may be an old one (zlib is used, even if data are not smaller)
+      if (bAdvertiseCodecs && ! bPeerCodecMaskKnown && (uiCompressData == QX_SERVICE_COMPRESSION_NONE))
+      {
+         if (QxCompression::getSingleton()->compress(QX_SERVICE_COMPRESSION_ZLIB, dataSerialized, compressed, -1)) { dataSerialized = compressed; uiCompressData = QX_SERVICE_COMPRESSION_ZLIB; }
+         else { bAdvertiseCodecs = false; }
+      }
+
+      // Codecs available are advertised in compressed data, or to a peer which has already advertised its own codecs (so old peers never receive a codec mask with uncompressed data)
+      if ((uiCompressData != QX_SERVICE_COMPRESSION_NONE) || bAdvertiseCodecs)
+      { uiCompressData |= static_cast<quint16>(static_cast<quint16>(QxCompression::getSingleton()->getCodecMask()) << 8); }
+   }
 
    quint16 uiEncryptData = 0;
    if (QxConnect::getSingleton()->getEncryptData())
@@ -209,18 +310,18 @@ qx_bool QxTools::writeSocket(QTcpSocket & socket, QxTransaction & transaction, q
       uiEncryptData = 1;
    }
 
-   QByteArray dataHeader;
-   QDataStream out(& dataHeader, QIODevice::WriteOnly);
-   out.setVersion(QDataStream::Qt_4_5);
-   out << (quint32)(dataSerialized.size());
-   out << (quint16)(QxConnect::getSingleton()->getSerializationType());
-   out << (quint16)(uiCompressData);
-   out << (quint16)(uiEncryptData);
-   qAssert(dataHeader.size() == (int)(QX_SERVICE_TOOLS_HEADER_SIZE));
+   QxTools::header h;
+   h.uiSerializedSize = static_cast<quint32>(dataSerialized.size());
+   h.uiSerializationType = static_cast<quint16>(QxConnect::getSingleton()->getSerializationType());
+   h.uiCompressData = uiCompressData;
+   h.uiEncryptData = uiEncryptData;
+   h.uiRequestId = transaction.getRequestId();
+   if (h.uiRequestId != 0) { h.uiEncryptData |= QX_SERVICE_TOOLS_HEADER_FLAG_REQUEST_ID; }
+   char pDataHeader[QX_SERVICE_TOOLS_HEADER_MAX_SIZE];
+   int iHeaderSize = QxTools::writeHeader(h, pDataHeader);
 
    qint64 iTotalWritten = 0;
-   qint64 iTotalToWrite = (qint64)(dataHeader.size());
-   const char * pDataHeader = dataHeader.constData();
+   qint64 iTotalToWrite = (qint64)(iHeaderSize);
    while (iTotalWritten < iTotalToWrite)
    {
       qint64 iWritten = socket.write((pDataHeader + iTotalWritten), (iTotalToWrite - iTotalWritten));
@@ -241,10 +342,68 @@ qx_bool QxTools::writeSocket(QTcpSocket & socket, QxTransaction & transaction, q
       iTotalWritten += iWritten;
    }
 
-   size = (quint32)(dataHeader.size() + dataSerialized.size());
+   size = (quint32)(iHeaderSize + dataSerialized.size());
    return ((iTotalWritten == iTotalToWrite) ? qx_bool(true) : qx_bool(QX_ERROR_SERVICE_WRITE_ERROR, "unable to write all data bytes (serialized data) to socket (" + socket.errorString() + ")"));
 }
 
+QxTools::header QxTools::parseHeader(const char * pData)
+{
+   const uchar * p = reinterpret_cast<const uchar *>(pData);
+   QxTools::header h;
+   h.uiSerializedSize = qFromBigEndian<quint32>(p);
+   h.uiSerializationType = qFromBigEndian<quint16>(p + 4);
+   h.uiCompressData = qFromBigEndian<quint16>(p + 6);
+   h.uiEncryptData = qFromBigEndian<quint16>(p + 8);
+   return h;
+}
+
+int QxTools::writeHeader(const QxTools::header & h, char * pData)
+{
+   uchar * p = reinterpret_cast<uchar *>(pData);
+   qToBigEndian<quint32>(h.uiSerializedSize, p);
+   qToBigEndian<quint16>(h.uiSerializationType, (p + 4));
+   qToBigEndian<quint16>(h.uiCompressData, (p + 6));
+   qToBigEndian<quint16>(h.uiEncryptData, (p + 8));
+   if (h.hasRequestId()) { qToBigEndian<quint32>(h.uiRequestId, (p + QX_SERVICE_TOOLS_HEADER_SIZE)); }
+   return static_cast<int>(h.getHeaderSize());
+}
+
+qint64 QxTools::checkFrame(const char * pData, qint64 iSize, QxTools::header & h)
+{
+   // Returns the frame size (header + serialized data) if a whole frame is available, 0 otherwise
+   if (iSize < static_cast<qint64>(QX_SERVICE_TOOLS_HEADER_SIZE)) { return 0; }
+   h = QxTools::parseHeader(pData);
+   if (iSize < h.getHeaderSize()) { return 0; }
+   if (h.hasRequestId()) { h.uiRequestId = qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(pData + QX_SERVICE_TOOLS_HEADER_SIZE)); }
+   qint64 iFrameSize = (h.getHeaderSize() + static_cast<qint64>(h.uiSerializedSize));
+   return ((iSize >= iFrameSize) ? iFrameSize : 0);
+}
+
+QByteArray QxTools::takePendingData(QTcpSocket & socket)
+{
+   detail::QxSocketBuffer * pBuffer = detail::QxSocketBuffer::find(socket);
+   QByteArray pending; if (pBuffer) { pending = pBuffer->m_pending; pBuffer->m_pending.clear(); }
+   return pending;
+}
+
+bool QxTools::hasPendingData(QTcpSocket & socket)
+{
+   detail::QxSocketBuffer * pBuffer = detail::QxSocketBuffer::find(socket);
+   return (pBuffer && (! pBuffer->m_pending.isEmpty()));
+}
+
+void QxTools::setPeerCodecMask(QTcpSocket & socket, quint16 uiCompressData)
+{
+   quint8 uiPeerCodecMask = static_cast<quint8>((uiCompressData >> 8) & 0xFF);
+   if (uiPeerCodecMask != 0) { socket.setProperty(QX_SERVICE_PEER_CODEC_MASK_PROPERTY, static_cast<uint>(uiPeerCodecMask)); }
+}
+
+quint8 QxTools::getPeerCodecMask(QTcpSocket & socket)
+{
+   QVariant v = socket.property(QX_SERVICE_PEER_CODEC_MASK_PROPERTY);
+   return (v.isValid() ? static_cast<quint8>(v.toUInt() & 0xFF) : static_cast<quint8>(0));
+}
+
 } // namespace service
 } // namespace qx
 
@@ -58,6 +58,30 @@ QX_REGISTER_INTERNAL_HELPER_START_FILE_CPP(qx::service::QxTransaction)
 namespace qx {
 namespace service {
 
+// Service factory and service method resolved only once by (service name, service method) : only resolved handles are stored, so invalid requests cannot grow the cache
+// Handles are dropped when a class or a factory is removed (plugin unloaded for example), see qx::QxFactoryX::getRegistryVersion()
+struct QxTransaction_ServiceHandle
+{
+   qx::IxFactory * m_pFactory;   //!< Factory to create a new service instance
+   qx::IxFunction * m_pFct;      //!< Service method to invoke
+   QxTransaction_ServiceHandle() : m_pFactory(NULL), m_pFct(NULL) { ; }
+};
+
+struct QxTransaction_ServiceHandleCache
+{
+   QMutex m_mutex;
+   int m_iRegistryVersion;
+   QHash<QPair<QString, QString>, QxTransaction_ServiceHandle> m_lstHandle;
+   QxTransaction_ServiceHandleCache() : m_iRegistryVersion(0) { ; }
+   void sync(int iRegistryVersion) { if (m_iRegistryVersion != iRegistryVersion) { m_lstHandle.clear(); m_iRegistryVersion = iRegistryVersion; } }
+};
+
+static QxTransaction_ServiceHandleCache & getServiceHandleCache()
+{
+   static QxTransaction_ServiceHandleCache cache;
+   return cache;
+}
+
 void QxTransaction::clear()
 {
    m_sTransactionId = QString();
@@ -79,6 +103,7 @@ void QxTransaction::clear()
    m_pInputParameter.reset();
    m_pOutputParameter.reset();
    m_pServiceInstance.reset();
+   m_uiRequestId = 0;
 }
 
 void QxTransaction::executeServer()
@@ -88,7 +113,15 @@ void QxTransaction::executeServer()
     if (m_sServiceMethod.isEmpty()) { m_bMessageReturn = qx_bool(QX_ERROR_SERVICE_NOT_SPECIFIED, QStringLiteral("[QxOrm] empty service method => cannot execute process")); return;
     }
 
-   qx::service::IxService * ptr = qx::create_nude_ptr<qx::service::IxService>(m_sServiceName);
+   QxTransaction_ServiceHandleCache & cache = getServiceHandleCache();
+   QPair<QString, QString> handleKey(m_sServiceName, m_sServiceMethod);
+   QxTransaction_ServiceHandle handle;
+   int iRegistryVersion = qx::QxFactoryX::getRegistryVersion();
+   { QMutexLocker locker(& cache.m_mutex); cache.sync(iRegistryVersion); handle = cache.m_lstHandle.value(handleKey); }
+   bool bHandleCached = (handle.m_pFct != NULL);
+   if (! bHandleCached) { handle.m_pFactory = qx::find_factory(m_sServiceName); }
+
+   qx::service::IxService * ptr = qx::create_nude_ptr<qx::service::IxService>(handle.m_pFactory);
    if (ptr == NULL) {
        m_bMessageReturn = qx_bool(
            QX_ERROR_SERVICE_INVALID,
@@ -104,7 +137,13 @@ void QxTransaction::executeServer()
    try
    {
       m_pServiceInstance->onBeforeProcess();
-      qx_bool bInvokeOk = qx::QxClassX::invoke(m_sServiceName, m_sServiceMethod, (* m_pServiceInstance));
+      if (! bHandleCached)
+      {
+         // Service class is registered by the call to registerClass() above, so the service method can be resolved now
+         handle.m_pFct = qx::QxClassX::getFctMember(m_sServiceName, m_sServiceMethod, true);
+         if (handle.m_pFct) { QMutexLocker locker(& cache.m_mutex); if (cache.m_iRegistryVersion == iRegistryVersion) { cache.m_lstHandle.insert(handleKey, handle); } }
+      }
+      qx_bool bInvokeOk = qx::QxClassX::invoke(handle.m_pFct, (* m_pServiceInstance));
       if (!bInvokeOk) {
           m_bMessageReturn
                          = qx_bool(QX_ERROR_SERVICE_INVALID,
@@ -38,6 +38,8 @@
 
 #include <QxRegister/QxClassX.h>
 
+#include <QtCore/qregularexpression.h>
+
 #include <QxMemLeak/mem_leak.h>
 
 namespace qx {
@@ -269,8 +271,9 @@ void IxValidator::validateDateFuture(const QVariant &v,
 void IxValidator::validateRegularExpression(
     const QVariant &v, QxInvalidValueX &lstInvalidValues) const {
   QString s = v.toString();
-  QRegExp constraint(getConstraint().toString());
-  if (!constraint.exactMatch(s)) {
+  QRegularExpression constraint =
+      compileRegularExpression(getConstraint().toString());
+  if (!constraint.match(s).hasMatch()) {
     lstInvalidValues.insert(this);
   }
 }
@@ -278,12 +281,35 @@ void IxValidator::validateRegularExpression(
 void IxValidator::validateEMail(const QVariant &v,
                                 QxInvalidValueX &lstInvalidValues) const {
   QString s = v.toString();
-  QString pattern =
-      QStringLiteral("\\b[A-Z0-9._%+-]+@[A-Z0-9.-]+\\.[A-Z]{2,4}\\b");
-  QRegExp constraint(pattern, Qt::CaseInsensitive);
-  if (!constraint.exactMatch(s)) {
+  QRegularExpression constraint =
+      compileRegularExpression(getEMailPattern(), true);
+  if (!constraint.match(s).hasMatch()) {
     lstInvalidValues.insert(this);
   }
 }
 
+QRegularExpression
+IxValidator::compileRegularExpression(const QString &sPattern,
+                                      bool bCaseInsensitive /* = false */) {
+  QRegularExpression::PatternOptions options =
+      (bCaseInsensitive ? QRegularExpression::CaseInsensitiveOption
+                        : QRegularExpression::NoPatternOption);
+  QRegularExpression regExp(QStringLiteral("\\A(?:") + sPattern +
+                                QStringLiteral(")\\z"),
+                            options);
+  if (!regExp.isValid()) {
+    qDebug("[QxOrm] qx::IxValidator::compileRegularExpression() : invalid "
+           "pattern '%s' (%s)",
+           qPrintable(sPattern), qPrintable(regExp.errorString()));
+  }
+#if (QT_VERSION >= 0x050400) && (QT_VERSION < 0x050C00)
+  regExp.optimize(); // JIT-compile now instead of on second match (since Qt 5.12, patterns are always JIT-compiled on first match)
+#endif // (QT_VERSION >= 0x050400) && (QT_VERSION < 0x050C00)
+  return regExp;
+}
+
+QString IxValidator::getEMailPattern() {
+  return QStringLiteral("\\b[A-Z0-9._%+-]+@[A-Z0-9.-]+\\.[A-Z]{2,4}\\b");
+}
+
 } // namespace qx
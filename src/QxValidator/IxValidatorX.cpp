@@ -39,13 +39,170 @@
 #include <QxRegister/IxClass.h>
 #include <QxRegister/QxClassX.h>
 
+#include <QtCore/qregularexpression.h>
+
 #include <QxMemLeak/mem_leak.h>
 
+#define QX_VALIDATOR_X_KIND_UNKNOWN -1
+
 namespace qx {
 
-IxValidatorX::IxValidatorX() : m_pClass(NULL) { ; }
+/*!
+ * One validator compiled into a plan : constraints are converted and regular expressions are built only once.
+ * m_iKind is the real type of the property, detected on first validation (a property can only be read without QVariant conversion when its type is known).
+ */
+struct IxValidatorXPlanEntry
+{
+
+   enum value_kind { e_kind_variant, e_kind_string, e_kind_date_time, e_kind_short, e_kind_int, e_kind_long, e_kind_long_long, e_kind_float, e_kind_double };
+
+   IxValidator * m_pValidator;            //!< Validator (owned by qx::IxValidatorX validators list)
+   IxDataMember * m_pDataMember;          //!< Property to validate
+   IxValidator::validator_type m_type;    //!< Validator type
+   qlonglong m_lConstraint;               //!< Constraint converted to integer (min/max value, min/max length)
+   double m_dConstraint;                  //!< Constraint converted to decimal (min/max decimal)
+   QRegularExpression m_regExp;           //!< Precompiled and anchored regular expression (regular expression and e-mail validators)
+   QAtomicInt m_iKind;                    //!< Real type of the property (value_kind enum), QX_VALIDATOR_X_KIND_UNKNOWN before first validation
+
+   IxValidatorXPlanEntry(IxValidator * pValidator) : m_pValidator(pValidator), m_pDataMember(pValidator->getDataMember()), m_type(pValidator->getType()), m_lConstraint(0), m_dConstraint(0.0), m_iKind(QX_VALIDATOR_X_KIND_UNKNOWN)
+   {
+      QVariant constraint = pValidator->getConstraint();
+      switch (m_type)
+      {
+         case IxValidator::min_value: case IxValidator::max_value: case IxValidator::min_length: case IxValidator::max_length: m_lConstraint = constraint.toLongLong(); break;
+         case IxValidator::min_decimal: case IxValidator::max_decimal: m_dConstraint = constraint.toDouble(); break;
+         case IxValidator::regular_expression: m_regExp = IxValidator::compileRegularExpression(constraint.toString()); break;
+         case IxValidator::e_mail: m_regExp = IxValidator::compileRegularExpression(IxValidator::getEMailPattern(), true); break;
+         default: break;
+      }
+   }
+
+   int getKind(void * pOwner)
+   {
+      int iKind = m_iKind.loadAcquire();
+      if (iKind != QX_VALIDATOR_X_KIND_UNKNOWN) { return iKind; }
+      iKind = e_kind_variant;
+      if (m_pDataMember->getAccessDataPointer())
+      {
+         qx::any a = m_pDataMember->getValueAnyPtr(pOwner);
+         if (qx::any_cast<QString *>(& a)) { iKind = e_kind_string; }
+         else if (qx::any_cast<QDateTime *>(& a)) { iKind = e_kind_date_time; }
+         else if (qx::any_cast<short *>(& a)) { iKind = e_kind_short; }
+         else if (qx::any_cast<int *>(& a)) { iKind = e_kind_int; }
+         else if (qx::any_cast<long *>(& a)) { iKind = e_kind_long; }
+         else if (qx::any_cast<long long *>(& a)) { iKind = e_kind_long_long; }
+         else if (qx::any_cast<float *>(& a)) { iKind = e_kind_float; }
+         else if (qx::any_cast<double *>(& a)) { iKind = e_kind_double; }
+      }
+      m_iKind.storeRelease(iKind);
+      return iKind;
+   }
+
+   static bool isInteger(int iKind) { return ((iKind >= e_kind_short) && (iKind <= e_kind_long_long)); }
+   static bool isNumeric(int iKind) { return ((iKind >= e_kind_short) && (iKind <= e_kind_double)); }
 
-IxValidatorX::~IxValidatorX() { ; }
+   static qlonglong toLongLong(void * p, int iKind)
+   {
+      switch (iKind)
+      {
+         case e_kind_short: return static_cast<qlonglong>(* static_cast<short *>(p));
+         case e_kind_int: return static_cast<qlonglong>(* static_cast<int *>(p));
+         case e_kind_long: return static_cast<qlonglong>(* static_cast<long *>(p));
+         case e_kind_long_long: return static_cast<qlonglong>(* static_cast<long long *>(p));
+         default: return 0;
+      }
+   }
+
+   static double toDouble(void * p, int iKind)
+   {
+      switch (iKind)
+      {
+         case e_kind_float: return static_cast<double>(* static_cast<float *>(p));
+         case e_kind_double: return (* static_cast<double *>(p));
+         default: return static_cast<double>(toLongLong(p, iKind));
+      }
+   }
+
+   // Return false if the property cannot be validated without QVariant conversion (generic qx::IxValidator::validate() method must be used)
+   bool validate(void * pOwner, QxInvalidValueX & lstInvalidValues)
+   {
+      int iKind = getKind(pOwner);
+      void * p = ((iKind != e_kind_variant) ? m_pDataMember->getValueVoidPtr(pOwner) : NULL);
+      bool bInvalid = false;
+
+      switch (m_type)
+      {
+         case IxValidator::not_null:
+            if (iKind == e_kind_string) { bInvalid = static_cast<QString *>(p)->isNull(); }
+            else if (iKind == e_kind_date_time) { bInvalid = static_cast<QDateTime *>(p)->isNull(); }
+            else if (! isNumeric(iKind)) { return false; }
+            break;
+         case IxValidator::not_empty:
+            if (iKind != e_kind_string) { return false; }
+            bInvalid = static_cast<QString *>(p)->isEmpty();
+            break;
+         case IxValidator::min_value:
+         case IxValidator::max_value:
+            if (! isInteger(iKind)) { return false; }
+            if (m_type == IxValidator::min_value) { bInvalid = ((long)toLongLong(p, iKind) < (long)m_lConstraint); }
+            else { bInvalid = ((long)toLongLong(p, iKind) > (long)m_lConstraint); }
+            break;
+         case IxValidator::min_length:
+         case IxValidator::max_length:
+            if (iKind != e_kind_string) { return false; }
+            if (m_type == IxValidator::min_length) { bInvalid = (static_cast<QString *>(p)->size() < (long)m_lConstraint); }
+            else { bInvalid = (static_cast<QString *>(p)->size() > (long)m_lConstraint); }
+            break;
+         case IxValidator::min_decimal:
+         case IxValidator::max_decimal:
+            if (! isNumeric(iKind)) { return false; }
+            if (m_type == IxValidator::min_decimal) { bInvalid = (toDouble(p, iKind) < m_dConstraint); }
+            else { bInvalid = (toDouble(p, iKind) > m_dConstraint); }
+            break;
+         case IxValidator::date_past:
+         case IxValidator::date_future:
+         {
+            if (iKind != e_kind_date_time) { return false; }
+            const QDateTime & dt = (* static_cast<QDateTime *>(p));
+            if (m_type == IxValidator::date_past) { bInvalid = (! dt.isValid() || (dt > QDateTime::currentDateTime())); }
+            else { bInvalid = (! dt.isValid() || (dt < QDateTime::currentDateTime())); }
+            break;
+         }
+         case IxValidator::regular_expression:
+         case IxValidator::e_mail:
+            if (iKind == e_kind_string) { bInvalid = (! m_regExp.match(* static_cast<QString *>(p)).hasMatch()); }
+            else { bInvalid = (! m_regExp.match(m_pDataMember->toVariant(pOwner).toString()).hasMatch()); }
+            break;
+         default:
+            return false;
+      }
+
+      if (bInvalid) { lstInvalidValues.insert(m_pValidator); }
+      return true;
+   }
+
+};
+
+typedef std::shared_ptr<IxValidatorXPlanEntry> IxValidatorXPlanEntry_ptr;
+
+/*!
+ * Validators of a class compiled by group : built on first validation, so all validators must be registered before (into qx::register_class() function)
+ */
+struct IxValidatorX::IxValidatorXPlan
+{
+
+   typedef QList<IxValidatorXPlanEntry_ptr> type_lst_entry;
+
+   QHash<QString, type_lst_entry> m_lstEntryByGroup;  //!< List of compiled validators by group (this class only)
+   IxValidatorX * m_pBaseValidator;                    //!< Validators of base class (NULL if there is no base class)
+
+   IxValidatorXPlan() : m_pBaseValidator(NULL) { ; }
+
+};
+
+IxValidatorX::IxValidatorX() : m_pClass(NULL), m_pPlan(NULL) { ; }
+
+IxValidatorX::~IxValidatorX() { resetPlan(); }
 
 void IxValidatorX::setClass(IxClass * p) { m_pClass = p; }
 
@@ -76,24 +233,72 @@ QxInvalidValueX IxValidatorX::validate(void * pOwner, const QString & sGroup /*
 {
    QxInvalidValueX invalidValues;
    if (! m_pClass) { qAssert(false); return invalidValues; }
+   validateByPlan(pOwner, sGroup, invalidValues);
+   return invalidValues;
+}
+
+bool IxValidatorX::isEmpty(const QString & sGroup /* = QString() */) const
+{
+   if (! m_pClass) { return true; }
+   const IxValidatorXPlan * pPlan = getPlan();
+   if (pPlan->m_lstEntryByGroup.contains(sGroup)) { return false; }
+   return (pPlan->m_pBaseValidator ? pPlan->m_pBaseValidator->isEmpty(sGroup) : true);
+}
 
-   if (m_pClass->getBaseClass())
+void IxValidatorX::validateByPlan(void * pOwner, const QString & sGroup, QxInvalidValueX & lstInvalidValues) const
+{
+   const IxValidatorXPlan * pPlan = getPlan();
+   if (pPlan->m_pBaseValidator) { pPlan->m_pBaseValidator->validateByPlan(pOwner, sGroup, lstInvalidValues); }
+
+   QHash<QString, IxValidatorXPlan::type_lst_entry>::const_iterator itr = pPlan->m_lstEntryByGroup.constFind(sGroup);
+   if (itr == pPlan->m_lstEntryByGroup.constEnd()) { return; }
+
+   const IxValidatorXPlan::type_lst_entry & lstEntry = itr.value();
+   for (int i = 0; i < lstEntry.count(); i++)
    {
-      IxValidatorX * pAllValidator = m_pClass->getBaseClass()->getAllValidator();
-      if (pAllValidator) { invalidValues.insert(pAllValidator->validate(pOwner, sGroup)); }
+      IxValidatorXPlanEntry * pEntry = lstEntry.at(i).get();
+      if (! pEntry->validate(pOwner, lstInvalidValues)) { pEntry->m_pValidator->validate(pOwner, lstInvalidValues); }
    }
+}
 
-   if (! m_lstValidatorByGroup.exist(sGroup)) { return invalidValues; }
-   type_lst_validator_ptr lstValidator = m_lstValidatorByGroup.getByKey(sGroup);
-   if (! lstValidator) { return invalidValues; }
+const IxValidatorX::IxValidatorXPlan * IxValidatorX::getPlan() const
+{
+   IxValidatorXPlan * pPlan = m_pPlan.loadAcquire();
+   if (pPlan) { return pPlan; }
+
+   pPlan = new IxValidatorXPlan();
+   IxClass * pBaseClass = (m_pClass ? m_pClass->getBaseClass() : NULL);
+   pPlan->m_pBaseValidator = (pBaseClass ? pBaseClass->getAllValidator() : NULL);
 
-   for (long l = 0; l < lstValidator->count(); l++)
+   for (long l = 0; l < m_lstValidatorByGroup.count(); l++)
    {
-      IxValidator_ptr validator = lstValidator->at(l);
-      if (validator) { validator->validate(pOwner, invalidValues); }
+      type_lst_validator_ptr lstValidator = m_lstValidatorByGroup.getByIndex(l);
+      if (! lstValidator) { continue; }
+
+      IxValidatorXPlan::type_lst_entry lstEntry;
+      for (long k = 0; k < lstValidator->count(); k++)
+      {
+         IxValidator_ptr validator = lstValidator->at(k);
+         if (! validator) { continue; }
+         IxValidatorXPlanEntry_ptr pEntry = std::make_shared<IxValidatorXPlanEntry>(validator.get());
+         bool bGeneric = ((pEntry->m_type == IxValidator::recursive_validator) || (pEntry->m_type == IxValidator::custom_validator));
+         if (! bGeneric && ! pEntry->m_pDataMember) { continue; } // Same behaviour as qx::IxValidator::validate() : nothing to check without property
+         if (bGeneric) { pEntry->m_iKind.storeRelease(IxValidatorXPlanEntry::e_kind_variant); }
+         lstEntry.append(pEntry);
+      }
+      if (lstEntry.count() > 0) { pPlan->m_lstEntryByGroup.insert(m_lstValidatorByGroup.getKeyByIndex(l), lstEntry); }
    }
 
-   return invalidValues;
+   // Another thread may have built the plan at the same time : keep the first one
+   if (m_pPlan.testAndSetOrdered(NULL, pPlan)) { return pPlan; }
+   delete pPlan;
+   return m_pPlan.loadAcquire();
+}
+
+void IxValidatorX::resetPlan()
+{
+   IxValidatorXPlan * pPlan = m_pPlan.fetchAndStoreOrdered(NULL);
+   if (pPlan) { delete pPlan; }
 }
 
 void IxValidatorX::insertIntoGroup(IxValidator_ptr pValidator, const QString & sGroup)
@@ -109,6 +314,7 @@ void IxValidatorX::insertIntoGroup(IxValidator_ptr pValidator, const QString & s
 
    type_lst_validator_ptr lstValidator = m_lstValidatorByGroup.getByKey(sGroup);
    lstValidator->append(pValidator);
+   resetPlan();
 }
 
 IxValidator_ptr IxValidatorX::createValidator(IxValidator::validator_type type, const QString & sPropertyKey, const QString & sMessage, const QString & sGroup)
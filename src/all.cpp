@@ -55,6 +55,7 @@
 
 #include "./QxCommon/QxBool.cpp"
 #include "./QxCommon/QxCache.cpp"
+#include "./QxCommon/QxTrace.cpp"
 #include "./QxCommon/QxSimpleCrypt.cpp"
 
 #include "./QxConvert/QxConvert_Export.cpp"
@@ -76,15 +77,21 @@
 #include "./QxDao/QxSqlDatabase.cpp"
 #include "./QxDao/IxSqlRelation.cpp"
 #include "./QxDao/QxSqlQuery.cpp"
+#include "./QxDao/QxSqlQueryCompiled.cpp"
 #include "./QxDao/QxSession.cpp"
+#include "./QxDao/QxUnitOfWork.cpp"
+#include "./QxDao/QxIdentityMap.cpp"
 #include "./QxDao/IxDao_Helper.cpp"
 #include "./QxDao/IxPersistable.cpp"
 #include "./QxDao/IxPersistableCollection.cpp"
 #include "./QxDao/IxPersistableList.cpp"
 #include "./QxDao/QxSqlRelationLinked.cpp"
 #include "./QxDao/QxDaoAsync.cpp"
+#include "./QxDao/QxDaoParallel.cpp"
+#include "./QxDao/QxDaoMetrics.cpp"
 #include "./QxDao/QxSqlRelationParams.cpp"
 #include "./QxDao/QxSoftDelete.cpp"
+#include "./QxDao/QxDao_IsDirty.cpp"
 #include "./QxDao/QxDateNeutral.cpp"
 #include "./QxDao/QxDateTimeNeutral.cpp"
 #include "./QxDao/QxTimeNeutral.cpp"
@@ -100,6 +107,7 @@
 #include "./QxDao/QxSqlElement/QxSqlIsNull.cpp"
 #include "./QxDao/QxSqlElement/QxSqlLimit.cpp"
 #include "./QxDao/QxSqlElement/QxSqlSort.cpp"
+#include "./QxDao/QxSqlElement/QxSqlSeek.cpp"
 
 #include "./QxDao/QxSqlGenerator/IxSqlGenerator.cpp"
 #include "./QxDao/QxSqlGenerator/QxSqlGenerator_MySQL.cpp"
@@ -180,11 +188,13 @@
 
 #include "./QxService/IxParameter.cpp"
 #include "./QxService/IxService.cpp"
+#include "./QxService/QxClientPool.cpp"
 #include "./QxService/QxConnect.cpp"
 #include "./QxService/QxServer.cpp"
 #include "./QxService/QxThread.cpp"
 #include "./QxService/QxThreadPool.cpp"
 #include "./QxService/QxTools.cpp"
+#include "./QxService/QxCompression.cpp"
 #include "./QxService/QxTransaction.cpp"
 
 #include "./QxHttpServer/QxHttpRequest.cpp"
@@ -192,6 +202,7 @@
 #include "./QxHttpServer/QxHttpServer.cpp"
 #include "./QxHttpServer/QxHttpTransaction.cpp"
 #include "./QxHttpServer/QxHttpCookie.cpp"
+#include "./QxHttpServer/QxHttpMetrics.cpp"
 #include "./QxHttpServer/QxHttpSession.cpp"
 #include "./QxHttpServer/QxHttpSessionManager.cpp"
 
@@ -0,0 +1,122 @@
+#ifndef _QX_BENCHMARK_BENCH_H_
+#define _QX_BENCHMARK_BENCH_H_
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qjsonobject.h>
+
+namespace qx_bench {
+
+/*!
+ * Number of heap allocations done by the process (all threads) while allocation tracking is enabled : global operator new (and malloc with glibc) is replaced by the benchmark executable.
+ */
+qlonglong alloc_count();
+
+/*!
+ * Allocation tracking is enabled only while an operation is measured (see runner::measure()) : the rest of the time, replaced allocation functions only read this flag (no write to a shared counter).
+ */
+void alloc_tracking(bool bEnabled);
+
+/*!
+ * Heap bytes peak tracking (glibc only, both functions return -1 on other platforms) : heap_peak_reset() enables allocation tracking and starts a new peak measure (returns 0), heap_peak() disables it and returns the max heap growth in bytes since last reset.
+ */
+qlonglong heap_peak_reset();
+qlonglong heap_peak();
+
+/*!
+ * One benchmark result : throughput, latency percentiles (in microseconds) and heap allocations of a single measured operation.
+ * Suites can add other values in m_extra (payload size, MB/s, rows per operation, etc.).
+ */
+struct result
+{
+   QString     m_suite;
+   QString     m_name;
+   qlonglong   m_iterations;
+   double      m_ops_per_sec;
+   double      m_p50_us;
+   double      m_p90_us;
+   double      m_p99_us;
+   double      m_max_us;
+   double      m_allocs_per_op;
+   QVariantMap m_extra;
+
+   result() : m_iterations(0), m_ops_per_sec(0.0), m_p50_us(0.0), m_p90_us(0.0), m_p99_us(0.0), m_max_us(0.0), m_allocs_per_op(0.0) { ; }
+};
+
+/*!
+ * Run measured operations and collect their results (a suite is a simple function taking a runner).
+ * Iteration counts given by suites are multiplied by the scale factor (--scale command line parameter).
+ * Suites can read their own settings with param() (--param key=value command line parameter).
+ */
+class runner
+{
+
+private:
+
+   QList<result> m_results;   //!< All results collected
+   QString m_sCurrentSuite;   //!< Suite currently running
+   double m_dScale;           //!< Iteration count scale factor
+   QMap<QString, QString> m_params; //!< Suite parameters
+   bool m_bCountAllocs;       //!< Count heap allocations of measured operations (multi-thread suites can disable it : all threads update the same counters)
+
+public:
+
+   runner() : m_dScale(1.0), m_bCountAllocs(true) { ; }
+
+   void setScale(double d) { m_dScale = ((d > 0.0) ? d : 1.0); }
+   void setCurrentSuite(const QString & s) { m_sCurrentSuite = s; }
+   const QList<result> & results() const { return m_results; }
+   void setParam(const QString & sKey, const QString & sValue) { m_params.insert(sKey, sValue); }
+   QString param(const QString & sKey, const QString & sDefault) const { return m_params.value(sKey, sDefault); }
+   void setCountAllocs(bool b) { m_bCountAllocs = b; }
+   bool getCountAllocs() const { return m_bCountAllocs; }
+
+   qlonglong iterations(qlonglong l) const { qlonglong r = static_cast<qlonglong>(l * m_dScale); return ((r > 0) ? r : 1); }
+
+   template <typename T_Fct>
+   result & measure(const QString & sName, qlonglong lIterations, T_Fct fct)
+   {
+      lIterations = iterations(lIterations);
+      QVector<qint64> samples; samples.reserve(static_cast<int>(lIterations));
+      fct(); // warm-up
+      qlonglong lAllocBefore = alloc_count();
+      if (m_bCountAllocs) { alloc_tracking(true); }
+      QElapsedTimer total; total.start();
+      QElapsedTimer timer;
+      for (qlonglong l = 0; l < lIterations; ++l) { timer.start(); fct(); samples.append(timer.nsecsElapsed()); }
+      qint64 iTotalNs = total.nsecsElapsed();
+      if (m_bCountAllocs) { alloc_tracking(false); }
+      result & res = add(sName, samples, iTotalNs);
+      res.m_allocs_per_op = (m_bCountAllocs ? (static_cast<double>(alloc_count() - lAllocBefore) / static_cast<double>(lIterations)) : -1.0); // -1 : not measured
+      return res;
+   }
+
+   result & add(const QString & sName, QVector<qint64> & samples, qint64 iTotalNs);
+   QJsonObject toJson() const;
+   void print() const;
+
+   static QList<result> fromJson(const QJsonObject & json);
+
+   /*!
+    * Compare results with a baseline (same suite and name) and print the differences : return the number of regressions.
+    * A regression is a throughput lower (or allocations per operation higher) than the baseline by more than dThresholdPct percent.
+    */
+   static int compare(const QList<result> & lstCurrent, const QList<result> & lstBaseline, double dThresholdPct);
+
+};
+
+typedef void (* type_fct_suite)(runner &);
+
+void suite_alloc(runner & r);
+void suite_compression(runner & r);
+void suite_crypt(runner & r);
+void suite_dao(runner & r);
+void suite_http(runner & r);
+void suite_parallel(runner & r);
+void suite_projection(runner & r);
+void suite_serialization(runner & r);
+void suite_session(runner & r);
+void suite_threads(runner & r);
+
+} // namespace qx_bench
+
+#endif // _QX_BENCHMARK_BENCH_H_
@@ -0,0 +1,24 @@
+#ifndef _QX_BENCHMARK_BENCH_HTTP_ITEM_H_
+#define _QX_BENCHMARK_BENCH_HTTP_ITEM_H_
+
+class QX_BENCHMARK_DLL_EXPORT bench_http_item : public qx::IxPersistable
+{
+   QX_PERSISTABLE_HPP(bench_http_item)
+public:
+// -- properties
+   long        m_id;
+   QString     m_name;
+   QString     m_category;
+   double      m_price;
+   QString     m_payload;
+// -- contructor, virtual destructor
+   bench_http_item() : qx::IxPersistable(), m_id(0), m_price(0.0) { ; }
+   virtual ~bench_http_item() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_http_item, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_http_item> bench_http_item_ptr;
+typedef qx::QxCollection<long, bench_http_item_ptr> list_bench_http_item;
+
+#endif // _QX_BENCHMARK_BENCH_HTTP_ITEM_H_
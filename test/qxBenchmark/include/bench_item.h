@@ -0,0 +1,44 @@
+#ifndef _QX_BENCHMARK_BENCH_ITEM_H_
+#define _QX_BENCHMARK_BENCH_ITEM_H_
+
+class QX_BENCHMARK_DLL_EXPORT bench_item
+{
+public:
+// -- properties
+   long        m_id;
+   QString     m_name;
+   QString     m_category;
+   double      m_price;
+   int         m_quantity;
+   QDateTime   m_updated;
+// -- contructor, virtual destructor
+   bench_item() : m_id(0), m_price(0.0), m_quantity(0) { ; }
+   virtual ~bench_item() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_item, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_item> bench_item_ptr;
+typedef qx::QxCollection<long, bench_item_ptr> list_bench_item;
+
+namespace qx_bench {
+
+/*!
+ * Common SQLite settings of all suites (SQL traces disabled)
+ */
+void setBenchDatabase(const QString & sDatabaseName, const QString & sConnectOptions);
+
+/*!
+ * Item with values computed from its id : name 'item_<id>', category 'category_<id % 16>' (or sCategory), price id * 0.25, quantity id % 100
+ */
+bench_item_ptr newBenchItem(long lId);
+bench_item_ptr newBenchItem(long lId, const QString & sCategory);
+
+/*!
+ * Create table 't_bench_item' and insert lRows items (ids from 1 to lRows) built by fctNewItem (newBenchItem(long) by default)
+ */
+bool initBenchItemDatabase(const QString & sDatabaseName, const QString & sConnectOptions, long lRows, const std::function<bench_item_ptr (long)> & fctNewItem = std::function<bench_item_ptr (long)>());
+
+} // namespace qx_bench
+
+#endif // _QX_BENCHMARK_BENCH_ITEM_H_
@@ -0,0 +1,77 @@
+#ifndef _QX_BENCHMARK_BENCH_RELATION_H_
+#define _QX_BENCHMARK_BENCH_RELATION_H_
+
+class bench_book;
+
+class QX_BENCHMARK_DLL_EXPORT bench_profile
+{
+public:
+// -- properties
+   long        m_id;
+   QString     m_bio;
+// -- contructor, virtual destructor
+   bench_profile() : m_id(0) { ; }
+   virtual ~bench_profile() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_profile, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_profile> bench_profile_ptr;
+
+class QX_BENCHMARK_DLL_EXPORT bench_tag
+{
+public:
+// -- properties
+   long        m_id;
+   QString     m_name;
+// -- contructor, virtual destructor
+   bench_tag() : m_id(0) { ; }
+   virtual ~bench_tag() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_tag, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_tag> bench_tag_ptr;
+typedef QList<bench_tag_ptr> list_bench_tag;
+
+class QX_BENCHMARK_DLL_EXPORT bench_author
+{
+public:
+// -- typedef
+   typedef std::shared_ptr<bench_book> bench_book_ptr;
+   typedef QList<bench_book_ptr> list_bench_book;
+// -- properties
+   long              m_id;
+   QString           m_name;
+   bench_profile_ptr m_profile;
+   list_bench_book   m_bookX;
+// -- contructor, virtual destructor
+   bench_author() : m_id(0) { ; }
+   virtual ~bench_author() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_author, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_author> bench_author_ptr;
+typedef QList<bench_author_ptr> list_bench_author;
+
+class QX_BENCHMARK_DLL_EXPORT bench_book
+{
+public:
+// -- properties
+   long              m_id;
+   QString           m_title;
+   double            m_price;
+   bench_author_ptr  m_author;
+   list_bench_tag    m_tagX;
+// -- contructor, virtual destructor
+   bench_book() : m_id(0), m_price(0.0) { ; }
+   virtual ~bench_book() { ; }
+};
+
+QX_REGISTER_HPP_QX_BENCHMARK(bench_book, qx::trait::no_base_class_defined, 0)
+
+typedef std::shared_ptr<bench_book> bench_book_ptr;
+typedef QList<bench_book_ptr> list_bench_book;
+
+#endif // _QX_BENCHMARK_BENCH_RELATION_H_
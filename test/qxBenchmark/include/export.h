@@ -0,0 +1,18 @@
+#ifndef _QX_BENCHMARK_EXPORT_H_
+#define _QX_BENCHMARK_EXPORT_H_
+
+#ifdef _BUILDING_QX_BENCHMARK
+#define QX_BENCHMARK_DLL_EXPORT QX_DLL_EXPORT_HELPER
+#else // _BUILDING_QX_BENCHMARK
+#define QX_BENCHMARK_DLL_EXPORT QX_DLL_IMPORT_HELPER
+#endif // _BUILDING_QX_BENCHMARK
+
+#ifdef _BUILDING_QX_BENCHMARK
+#define QX_REGISTER_HPP_QX_BENCHMARK     QX_REGISTER_HPP_EXPORT_DLL
+#define QX_REGISTER_CPP_QX_BENCHMARK     QX_REGISTER_CPP_EXPORT_DLL
+#else // _BUILDING_QX_BENCHMARK
+#define QX_REGISTER_HPP_QX_BENCHMARK     QX_REGISTER_HPP_IMPORT_DLL
+#define QX_REGISTER_CPP_QX_BENCHMARK     QX_REGISTER_CPP_IMPORT_DLL
+#endif // _BUILDING_QX_BENCHMARK
+
+#endif // _QX_BENCHMARK_EXPORT_H_
@@ -0,0 +1,8 @@
+#ifndef _QX_BENCHMARK_PRECOMPILED_HEADER_H_
+#define _QX_BENCHMARK_PRECOMPILED_HEADER_H_
+
+#include <QxOrm.h>
+
+#include "export.h"
+
+#endif // _QX_BENCHMARK_PRECOMPILED_HEADER_H_
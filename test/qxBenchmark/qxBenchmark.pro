@@ -0,0 +1,44 @@
+include(../../QxOrm.pri)
+
+TEMPLATE = app
+DEFINES += _BUILDING_QX_BENCHMARK
+INCLUDEPATH += ../../../QxOrm/include/
+DESTDIR = ../../../QxOrm/test/_bin/
+LIBS += -L"../../../QxOrm/lib"
+
+!contains(DEFINES, _QX_NO_PRECOMPILED_HEADER) {
+PRECOMPILED_HEADER = ./include/precompiled.h
+} # !contains(DEFINES, _QX_NO_PRECOMPILED_HEADER)
+
+macx:CONFIG-=app_bundle
+
+CONFIG(debug, debug|release) {
+TARGET = qxBenchmarkd
+LIBS += -l"QxOrmd"
+} else {
+TARGET = qxBenchmark
+LIBS += -l"QxOrm"
+} # CONFIG(debug, debug|release)
+
+HEADERS += ./include/precompiled.h
+HEADERS += ./include/export.h
+HEADERS += ./include/bench.h
+HEADERS += ./include/bench_http_item.h
+HEADERS += ./include/bench_item.h
+HEADERS += ./include/bench_relation.h
+
+SOURCES += ./src/bench.cpp
+SOURCES += ./src/bench_alloc.cpp
+SOURCES += ./src/bench_compression.cpp
+SOURCES += ./src/bench_crypt.cpp
+SOURCES += ./src/bench_dao.cpp
+SOURCES += ./src/bench_http.cpp
+SOURCES += ./src/bench_http_item.cpp
+SOURCES += ./src/bench_item.cpp
+SOURCES += ./src/bench_parallel.cpp
+SOURCES += ./src/bench_projection.cpp
+SOURCES += ./src/bench_relation.cpp
+SOURCES += ./src/bench_serialization.cpp
+SOURCES += ./src/bench_session.cpp
+SOURCES += ./src/bench_threads.cpp
+SOURCES += ./src/main.cpp
@@ -0,0 +1,119 @@
+#include "../include/precompiled.h"
+
+#include <QtCore/qjsonarray.h>
+
+#include <algorithm>
+
+#include "../include/bench.h"
+
+namespace qx_bench {
+
+static double percentile_us(const QVector<qint64> & sorted, double p)
+{
+   if (sorted.isEmpty()) { return 0.0; }
+   int idx = static_cast<int>(p * (sorted.count() - 1) + 0.5);
+   return (sorted.at(idx) / 1000.0);
+}
+
+result & runner::add(const QString & sName, QVector<qint64> & samples, qint64 iTotalNs)
+{
+   std::sort(samples.begin(), samples.end());
+   result r;
+   r.m_suite = m_sCurrentSuite;
+   r.m_name = sName;
+   r.m_iterations = samples.count();
+   r.m_ops_per_sec = ((iTotalNs > 0) ? (samples.count() * 1000000000.0 / iTotalNs) : 0.0);
+   r.m_p50_us = percentile_us(samples, 0.50);
+   r.m_p90_us = percentile_us(samples, 0.90);
+   r.m_p99_us = percentile_us(samples, 0.99);
+   r.m_max_us = (samples.isEmpty() ? 0.0 : (samples.last() / 1000.0));
+   m_results.append(r);
+   return m_results.last();
+}
+
+QJsonObject runner::toJson() const
+{
+   QJsonArray lst;
+   Q_FOREACH(const result & r, m_results)
+   {
+      QJsonObject obj;
+      obj.insert("suite", r.m_suite);
+      obj.insert("name", r.m_name);
+      obj.insert("iterations", static_cast<double>(r.m_iterations));
+      obj.insert("ops_per_sec", r.m_ops_per_sec);
+      obj.insert("p50_us", r.m_p50_us);
+      obj.insert("p90_us", r.m_p90_us);
+      obj.insert("p99_us", r.m_p99_us);
+      obj.insert("max_us", r.m_max_us);
+      obj.insert("allocs_per_op", r.m_allocs_per_op);
+      if (! r.m_extra.isEmpty()) { obj.insert("extra", QJsonObject::fromVariantMap(r.m_extra)); }
+      lst.append(obj);
+   }
+
+   QJsonObject root;
+   root.insert("qxorm_version", QString(QX_VERSION_STR));
+   root.insert("qt_version", QString(qVersion()));
+   root.insert("results", lst);
+   return root;
+}
+
+void runner::print() const
+{
+   Q_FOREACH(const result & r, m_results)
+   {
+      QString sExtra;
+      QMapIterator<QString, QVariant> itr(r.m_extra);
+      while (itr.hasNext()) { itr.next(); sExtra += (" " + itr.key() + "=" + itr.value().toString()); }
+      qDebug("[qxBenchmark] %-14s %-48s %12.1f ops/s  p50=%9.2fus  p99=%9.2fus  allocs=%9.1f%s", qPrintable(r.m_suite), qPrintable(r.m_name), r.m_ops_per_sec, r.m_p50_us, r.m_p99_us, r.m_allocs_per_op, qPrintable(sExtra));
+   }
+}
+
+QList<result> runner::fromJson(const QJsonObject & json)
+{
+   QList<result> lst;
+   QJsonArray arr = json.value("results").toArray();
+   for (int i = 0; i < arr.count(); ++i)
+   {
+      QJsonObject obj = arr.at(i).toObject();
+      result r;
+      r.m_suite = obj.value("suite").toString();
+      r.m_name = obj.value("name").toString();
+      r.m_iterations = static_cast<qlonglong>(obj.value("iterations").toDouble());
+      r.m_ops_per_sec = obj.value("ops_per_sec").toDouble();
+      r.m_p50_us = obj.value("p50_us").toDouble();
+      r.m_p90_us = obj.value("p90_us").toDouble();
+      r.m_p99_us = obj.value("p99_us").toDouble();
+      r.m_max_us = obj.value("max_us").toDouble();
+      r.m_allocs_per_op = obj.value("allocs_per_op").toDouble(-1.0); // -1 : baseline written before allocations were measured
+      r.m_extra = obj.value("extra").toObject().toVariantMap();
+      lst.append(r);
+   }
+   return lst;
+}
+
+static double delta_pct(double dCurrent, double dBaseline) { return ((dBaseline > 0.0) ? (((dCurrent - dBaseline) * 100.0) / dBaseline) : 0.0); }
+
+int runner::compare(const QList<result> & lstCurrent, const QList<result> & lstBaseline, double dThresholdPct)
+{
+   QHash<QString, const result *> hashBaseline;
+   for (int i = 0; i < lstBaseline.count(); ++i) { const result & r = lstBaseline.at(i); hashBaseline.insert((r.m_suite + "/" + r.m_name), (& r)); }
+
+   int iRegressions = 0;
+   Q_FOREACH(const result & r, lstCurrent)
+   {
+      const result * pBaseline = hashBaseline.value((r.m_suite + "/" + r.m_name), NULL);
+      if (! pBaseline) { qDebug("[qxBenchmark] %-14s %-48s (new, no baseline)", qPrintable(r.m_suite), qPrintable(r.m_name)); continue; }
+      double dOps = delta_pct(r.m_ops_per_sec, pBaseline->m_ops_per_sec);
+      double dP99 = delta_pct(r.m_p99_us, pBaseline->m_p99_us);
+      bool bAllocs = ((pBaseline->m_allocs_per_op >= 0.0) && (r.m_allocs_per_op >= 0.0)); // -1 : allocations not measured
+      double dAllocs = (bAllocs ? delta_pct(r.m_allocs_per_op, pBaseline->m_allocs_per_op) : 0.0);
+      if (bAllocs && (pBaseline->m_allocs_per_op <= 0.0) && (r.m_allocs_per_op >= 1.0)) { dAllocs = 100.0; } // From zero allocation to at least one per operation
+      bool bRegression = ((dOps < -dThresholdPct) || (bAllocs && (dAllocs > dThresholdPct) && ((r.m_allocs_per_op - pBaseline->m_allocs_per_op) >= 0.5)));
+      if (bRegression) { iRegressions++; }
+      qDebug("[qxBenchmark] %-14s %-48s ops/s %+7.1f%%  p99 %+7.1f%%  allocs %+7.1f%%%s", qPrintable(r.m_suite), qPrintable(r.m_name), dOps, dP99, dAllocs, (bRegression ? "  <-- REGRESSION" : ""));
+   }
+   qDebug("[qxBenchmark] %d regression(s) found (threshold %.1f%%)", iRegressions, dThresholdPct);
+   return iRegressions;
+}
+
+} // namespace qx_bench
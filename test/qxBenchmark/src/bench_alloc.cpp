@@ -0,0 +1,134 @@
+#include "../include/precompiled.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+// Count all heap allocations of the process : global operator new is replaced for the whole executable (and, on Linux, for all shared libraries loaded).
+// With glibc, malloc/calloc/realloc/free are replaced instead (Qt containers and QString allocate with malloc, not operator new) : heap bytes in use and peak are also tracked.
+// On other platforms, only allocations done with operator new are counted, and heap bytes are not available.
+#if defined(__GLIBC__) && ! defined(_QX_USE_MEM_LEAK_DETECTION)
+#define QX_BENCH_HOOK_MALLOC 1
+#else // defined(__GLIBC__) && ! defined(_QX_USE_MEM_LEAK_DETECTION)
+#define QX_BENCH_HOOK_MALLOC 0
+#endif // defined(__GLIBC__) && ! defined(_QX_USE_MEM_LEAK_DETECTION)
+
+// Allocations are counted only while tracking is enabled (runner::measure()) : otherwise hooks only read g_allocTracking, so other benchmarks don't measure contention on these counters
+static std::atomic<bool> g_allocTracking(false);
+static std::atomic<qlonglong> g_allocCount(0);
+
+static inline bool isAllocTracking() { return g_allocTracking.load(std::memory_order_relaxed); }
+
+void * operator new(std::size_t size)
+{
+   if (! QX_BENCH_HOOK_MALLOC && isAllocTracking()) { g_allocCount.fetch_add(1, std::memory_order_relaxed); }
+   void * p = std::malloc(size ? size : 1);
+   if (! p) { throw std::bad_alloc(); }
+   return p;
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+   if (! QX_BENCH_HOOK_MALLOC && isAllocTracking()) { g_allocCount.fetch_add(1, std::memory_order_relaxed); }
+   return std::malloc(size ? size : 1);
+}
+
+void operator delete(void * p) noexcept { std::free(p); }
+void operator delete(void * p, const std::nothrow_t &) noexcept { std::free(p); }
+
+#if QX_BENCH_HOOK_MALLOC
+#include <malloc.h>
+
+// Heap bytes allocated minus heap bytes freed since heap_peak_reset() (only while tracking is enabled, so this can be negative)
+static std::atomic<qlonglong> g_heapBytes(0);
+static std::atomic<qlonglong> g_heapPeak(0);
+
+static inline void trackHeapAlloc(void * p)
+{
+   if (! p) { return; }
+   g_allocCount.fetch_add(1, std::memory_order_relaxed);
+   qlonglong lSize = static_cast<qlonglong>(malloc_usable_size(p));
+   qlonglong lBytes = (g_heapBytes.fetch_add(lSize, std::memory_order_relaxed) + lSize);
+   qlonglong lPeak = g_heapPeak.load(std::memory_order_relaxed);
+   while ((lBytes > lPeak) && (! g_heapPeak.compare_exchange_weak(lPeak, lBytes, std::memory_order_relaxed))) { ; }
+}
+
+static inline void trackHeapFree(void * p) { if (p && isAllocTracking()) { g_heapBytes.fetch_sub(static_cast<qlonglong>(malloc_usable_size(p)), std::memory_order_relaxed); } }
+
+extern "C" void * __libc_malloc(size_t size);
+extern "C" void * __libc_calloc(size_t n, size_t size);
+extern "C" void * __libc_realloc(void * p, size_t size);
+extern "C" void * __libc_memalign(size_t alignment, size_t size);
+extern "C" void __libc_free(void * p);
+extern "C" void * malloc(size_t size) { void * p = __libc_malloc(size); if (isAllocTracking()) { trackHeapAlloc(p); } return p; }
+extern "C" void * calloc(size_t n, size_t size) { void * p = __libc_calloc(n, size); if (isAllocTracking()) { trackHeapAlloc(p); } return p; }
+extern "C" void * memalign(size_t alignment, size_t size) { void * p = __libc_memalign(alignment, size); if (isAllocTracking()) { trackHeapAlloc(p); } return p; }
+extern "C" void * aligned_alloc(size_t alignment, size_t size) { return memalign(alignment, size); }
+extern "C" int posix_memalign(void ** pp, size_t alignment, size_t size) { void * p = memalign(alignment, size); if (! p) { return ENOMEM; } (* pp) = p; return 0; }
+extern "C" void free(void * p) { trackHeapFree(p); __libc_free(p); }
+extern "C" void * realloc(void * p, size_t size)
+{
+   if (! isAllocTracking()) { return __libc_realloc(p, size); }
+   qlonglong lOldSize = (p ? static_cast<qlonglong>(malloc_usable_size(p)) : 0);
+   void * q = __libc_realloc(p, size);
+   if (q || (size == 0)) { g_heapBytes.fetch_sub(lOldSize, std::memory_order_relaxed); trackHeapAlloc(q); } // If realloc fails, the original block is left untouched
+   return q;
+}
+#endif // QX_BENCH_HOOK_MALLOC
+
+namespace qx_bench {
+
+qlonglong alloc_count() { return g_allocCount.load(std::memory_order_relaxed); }
+
+void alloc_tracking(bool bEnabled) { g_allocTracking.store(bEnabled, std::memory_order_seq_cst); }
+
+#if QX_BENCH_HOOK_MALLOC
+qlonglong heap_peak_reset() { g_heapBytes.store(0, std::memory_order_relaxed); g_heapPeak.store(0, std::memory_order_relaxed); alloc_tracking(true); return 0; }
+qlonglong heap_peak() { alloc_tracking(false); return g_heapPeak.load(std::memory_order_relaxed); }
+#else // QX_BENCH_HOOK_MALLOC
+qlonglong heap_peak_reset() { return -1; }
+qlonglong heap_peak() { return -1; }
+#endif // QX_BENCH_HOOK_MALLOC
+
+void suite_alloc(runner & r)
+{
+   const long lRows = 1000;
+   if (! initBenchItemDatabase(":memory:", "", lRows)) { return; }
+
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   bool bRecycleBackup = qx::QxSqlDatabase::getSingleton()->getRecycleDaoHelper();
+   bool bMetricsBackup = qx::QxSqlDatabase::getSingleton()->getDaoMetrics();
+   for (int i = 0; i < 3; ++i)
+   {
+      bool bRecycle = (i >= 1); bool bMetrics = (i == 2);
+      qx::QxSqlDatabase::getSingleton()->setRecycleDaoHelper(bRecycle);
+      qx::QxSqlDatabase::getSingleton()->setDaoMetrics(bMetrics);
+      if (! bRecycle) { qx::dao::detail::IxDao_Recycler::clearCurrentThread(); }
+
+      bench_item item; long lCount = 0; int iErrors = 0;
+      auto fct = [&]() {
+         item.m_id = ((lCount++ * 7919) % lRows) + 1;
+         QSqlError daoError = qx::dao::fetch_by_id(item, (& db));
+         if (daoError.isValid()) { ++iErrors; }
+      };
+
+      result & res = r.measure(QString("fetch_by_id (recycle dao helper %1%2)").arg(bRecycle ? "on" : "off").arg(bMetrics ? ", dao metrics on" : ""), 50000, fct);
+      res.m_extra.insert("recycle_dao_helper", bRecycle);
+      res.m_extra.insert("dao_metrics", bMetrics);
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   qx::QxSqlDatabase::getSingleton()->setRecycleDaoHelper(bRecycleBackup);
+   qx::QxSqlDatabase::getSingleton()->setDaoMetrics(bMetricsBackup);
+   qx::QxDaoMetrics::getSingleton()->reset();
+
+   db = QSqlDatabase();
+   qx::QxSqlDatabase::closeAllDatabases();
+}
+
+} // namespace qx_bench
@@ -0,0 +1,83 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench.h"
+
+namespace qx_bench {
+
+#ifdef _QX_ENABLE_QT_NETWORK
+
+static QByteArray buildTextPayload(int iSize)
+{
+   // Looks like a serialized list of entities (lots of repeated field names and small values)
+   QByteArray data; data.reserve(iSize + 256); int i = 0;
+   while (data.size() < iSize)
+   {
+      data += "{\"author_id\":\"" + QByteArray::number(i % 997) + "\",\"name\":\"author_" + QByteArray::number(i) + "\",";
+      data += "\"birthdate\":\"19" + QByteArray::number(50 + (i % 50)) + "-0" + QByteArray::number(1 + (i % 9)) + "-1" + QByteArray::number(i % 10) + "\",\"sex\":" + QByteArray::number(i % 3) + "},";
+      ++i;
+   }
+   data.resize(iSize);
+   return data;
+}
+
+static QByteArray buildRandomPayload(int iSize)
+{
+   // Almost incompressible data (pseudo-random, deterministic)
+   QByteArray data(iSize, Qt::Uninitialized); quint32 seed = 12345;
+   for (int i = 0; i < iSize; ++i) { seed = ((seed * 1103515245U) + 12345U); data[i] = static_cast<char>((seed >> 16) & 0xFF); }
+   return data;
+}
+
+static void measureCodec(runner & r, const QString & sPayload, const QByteArray & data, quint8 uiCodecId, int iLevel, qlonglong lIterations)
+{
+   qx::service::QxCompression * pCompression = qx::service::QxCompression::getSingleton();
+   qx::service::IxCompressionCodec * pCodec = pCompression->getCodec(uiCodecId);
+   if (! pCodec) { return; }
+
+   QByteArray compressed, uncompressed;
+   if (! pCompression->compress(uiCodecId, data, compressed, iLevel)) { qDebug("[qxBenchmark] unable to compress data using codec '%s'", qPrintable(pCodec->getName())); return; }
+   double dRatio = ((compressed.size() > 0) ? (static_cast<double>(data.size()) / compressed.size()) : 0.0);
+   QString sCodec = pCodec->getName() + ((iLevel >= 0) ? QString("(%1)").arg(iLevel) : QString());
+   double dMB = (data.size() / (1024.0 * 1024.0));
+
+   result & rc = r.measure(QString("compress %1 %2").arg(sCodec, sPayload), lIterations, [&]() { compressed.clear(); pCompression->compress(uiCodecId, data, compressed, iLevel); });
+   rc.m_extra.insert("ratio", dRatio);
+   rc.m_extra.insert("MB_per_sec", (rc.m_ops_per_sec * dMB));
+
+   result & ru = r.measure(QString("uncompress %1 %2").arg(sCodec, sPayload), lIterations, [&]() { uncompressed.clear(); pCompression->uncompress(uiCodecId, compressed, uncompressed); });
+   ru.m_extra.insert("MB_per_sec", (ru.m_ops_per_sec * dMB));
+   if (uncompressed != data) { qDebug("[qxBenchmark] codec '%s' : uncompressed data differ from original data", qPrintable(pCodec->getName())); }
+}
+
+void suite_compression(runner & r)
+{
+   QList<QPair<QString, QByteArray> > lstPayload;
+   lstPayload.append(qMakePair(QString("text_4KB"), buildTextPayload(4 * 1024)));
+   lstPayload.append(qMakePair(QString("text_256KB"), buildTextPayload(256 * 1024)));
+   lstPayload.append(qMakePair(QString("text_4MB"), buildTextPayload(4 * 1024 * 1024)));
+   lstPayload.append(qMakePair(QString("random_256KB"), buildRandomPayload(256 * 1024)));
+
+   for (int i = 0; i < lstPayload.count(); ++i)
+   {
+      const QString & sPayload = lstPayload.at(i).first;
+      const QByteArray & data = lstPayload.at(i).second;
+      qlonglong lIterations = qMax(5, (64 * 1024 * 1024) / qMax(data.size(), 1) / 8);
+      lIterations = qMin(lIterations, static_cast<qlonglong>(2000));
+      measureCodec(r, sPayload, data, QX_SERVICE_COMPRESSION_ZLIB, 1, lIterations);
+      measureCodec(r, sPayload, data, QX_SERVICE_COMPRESSION_ZLIB, -1, lIterations);
+      measureCodec(r, sPayload, data, QX_SERVICE_COMPRESSION_ZLIB, 9, lIterations);
+      measureCodec(r, sPayload, data, QX_SERVICE_COMPRESSION_LZ4, -1, lIterations);
+   }
+}
+
+#else // _QX_ENABLE_QT_NETWORK
+
+void suite_compression(runner & r)
+{
+   Q_UNUSED(r);
+   qDebug("[qxBenchmark] %s", "suite 'compression' skipped : QxService module is not enabled (_QX_ENABLE_QT_NETWORK)");
+}
+
+#endif // _QX_ENABLE_QT_NETWORK
+
+} // namespace qx_bench
@@ -0,0 +1,65 @@
+#include "../include/precompiled.h"
+
+#include <QxCommon/QxSimpleCrypt.h>
+
+#include "../include/bench.h"
+
+namespace qx_bench {
+
+static QByteArray buildCryptPayload(int iSize)
+{
+   QByteArray data(iSize, Qt::Uninitialized); quint32 seed = 4242;
+   for (int i = 0; i < iSize; ++i) { seed = ((seed * 1103515245U) + 12345U); data[i] = static_cast<char>((seed >> 16) & 0xFF); }
+   return data;
+}
+
+static QByteArray legacyEncrypt(const QByteArray & plaintext, quint64 key)
+{
+   // Byte-wise algorithm used by previous versions of qx::QxSimpleCrypt (reference to compare throughput)
+   char keyParts[8]; for (int i = 0; i < 8; i++) { keyParts[i] = static_cast<char>((key >> (8 * i)) & 0xFF); }
+   QByteArray integrityProtection;
+   { QDataStream s(& integrityProtection, QIODevice::WriteOnly); s << qChecksum(plaintext.constData(), plaintext.length()); }
+   QByteArray ba = char(0) + integrityProtection + plaintext;
+   char lastChar = 0;
+   for (int pos = 0; pos < ba.count(); ++pos) { ba[pos] = ba.at(pos) ^ keyParts[pos % 8] ^ lastChar; lastChar = ba.at(pos); }
+   QByteArray resultArray; resultArray.append(char(0x03)); resultArray.append(char(0x02)); resultArray.append(ba);
+   return resultArray;
+}
+
+void suite_crypt(runner & r)
+{
+   const quint64 key = Q_UINT64_C(0x0c2ad4a4acb9f023);
+   QList<int> lstSize; lstSize << (64 * 1024) << (1024 * 1024) << (8 * 1024 * 1024);
+
+   Q_FOREACH(int iSize, lstSize)
+   {
+      QByteArray data = buildCryptPayload(iSize);
+      QString sPayload = ((iSize >= (1024 * 1024)) ? QString("%1MB").arg(iSize / (1024 * 1024)) : QString("%1KB").arg(iSize / 1024));
+      qlonglong lIterations = qBound(static_cast<qlonglong>(5), static_cast<qlonglong>((256 * 1024 * 1024) / iSize), static_cast<qlonglong>(2000));
+      double dGB = (iSize / (1024.0 * 1024.0 * 1024.0));
+
+      qx::QxSimpleCrypt crypto(key);
+      crypto.setCompressionMode(qx::QxSimpleCrypt::CompressionNever);
+      crypto.setIntegrityProtectionMode(qx::QxSimpleCrypt::ProtectionChecksum);
+      QByteArray encrypted = crypto.encryptToByteArray(data);
+      if (crypto.decryptToByteArray(legacyEncrypt(data, key)) != data) { qDebug("[qxBenchmark] %s", "qx::QxSimpleCrypt is not compatible with legacy format"); }
+
+      QByteArray tmp;
+      result & rl = r.measure("legacy byte-wise encrypt " + sPayload, lIterations, [&]() { tmp = legacyEncrypt(data, key); });
+      rl.m_extra.insert("GB_per_sec", (rl.m_ops_per_sec * dGB));
+
+      result & re = r.measure("encryptToByteArray " + sPayload, lIterations, [&]() { tmp = crypto.encryptToByteArray(data); });
+      re.m_extra.insert("GB_per_sec", (re.m_ops_per_sec * dGB));
+
+      result & rd = r.measure("decryptToByteArray " + sPayload, lIterations, [&]() { tmp = crypto.decryptToByteArray(encrypted); });
+      rd.m_extra.insert("GB_per_sec", (rd.m_ops_per_sec * dGB));
+      if (tmp != data) { qDebug("[qxBenchmark] %s", "qx::QxSimpleCrypt : decrypted data differ from original data"); }
+
+      QByteArray work = encrypted;
+      result & ri = r.measure("decryptInPlace " + sPayload, lIterations, [&]() { ::memcpy(work.data(), encrypted.constData(), static_cast<size_t>(encrypted.size())); tmp = crypto.decryptInPlace(work.data(), work.size()); });
+      ri.m_extra.insert("GB_per_sec", (ri.m_ops_per_sec * dGB));
+      ri.m_extra.insert("note", QString("includes a memcpy of the cypher text"));
+   }
+}
+
+} // namespace qx_bench
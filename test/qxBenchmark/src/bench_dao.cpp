@@ -0,0 +1,205 @@
+#include "../include/precompiled.h"
+
+#include <QtCore/qdir.h>
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+#include "../include/bench_relation.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+static bool checkDaoError(const QSqlError & daoError, const char * sContext)
+{
+   if (! daoError.isValid()) { return true; }
+   qDebug("[qxBenchmark] %s : %s", sContext, qPrintable(daoError.text()));
+   return false;
+}
+
+static bool initDaoDatabase(const QString & sDatabaseName)
+{
+   qx::QxSqlDatabase::closeAllDatabases();
+   if (! initBenchItemDatabase(sDatabaseName, "", 0)) { return false; }
+   if (! checkDaoError(qx::dao::create_table<bench_profile>(), "unable to create table")) { return false; }
+   if (! checkDaoError(qx::dao::create_table<bench_tag>(), "unable to create table")) { return false; }
+   if (! checkDaoError(qx::dao::create_table<bench_author>(), "unable to create table")) { return false; }
+   if (! checkDaoError(qx::dao::create_table<bench_book>(), "unable to create table")) { return false; }
+
+   // Many-to-many relationship table is not created by qx::dao::create_table<T>()
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   QSqlQuery query(db);
+   if (! query.exec("CREATE TABLE t_bench_book_tag (book_id INTEGER NOT NULL, tag_id INTEGER NOT NULL)")) { return checkDaoError(query.lastError(), "unable to create table"); }
+   return true;
+}
+
+// Reset table 't_bench_item' with lRows rows (ids from 1 to lRows)
+static bool populateDaoItems(long lRows)
+{
+   if (! checkDaoError(qx::dao::delete_all<bench_item>(), "unable to delete rows")) { return false; }
+   list_bench_item lst;
+   for (long l = 1; l <= lRows; ++l) { lst.insert(l, newBenchItem(l)); }
+   return checkDaoError(qx::dao::insert(lst), "unable to insert rows");
+}
+
+// 100 authors (each one with a profile), 1000 books (10 per author) and 50 tags (3 per book)
+static bool populateDaoRelations(long lAuthors, long lBooksPerAuthor, long lTags, long lTagsPerBook)
+{
+   QList<bench_profile_ptr> lstProfile; list_bench_author lstAuthor; list_bench_tag lstTag; list_bench_book lstBook;
+   for (long l = 1; l <= lTags; ++l) { bench_tag_ptr p = std::make_shared<bench_tag>(); p->m_id = l; p->m_name = QString("tag_%1").arg(l); lstTag.append(p); }
+   for (long l = 1; l <= lAuthors; ++l)
+   {
+      bench_author_ptr pAuthor = std::make_shared<bench_author>(); pAuthor->m_id = l; pAuthor->m_name = QString("author_%1").arg(l); lstAuthor.append(pAuthor);
+      bench_profile_ptr pProfile = std::make_shared<bench_profile>(); pProfile->m_id = l; pProfile->m_bio = QString("biography of author_%1").arg(l); lstProfile.append(pProfile);
+      for (long k = 1; k <= lBooksPerAuthor; ++k)
+      {
+         bench_book_ptr pBook = std::make_shared<bench_book>(); pBook->m_id = (((l - 1) * lBooksPerAuthor) + k);
+         pBook->m_title = QString("book_%1").arg(pBook->m_id); pBook->m_price = (k * 1.5); pBook->m_author = pAuthor;
+         for (long t = 0; t < lTagsPerBook; ++t) { pBook->m_tagX.append(lstTag.at(((pBook->m_id * 7) + t) % lTags)); }
+         lstBook.append(pBook);
+      }
+   }
+
+   if (! checkDaoError(qx::dao::insert(lstTag), "unable to insert tags")) { return false; }
+   if (! checkDaoError(qx::dao::insert(lstProfile), "unable to insert profiles")) { return false; }
+   if (! checkDaoError(qx::dao::insert(lstAuthor), "unable to insert authors")) { return false; }
+   return checkDaoError(qx::dao::insert_with_relation("list_tag", lstBook), "unable to insert books");
+}
+
+template <class T>
+static void measureDaoRelation(runner & r, const QString & sPrefix, const QString & sRelationType, const QString & sRelation, qlonglong lIterations)
+{
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   long lFetched = 0; int iErrors = 0;
+   auto fct = [&]() {
+      T lst;
+      QSqlError daoError = qx::dao::fetch_all_with_relation(sRelation, lst, (& db));
+      if (daoError.isValid()) { ++iErrors; }
+      lFetched = lst.count();
+   };
+   result & res = r.measure(QString("%1 fetch_all_with_relation (%2)").arg(sPrefix, sRelationType), lIterations, fct);
+   res.m_extra.insert("relation", sRelation);
+   res.m_extra.insert("rows", static_cast<qlonglong>(lFetched));
+   if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+}
+
+static void runDaoSuite(runner & r, const QString & sPrefix, const QString & sDatabaseName, double dFactor)
+{
+   if (! initDaoDatabase(sDatabaseName)) { return; }
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   auto iterations = [dFactor](qlonglong l) { qlonglong n = static_cast<qlonglong>(l * dFactor); return ((n > 0) ? n : 1); };
+   const long lRows = 1000;
+   long lNextId = 1;
+
+   // Single row operations use the connection of the thread (one implicit transaction per statement), containers are saved in a single transaction
+   {
+      int iErrors = 0;
+      auto fct = [&]() { bench_item_ptr p = newBenchItem(lNextId++, "single"); if (qx::dao::insert(p, (& db)).isValid()) { ++iErrors; } };
+      result & res = r.measure(QString("%1 insert (single)").arg(sPrefix), iterations(2000), fct);
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      const long lBatch = 100; int iErrors = 0;
+      auto fct = [&]() {
+         list_bench_item lst;
+         for (long l = 0; l < lBatch; ++l) { bench_item_ptr p = newBenchItem(lNextId++, "container"); lst.insert(p->m_id, p); }
+         if (qx::dao::insert(lst).isValid()) { ++iErrors; }
+      };
+      result & res = r.measure(QString("%1 insert (container)").arg(sPrefix), iterations(100), fct);
+      res.m_extra.insert("rows_per_op", static_cast<qlonglong>(lBatch));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+
+   if (! populateDaoItems(lRows)) { return; }
+   {
+      long lCountResult = 0; int iErrors = 0;
+      auto fct = [&]() { if (qx::dao::count<bench_item>(lCountResult, qx::QxSqlQuery(), (& db)).isValid()) { ++iErrors; } };
+      result & res = r.measure(QString("%1 count").arg(sPrefix), iterations(2000), fct);
+      res.m_extra.insert("rows", static_cast<qlonglong>(lCountResult));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      bench_item item; long lCount = 0; int iErrors = 0;
+      auto fct = [&]() {
+         item.m_id = ((lCount++ * 7919) % lRows) + 1;
+         if (qx::dao::fetch_by_id(item, (& db)).isValid()) { ++iErrors; }
+      };
+      result & res = r.measure(QString("%1 fetch_by_id").arg(sPrefix), iterations(10000), fct);
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      long lFetched = 0; int iErrors = 0;
+      auto fct = [&]() { list_bench_item lst; if (qx::dao::fetch_all(lst, (& db)).isValid()) { ++iErrors; } lFetched = lst.count(); };
+      result & res = r.measure(QString("%1 fetch_all (1k rows)").arg(sPrefix), iterations(100), fct);
+      res.m_extra.insert("rows", static_cast<qlonglong>(lFetched));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      qx::dao::ptr<bench_item> pItem = qx::dao::ptr<bench_item>(new bench_item()); long lCount = 0; int iErrors = 0;
+      pItem->m_id = 1; if (qx::dao::fetch_by_id(pItem, (& db)).isValid()) { ++iErrors; }
+      auto fct = [&]() {
+         pItem->m_quantity = static_cast<int>(lCount++ % 1000); // Only 1 column updated
+         if (qx::dao::update_optimized(pItem, (& db)).isValid()) { ++iErrors; }
+      };
+      result & res = r.measure(QString("%1 update_optimized (1 dirty column)").arg(sPrefix), iterations(2000), fct);
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      const long lBatch = 100; long lCount = 0; int iErrors = 0; lNextId = (lRows + 1);
+      auto fct = [&]() {
+         list_bench_item lst;
+         for (long l = 0; l < (lBatch / 2); ++l) { long lId = ((((lCount * lBatch) + l) * 7919) % lRows) + 1; if (! lst.exist(lId)) { lst.insert(lId, newBenchItem(lId, "saved")); } }
+         for (long l = 0; l < (lBatch / 2); ++l) { bench_item_ptr p = newBenchItem(lNextId++, "saved"); lst.insert(p->m_id, p); }
+         lCount++;
+         if (qx::dao::save(lst).isValid()) { ++iErrors; }
+      };
+      result & res = r.measure(QString("%1 save (50% new, 50% existing)").arg(sPrefix), iterations(100), fct);
+      res.m_extra.insert("rows_per_op", static_cast<qlonglong>(lBatch));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      // One bucket of rows per iteration (and warm-up) is inserted before measuring, so only the delete is measured
+      const long lBucket = 10; qlonglong lIterations = r.iterations(iterations(200)); int iErrors = 0; long lCount = 0;
+      list_bench_item lst;
+      for (qlonglong b = 0; b <= lIterations; ++b) { for (long l = 0; l < lBucket; ++l) { bench_item_ptr p = newBenchItem(lNextId++, QString("bucket_%1").arg(b)); lst.insert(p->m_id, p); } }
+      if (! checkDaoError(qx::dao::insert(lst), "unable to insert rows")) { return; }
+      auto fct = [&]() {
+         qx_query query; query.where("category").isEqualTo(QString("bucket_%1").arg(lCount++));
+         if (qx::dao::delete_by_query<bench_item>(query, (& db)).isValid()) { ++iErrors; }
+      };
+      result & res = r.measure(QString("%1 delete_by_query").arg(sPrefix), iterations(200), fct);
+      res.m_extra.insert("rows_per_op", static_cast<qlonglong>(lBucket));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+
+   if (! populateDaoItems(100000)) { return; }
+   {
+      long lFetched = 0; int iErrors = 0;
+      auto fct = [&]() { list_bench_item lst; if (qx::dao::fetch_all(lst, (& db)).isValid()) { ++iErrors; } lFetched = lst.count(); };
+      result & res = r.measure(QString("%1 fetch_all (100k rows)").arg(sPrefix), iterations(5), fct);
+      res.m_extra.insert("rows", static_cast<qlonglong>(lFetched));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   if (! populateDaoItems(0)) { return; }
+
+   if (! populateDaoRelations(100, 10, 50, 3)) { return; }
+   measureDaoRelation<list_bench_author>(r, sPrefix, "one-to-one", "profile", iterations(50));
+   measureDaoRelation<list_bench_author>(r, sPrefix, "one-to-many", "list_book", iterations(20));
+   measureDaoRelation<list_bench_book>(r, sPrefix, "many-to-one", "author_id", iterations(20));
+   measureDaoRelation<list_bench_book>(r, sPrefix, "many-to-many", "list_tag", iterations(20));
+}
+
+void suite_dao(runner & r)
+{
+   runDaoSuite(r, "[memory]", ":memory:", 1.0);
+   qx::QxSqlDatabase::closeAllDatabases();
+
+   // File database : each single row write is a disk transaction, so fewer iterations are done
+   QString sFile = QDir::temp().filePath("qxBenchmark_dao.sqlite");
+   QFile::remove(sFile);
+   runDaoSuite(r, "[file]", sFile, 0.25);
+   qx::QxSqlDatabase::closeAllDatabases();
+   QFile::remove(sFile);
+}
+
+} // namespace qx_bench
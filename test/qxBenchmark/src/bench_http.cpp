@@ -0,0 +1,382 @@
+#include "../include/precompiled.h"
+
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qthread.h>
+
+#ifdef _QX_ENABLE_QT_NETWORK
+#include <QtNetwork/qhostaddress.h>
+#include <QtNetwork/qtcpsocket.h>
+#endif // _QX_ENABLE_QT_NETWORK
+
+#ifdef Q_OS_LINUX
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif // Q_OS_LINUX
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+#include "../include/bench_http_item.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+#ifdef _QX_ENABLE_QT_NETWORK
+
+/*
+ * Settings of the 'http' suite (--param key=value command line parameter) :
+ *  - http.concurrency : list of client threads counts (default '1,8') ;
+ *  - http.keep_alive : list of connection modes, 'on' (one connection per client) and/or 'off' (one connection per request, default 'on,off') ;
+ *  - http.mix : list of request types, 'static' (static file), 'fetch_by_id' (small JSON), 'fetch_all' (large JSON), 'batch' (array of 10 fetch_by_id) and 'mixed' (all types, default all) ;
+ *  - http.payload : list of payload sizes in bytes, used for static file size and for 'payload' column of each row (default '64,4096') ;
+ *  - http.rows : count of rows in database, all fetched by 'fetch_all' requests (default 1000) ;
+ *  - http.server_threads : count of server threads (default max concurrency + 4 : a keep-alive connection holds a server thread) ;
+ *  - http.port : server port on loopback (default 9643).
+ * CPU time per thread is only available on Linux.
+ */
+
+struct http_client_stats
+{
+   QVector<qint64> m_samples;    //!< Latency of each request (in nanoseconds)
+   qlonglong m_lResponseBytes;   //!< Sum of response body sizes
+   int m_iErrors;                //!< Requests failed (network error or HTTP status different from 200)
+   qint64 m_iTid;                //!< Client thread id (Linux only)
+   qint64 m_iCpuNs;              //!< Client thread CPU time (Linux only)
+
+   http_client_stats() : m_lResponseBytes(0), m_iErrors(0), m_iTid(0), m_iCpuNs(0) { ; }
+};
+
+static qint64 currentThreadCpuNs()
+{
+#ifdef Q_OS_LINUX
+   struct timespec ts;
+   if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, (& ts)) == 0) { return ((static_cast<qint64>(ts.tv_sec) * 1000000000LL) + ts.tv_nsec); }
+#endif // Q_OS_LINUX
+   return 0;
+}
+
+static qint64 currentThreadId()
+{
+#ifdef Q_OS_LINUX
+   return static_cast<qint64>(syscall(SYS_gettid));
+#else // Q_OS_LINUX
+   return 0;
+#endif // Q_OS_LINUX
+}
+
+// CPU time (in nanoseconds) of each thread of the process, read from /proc/self/task/<tid>/stat (utime + stime)
+static QHash<qint64, qint64> allThreadsCpuNs()
+{
+   QHash<qint64, qint64> hash;
+#ifdef Q_OS_LINUX
+   long lTicksPerSec = sysconf(_SC_CLK_TCK); if (lTicksPerSec <= 0) { lTicksPerSec = 100; }
+   QStringList lstTask = QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+   Q_FOREACH(QString sTask, lstTask)
+   {
+      QFile file("/proc/self/task/" + sTask + "/stat");
+      if (! file.open(QIODevice::ReadOnly)) { continue; }
+      QByteArray stat = file.readAll(); int iPos = stat.lastIndexOf(')'); if (iPos < 0) { continue; }
+      QList<QByteArray> lstFields = stat.mid(iPos + 2).split(' '); // First field after thread name is state (3rd field of stat file)
+      if (lstFields.count() < 13) { continue; }
+      qint64 iTicks = (lstFields.at(11).toLongLong() + lstFields.at(12).toLongLong());
+      hash.insert(sTask.toLongLong(), ((iTicks * 1000000000LL) / lTicksPerSec));
+   }
+#endif // Q_OS_LINUX
+   return hash;
+}
+
+// Send a request and read the whole response (Content-Length, chunked or until connection closed)
+static bool sendHttpRequest(QTcpSocket & socket, quint16 iPort, const QByteArray & request, bool bKeepAlive, qlonglong & lResponseBytes)
+{
+   const int iTimeOut = 30000;
+   if (socket.state() != QAbstractSocket::ConnectedState)
+   {
+      socket.abort(); socket.connectToHost(QHostAddress(QHostAddress::LocalHost), iPort);
+      if (! socket.waitForConnected(iTimeOut)) { return false; }
+   }
+   socket.write(request);
+
+   QByteArray buffer; int iHeaderEnd = -1;
+   while ((iHeaderEnd = buffer.indexOf("\r\n\r\n")) < 0) { if (! socket.waitForReadyRead(iTimeOut)) { socket.abort(); return false; } buffer += socket.readAll(); }
+   QList<QByteArray> lstHeaders = buffer.left(iHeaderEnd).split('\n');
+   QList<QByteArray> lstStatus = lstHeaders.value(0).trimmed().split(' ');
+   int iStatus = lstStatus.value(1).toInt();
+   qlonglong lContentLength = -1; bool bChunked = false; bool bClose = (! bKeepAlive);
+   for (int i = 1; i < lstHeaders.count(); ++i)
+   {
+      QByteArray sHeader = lstHeaders.at(i).trimmed(); int iSep = sHeader.indexOf(':'); if (iSep <= 0) { continue; }
+      QByteArray sKey = sHeader.left(iSep).trimmed().toLower(); QByteArray sValue = sHeader.mid(iSep + 1).trimmed().toLower();
+      if (sKey == "content-length") { lContentLength = sValue.toLongLong(); }
+      else if ((sKey == "transfer-encoding") && sValue.contains("chunked")) { bChunked = true; }
+      else if ((sKey == "connection") && (sValue == "close")) { bClose = true; }
+   }
+
+   QByteArray body = buffer.mid(iHeaderEnd + 4); bool bOk = true;
+   if (bChunked)
+   {
+      QByteArray data; int iPos = 0;
+      while (bOk)
+      {
+         int iLineEnd = body.indexOf("\r\n", iPos);
+         if (iLineEnd < 0) { bOk = socket.waitForReadyRead(iTimeOut); body += socket.readAll(); continue; }
+         qlonglong lChunkSize = body.mid(iPos, (iLineEnd - iPos)).trimmed().toLongLong(NULL, 16);
+         while (bOk && (body.size() < (iLineEnd + 2 + lChunkSize + 2))) { bOk = socket.waitForReadyRead(iTimeOut); body += socket.readAll(); }
+         if (! bOk) { break; }
+         if (lChunkSize == 0) { break; }
+         data += body.mid(iLineEnd + 2, lChunkSize); iPos = static_cast<int>(iLineEnd + 2 + lChunkSize + 2);
+      }
+      body = data;
+   }
+   else if (lContentLength >= 0) { while (bOk && (body.size() < lContentLength)) { bOk = socket.waitForReadyRead(iTimeOut); body += socket.readAll(); } }
+   else { while (socket.waitForReadyRead(iTimeOut)) { body += socket.readAll(); } bClose = true; }
+
+   lResponseBytes += body.size();
+   if (bClose || ! bOk) { socket.abort(); }
+   return (bOk && (iStatus == 200));
+}
+
+static QByteArray buildPostRequest(const QByteArray & json, bool bKeepAlive)
+{
+   QByteArray request = "POST /qx HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Type: application/json\r\n";
+   request += "Content-Length: " + QByteArray::number(json.size()) + "\r\n";
+   request += (bKeepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n");
+   return (request + json);
+}
+
+static QByteArray buildFetchByIdJson(long lId)
+{
+   return ("{\"request_id\":\"" + QByteArray::number(static_cast<qlonglong>(lId)) + "\",\"action\":\"fetch_by_id\",\"entity\":\"bench_http_item\",\"data\":{\"item_id\":" + QByteArray::number(static_cast<qlonglong>(lId)) + "}}");
+}
+
+static QByteArray buildHttpRequest(const QString & sType, qlonglong lIndex, long lRows, int iPayload, bool bKeepAlive)
+{
+   QString sRequestType = sType;
+   if (sRequestType == "mixed")
+   {
+      // 60% fetch_by_id, 20% static file, 10% batch, 10% fetch_all
+      int iSlot = static_cast<int>(lIndex % 10);
+      sRequestType = ((iSlot < 6) ? QString("fetch_by_id") : ((iSlot < 8) ? QString("static") : ((iSlot == 8) ? QString("batch") : QString("fetch_all"))));
+   }
+
+   long lId = static_cast<long>(((lIndex * 7919) % lRows) + 1);
+   if (sRequestType == "static")
+   {
+      QByteArray request = "GET /files/bench_" + QByteArray::number(iPayload) + ".bin HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+      return (request + (bKeepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n"));
+   }
+   else if (sRequestType == "fetch_all") { return buildPostRequest("{\"request_id\":\"all\",\"action\":\"fetch_all\",\"entity\":\"bench_http_item\"}", bKeepAlive); }
+   else if (sRequestType == "batch")
+   {
+      QByteArray json = "[";
+      for (long l = 0; l < 10; ++l) { json += ((l > 0) ? "," : "") + buildFetchByIdJson(((lId + l - 1) % lRows) + 1); }
+      return buildPostRequest((json + "]"), bKeepAlive);
+   }
+   return buildPostRequest(buildFetchByIdJson(lId), bKeepAlive);
+}
+
+static qlonglong baseRequestCount(const QString & sType)
+{
+   if (sType == "fetch_all") { return 50; }
+   else if (sType == "batch") { return 1000; }
+   else if (sType == "mixed") { return 1000; }
+   return 4000;
+}
+
+static bool initHttpDatabase(long lRows, int iPayload)
+{
+   QSqlError daoError = qx::dao::delete_all<bench_http_item>();
+   if (daoError.isValid()) { qDebug("[qxBenchmark] unable to delete rows : %s", qPrintable(daoError.text())); return false; }
+
+   list_bench_http_item lst;
+   for (long l = 1; l <= lRows; ++l)
+   {
+      bench_http_item_ptr p = std::make_shared<bench_http_item>();
+      p->m_id = l; p->m_name = QString("item_%1").arg(l); p->m_category = QString("category_%1").arg(l % 16);
+      p->m_price = (l * 0.25); p->m_payload = QString(iPayload, QLatin1Char(static_cast<char>('a' + (l % 26))));
+      lst.insert(l, p);
+   }
+   daoError = qx::dao::insert(lst);
+   if (daoError.isValid()) { qDebug("[qxBenchmark] unable to insert rows : %s", qPrintable(daoError.text())); return false; }
+   return true;
+}
+
+static bool waitForHttpServer(quint16 iPort)
+{
+   QElapsedTimer timer; timer.start();
+   while (timer.elapsed() < 10000)
+   {
+      QCoreApplication::processEvents();
+      QTcpSocket socket; socket.connectToHost(QHostAddress(QHostAddress::LocalHost), iPort);
+      if (socket.waitForConnected(100)) { socket.abort(); return true; }
+   }
+   return false;
+}
+
+static void runHttpScenario(runner & r, const QString & sType, int iConcurrency, bool bKeepAlive, int iPayload, long lRows, quint16 iPort)
+{
+   qlonglong lTotal = r.iterations(baseRequestCount(sType));
+   QVector<http_client_stats> lstStats(iConcurrency);
+   QAtomicInt iNextRequest(0); QAtomicInt iClientsDone(0);
+   QHash<qint64, qint64> cpuBefore = allThreadsCpuNs();
+   qlonglong lAllocBefore = alloc_count();
+   if (r.getCountAllocs()) { alloc_tracking(true); }
+   QElapsedTimer total; total.start();
+
+   std::vector<std::thread> lstThreads;
+   for (int t = 0; t < iConcurrency; ++t)
+   {
+      lstThreads.push_back(std::thread([&, t]() {
+         http_client_stats & stats = lstStats[t];
+         stats.m_iTid = currentThreadId(); qint64 iCpuStart = currentThreadCpuNs();
+         stats.m_samples.reserve(static_cast<int>(lTotal / iConcurrency) + 1);
+         QTcpSocket socket; QElapsedTimer timer;
+         while (true)
+         {
+            qlonglong lIndex = iNextRequest.fetchAndAddRelaxed(1); if (lIndex >= lTotal) { break; }
+            QByteArray request = buildHttpRequest(sType, lIndex, lRows, iPayload, bKeepAlive);
+            timer.start();
+            bool bOk = sendHttpRequest(socket, iPort, request, bKeepAlive, stats.m_lResponseBytes);
+            stats.m_samples.append(timer.nsecsElapsed());
+            if (! bOk) { stats.m_iErrors++; }
+         }
+         socket.abort();
+         stats.m_iCpuNs = (currentThreadCpuNs() - iCpuStart);
+         iClientsDone.fetchAndAddRelease(1);
+      }));
+   }
+
+   // Server signals are queued to the main thread : process them while clients are running
+   while (iClientsDone.loadAcquire() < iConcurrency) { QCoreApplication::processEvents(); QThread::msleep(1); }
+   for (std::thread & th : lstThreads) { th.join(); }
+   qint64 iTotalNs = total.nsecsElapsed();
+   if (r.getCountAllocs()) { alloc_tracking(false); }
+   qlonglong lAllocAfter = alloc_count();
+   QHash<qint64, qint64> cpuAfter = allThreadsCpuNs();
+
+   QVector<qint64> samples; qlonglong lResponseBytes = 0; int iErrors = 0; qint64 iClientCpuNs = 0; QSet<qint64> setClientTid;
+   for (int t = 0; t < lstStats.count(); ++t)
+   {
+      const http_client_stats & stats = lstStats.at(t);
+      samples += stats.m_samples; lResponseBytes += stats.m_lResponseBytes; iErrors += stats.m_iErrors;
+      iClientCpuNs += stats.m_iCpuNs; setClientTid.insert(stats.m_iTid);
+   }
+
+   QString sName = QString("%1 payload=%2 clients=%3 keep-alive=%4").arg(sType).arg(iPayload).arg(iConcurrency).arg(bKeepAlive ? "on" : "off");
+   result & res = r.add(sName, samples, iTotalNs);
+   res.m_allocs_per_op = ((! r.getCountAllocs()) ? -1.0 : (samples.isEmpty() ? 0.0 : (static_cast<double>(lAllocAfter - lAllocBefore) / samples.count()))); // Client and server sides (-1 : not measured)
+   res.m_extra.insert("request_type", sType);
+   res.m_extra.insert("payload_bytes", iPayload);
+   res.m_extra.insert("concurrency", iConcurrency);
+   res.m_extra.insert("keep_alive", bKeepAlive);
+   res.m_extra.insert("response_bytes_per_request", (samples.isEmpty() ? 0.0 : (static_cast<double>(lResponseBytes) / samples.count())));
+   if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+
+   if (! cpuAfter.isEmpty() && ! samples.isEmpty())
+   {
+      // Server side : all threads of the process except client threads (worker threads, server thread and main thread)
+      QList<qint64> lstServerCpuNs; qint64 iServerCpuNs = 0;
+      QHashIterator<qint64, qint64> itr(cpuAfter);
+      while (itr.hasNext())
+      {
+         itr.next(); if (setClientTid.contains(itr.key())) { continue; }
+         qint64 iDelta = (itr.value() - cpuBefore.value(itr.key(), 0)); if (iDelta <= 0) { continue; }
+         lstServerCpuNs.append(iDelta); iServerCpuNs += iDelta;
+      }
+      std::sort(lstServerCpuNs.begin(), lstServerCpuNs.end(), std::greater<qint64>());
+      QVariantList lstServerCpuMs; Q_FOREACH(qint64 iCpuNs, lstServerCpuNs) { lstServerCpuMs.append(iCpuNs / 1000000.0); }
+      res.m_extra.insert("client_cpu_us_per_request", ((iClientCpuNs / 1000.0) / samples.count()));
+      res.m_extra.insert("client_cpu_ms_per_thread", ((iClientCpuNs / 1000000.0) / iConcurrency));
+      res.m_extra.insert("server_cpu_us_per_request", ((iServerCpuNs / 1000.0) / samples.count()));
+      res.m_extra.insert("server_threads_busy", lstServerCpuNs.count());
+      res.m_extra.insert("server_cpu_ms_by_thread", lstServerCpuMs);
+   }
+}
+
+static QList<int> toIntList(const QString & s)
+{
+   QList<int> lst;
+   Q_FOREACH(QString sValue, s.split(',', QString::SkipEmptyParts)) { bool bOk = false; int i = sValue.trimmed().toInt(& bOk); if (bOk && (i > 0)) { lst.append(i); } }
+   return lst;
+}
+
+void suite_http(runner & r)
+{
+   QList<int> lstConcurrency = toIntList(r.param("http.concurrency", "1,8"));
+   QList<int> lstPayload = toIntList(r.param("http.payload", "64,4096"));
+   QStringList lstKeepAlive = r.param("http.keep_alive", "on,off").split(',', QString::SkipEmptyParts);
+   QStringList lstMix = r.param("http.mix", "static,fetch_by_id,fetch_all,batch,mixed").split(',', QString::SkipEmptyParts);
+   long lRows = r.param("http.rows", "1000").toLong(); if (lRows <= 0) { lRows = 1000; }
+   quint16 iPort = static_cast<quint16>(r.param("http.port", "9643").toUInt());
+   int iMaxConcurrency = 1; Q_FOREACH(int i, lstConcurrency) { iMaxConcurrency = qMax(iMaxConcurrency, i); }
+   int iServerThreads = r.param("http.server_threads", QString::number(iMaxConcurrency + 4)).toInt();
+   r.setCountAllocs(r.param("http.count_allocs", "off") == "on"); // Client and server threads would all update the same allocation counters
+
+   // Shared in-memory SQLite database : each server thread gets its own connection (managed by qx::QxSqlDatabase) to the same data
+   setBenchDatabase("file:qx_bench_http?mode=memory&cache=shared", "QSQLITE_OPEN_URI;QSQLITE_ENABLE_SHARED_CACHE");
+   QSqlDatabase dbKeepAlive = qx::QxSqlDatabase::getDatabase(); // In-memory database is destroyed when last connection is closed
+   QSqlError daoError = qx::dao::create_table<bench_http_item>();
+   if (daoError.isValid()) { qDebug("[qxBenchmark] unable to create table : %s", qPrintable(daoError.text())); return; }
+
+   // Static files : <temp>/qxBenchmark_http/files/bench_<payload>.bin
+   QDir dirRoot(QDir::temp().filePath("qxBenchmark_http")); dirRoot.mkpath("files");
+   Q_FOREACH(int iPayload, lstPayload)
+   {
+      QFile file(dirRoot.filePath(QString("files/bench_%1.bin").arg(iPayload)));
+      if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { file.write(QByteArray(iPayload, 'x')); }
+   }
+
+   qx::service::QxConnect * pSettings = qx::service::QxConnect::getSingleton();
+   pSettings->setPort(iPort);
+   pSettings->setThreadCount(iServerThreads);
+   pSettings->setKeepAlive(5000);
+   pSettings->setCompressData(false);
+
+   QString sServerPath = dirRoot.absolutePath();
+   qx::QxHttpServer httpServer;
+   httpServer.dispatch("GET", "/files/*", [sServerPath](qx::QxHttpRequest & request, qx::QxHttpResponse & response) {
+      qx::QxHttpServer::buildResponseStaticFile(request, response, sServerPath);
+   });
+   httpServer.dispatch("POST", "/qx", [](qx::QxHttpRequest & request, qx::QxHttpResponse & response) {
+      qx::QxHttpServer::buildResponseQxRestApi(request, response);
+   });
+   httpServer.startServer();
+   if (! waitForHttpServer(iPort)) { qDebug("[qxBenchmark] unable to start HTTP server on port %d", static_cast<int>(iPort)); httpServer.stopServer(); return; }
+
+   Q_FOREACH(int iPayload, lstPayload)
+   {
+      if (! initHttpDatabase(lRows, iPayload)) { break; }
+      Q_FOREACH(QString sType, lstMix)
+      {
+         sType = sType.trimmed();
+         Q_FOREACH(QString sKeepAlive, lstKeepAlive)
+         {
+            bool bKeepAlive = (sKeepAlive.trimmed() == "on");
+            Q_FOREACH(int iConcurrency, lstConcurrency) { runHttpScenario(r, sType, iConcurrency, bKeepAlive, iPayload, lRows, iPort); }
+         }
+      }
+   }
+
+   httpServer.stopServer();
+   QCoreApplication::processEvents();
+   dirRoot.removeRecursively();
+   dbKeepAlive = QSqlDatabase();
+   qx::QxSqlDatabase::closeAllDatabases();
+}
+
+#else // _QX_ENABLE_QT_NETWORK
+
+void suite_http(runner & r)
+{
+   Q_UNUSED(r);
+   qDebug("[qxBenchmark] %s", "suite 'http' skipped : QxHttpServer module is not enabled (_QX_ENABLE_QT_NETWORK)");
+}
+
+#endif // _QX_ENABLE_QT_NETWORK
+
+} // namespace qx_bench
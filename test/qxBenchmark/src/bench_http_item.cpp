@@ -0,0 +1,21 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench_http_item.h"
+
+#include <QxOrm_Impl.h>
+
+QX_REGISTER_CPP_QX_BENCHMARK(bench_http_item)
+QX_PERSISTABLE_CPP(bench_http_item)
+
+namespace qx {
+template <> void register_class(QxClass<bench_http_item> & t)
+{
+   t.setName("t_bench_http_item");
+
+   t.id(& bench_http_item::m_id, "item_id");
+
+   t.data(& bench_http_item::m_name, "name");
+   t.data(& bench_http_item::m_category, "category");
+   t.data(& bench_http_item::m_price, "price");
+   t.data(& bench_http_item::m_payload, "payload");
+}}
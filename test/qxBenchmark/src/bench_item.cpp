@@ -0,0 +1,61 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+QX_REGISTER_CPP_QX_BENCHMARK(bench_item)
+
+namespace qx {
+template <> void register_class(QxClass<bench_item> & t)
+{
+   t.setName("t_bench_item");
+
+   t.id(& bench_item::m_id, "item_id");
+
+   t.data(& bench_item::m_name, "name");
+   t.data(& bench_item::m_category, "category");
+   t.data(& bench_item::m_price, "price");
+   t.data(& bench_item::m_quantity, "quantity");
+   t.data(& bench_item::m_updated, "updated");
+}}
+
+namespace qx_bench {
+
+void setBenchDatabase(const QString & sDatabaseName, const QString & sConnectOptions)
+{
+   qx::QxSqlDatabase::getSingleton()->setDriverName("QSQLITE");
+   qx::QxSqlDatabase::getSingleton()->setConnectOptions(sConnectOptions);
+   qx::QxSqlDatabase::getSingleton()->setDatabaseName(sDatabaseName);
+   qx::QxSqlDatabase::getSingleton()->setTraceSqlQuery(false);
+   qx::QxSqlDatabase::getSingleton()->setTraceSqlRecord(false);
+}
+
+bench_item_ptr newBenchItem(long lId)
+{
+   return newBenchItem(lId, QString("category_%1").arg(lId % 16));
+}
+
+bench_item_ptr newBenchItem(long lId, const QString & sCategory)
+{
+   bench_item_ptr p = std::make_shared<bench_item>();
+   p->m_id = lId; p->m_name = QString("item_%1").arg(lId); p->m_category = sCategory;
+   p->m_price = (lId * 0.25); p->m_quantity = static_cast<int>(lId % 100); p->m_updated = QDateTime::currentDateTime();
+   return p;
+}
+
+bool initBenchItemDatabase(const QString & sDatabaseName, const QString & sConnectOptions, long lRows, const std::function<bench_item_ptr (long)> & fctNewItem)
+{
+   setBenchDatabase(sDatabaseName, sConnectOptions);
+   QSqlError daoError = qx::dao::create_table<bench_item>();
+   if (daoError.isValid()) { qDebug("[qxBenchmark] unable to create table : %s", qPrintable(daoError.text())); return false; }
+   if (lRows <= 0) { return true; }
+
+   list_bench_item lst;
+   for (long l = 1; l <= lRows; ++l) { lst.insert(l, (fctNewItem ? fctNewItem(l) : newBenchItem(l))); }
+   daoError = qx::dao::insert(lst);
+   if (daoError.isValid()) { qDebug("[qxBenchmark] unable to insert rows : %s", qPrintable(daoError.text())); return false; }
+   return true;
+}
+
+} // namespace qx_bench
@@ -0,0 +1,61 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+static int countMismatch(const list_bench_item & lst1, const list_bench_item & lst2)
+{
+   if (lst1.count() != lst2.count()) { return static_cast<int>(qAbs(lst1.count() - lst2.count())); }
+   int iMismatch = 0;
+   for (long l = 0; l < lst1.count(); ++l) { if (lst1.getByIndex(l)->m_id != lst2.getByIndex(l)->m_id) { ++iMismatch; } }
+   return iMismatch;
+}
+
+void suite_parallel(runner & r)
+{
+   const long lRows = 50000;
+   r.setCountAllocs(r.param("parallel.count_allocs", "off") == "on"); // Worker threads would all update the same allocation counters
+   QString sFileName = QDir::temp().filePath("qx_bench_parallel.sqlite");
+   // Parallel fetch clones the connection for each worker thread : use a SQLite file (an in-memory database would be empty for other connections)
+   // Prices are shuffled, so rows ordered by price are not ordered by id
+   QFile::remove(sFileName);
+   if (! initBenchItemDatabase(sFileName, "", lRows, [lRows](long l) { bench_item_ptr p = newBenchItem(l); p->m_price = (((l * 7919) % lRows) * 0.25); return p; })) { return; }
+
+   // Ordered by primary key (parts are appended) and by another column (parts are merged)
+   QList<qx::QxSqlQuery> lstQuery;
+   lstQuery.append(qx::QxSqlQuery().where("quantity").isGreaterThanOrEqualTo(10).orderAsc("item_id"));
+   lstQuery.append(qx::QxSqlQuery().where("quantity").isGreaterThanOrEqualTo(10).orderDesc("price"));
+   QStringList lstQueryName = QStringList() << "order by id" << "order by price";
+
+   for (int q = 0; q < lstQuery.count(); ++q)
+   {
+      list_bench_item lstReference; int iErrors = 0;
+      r.measure(QString("fetch_by_query (%1, sequential)").arg(lstQueryName.at(q)), 10, [&]() {
+         QSqlError daoError = qx::dao::fetch_by_query(lstQuery.at(q), lstReference);
+         if (daoError.isValid()) { ++iErrors; }
+      }).m_extra.insert("rows", static_cast<qlonglong>(lstReference.count()));
+
+      QList<int> lstPartitions = QList<int>() << 1 << 2 << 4 << 8;
+      for (int iPartitions : lstPartitions)
+      {
+         list_bench_item lst;
+         result & res = r.measure(QString("fetch_by_query_parallel (%1, %2 partitions)").arg(lstQueryName.at(q)).arg(iPartitions), 10, [&]() {
+            QSqlError daoError = qx::dao::fetch_by_query_parallel(lstQuery.at(q), lst, qx::dao::parallel_fetch(iPartitions));
+            if (daoError.isValid()) { ++iErrors; }
+         });
+         res.m_extra.insert("partitions", iPartitions);
+         res.m_extra.insert("rows", static_cast<qlonglong>(lst.count()));
+         res.m_extra.insert("order_mismatch", countMismatch(lstReference, lst));
+         if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+      }
+   }
+
+   qx::QxSqlDatabase::closeAllDatabases();
+   QFile::remove(sFileName);
+}
+
+} // namespace qx_bench
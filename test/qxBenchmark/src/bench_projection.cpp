@@ -0,0 +1,50 @@
+#include "../include/precompiled.h"
+
+#include <tuple>
+#include <vector>
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+void suite_projection(runner & r)
+{
+   const long lRows = 10000;
+   if (! initBenchItemDatabase(":memory:", "", lRows)) { return; }
+
+   // Simulate a dropdown endpoint : read (id, name) of all rows
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   QStringList columns = QStringList() << "item_id" << "name";
+   {
+      long lFetched = 0; int iErrors = 0;
+      auto fct = [&]() {
+         list_bench_item lst;
+         QSqlError daoError = qx::dao::fetch_all(lst, (& db), columns);
+         if (daoError.isValid()) { ++iErrors; }
+         lFetched = lst.count();
+      };
+      result & res = r.measure("fetch_all (entities, 2 columns)", 50, fct);
+      res.m_extra.insert("rows", static_cast<qlonglong>(lFetched));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+   {
+      long lFetched = 0; int iErrors = 0;
+      auto fct = [&]() {
+         std::vector< std::tuple<long, QString> > rows;
+         QSqlError daoError = qx::dao::fetch_projection<bench_item>(columns, rows, (& db));
+         if (daoError.isValid()) { ++iErrors; }
+         lFetched = static_cast<long>(rows.size());
+      };
+      result & res = r.measure("fetch_projection (tuples, 2 columns)", 50, fct);
+      res.m_extra.insert("rows", static_cast<qlonglong>(lFetched));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+
+   db = QSqlDatabase();
+   qx::QxSqlDatabase::closeAllDatabases();
+}
+
+} // namespace qx_bench
@@ -0,0 +1,57 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench_relation.h"
+
+#include <QxOrm_Impl.h>
+
+QX_REGISTER_CPP_QX_BENCHMARK(bench_profile)
+QX_REGISTER_CPP_QX_BENCHMARK(bench_tag)
+QX_REGISTER_CPP_QX_BENCHMARK(bench_author)
+QX_REGISTER_CPP_QX_BENCHMARK(bench_book)
+
+namespace qx {
+template <> void register_class(QxClass<bench_profile> & t)
+{
+   t.setName("t_bench_profile");
+
+   t.id(& bench_profile::m_id, "profile_id");
+
+   t.data(& bench_profile::m_bio, "bio");
+}}
+
+namespace qx {
+template <> void register_class(QxClass<bench_tag> & t)
+{
+   t.setName("t_bench_tag");
+
+   t.id(& bench_tag::m_id, "tag_id");
+
+   t.data(& bench_tag::m_name, "name");
+}}
+
+namespace qx {
+template <> void register_class(QxClass<bench_author> & t)
+{
+   t.setName("t_bench_author");
+
+   t.id(& bench_author::m_id, "author_id");
+
+   t.data(& bench_author::m_name, "name");
+
+   t.relationOneToOne(& bench_author::m_profile, "profile");
+   t.relationOneToMany(& bench_author::m_bookX, "list_book", "author_id");
+}}
+
+namespace qx {
+template <> void register_class(QxClass<bench_book> & t)
+{
+   t.setName("t_bench_book");
+
+   t.id(& bench_book::m_id, "book_id");
+
+   t.data(& bench_book::m_title, "title");
+   t.data(& bench_book::m_price, "price");
+
+   t.relationManyToOne(& bench_book::m_author, "author_id");
+   t.relationManyToMany(& bench_book::m_tagX, "list_tag", "t_bench_book_tag", "book_id", "tag_id");
+}}
@@ -0,0 +1,179 @@
+#include "../include/precompiled.h"
+
+#include <functional>
+#include <string>
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+#include "../include/bench_relation.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+/*!
+ * One serialization engine : m_sType is the name of the matching qx::service::QxConnect::serialization_type value (engine used by qx::service::QxTools::writeSocket()).
+ * Boost archives write into an owner string (std::string or std::wstring) referenced by the output QByteArray, so the owner must live as long as the output.
+ */
+template <class T>
+struct serialization_engine
+{
+   typedef std::function<QByteArray (const T &, std::string &, std::wstring &)> type_fct_save;
+   typedef std::function<bool (T &, const QByteArray &)> type_fct_load;
+
+   QString        m_sType;
+   type_fct_save  m_fctSave;
+   type_fct_load  m_fctLoad;
+};
+
+#define QX_BENCH_SERIALIZATION_ENGINE(type, save, load) \
+lst.append(serialization_engine<T>{ QString(type), \
+           [](const T & t, std::string & owner, std::wstring & w_owner) -> QByteArray { Q_UNUSED(owner); Q_UNUSED(w_owner); return save; }, \
+           [](T & t, const QByteArray & data) -> bool { return static_cast<bool>(load); } });
+
+template <class T>
+static QList< serialization_engine<T> > getSerializationEngines()
+{
+   QList< serialization_engine<T> > lst;
+#if _QX_SERIALIZE_BINARY
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_binary", qx::serialization::binary::to_byte_array(t, (& owner)), qx::serialization::binary::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_BINARY
+#if _QX_SERIALIZE_XML
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_xml", qx::serialization::xml::to_byte_array(t, (& owner)), qx::serialization::xml::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_XML
+#if _QX_SERIALIZE_TEXT
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_text", qx::serialization::text::to_byte_array(t, (& owner)), qx::serialization::text::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_TEXT
+#if _QX_SERIALIZE_PORTABLE_BINARY
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_portable_binary", qx::serialization::portable_binary::to_byte_array(t, (& owner), 0), qx::serialization::portable_binary::from_byte_array(t, data, 0))
+#endif // _QX_SERIALIZE_PORTABLE_BINARY
+#if _QX_SERIALIZE_WIDE_BINARY
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_wide_binary", qx::serialization::wide::binary::to_byte_array(t, (& w_owner)), qx::serialization::wide::binary::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_WIDE_BINARY
+#if _QX_SERIALIZE_WIDE_XML
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_wide_xml", qx::serialization::wide::xml::to_byte_array(t, (& w_owner)), qx::serialization::wide::xml::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_WIDE_XML
+#if _QX_SERIALIZE_WIDE_TEXT
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_wide_text", qx::serialization::wide::text::to_byte_array(t, (& w_owner)), qx::serialization::wide::text::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_WIDE_TEXT
+#if _QX_SERIALIZE_POLYMORPHIC
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_polymorphic_binary", qx::serialization::polymorphic_binary::to_byte_array(t, (& owner)), qx::serialization::polymorphic_binary::from_byte_array(t, data))
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_polymorphic_xml", qx::serialization::polymorphic_xml::to_byte_array(t, (& owner)), qx::serialization::polymorphic_xml::from_byte_array(t, data))
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_polymorphic_text", qx::serialization::polymorphic_text::to_byte_array(t, (& owner)), qx::serialization::polymorphic_text::from_byte_array(t, data))
+#endif // _QX_SERIALIZE_POLYMORPHIC
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_qt", qx::serialization::qt::to_byte_array(t), qx::serialization::qt::from_byte_array(t, data))
+#ifndef _QX_NO_JSON
+   QX_BENCH_SERIALIZATION_ENGINE("serialization_json", qx::serialization::json::to_byte_array(t), qx::serialization::json::from_byte_array(t, data))
+#endif // _QX_NO_JSON
+   return lst;
+}
+
+#undef QX_BENCH_SERIALIZATION_ENGINE
+
+static bench_item_ptr newSerializedItem(long lId)
+{
+   bench_item_ptr p = std::make_shared<bench_item>();
+   p->m_id = lId; p->m_name = QString("item_%1").arg(lId); p->m_category = QString("category_%1").arg(lId % 16);
+   p->m_price = (lId * 0.25); p->m_quantity = static_cast<int>(lId % 100); p->m_updated = QDateTime(QDate(2020, 1, 1), QTime(12, 0, 0)).addSecs(lId);
+   return p;
+}
+
+// 10 authors, each one with a profile and 10 books, each book with 3 tags : tags are new instances per book, or shared by all books (pool of 5 tags)
+static list_bench_author buildAuthorGraph(bool bSharedTags)
+{
+   list_bench_author lst; list_bench_tag lstTagPool;
+   for (long l = 1; l <= 5; ++l) { bench_tag_ptr p = std::make_shared<bench_tag>(); p->m_id = l; p->m_name = QString("tag_%1").arg(l); lstTagPool.append(p); }
+   for (long l = 1; l <= 10; ++l)
+   {
+      bench_author_ptr pAuthor = std::make_shared<bench_author>(); pAuthor->m_id = l; pAuthor->m_name = QString("author_%1").arg(l);
+      pAuthor->m_profile = std::make_shared<bench_profile>(); pAuthor->m_profile->m_id = l; pAuthor->m_profile->m_bio = QString("biography of author_%1").arg(l);
+      for (long k = 1; k <= 10; ++k)
+      {
+         bench_book_ptr pBook = std::make_shared<bench_book>(); pBook->m_id = (((l - 1) * 10) + k);
+         pBook->m_title = QString("book_%1").arg(pBook->m_id); pBook->m_price = (k * 1.5); // No back pointer to the author (no cycle in the graph)
+         for (long t = 0; t < 3; ++t)
+         {
+            bench_tag_ptr pTag = lstTagPool.at((pBook->m_id + t) % lstTagPool.count());
+            if (! bSharedTags) { bench_tag_ptr pCopy = std::make_shared<bench_tag>(* pTag); pTag = pCopy; }
+            pBook->m_tagX.append(pTag);
+         }
+         pAuthor->m_bookX.append(pBook);
+      }
+      lst.append(pAuthor);
+   }
+   return lst;
+}
+
+// Heap bytes peak (above heap bytes in use before the call) reached while executing fct once, -1 if not available
+template <typename T_Fct>
+static qlonglong measureHeapPeak(T_Fct fct)
+{
+   qlonglong lBefore = heap_peak_reset();
+   if (lBefore < 0) { return -1; }
+   fct();
+   return (heap_peak() - lBefore);
+}
+
+template <class T>
+static void measureSerialization(runner & r, const QString & sGraph, const T & obj, qlonglong lIterations)
+{
+   QList< serialization_engine<T> > lstEngine = getSerializationEngines<T>();
+   for (int i = 0; i < lstEngine.count(); ++i)
+   {
+      const serialization_engine<T> & engine = lstEngine.at(i);
+      std::string owner; std::wstring w_owner; QByteArray data;
+      data = engine.m_fctSave(obj, owner, w_owner);
+      if (data.isEmpty()) { qDebug("[qxBenchmark] unable to serialize graph '%s' using '%s'", qPrintable(sGraph), qPrintable(engine.m_sType)); continue; }
+      double dMB = (data.size() / (1024.0 * 1024.0));
+
+      // Check the round-trip : an object loaded from the payload must be serialized to the same payload
+      T loaded; bool bLoadOk = engine.m_fctLoad(loaded, data);
+      std::string owner_check; std::wstring w_owner_check;
+      bool bRoundTripOk = (bLoadOk && (engine.m_fctSave(loaded, owner_check, w_owner_check) == data));
+      if (! bRoundTripOk) { qDebug("[qxBenchmark] graph '%s' using '%s' : %s", qPrintable(sGraph), qPrintable(engine.m_sType), (bLoadOk ? "round-trip payload differs" : "unable to deserialize")); }
+
+      std::string owner_tmp; std::wstring w_owner_tmp;
+      auto fctSave = [&]() { QByteArray tmp = engine.m_fctSave(obj, owner_tmp, w_owner_tmp); Q_UNUSED(tmp); };
+      auto fctLoad = [&]() { T tmp; engine.m_fctLoad(tmp, data); };
+
+      result & rs = r.measure(QString("serialize %1 %2").arg(engine.m_sType, sGraph), lIterations, fctSave);
+      rs.m_extra.insert("serialization_type", engine.m_sType);
+      rs.m_extra.insert("graph", sGraph);
+      rs.m_extra.insert("payload_bytes", data.size());
+      rs.m_extra.insert("MB_per_sec", (rs.m_ops_per_sec * dMB));
+      qlonglong lPeak = measureHeapPeak(fctSave);
+      if (lPeak >= 0) { rs.m_extra.insert("peak_heap_bytes", lPeak); }
+      if (! bRoundTripOk) { rs.m_extra.insert("round_trip_error", true); }
+
+      if (! bLoadOk) { continue; }
+      result & rl = r.measure(QString("deserialize %1 %2").arg(engine.m_sType, sGraph), lIterations, fctLoad);
+      rl.m_extra.insert("serialization_type", engine.m_sType);
+      rl.m_extra.insert("graph", sGraph);
+      rl.m_extra.insert("payload_bytes", data.size());
+      rl.m_extra.insert("MB_per_sec", (rl.m_ops_per_sec * dMB));
+      lPeak = measureHeapPeak(fctLoad);
+      if (lPeak >= 0) { rl.m_extra.insert("peak_heap_bytes", lPeak); }
+   }
+}
+
+void suite_serialization(runner & r)
+{
+   // Flat : 1 entity
+   bench_item_ptr pItem = newSerializedItem(1);
+   measureSerialization(r, "flat", (* pItem), 20000);
+
+   // Container of smart pointers : 1000 entities
+   list_bench_item lstItem;
+   for (long l = 1; l <= 1000; ++l) { lstItem.insert(l, newSerializedItem(l)); }
+   measureSerialization(r, "container_1000", lstItem, 100);
+
+   // Deep graph : authors -> profile + books -> tags (4 levels, 10 authors, 100 books, 300 tags)
+   list_bench_author lstDeep = buildAuthorGraph(false);
+   measureSerialization(r, "deep", lstDeep, 500);
+
+   // Same graph with shared references : 300 links to only 5 tags instances
+   list_bench_author lstShared = buildAuthorGraph(true);
+   measureSerialization(r, "shared_references", lstShared, 500);
+}
+
+} // namespace qx_bench
@@ -0,0 +1,80 @@
+#include "../include/precompiled.h"
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+void suite_session(runner & r)
+{
+   const long lRows = 1000;
+   if (! initBenchItemDatabase(":memory:", "", lRows)) { return; }
+
+   // Simulate a request handler : 20 rows updated 3 times each, 10 rows inserted then updated, 10 rows inserted then deleted by another request
+   const long lTouched = 20; const long lInserted = 10;
+   QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+   long lNextId = (lRows + 1);
+   for (int i = 0; i < 2; ++i)
+   {
+      bool bDeferred = (i == 1); long lCount = 0; int iErrors = 0; long lPending = 0;
+      auto fct = [&]() {
+         qx::QxSession session(db, true, false);
+         session.setDeferred(bDeferred);
+         list_bench_item lstTouched; list_bench_item lstInserted;
+         for (long l = 0; l < lTouched; ++l)
+         {
+            bench_item_ptr p = std::make_shared<bench_item>(); p->m_id = ((((lCount * lTouched) + l) * 7919) % lRows) + 1;
+            p->m_name = QString("item_%1").arg(p->m_id); p->m_category = "touched"; lstTouched.insert(p->m_id, p);
+            for (int k = 0; k < 3; ++k) { p->m_quantity = k; session.update(p); }
+         }
+         for (long l = 0; l < lInserted; ++l)
+         {
+            bench_item_ptr p = std::make_shared<bench_item>(); p->m_id = lNextId++;
+            p->m_name = QString("item_%1").arg(p->m_id); p->m_category = "inserted"; lstInserted.insert(p->m_id, p);
+            session.insert(p); p->m_quantity = 1; session.update(p);
+         }
+         for (long l = 0; l < lstInserted.count(); ++l) { if ((l % 2) == 0) { bench_item_ptr p = lstInserted.getByIndex(l); session.deleteById(p); } }
+         lPending = session.pendingCount(); lCount++;
+         if (! session.commit()) { ++iErrors; }
+         if (! session.isValid()) { ++iErrors; }
+      };
+
+      result & res = r.measure(QString("request handler (session %1)").arg(bDeferred ? "deferred" : "immediate"), 200, fct);
+      res.m_extra.insert("deferred", bDeferred);
+      res.m_extra.insert("calls_per_op", static_cast<qlonglong>((lTouched * 3) + (lInserted * 2) + (lInserted / 2)));
+      res.m_extra.insert("pending_writes_per_op", static_cast<qlonglong>(bDeferred ? lPending : ((lTouched * 3) + (lInserted * 2) + (lInserted / 2))));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+
+   // Simulate a request handler reading 50 entities by id, only 10 distinct ids (same entities referenced several times)
+   const long lReads = 50; const long lDistinct = 10;
+   for (int i = 0; i < 2; ++i)
+   {
+      bool bIdentityMap = (i == 1); long lCount = 0; int iErrors = 0; long lShared = 0;
+      auto fct = [&]() {
+         qx::QxSession session(db, true, false);
+         session.setIdentityMap(bIdentityMap);
+         QList<bench_item_ptr> lstFetched; QSet<bench_item *> setInstances;
+         for (long l = 0; l < lReads; ++l)
+         {
+            bench_item_ptr p = std::make_shared<bench_item>(); p->m_id = ((((lCount * lDistinct) + (l % lDistinct)) * 7919) % lRows) + 1;
+            session.fetchById(p); lstFetched.append(p); setInstances.insert(p.get());
+         }
+         lShared = (lReads - setInstances.count()); lCount++;
+         if (! session.isValid()) { ++iErrors; }
+      };
+
+      result & res = r.measure(QString("fetch_by_id (identity map %1)").arg(bIdentityMap ? "on" : "off"), 200, fct);
+      res.m_extra.insert("identity_map", bIdentityMap);
+      res.m_extra.insert("fetch_per_op", static_cast<qlonglong>(lReads));
+      res.m_extra.insert("instances_shared_per_op", static_cast<qlonglong>(lShared));
+      if (iErrors > 0) { res.m_extra.insert("errors", iErrors); }
+   }
+
+   db = QSqlDatabase();
+   qx::QxSqlDatabase::closeAllDatabases();
+}
+
+} // namespace qx_bench
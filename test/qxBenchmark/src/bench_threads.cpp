@@ -0,0 +1,62 @@
+#include "../include/precompiled.h"
+
+#include <thread>
+
+#include "../include/bench.h"
+#include "../include/bench_item.h"
+
+#include <QxOrm_Impl.h>
+
+namespace qx_bench {
+
+void suite_threads(runner & r)
+{
+   const long lRows = 1000;
+   // Shared in-memory SQLite database : each thread gets its own connection (managed by qx::QxSqlDatabase) to the same data
+   if (! initBenchItemDatabase("file:qx_bench_threads?mode=memory&cache=shared", "QSQLITE_OPEN_URI;QSQLITE_ENABLE_SHARED_CACHE", lRows)) { return; }
+
+   // Keep one connection opened : in-memory database is destroyed when last connection is closed
+   QSqlDatabase dbKeepAlive = qx::QxSqlDatabase::getDatabase();
+
+   int iMaxThreads = qMax(8, static_cast<int>(std::thread::hardware_concurrency()));
+   qlonglong lIterationsPerThread = r.iterations(20000);
+   for (int iThreads = 1; iThreads <= iMaxThreads; iThreads *= 2)
+   {
+      QVector< QVector<qint64> > samplesByThread(iThreads);
+      QAtomicInt iErrors(0);
+      QElapsedTimer total; total.start();
+
+      std::vector<std::thread> lstThreads;
+      for (int t = 0; t < iThreads; ++t)
+      {
+         lstThreads.push_back(std::thread([&, t]() {
+            QVector<qint64> & samples = samplesByThread[t];
+            samples.reserve(static_cast<int>(lIterationsPerThread));
+            QSqlDatabase db = qx::QxSqlDatabase::getDatabase();
+            bench_item item; QElapsedTimer timer;
+            for (qlonglong l = 0; l < lIterationsPerThread; ++l)
+            {
+               item.m_id = static_cast<long>(((l * 7919) + t) % lRows) + 1;
+               timer.start();
+               QSqlError daoError = qx::dao::fetch_by_id(item, (& db));
+               samples.append(timer.nsecsElapsed());
+               if (daoError.isValid()) { iErrors.fetchAndAddRelaxed(1); }
+            }
+         }));
+      }
+      for (std::thread & th : lstThreads) { th.join(); }
+      qint64 iTotalNs = total.nsecsElapsed();
+
+      QVector<qint64> samples;
+      Q_FOREACH(const QVector<qint64> & lst, samplesByThread) { samples += lst; }
+      result & res = r.add(QString("fetch_by_id %1 thread(s)").arg(iThreads), samples, iTotalNs);
+      res.m_extra.insert("threads", iThreads);
+      res.m_extra.insert("ops_per_sec_per_thread", (res.m_ops_per_sec / iThreads));
+      if (iErrors.loadAcquire() > 0) { res.m_extra.insert("errors", iErrors.loadAcquire()); }
+   }
+
+   dbKeepAlive = QSqlDatabase();
+   qx::QxSqlDatabase::closeAllDatabases();
+}
+
+} // namespace qx_bench
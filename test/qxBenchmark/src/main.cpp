@@ -0,0 +1,90 @@
+#include "../include/precompiled.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qjsondocument.h>
+
+#include "../include/bench.h"
+
+static void printUsage()
+{
+   qDebug("usage : qxBenchmark [--scale <factor>] [--param <key=value>] [--output <file.json>] [--compare <baseline.json> [--threshold <percent>] [--input <results.json>]] [suite1 suite2 ...]");
+   qDebug("available suites : %s", "alloc, compression, crypt, dao, http, parallel, projection, serialization, session, threads");
+   qDebug("--param : suite setting, for example 'http.concurrency=1,8,32' (see each suite for available settings)");
+   qDebug("--compare : compare results with a baseline file (exit code 2 if a regression is found), results are read from --input file instead of running suites if provided");
+}
+
+static bool loadResults(const QString & sFile, QList<qx_bench::result> & lst)
+{
+   QFile file(sFile);
+   if (! file.open(QIODevice::ReadOnly)) { qDebug("[qxBenchmark] unable to read file '%s'", qPrintable(sFile)); return false; }
+   QJsonParseError err; QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), (& err));
+   if (err.error != QJsonParseError::NoError) { qDebug("[qxBenchmark] invalid JSON file '%s' : %s", qPrintable(sFile), qPrintable(err.errorString())); return false; }
+   lst = qx_bench::runner::fromJson(doc.object());
+   return true;
+}
+
+int main(int argc, char * argv[])
+{
+   QCoreApplication app(argc, argv);
+
+   QMap<QString, qx_bench::type_fct_suite> mapSuite;
+   mapSuite.insert("alloc", (& qx_bench::suite_alloc));
+   mapSuite.insert("compression", (& qx_bench::suite_compression));
+   mapSuite.insert("crypt", (& qx_bench::suite_crypt));
+   mapSuite.insert("dao", (& qx_bench::suite_dao));
+   mapSuite.insert("http", (& qx_bench::suite_http));
+   mapSuite.insert("parallel", (& qx_bench::suite_parallel));
+   mapSuite.insert("projection", (& qx_bench::suite_projection));
+   mapSuite.insert("serialization", (& qx_bench::suite_serialization));
+   mapSuite.insert("session", (& qx_bench::suite_session));
+   mapSuite.insert("threads", (& qx_bench::suite_threads));
+
+   qx_bench::runner r;
+   QString sOutput; QString sCompare; QString sInput; double dThreshold = 10.0;
+   QStringList lstSuite;
+   QStringList lstArgs = app.arguments(); lstArgs.removeFirst();
+   for (int i = 0; i < lstArgs.count(); ++i)
+   {
+      QString sArg = lstArgs.at(i);
+      if ((sArg == "--scale") && ((i + 1) < lstArgs.count())) { r.setScale(lstArgs.at(++i).toDouble()); }
+      else if ((sArg == "--output") && ((i + 1) < lstArgs.count())) { sOutput = lstArgs.at(++i); }
+      else if ((sArg == "--param") && ((i + 1) < lstArgs.count()) && lstArgs.at(i + 1).contains("=")) { QString sParam = lstArgs.at(++i); r.setParam(sParam.section('=', 0, 0).trimmed(), sParam.section('=', 1).trimmed()); }
+      else if ((sArg == "--compare") && ((i + 1) < lstArgs.count())) { sCompare = lstArgs.at(++i); }
+      else if ((sArg == "--input") && ((i + 1) < lstArgs.count())) { sInput = lstArgs.at(++i); }
+      else if ((sArg == "--threshold") && ((i + 1) < lstArgs.count())) { dThreshold = lstArgs.at(++i).toDouble(); }
+      else if ((sArg == "--help") || (sArg == "-h")) { printUsage(); return 0; }
+      else if (mapSuite.contains(sArg)) { lstSuite.append(sArg); }
+      else { qDebug("[qxBenchmark] unknown argument '%s'", qPrintable(sArg)); printUsage(); return 1; }
+   }
+   if (lstSuite.isEmpty()) { lstSuite = mapSuite.keys(); }
+
+   QList<qx_bench::result> lstBaseline;
+   if (! sCompare.isEmpty() && ! loadResults(sCompare, lstBaseline)) { return 1; }
+   if (! sInput.isEmpty())
+   {
+      if (sCompare.isEmpty()) { qDebug("[qxBenchmark] --input requires --compare"); printUsage(); return 1; }
+      QList<qx_bench::result> lstInput;
+      if (! loadResults(sInput, lstInput)) { return 1; }
+      return ((qx_bench::runner::compare(lstInput, lstBaseline, dThreshold) > 0) ? 2 : 0);
+   }
+
+   Q_FOREACH(QString sSuite, lstSuite)
+   {
+      qDebug("[qxBenchmark] running suite '%s'...", qPrintable(sSuite));
+      r.setCurrentSuite(sSuite);
+      r.setCountAllocs(true); // Multi-thread suites can disable it
+      mapSuite.value(sSuite)(r);
+   }
+   r.print();
+
+   if (! sOutput.isEmpty())
+   {
+      QFile file(sOutput);
+      if (! file.open(QIODevice::WriteOnly | QIODevice::Truncate)) { qDebug("[qxBenchmark] unable to write file '%s'", qPrintable(sOutput)); return 1; }
+      file.write(QJsonDocument(r.toJson()).toJson());
+      qDebug("[qxBenchmark] results written to file '%s'", qPrintable(sOutput));
+   }
+
+   if (! sCompare.isEmpty() && (qx_bench::runner::compare(r.results(), lstBaseline, dThreshold) > 0)) { return 2; }
+   return 0;
+}